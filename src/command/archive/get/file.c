@@ -11,6 +11,7 @@ Archive Get File
 #include "compress/gzipDecompress.h"
 #include "config/config.h"
 #include "crypto/cipherBlock.h"
+#include "crypto/hash.h"
 #include "info/infoArchive.h"
 #include "postgres/interface.h"
 #include "storage/helper.h"
@@ -165,11 +166,38 @@ archiveGetFile(
 
             ioWriteFilterGroupSet(storageFileWriteIo(destination), filterGroup);
 
-            // Copy the file
-            storageCopyNP(
-                storageNewReadNP(
-                    storageRepo(), strNewFmt("%s/%s", STORAGE_REPO_ARCHIVE, strPtr(archiveGetCheckResult.archiveFileActual))),
-                destination);
+            // Verify WAL segments stored uncompressed and unencrypted against the checksum in the file name since nothing else will
+            // detect corruption, e.g. gzip checks a CRC when decompressing.  The checksum is of the original segment so it can only
+            // be checked against files stored as-is.  The hash is calculated where the file is stored, e.g. on the repository host,
+            // so the database host does not pay for it.
+            bool plain = cipherType == cipherTypeNone && !strEndsWithZ(archiveGetCheckResult.archiveFileActual, "." GZIP_EXT);
+            bool verify = plain && walIsSegment(archiveFile);
+
+            // Copy the file.  The archived file will not be read again soon so don't let it evict more useful data from the cache.
+            // Only compress the transfer when the file is stored uncompressed and unencrypted.
+            StorageFileRead *source = storageNewReadP(
+                storageRepo(), strNewFmt("%s/%s", STORAGE_REPO_ARCHIVE, strPtr(archiveGetCheckResult.archiveFileActual)),
+                .noCache = true, .compressible = plain,
+                .filterList = verify ? strLstAddZ(strLstNew(), CRYPTO_HASH_FILTER_TYPE ":" HASH_TYPE_SHA1) : NULL);
+
+            storageCopyNP(source, destination);
+
+            if (verify)
+            {
+                const String *archiveFileName = strBase(archiveGetCheckResult.archiveFileActual);
+                const String *checksum = strSub(archiveFileName, (size_t)strChr(archiveFileName, '-') + 1);
+                const String *checksumActual = varStr(varLstGet(storageFileReadFilterResult(source), 0));
+
+                // Remove the WAL segment so it is not used by mistake
+                if (!strEq(checksum, checksumActual))
+                {
+                    storageRemoveNP(storage, walDestination);
+
+                    THROW_FMT(
+                        ChecksumError, "WAL segment '%s' in the archive has checksum '%s' but expected '%s' from the file name",
+                        strPtr(archiveGetCheckResult.archiveFileActual), strPtr(checksumActual), strPtr(checksum));
+                }
+            }
 
             // The WAL file was found
             result = 0;
@@ -214,8 +214,8 @@ cmdArchiveGet(void)
                     // The async process should not output on the console at all
                     KeyValue *optionReplace = kvNew();
 
-                    kvPut(optionReplace, varNewStr(strNew(cfgOptionName(cfgOptLogLevelConsole))), varNewStrZ("off"));
-                    kvPut(optionReplace, varNewStr(strNew(cfgOptionName(cfgOptLogLevelStderr))), varNewStrZ("off"));
+                    kvPut(optionReplace, varNewStr(strNew(cfgOptionName(cfgOptLogLevelConsole))), VARSTRDEF("off"));
+                    kvPut(optionReplace, varNewStr(strNew(cfgOptionName(cfgOptLogLevelStderr))), VARSTRDEF("off"));
 
                     // Generate command options
                     StringList *commandExec = cfgExecParam(cfgCmdArchiveGetAsync, optionReplace);
@@ -314,7 +314,7 @@ cmdArchiveGetAsync(void)
                 const String *walSegment = strLstGet(walSegmentList, walSegmentIdx);
 
                 ProtocolCommand *command = protocolCommandNew(PROTOCOL_COMMAND_ARCHIVE_GET_STR);
-                protocolCommandParamAdd(command, varNewStr(walSegment));
+                protocolCommandParamAdd(command, VARSTR(walSegment));
 
                 protocolParallelJobAdd(parallelExec, protocolParallelJobNew(varNewStr(walSegment), command));
             }
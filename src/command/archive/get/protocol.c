@@ -43,7 +43,7 @@ archiveGetProtocol(const String *command, const VariantList *paramList, Protocol
 
             protocolServerResponse(
                 server,
-                varNewInt(
+                VARINT(
                     archiveGetFile(
                         storageSpoolWrite(), walSegment, strNewFmt(STORAGE_SPOOL_ARCHIVE_IN "/%s", strPtr(walSegment)), true,
                         cipherType(cfgOptionStr(cfgOptRepoCipherType)), cfgOptionStr(cfgOptRepoCipherPass))));
@@ -63,8 +63,8 @@ cmdArchivePush(void)
                         server = true;
 
                         // The async process should not output on the console at all
-                        cfgOptionSet(cfgOptLogLevelConsole, cfgSourceParam, varNewStrZ("off"));
-                        cfgOptionSet(cfgOptLogLevelStderr, cfgSourceParam, varNewStrZ("off"));
+                        cfgOptionSet(cfgOptLogLevelConsole, cfgSourceParam, VARSTRDEF("off"));
+                        cfgOptionSet(cfgOptLogLevelStderr, cfgSourceParam, VARSTRDEF("off"));
                         cfgLoadLogSetting();
 
                         // Open the log file
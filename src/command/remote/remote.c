@@ -4,6 +4,7 @@ Remote Command
 #include "common/debug.h"
 #include "common/io/handleRead.h"
 #include "common/io/handleWrite.h"
+#include "common/io/io.h"
 #include "common/log.h"
 #include "config/config.h"
 #include "config/protocol.h"
@@ -25,6 +26,7 @@ cmdRemote(int handleRead, int handleWrite)
         IoRead *read = ioHandleReadIo(ioHandleReadNew(name, handleRead, (TimeMSec)(cfgOptionDbl(cfgOptProtocolTimeout) * 1000)));
         ioReadOpen(read);
         IoWrite *write = ioHandleWriteIo(ioHandleWriteNew(name, handleWrite));
+        ioHandlePipeSizeSet(handleWrite, ioBufferSize() * PROTOCOL_READ_AHEAD_BLOCKS);
         ioWriteOpen(write);
 
         ProtocolServer *server = protocolServerNew(name, PROTOCOL_SERVICE_REMOTE_STR, read, write);
@@ -6,9 +6,11 @@ Ini Handler
 #include <string.h>
 
 #include "common/debug.h"
-#include "common/memContext.h"
 #include "common/ini.h"
+#include "common/log.h"
+#include "common/memContext.h"
 #include "common/type/keyValue.h"
+#include "common/type/list.h"
 
 /***********************************************************************************************************************************
 Contains information about the ini
@@ -16,9 +18,43 @@ Contains information about the ini
 struct Ini
 {
     MemContext *memContext;                                         // Context that contains the ini
-    KeyValue *store;                                                // Key value store that contains the ini data
+    KeyValue *sectionIndex;                                         // Index of each section in the section list by name
+    List *sectionList;                                              // List of sections
+    StringList *sectionNameList;                                    // Section names in the order they were added
 };
 
+/***********************************************************************************************************************************
+Contains information about a section
+***********************************************************************************************************************************/
+typedef struct IniSection
+{
+    KeyValue *store;                                                // Key value store that contains the section data
+    StringList *keyList;                                            // Keys in the order they were added
+} IniSection;
+
+/***********************************************************************************************************************************
+Create the section store.  Sections are allocated in the section list mem context so they are freed with the list.
+***********************************************************************************************************************************/
+static void
+iniStoreNew(Ini *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INI, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    MEM_CONTEXT_BEGIN(this->memContext)
+    {
+        this->sectionIndex = kvNew();
+        this->sectionList = lstNew(sizeof(IniSection));
+        this->sectionNameList = strLstNew();
+    }
+    MEM_CONTEXT_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Create a new Ini object
 ***********************************************************************************************************************************/
@@ -33,8 +69,8 @@ iniNew(void)
         this = memNew(sizeof(Ini));
         this->memContext = MEM_CONTEXT_NEW();
 
-        // Allocate key value store
-        this->store = kvNew();
+        // Allocate section store
+        iniStoreNew(this);
     }
     MEM_CONTEXT_NEW_END();
 
@@ -42,6 +78,29 @@ iniNew(void)
     return this;
 }
 
+/***********************************************************************************************************************************
+Find a section -- returns NULL if it does not exist
+***********************************************************************************************************************************/
+static IniSection *
+iniSectionFind(const Ini *this, const String *section)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INI, this);
+        FUNCTION_TEST_PARAM(STRING, section);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(section != NULL);
+
+    IniSection *result = NULL;
+    const Variant *sectionIdx = kvGetStr(this->sectionIndex, section);
+
+    if (sectionIdx != NULL)
+        result = (IniSection *)lstGet(this->sectionList, (unsigned int)varUInt64(sectionIdx));
+
+    FUNCTION_TEST_RETURN(result);
+}
+
 /***********************************************************************************************************************************
 Internal function to get an ini value
 ***********************************************************************************************************************************/
@@ -60,16 +119,12 @@ iniGetInternal(const Ini *this, const String *section, const String *key)
 
     const Variant *result = NULL;
 
-    MEM_CONTEXT_TEMP_BEGIN()
-    {
-        // Get the section
-        KeyValue *sectionKv = varKv(kvGet(this->store, varNewStr(section)));
+    // Get the section
+    const IniSection *iniSection = iniSectionFind(this, section);
 
-        // Section must exist to get the value
-        if (sectionKv != NULL)
-            result = kvGet(sectionKv, varNewStr(key));
-    }
-    MEM_CONTEXT_TEMP_END();
+    // Section must exist to get the value
+    if (iniSection != NULL)
+        result = kvGetStr(iniSection->store, key);
 
     FUNCTION_TEST_RETURN(result);
 }
@@ -129,8 +184,10 @@ iniGetDefault(const Ini *this, const String *section, const String *key, Variant
 
 /***********************************************************************************************************************************
 Get a list of keys for a section
+
+The list is maintained as keys are set so it is not copied.  If the section does not exist then a new empty list is returned.
 ***********************************************************************************************************************************/
-StringList *
+const StringList *
 iniSectionKeyList(const Ini *this, const String *section)
 {
     FUNCTION_TEST_BEGIN();
@@ -141,32 +198,173 @@ iniSectionKeyList(const Ini *this, const String *section)
     ASSERT(this != NULL);
     ASSERT(section != NULL);
 
-    StringList *result = NULL;
+    // Get the section
+    const IniSection *iniSection = iniSectionFind(this, section);
 
-    MEM_CONTEXT_TEMP_BEGIN()
+    FUNCTION_TEST_RETURN(iniSection == NULL ? strLstNew() : iniSection->keyList);
+}
+
+/***********************************************************************************************************************************
+Get a list of sections
+***********************************************************************************************************************************/
+const StringList *
+iniSectionList(const Ini *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INI, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->sectionNameList);
+}
+
+/***********************************************************************************************************************************
+Internal function to set an ini value
+
+Temporary allocations are made in the current mem context so the caller should set a temp context.
+***********************************************************************************************************************************/
+static void
+iniSetInternal(Ini *this, const String *section, const String *key, const Variant *value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INI, this);
+        FUNCTION_TEST_PARAM(STRING, section);
+        FUNCTION_TEST_PARAM(STRING, key);
+        FUNCTION_TEST_PARAM(VARIANT, value);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(section != NULL);
+    ASSERT(key != NULL);
+    ASSERT(value != NULL);
+
+    IniSection *iniSection = iniSectionFind(this, section);
+
+    // Add the section if it does not exist
+    if (iniSection == NULL)
     {
-        // Get the section
-        KeyValue *sectionKv = varKv(kvGet(this->store, varNewStr(section)));
+        MEM_CONTEXT_BEGIN(lstMemContext(this->sectionList))
+        {
+            IniSection iniSectionNew = {.store = kvNew(), .keyList = strLstNew()};
+            lstAdd(this->sectionList, &iniSectionNew);
+        }
+        MEM_CONTEXT_END();
 
-        // Return key list if the section exists
-        if (sectionKv != NULL)
-            result = strLstNewVarLst(kvKeyList(sectionKv));
-        // Otherwise return an empty list
+        kvPut(this->sectionIndex, VARSTR(section), VARUINT64(lstSize(this->sectionList) - 1));
+        strLstAdd(this->sectionNameList, section);
+
+        iniSection = (IniSection *)lstGet(this->sectionList, lstSize(this->sectionList) - 1);
+    }
+
+    // Add the key to the key list if it does not exist
+    if (kvGetStr(iniSection->store, key) == NULL)
+        strLstAdd(iniSection->keyList, key);
+
+    kvAdd(iniSection->store, VARSTR(key), value);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Parse a line
+
+Whitespace is trimmed from the line before it is parsed.  The current section is allocated in the ini context so it survives temp
+context resets in the caller, which must free it when parsing is complete.
+***********************************************************************************************************************************/
+static void
+iniParseLine(
+    Ini *this, const char *linePtr, size_t lineSize, unsigned int lineIdx, String **section, IniLoadCallback *callback,
+    void *callbackData)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INI, this);
+        FUNCTION_TEST_PARAM(STRINGZ, linePtr);
+        FUNCTION_TEST_PARAM(SIZE, lineSize);
+        FUNCTION_TEST_PARAM(UINT, lineIdx);
+        FUNCTION_TEST_PARAM_P(STRING, section);
+        FUNCTION_TEST_PARAM(FUNCTIONP, callback);
+        FUNCTION_TEST_PARAM_P(VOID, callbackData);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(linePtr != NULL);
+    ASSERT(section != NULL);
+
+    // Trim the line
+    const char *lineEnd = linePtr + lineSize;
+
+    while (linePtr < lineEnd && (*linePtr == ' ' || *linePtr == '\t' || *linePtr == '\r'))
+        linePtr++;
+
+    while (lineEnd > linePtr && (lineEnd[-1] == ' ' || lineEnd[-1] == '\t' || lineEnd[-1] == '\r'))
+        lineEnd--;
+
+    lineSize = (size_t)(lineEnd - linePtr);
+
+    // Only interested in lines that are not blank or comments
+    if (lineSize > 0 && linePtr[0] != '#')
+    {
+        // Looks like this line is a section
+        if (linePtr[0] == '[')
+        {
+            // Make sure the section ends with ]
+            if (linePtr[lineSize - 1] != ']')
+            {
+                THROW_FMT(
+                    FormatError, "ini section should end with ] at line %u: %s", lineIdx + 1, strPtr(strNewN(linePtr, lineSize)));
+            }
+
+            // Assign section
+            MEM_CONTEXT_BEGIN(this->memContext)
+            {
+                strFree(*section);
+                *section = strNewN(linePtr + 1, lineSize - 2);
+            }
+            MEM_CONTEXT_END();
+        }
+        // Else it should be a key/value
         else
-            result = strLstNew();
+        {
+            if (*section == NULL)
+            {
+                THROW_FMT(
+                    FormatError, "key/value found outside of section at line %u: %s", lineIdx + 1,
+                    strPtr(strNewN(linePtr, lineSize)));
+            }
+
+            // Find the =
+            const char *lineEqual = memchr(linePtr, '=', lineSize);
+
+            if (lineEqual == NULL)
+            {
+                THROW_FMT(
+                    FormatError, "missing '=' in key/value at line %u: %s", lineIdx + 1, strPtr(strNewN(linePtr, lineSize)));
+            }
+
+            // Extract the key
+            String *key = strTrim(strNewN(linePtr, (size_t)(lineEqual - linePtr)));
+
+            if (strSize(key) == 0)
+                THROW_FMT(FormatError, "key is zero-length at line %u: %s", lineIdx, strPtr(strNewN(linePtr, lineSize)));
 
-        strLstMove(result, MEM_CONTEXT_OLD());
+            // Extract the value
+            String *value = strTrim(strNewN(lineEqual + 1, (size_t)(lineEnd - lineEqual - 1)));
+
+            // Store the section/key/value unless the callback has consumed it
+            if (callback == NULL || callback(callbackData, *section, key, value))
+                iniSetInternal(this, *section, key, varNewStr(value));
+        }
     }
-    MEM_CONTEXT_TEMP_END();
 
-    FUNCTION_TEST_RETURN(result);
+    FUNCTION_TEST_RETURN_VOID();
 }
 
 /***********************************************************************************************************************************
-Get a list of sections
+Clear the ini before parsing new content
 ***********************************************************************************************************************************/
-StringList *
-iniSectionList(const Ini *this)
+static void
+iniClear(Ini *this)
 {
     FUNCTION_TEST_BEGIN();
         FUNCTION_TEST_PARAM(INI, this);
@@ -174,22 +372,69 @@ iniSectionList(const Ini *this)
 
     ASSERT(this != NULL);
 
-    StringList *result = NULL;
+    kvFree(this->sectionIndex);
+    lstFree(this->sectionList);
+    strLstFree(this->sectionNameList);
+    iniStoreNew(this);
 
-    MEM_CONTEXT_TEMP_BEGIN()
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Load ini from an IoRead
+
+Lines are parsed as they are read so the raw content is never held in memory.  If a callback is provided it is called for each
+key/value in the order they appear so the caller can process the content (e.g. checksum it) in the same pass.  Key/values the
+callback returns false for are not stored.  The read must be open and is not closed.
+***********************************************************************************************************************************/
+void
+iniLoad(Ini *this, IoRead *read, IniLoadCallback *callback, void *callbackData)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(INI, this);
+        FUNCTION_LOG_PARAM(IO_READ, read);
+        FUNCTION_LOG_PARAM(FUNCTIONP, callback);
+        FUNCTION_LOG_PARAM_P(VOID, callbackData);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(read != NULL);
+
+    iniClear(this);
+
+    MEM_CONTEXT_TEMP_RESET_BEGIN()
     {
-        // Get the sections from the keyList
-        result = strLstNewVarLst(kvKeyList(this->store));
+        // Track the current section
+        String *section = NULL;
+        unsigned int lineIdx = 0;
+        String *line = NULL;
+
+        do
+        {
+            MEM_CONTEXT_TEMP_RESET(1000);
 
-        strLstMove(result, MEM_CONTEXT_OLD());
+            line = ioReadLineParam(read, true);
+
+            if (line != NULL)
+            {
+                iniParseLine(this, strPtr(line), strSize(line), lineIdx, &section, callback, callbackData);
+                lineIdx++;
+            }
+        }
+        while (line != NULL);
+
+        strFree(section);
     }
     MEM_CONTEXT_TEMP_END();
 
-    FUNCTION_TEST_RETURN(result);
+    FUNCTION_LOG_RETURN_VOID();
 }
 
 /***********************************************************************************************************************************
 Parse ini from a string
+
+Lines are parsed in place so only the keys and values are copied.  The temp context is reset periodically so memory used while
+parsing does not grow with the size of the content.
 ***********************************************************************************************************************************/
 void
 iniParse(Ini *this, const String *content)
@@ -201,71 +446,41 @@ iniParse(Ini *this, const String *content)
 
     ASSERT(this != NULL);
 
-    MEM_CONTEXT_BEGIN(this->memContext)
-    {
-        kvFree(this->store);
-        this->store = kvNew();
+    iniClear(this);
 
-        if (content != NULL)
+    if (content != NULL)
+    {
+        MEM_CONTEXT_TEMP_RESET_BEGIN()
         {
-            MEM_CONTEXT_TEMP_BEGIN()
+            // Track the current section
+            String *section = NULL;
+
+            // Loop through lines
+            const char *linePtr = strPtr(content);
+            unsigned int lineIdx = 0;
+
+            do
             {
-                // Track the current section
-                String *section = NULL;
-
-                // Split the content into lines and loop
-                StringList *lines = strLstNewSplitZ(content, "\n");
-
-                for (unsigned int lineIdx = 0; lineIdx < strLstSize(lines); lineIdx++)
-                {
-                    // Get next line
-                    const String *line = strTrim(strLstGet(lines, lineIdx));
-                    const char *linePtr = strPtr(line);
-
-                    // Only interested in lines that are not blank or comments
-                    if (strSize(line) > 0 && linePtr[0] != '#')
-                    {
-                        // Looks like this line is a section
-                        if (linePtr[0] == '[')
-                        {
-                            // Make sure the section ends with ]
-                            if (linePtr[strSize(line) - 1] != ']')
-                                THROW_FMT(FormatError, "ini section should end with ] at line %u: %s", lineIdx + 1, linePtr);
-
-                            // Assign section
-                            section = strNewN(linePtr + 1, strSize(line) - 2);
-                        }
-                        // Else it should be a key/value
-                        else
-                        {
-                            if (section == NULL)
-                                THROW_FMT(FormatError, "key/value found outside of section at line %u: %s", lineIdx + 1, linePtr);
-
-                            // Find the =
-                            const char *lineEqual = strstr(linePtr, "=");
-
-                            if (lineEqual == NULL)
-                                THROW_FMT(FormatError, "missing '=' in key/value at line %u: %s", lineIdx + 1, linePtr);
-
-                            // Extract the key
-                            String *key = strTrim(strNewN(linePtr, (size_t)(lineEqual - linePtr)));
-
-                            if (strSize(key) == 0)
-                                THROW_FMT(FormatError, "key is zero-length at line %u: %s", lineIdx++, linePtr);
-
-                            // Extract the value
-                            Variant *value = varNewStr(strTrim(strNew(lineEqual + 1)));
-
-                            // Store the section/key/value
-                            iniSet(this, section, key, value);
-                        }
-                    }
-                }
+                MEM_CONTEXT_TEMP_RESET(1000);
+
+                // Find the end of the line and the beginning of the next
+                const char *lineEnd = strchr(linePtr, '\n');
+                const char *lineNext = lineEnd == NULL ? NULL : lineEnd + 1;
+
+                if (lineEnd == NULL)
+                    lineEnd = linePtr + strlen(linePtr);
+
+                iniParseLine(this, linePtr, (size_t)(lineEnd - linePtr), lineIdx, &section, NULL, NULL);
+
+                linePtr = lineNext;
+                lineIdx++;
             }
-            MEM_CONTEXT_TEMP_END();
+            while (linePtr != NULL);
+
+            strFree(section);
         }
+        MEM_CONTEXT_TEMP_END();
     }
-    MEM_CONTEXT_END()
 
     FUNCTION_TEST_RETURN_VOID();
 }
@@ -290,13 +505,7 @@ iniSet(Ini *this, const String *section, const String *key, const Variant *value
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        Variant *sectionKey = varNewStr(section);
-        KeyValue *sectionKv = varKv(kvGet(this->store, sectionKey));
-
-        if (sectionKv == NULL)
-            sectionKv = kvPutKv(this->store, sectionKey);
-
-        kvAdd(sectionKv, varNewStr(key), value);
+        iniSetInternal(this, section, key, value);
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -9,16 +9,24 @@ Ini object
 ***********************************************************************************************************************************/
 typedef struct Ini Ini;
 
+#include "common/io/read.h"
 #include "common/type/variant.h"
 
+/***********************************************************************************************************************************
+Callback for each key/value loaded by iniLoad().  Return true to store the key/value in the ini or false if the callback has consumed
+it and it should not be stored.
+***********************************************************************************************************************************/
+typedef bool IniLoadCallback(void *data, const String *section, const String *key, const String *value);
+
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
 Ini *iniNew(void);
 const Variant *iniGet(const Ini *this, const String *section, const String *key);
 const Variant *iniGetDefault(const Ini *this, const String *section, const String *key, Variant *defaultValue);
-StringList *iniSectionKeyList(const Ini *this, const String *section);
-StringList *iniSectionList(const Ini *this);
+const StringList *iniSectionKeyList(const Ini *this, const String *section);
+const StringList *iniSectionList(const Ini *this);
+void iniLoad(Ini *this, IoRead *read, IniLoadCallback *callback, void *callbackData);
 void iniParse(Ini *this, const String *content);
 void iniSet(Ini *this, const String *section, const String *key, const Variant *value);
 void iniFree(Ini *this);
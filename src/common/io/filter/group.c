@@ -41,6 +41,7 @@ struct IoFilterGroup
     unsigned int firstOutputFilter;                                 // Index of the first output filter
     KeyValue *filterResult;                                         // Filter results (if any)
     bool inputSame;                                                 // Same input required again?
+    bool passThru;                                                  // Is output the same as input, i.e. no filters added?
     bool done;                                                      // Is processing done?
 
 #ifdef DEBUG
@@ -129,6 +130,9 @@ ioFilterGroupOpen(IoFilterGroup *this)
 
     MEM_CONTEXT_BEGIN(this->memContext)
     {
+        // If no filters were added then data will pass through the group unmodified
+        this->passThru = lstSize(this->filterList) == 0;
+
         // If the last filter is not an output filter then add a filter to buffer/copy data.  Input filters won't copy to an output
         // buffer so we need some way to get the data to the output buffer.
         if (lstSize(this->filterList) == 0 || !ioFilterOutput((ioFilterGroupGet(this, lstSize(this->filterList) - 1))->filter))
@@ -342,7 +346,7 @@ ioFilterGroupClose(IoFilterGroup *this)
 
         MEM_CONTEXT_TEMP_BEGIN()
         {
-            kvAdd(this->filterResult, varNewStr(ioFilterType(filterData->filter)), filterResult);
+            kvAdd(this->filterResult, VARSTR(ioFilterType(filterData->filter)), filterResult);
         }
         MEM_CONTEXT_TEMP_END();
     }
@@ -389,6 +393,22 @@ ioFilterGroupInputSame(const IoFilterGroup *this)
     FUNCTION_TEST_RETURN(this->inputSame);
 }
 
+/***********************************************************************************************************************************
+Will data pass through the group unmodified?  Callers can use this to skip the group entirely, e.g. to copy in the kernel.
+***********************************************************************************************************************************/
+bool
+ioFilterGroupPassThru(const IoFilterGroup *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_FILTER_GROUP, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->opened);
+
+    FUNCTION_TEST_RETURN(this->passThru);
+}
+
 /***********************************************************************************************************************************
 Get filter results
 ***********************************************************************************************************************************/
@@ -404,15 +424,7 @@ ioFilterGroupResult(const IoFilterGroup *this, const String *filterType)
     ASSERT(this->opened && this->closed);
     ASSERT(filterType != NULL);
 
-    const Variant *result = NULL;
-
-    MEM_CONTEXT_TEMP_BEGIN()
-    {
-        result = kvGet(this->filterResult, varNewStr(filterType));
-    }
-    MEM_CONTEXT_TEMP_END();
-
-    FUNCTION_LOG_RETURN_CONST(VARIANT, result);
+    FUNCTION_LOG_RETURN_CONST(VARIANT, kvGetStr(this->filterResult, filterType));
 }
 
 /***********************************************************************************************************************************
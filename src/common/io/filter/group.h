@@ -36,6 +36,7 @@ Getters
 ***********************************************************************************************************************************/
 bool ioFilterGroupDone(const IoFilterGroup *this);
 bool ioFilterGroupInputSame(const IoFilterGroup *this);
+bool ioFilterGroupPassThru(const IoFilterGroup *this);
 const Variant *ioFilterGroupResult(const IoFilterGroup *this, const String *filterType);
 
 /***********************************************************************************************************************************
@@ -15,6 +15,12 @@ typedef struct IoSize IoSize;
 #include "common/io/filter/filter.h"
 #include "common/type/buffer.h"
 
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+#define SIZE_FILTER_TYPE                                            "size"
+    STRING_DECLARE(SIZE_FILTER_TYPE_STR);
+
 /***********************************************************************************************************************************
 Constructor
 ***********************************************************************************************************************************/
@@ -1,6 +1,7 @@
 /***********************************************************************************************************************************
 Handle IO Write
 ***********************************************************************************************************************************/
+#include <fcntl.h>
 #include <unistd.h>
 
 #include "common/debug.h"
@@ -133,3 +134,33 @@ ioHandleWriteOneStr(int handle, const String *string)
 
     FUNCTION_LOG_RETURN_VOID();
 }
+
+/***********************************************************************************************************************************
+Grow the kernel buffer of a pipe so the writer can get ahead of the reader
+
+This is best effort since the handle may not be a pipe (e.g. a socket) and not all platforms allow the pipe size to be set.  Returns the
+new size of the pipe buffer or 0 if it could not be set.
+***********************************************************************************************************************************/
+size_t
+ioHandlePipeSizeSet(int handle, size_t size)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(INT, handle);
+        FUNCTION_LOG_PARAM(SIZE, size);
+    FUNCTION_LOG_END();
+
+    ASSERT(size > 0);
+
+    size_t result = 0;
+
+#ifdef F_SETPIPE_SZ
+    int pipeSize = fcntl(handle, F_SETPIPE_SZ, (int)size);
+
+    if (pipeSize != -1)
+        result = (size_t)pipeSize;
+#else
+    (void)handle;
+#endif
+
+    FUNCTION_LOG_RETURN(SIZE, result);
+}
@@ -37,6 +37,7 @@ void ioHandleWriteFree(IoHandleWrite *this);
 /***********************************************************************************************************************************
 Helper functions
 ***********************************************************************************************************************************/
+size_t ioHandlePipeSizeSet(int handle, size_t size);
 void ioHandleWriteOneStr(int handle, const String *string);
 
 /***********************************************************************************************************************************
@@ -17,10 +17,12 @@ Http constants
     STRING_STATIC(HTTP_VERSION_STR,                                 HTTP_VERSION);
 
 STRING_EXTERN(HTTP_VERB_GET_STR,                                    HTTP_VERB_GET);
+STRING_EXTERN(HTTP_VERB_POST_STR,                                   HTTP_VERB_POST);
 
 #define HTTP_HEADER_CONNECTION                                      "connection"
     STRING_STATIC(HTTP_HEADER_CONNECTION_STR,                       HTTP_HEADER_CONNECTION);
 STRING_EXTERN(HTTP_HEADER_CONTENT_LENGTH_STR,                       HTTP_HEADER_CONTENT_LENGTH);
+STRING_EXTERN(HTTP_HEADER_CONTENT_MD5_STR,                          HTTP_HEADER_CONTENT_MD5);
 #define HTTP_HEADER_TRANSFER_ENCODING                               "transfer-encoding"
     STRING_STATIC(HTTP_HEADER_TRANSFER_ENCODING_STR,                HTTP_HEADER_TRANSFER_ENCODING);
 
@@ -43,6 +45,9 @@ struct HttpClient
     TlsClient *tls;                                                 // Tls client
     IoRead *ioRead;                                                 // Read io interface
 
+    Buffer *request;                                                // Request to send (kept in case a retry is required)
+    bool requestSent;                                               // Has the request been sent on the current connection?
+
     unsigned int responseCode;                                      // Response code (e.g. 200, 404)
     String *responseMessage;                                        // Response message e.g. (OK, Not Found)
     HttpHeader *responseHeader;                                     // Response headers
@@ -185,12 +190,45 @@ httpClientNew(
 }
 
 /***********************************************************************************************************************************
-Perform a request
+Write the request to the server, opening the connection if needed
 ***********************************************************************************************************************************/
-Buffer *
-httpClientRequest(
+static void
+httpClientRequestWrite(HttpClient *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace)
+        FUNCTION_LOG_PARAM(HTTP_CLIENT, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->request != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        tlsClientOpen(this->tls);
+
+        // Write the request and flush
+        ioWrite(tlsClientIoWrite(this->tls), this->request);
+        ioWriteFlush(tlsClientIoWrite(this->tls));
+
+        this->requestSent = true;
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Send a request without waiting for the response
+
+This allows requests to be sent on multiple clients before any responses are read so the server can process them concurrently.  The
+response must be read with httpClientResponse() before another request is sent on this client.  Errors sending the request are not
+thrown here but are instead handled (and retried) when the response is read.  Use httpClientRequestSent() to check whether there
+is a connection to wait on.
+***********************************************************************************************************************************/
+void
+httpClientRequestSend(
     HttpClient *this, const String *verb, const String *uri, const HttpQuery *query, const HttpHeader *requestHeader,
-    bool returnContent)
+    const Buffer *body)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug)
         FUNCTION_LOG_PARAM(HTTP_CLIENT, this);
@@ -198,12 +236,86 @@ httpClientRequest(
         FUNCTION_LOG_PARAM(STRING, uri);
         FUNCTION_LOG_PARAM(HTTP_QUERY, query);
         FUNCTION_LOG_PARAM(HTTP_HEADER, requestHeader);
+        FUNCTION_LOG_PARAM(BUFFER, body);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
     ASSERT(verb != NULL);
     ASSERT(uri != NULL);
 
+    // Free the read interface from the prior request since it is no longer valid once a new request has been sent
+    ioReadFree(this->ioRead);
+    this->ioRead = NULL;
+
+    // Render the request
+    bufFree(this->request);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        String *request = strNew("");
+        String *queryStr = httpQueryRender(query);
+
+        strCatFmt(
+            request, "%s %s%s%s " HTTP_VERSION "\r\n", strPtr(verb), strPtr(httpUriEncode(uri, true)), queryStr == NULL ? "" : "?",
+            queryStr == NULL ? "" : strPtr(queryStr));
+
+        // Render headers
+        if (requestHeader != NULL)
+        {
+            const StringList *headerList = httpHeaderList(requestHeader);
+
+            for (unsigned int headerIdx = 0; headerIdx < strLstSize(headerList); headerIdx++)
+            {
+                const String *headerKey = strLstGet(headerList, headerIdx);
+                strCatFmt(request, "%s:%s\r\n", strPtr(headerKey), strPtr(httpHeaderGet(requestHeader, headerKey)));
+            }
+        }
+
+        // Add blank line to end the request
+        strCat(request, "\r\n");
+
+        // Combine the request and body so they are sent together
+        MEM_CONTEXT_BEGIN(this->memContext)
+        {
+            this->request = bufNew(strSize(request) + (body == NULL ? 0 : bufUsed(body)));
+            bufCatC(this->request, (const unsigned char *)strPtr(request), 0, strSize(request));
+            bufCat(this->request, body);
+        }
+        MEM_CONTEXT_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    // Send the request.  On error close the connection so the request will be sent again when the response is read.
+    this->requestSent = false;
+
+    TRY_BEGIN()
+    {
+        httpClientRequestWrite(this);
+    }
+    CATCH_ANY()
+    {
+        LOG_DEBUG("unable to send request %s: %s", errorTypeName(errorType()), errorMessage());
+        tlsClientClose(this->tls);
+    }
+    TRY_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Read the response to a request sent with httpClientRequestSend()
+***********************************************************************************************************************************/
+Buffer *
+httpClientResponse(HttpClient *this, bool returnContent)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug)
+        FUNCTION_LOG_PARAM(HTTP_CLIENT, this);
+        FUNCTION_LOG_PARAM(BOOL, returnContent);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->request != NULL);
+
     // Buffer for returned content
     Buffer *result = NULL;
 
@@ -237,34 +349,9 @@ httpClientRequest(
 
             TRY_BEGIN()
             {
-                tlsClientOpen(this->tls);
-
-                // Write the request
-                String *queryStr = httpQueryRender(query);
-
-                ioWriteLine(
-                    tlsClientIoWrite(this->tls),
-                    strNewFmt(
-                        "%s %s%s%s " HTTP_VERSION "\r", strPtr(verb), strPtr(httpUriEncode(uri, true)), queryStr == NULL ? "" : "?",
-                        queryStr == NULL ? "" : strPtr(queryStr)));
-
-                // Write headers
-                if (requestHeader != NULL)
-                {
-                    const StringList *headerList = httpHeaderList(requestHeader);
-
-                    for (unsigned int headerIdx = 0; headerIdx < strLstSize(headerList); headerIdx++)
-                    {
-                        const String *headerKey = strLstGet(headerList, headerIdx);
-                        ioWriteLine(
-                            tlsClientIoWrite(this->tls),
-                            strNewFmt("%s:%s\r", strPtr(headerKey), strPtr(httpHeaderGet(requestHeader, headerKey))));
-                    }
-                }
-
-                // Write out blank line and close the write so it flushes
-                ioWriteLine(tlsClientIoWrite(this->tls), CR_STR);
-                ioWriteFlush(tlsClientIoWrite(this->tls));
+                // Write the request if it has not already been sent (or needs to be sent again for a retry)
+                if (!this->requestSent)
+                    httpClientRequestWrite(this);
 
                 // Read status and make sure it starts with the correct http version
                 String *status = strTrim(ioReadLine(tlsClientIoRead(this->tls)));
@@ -403,7 +490,9 @@ httpClientRequest(
                     retry = true;
                 }
 
+                // The request must be sent again on a new connection
                 tlsClientClose(this->tls);
+                this->requestSent = false;
             }
             TRY_END();
         }
@@ -420,6 +509,64 @@ httpClientRequest(
     FUNCTION_LOG_RETURN(BUFFER, result);
 }
 
+/***********************************************************************************************************************************
+Perform a request
+***********************************************************************************************************************************/
+Buffer *
+httpClientRequest(
+    HttpClient *this, const String *verb, const String *uri, const HttpQuery *query, const HttpHeader *requestHeader,
+    const Buffer *body, bool returnContent)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug)
+        FUNCTION_LOG_PARAM(HTTP_CLIENT, this);
+        FUNCTION_LOG_PARAM(STRING, verb);
+        FUNCTION_LOG_PARAM(STRING, uri);
+        FUNCTION_LOG_PARAM(HTTP_QUERY, query);
+        FUNCTION_LOG_PARAM(HTTP_HEADER, requestHeader);
+        FUNCTION_LOG_PARAM(BUFFER, body);
+        FUNCTION_LOG_PARAM(BOOL, returnContent);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(verb != NULL);
+    ASSERT(uri != NULL);
+
+    httpClientRequestSend(this, verb, uri, query, requestHeader, body);
+
+    FUNCTION_LOG_RETURN(BUFFER, httpClientResponse(this, returnContent));
+}
+
+/***********************************************************************************************************************************
+Is a response ready to be read?  Call after select() reports the handle readable since the connection may be readable without any
+response data (see tlsClientReady()).
+***********************************************************************************************************************************/
+bool
+httpClientReady(HttpClient *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(HTTP_CLIENT, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_LOG_RETURN(BOOL, tlsClientReady(this->tls));
+}
+
+/***********************************************************************************************************************************
+Get the handle of the connection so callers with requests outstanding on multiple clients can wait for the first response
+***********************************************************************************************************************************/
+int
+httpClientHandle(const HttpClient *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(HTTP_CLIENT, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(tlsClientHandle(this->tls));
+}
+
 /***********************************************************************************************************************************
 Get read interface
 ***********************************************************************************************************************************/
@@ -435,6 +582,22 @@ httpClientIoRead(const HttpClient *this)
     FUNCTION_TEST_RETURN(this->ioRead);
 }
 
+/***********************************************************************************************************************************
+Was the last request sent?  When httpClientRequestSend() fails the connection is closed so there is no handle to wait on, but
+httpClientResponse() can be called immediately to send the request again.
+***********************************************************************************************************************************/
+bool
+httpClientRequestSent(const HttpClient *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(HTTP_CLIENT, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->requestSent);
+}
+
 /***********************************************************************************************************************************
 Get the response code
 ***********************************************************************************************************************************/
@@ -6,6 +6,9 @@ A robust HTTP client with pipelining support and automatic retries.
 Using a single object to make multiple requests is more efficient because requests are piplelined whenever possible.  Requests are
 automatically retried when the connection has been closed by the server.  Any 5xx response is also retried.
 
+A request may also be split into httpClientRequestSend() and httpClientResponse() so that requests can be outstanding on multiple
+clients at the same time.
+
 Only the HTTPS protocol is currently supported.
 ***********************************************************************************************************************************/
 #ifndef COMMON_IO_HTTP_CLIENT_H
@@ -27,9 +30,13 @@ HTTP Constants
 ***********************************************************************************************************************************/
 #define HTTP_VERB_GET                                               "GET"
     STRING_DECLARE(HTTP_VERB_GET_STR);
+#define HTTP_VERB_POST                                              "POST"
+    STRING_DECLARE(HTTP_VERB_POST_STR);
 
 #define HTTP_HEADER_CONTENT_LENGTH                                  "content-length"
     STRING_DECLARE(HTTP_HEADER_CONTENT_LENGTH_STR);
+#define HTTP_HEADER_CONTENT_MD5                                     "content-md5"
+    STRING_DECLARE(HTTP_HEADER_CONTENT_MD5_STR);
 
 #define HTTP_RESPONSE_CODE_OK                                       200
 #define HTTP_RESPONSE_CODE_FORBIDDEN                                403
@@ -46,12 +53,19 @@ Functions
 ***********************************************************************************************************************************/
 Buffer *httpClientRequest(
     HttpClient *this, const String *verb, const String *uri, const HttpQuery *query, const HttpHeader *requestHeader,
-    bool returnContent);
+    const Buffer *body, bool returnContent);
+void httpClientRequestSend(
+    HttpClient *this, const String *verb, const String *uri, const HttpQuery *query, const HttpHeader *requestHeader,
+    const Buffer *body);
+Buffer *httpClientResponse(HttpClient *this, bool returnContent);
+bool httpClientReady(HttpClient *this);
 
 /***********************************************************************************************************************************
 Getters
 ***********************************************************************************************************************************/
+int httpClientHandle(const HttpClient *this);
 IoRead *httpClientIoRead(const HttpClient *this);
+bool httpClientRequestSent(const HttpClient *this);
 unsigned int httpClientResponseCode(const HttpClient *this);
 const HttpHeader *httpClientReponseHeader(const HttpClient *this);
 const String *httpClientResponseMessage(const HttpClient *this);
@@ -57,13 +57,11 @@ httpQueryAdd(HttpQuery *this, const String *key, const String *value)
     MEM_CONTEXT_BEGIN(this->memContext)
     {
         // Make sure the key does not already exist
-        Variant *keyVar = varNewStr(key);
-
-        if (kvGet(this->kv, keyVar) != NULL)
+        if (kvGetStr(this->kv, key) != NULL)
             THROW_FMT(AssertError, "key '%s' already exists", strPtr(key));
 
         // Store the key
-        kvPut(this->kv, keyVar, varNewStr(value));
+        kvPut(this->kv, VARSTR(key), VARSTR(value));
     }
     MEM_CONTEXT_END();
 
@@ -84,15 +82,7 @@ httpQueryGet(const HttpQuery *this, const String *key)
     ASSERT(this != NULL);
     ASSERT(key != NULL);
 
-    String *result = NULL;
-
-    MEM_CONTEXT_BEGIN(this->memContext)
-    {
-        result = varStr(kvGet(this->kv, varNewStr(key)));
-    }
-    MEM_CONTEXT_END();
-
-    FUNCTION_TEST_RETURN(result);
+    FUNCTION_TEST_RETURN(varStr(kvGetStr(this->kv, key)));
 }
 
 /***********************************************************************************************************************************
@@ -148,7 +138,7 @@ httpQueryPut(HttpQuery *this, const String *key, const String *value)
     MEM_CONTEXT_BEGIN(this->memContext)
     {
         // Store the key
-        kvPut(this->kv, varNewStr(key), varNewStr(value));
+        kvPut(this->kv, VARSTR(key), VARSTR(value));
     }
     MEM_CONTEXT_END();
 
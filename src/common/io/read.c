@@ -19,6 +19,7 @@ struct IoRead
     IoReadInterface interface;                                      // Driver interface
     IoFilterGroup *filterGroup;                                     // IO filters
     Buffer *input;                                                  // Input buffer
+    const Buffer *inputView;                                        // Input view from the driver (NULL when input buffer is used)
     Buffer *output;                                                 // Output buffer (holds extra data from line read)
 
     bool eofAll;                                                    // Is the read done (read and filters complete)?
@@ -133,7 +134,7 @@ ioReadInternal(IoRead *this, Buffer *buffer, bool block)
         // Process input buffer again to get more output
         if (ioFilterGroupInputSame(this->filterGroup))
         {
-            ioFilterGroupProcess(this->filterGroup, this->input, buffer);
+            ioFilterGroupProcess(this->filterGroup, this->inputView != NULL ? this->inputView : this->input, buffer);
         }
         // Else new input can be accepted
         else
@@ -141,21 +142,29 @@ ioReadInternal(IoRead *this, Buffer *buffer, bool block)
             // Read if not EOF
             if (!ioReadEofDriver(this))
             {
-                bufUsedZero(this->input);
-
                 // If blocking then limit the amount of data requested
-                if (block && bufRemains(this->input) > bufRemains(buffer))
-                    bufLimitSet(this->input, bufRemains(buffer));
-
-                this->interface.read(this->driver, this->input, block);
-                bufLimitClear(this->input);
+                size_t size = block && bufSize(this->input) > bufRemains(buffer) ? bufRemains(buffer) : bufSize(this->input);
+
+                // Get a view of the data when the driver can provide one so it does not need to be copied into the input buffer
+                this->inputView = this->interface.view != NULL ? this->interface.view(this->driver, size) : NULL;
+
+                if (this->inputView == NULL)
+                {
+                    bufUsedZero(this->input);
+                    bufLimitSet(this->input, size);
+                    this->interface.read(this->driver, this->input, block);
+                    bufLimitClear(this->input);
+                }
             }
             // Set input to NULL and flush (no need to actually free the buffer here as it will be freed with the mem context)
             else
+            {
                 this->input = NULL;
+                this->inputView = NULL;
+            }
 
             // Process the input buffer (or flush if NULL)
-            ioFilterGroupProcess(this->filterGroup, this->input, buffer);
+            ioFilterGroupProcess(this->filterGroup, this->inputView != NULL ? this->inputView : this->input, buffer);
 
             // Stop if not blocking -- we don't need to fill the buffer as long as we got some data
             if (!block && bufUsed(buffer) > bufferUsedBegin)
@@ -209,20 +218,25 @@ ioRead(IoRead *this, Buffer *buffer)
 }
 
 /***********************************************************************************************************************************
-Read linefeed-terminated string
+Find the next line in the output buffer, reading more data as needed
 
-The entire string to search for must fit within a single buffer.
+Returns false when allowEof is true and there are no more lines.  Otherwise lineSize is set to the size of the line without the
+linefeed and consumeSize is set to the number of bytes to remove from the output buffer once the line has been copied.
 ***********************************************************************************************************************************/
-String *
-ioReadLine(IoRead *this)
+static bool
+ioReadLineInternal(IoRead *this, bool allowEof, size_t *lineSize, size_t *consumeSize)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(IO_READ, this);
-        FUNCTION_LOG_PARAM(BUFFER, this->output);
+        FUNCTION_LOG_PARAM(BOOL, allowEof);
+        FUNCTION_LOG_PARAM_P(SIZE, lineSize);
+        FUNCTION_LOG_PARAM_P(SIZE, consumeSize);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
     ASSERT(this->opened && !this->closed);
+    ASSERT(lineSize != NULL);
+    ASSERT(consumeSize != NULL);
 
     // Allocate the output buffer if it has not already been allocated.  This buffer is not allocated at object creation because it
     // is not always used.
@@ -236,7 +250,8 @@ ioReadLine(IoRead *this)
     }
 
     // Search for a linefeed
-    String *result = NULL;
+    bool found = false;
+    bool eof = false;
 
     do
     {
@@ -245,38 +260,127 @@ ioReadLine(IoRead *this)
             // Search for a linefeed in the buffer
             char *linefeed = memchr(bufPtr(this->output), '\n', bufUsed(this->output));
 
-            // A linefeed was found so get the string
+            // A linefeed was found so return the line size
             if (linefeed != NULL)
             {
-                // Get the string size
-                size_t size = (size_t)(linefeed - (char *)bufPtr(this->output) + 1);
-
-                // Create the string
-                result = strNewN((char *)bufPtr(this->output), size - 1);
-
-                // Remove string from the output buffer
-                memmove(bufPtr(this->output), bufPtr(this->output) + size, bufUsed(this->output) - size);
-                bufUsedSet(this->output, bufUsed(this->output) - size);
+                *lineSize = (size_t)(linefeed - (char *)bufPtr(this->output));
+                *consumeSize = *lineSize + 1;
+                found = true;
             }
         }
 
         // Read data if no linefeed was found in the existing buffer
-        if (result == NULL)
+        if (!found)
         {
             if (bufFull(this->output))
                 THROW_FMT(FileReadError, "unable to find line in %zu byte buffer", bufSize(this->output));
 
             if (ioReadEof(this))
-                THROW(FileReadError, "unexpected eof while reading line");
-
-            ioReadInternal(this, this->output, false);
+            {
+                if (!allowEof)
+                    THROW(FileReadError, "unexpected eof while reading line");
+
+                // Return what is left in the buffer as the last line
+                if (bufUsed(this->output) > 0)
+                {
+                    *lineSize = bufUsed(this->output);
+                    *consumeSize = *lineSize;
+                    found = true;
+                }
+
+                eof = true;
+            }
+            else
+                ioReadInternal(this, this->output, false);
         }
     }
-    while (result == NULL);
+    while (!found && !eof);
+
+    FUNCTION_LOG_RETURN(BOOL, found);
+}
+
+/***********************************************************************************************************************************
+Remove a line from the output buffer after it has been copied
+***********************************************************************************************************************************/
+static void
+ioReadLineConsume(IoRead *this, size_t consumeSize)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_READ, this);
+        FUNCTION_TEST_PARAM(SIZE, consumeSize);
+    FUNCTION_TEST_END();
+
+    memmove(bufPtr(this->output), bufPtr(this->output) + consumeSize, bufUsed(this->output) - consumeSize);
+    bufUsedSet(this->output, bufUsed(this->output) - consumeSize);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Read linefeed-terminated string
+
+The entire string to search for must fit within a single buffer.  If allowEof is true then the last line does not need to be
+terminated and NULL is returned when there are no more lines.
+***********************************************************************************************************************************/
+String *
+ioReadLineParam(IoRead *this, bool allowEof)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_READ, this);
+        FUNCTION_LOG_PARAM(BOOL, allowEof);
+    FUNCTION_LOG_END();
+
+    String *result = NULL;
+    size_t lineSize;
+    size_t consumeSize;
+
+    if (ioReadLineInternal(this, allowEof, &lineSize, &consumeSize))
+    {
+        result = strNewN((char *)bufPtr(this->output), lineSize);
+        ioReadLineConsume(this, consumeSize);
+    }
 
     FUNCTION_LOG_RETURN(STRING, result);
 }
 
+String *
+ioReadLine(IoRead *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_READ, this);
+    FUNCTION_LOG_END();
+
+    FUNCTION_LOG_RETURN(STRING, ioReadLineParam(this, false));
+}
+
+/***********************************************************************************************************************************
+Read linefeed-terminated line into a buffer
+
+The line replaces the contents of the buffer, which is only resized when the line does not fit.  This allows the same buffer to be
+reused for each line without allocating.
+***********************************************************************************************************************************/
+void
+ioReadLineBuf(IoRead *this, Buffer *buffer)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_READ, this);
+        FUNCTION_LOG_PARAM(BUFFER, buffer);
+    FUNCTION_LOG_END();
+
+    ASSERT(buffer != NULL);
+
+    size_t lineSize;
+    size_t consumeSize;
+
+    ioReadLineInternal(this, false, &lineSize, &consumeSize);
+
+    bufUsedZero(buffer);
+    bufCatC(buffer, bufPtr(this->output), 0, lineSize);
+    ioReadLineConsume(this, consumeSize);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Close the IO
 ***********************************************************************************************************************************/
@@ -23,6 +23,8 @@ Functions
 bool ioReadOpen(IoRead *this);
 size_t ioRead(IoRead *this, Buffer *buffer);
 String *ioReadLine(IoRead *this);
+String *ioReadLineParam(IoRead *this, bool allowEof);
+void ioReadLineBuf(IoRead *this, Buffer *buffer);
 void ioReadClose(IoRead *this);
 
 /***********************************************************************************************************************************
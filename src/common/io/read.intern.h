@@ -15,6 +15,10 @@ typedef bool (*IoReadInterfaceOpen)(void *driver);
 typedef int (*IoReadInterfaceHandle)(void *driver);
 typedef size_t (*IoReadInterfaceRead)(void *driver, Buffer *buffer, bool block);
 
+// Optional function that returns a view of up to size bytes of data without copying it.  The view must remain valid until the next
+// call or until the driver is closed.  If NULL is returned then read() is called instead.
+typedef const Buffer *(*IoReadInterfaceView)(void *driver, size_t size);
+
 typedef struct IoReadInterface
 {
     IoReadInterfaceEof eof;
@@ -22,6 +26,7 @@ typedef struct IoReadInterface
     IoReadInterfaceHandle handle;
     IoReadInterfaceOpen open;
     IoReadInterfaceRead read;
+    IoReadInterfaceView view;
 } IoReadInterface;
 
 #define ioReadNewP(driver, ...)                                                                                                    \
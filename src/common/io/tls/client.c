@@ -2,6 +2,7 @@
 TLS Client
 ***********************************************************************************************************************************/
 #include <arpa/inet.h>
+#include <fcntl.h>
 #include <netdb.h>
 #include <stdio.h>
 #include <string.h>
@@ -558,6 +559,58 @@ tlsClientEof(const TlsClient *this)
     FUNCTION_LOG_RETURN(BOOL, this->session == NULL);
 }
 
+/***********************************************************************************************************************************
+Get the socket so callers can wait for data on multiple sessions
+***********************************************************************************************************************************/
+int
+tlsClientHandle(const TlsClient *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(TLS_CLIENT, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->socket);
+}
+
+/***********************************************************************************************************************************
+Is there data ready to be read?
+
+This should be called after select() reports that the socket is readable.  The socket may be readable when only TLS protocol
+messages (e.g. session tickets) have arrived so the session is checked without blocking to see if there is data.  True is also
+returned when the session has been closed or has an error so the caller's read will handle it.
+***********************************************************************************************************************************/
+bool
+tlsClientReady(TlsClient *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(TLS_CLIENT, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    bool result = true;
+
+    if (this->session != NULL && !SSL_pending(this->session))
+    {
+        // Peek without blocking so protocol messages are processed but the read does not wait for data
+        int flags = fcntl(this->socket, F_GETFL);
+        THROW_ON_SYS_ERROR(flags == -1, KernelError, "unable to get socket flags");
+        THROW_ON_SYS_ERROR(fcntl(this->socket, F_SETFL, flags | O_NONBLOCK) == -1, KernelError, "unable to set socket flags");
+
+        unsigned char peek;
+        int peekResult = SSL_peek(this->session, &peek, 1);
+
+        fcntl(this->socket, F_SETFL, flags);
+
+        if (peekResult <= 0 && SSL_get_error(this->session, peekResult) == SSL_ERROR_WANT_READ)
+            result = false;
+    }
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
+
 /***********************************************************************************************************************************
 Get read interface
 ***********************************************************************************************************************************/
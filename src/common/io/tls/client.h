@@ -37,6 +37,7 @@ Functions
 ***********************************************************************************************************************************/
 void tlsClientOpen(TlsClient *this);
 size_t tlsClientRead(TlsClient *this, Buffer *buffer, bool block);
+bool tlsClientReady(TlsClient *this);
 void tlsClientWrite(TlsClient *this, const Buffer *buffer);
 void tlsClientClose(TlsClient *this);
 
@@ -44,6 +45,7 @@ void tlsClientClose(TlsClient *this);
 Getters
 ***********************************************************************************************************************************/
 bool tlsClientEof(const TlsClient *this);
+int tlsClientHandle(const TlsClient *this);
 IoRead *tlsClientIoRead(const TlsClient *this);
 IoWrite *tlsClientIoWrite(const TlsClient *this);
 
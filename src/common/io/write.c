@@ -227,7 +227,7 @@ ioWriteFilterGroup(const IoWrite *this)
     FUNCTION_TEST_END();
 
     ASSERT(this != NULL);
-    ASSERT(this->opened && this->closed);
+    ASSERT(this->opened);
 
     FUNCTION_TEST_RETURN(this->filterGroup);
 }
@@ -13,16 +13,59 @@ Memory context states
 ***********************************************************************************************************************************/
 typedef enum {memContextStateFree = 0, memContextStateFreeing, memContextStateActive} MemContextState;
 
+/***********************************************************************************************************************************
+Alignment of allocations, which matches what malloc() provides on common platforms.  Headers stored before allocations are padded
+to this size so the allocations stay aligned.
+***********************************************************************************************************************************/
+#define MEM_CONTEXT_ALIGN                                           16
+#define MEM_CONTEXT_ALIGN_SIZE(size)                                                                                               \
+    (((size) + MEM_CONTEXT_ALIGN - 1) & ~((size_t)MEM_CONTEXT_ALIGN - 1))
+
 /***********************************************************************************************************************************
 Contains information about a memory allocation
+
+The header is stored just before the allocated buffer so the allocation can be found in the alloc list without searching.
 ***********************************************************************************************************************************/
 typedef struct MemContextAlloc
 {
-    bool active:1;                                                  // Is the allocation active?
+    unsigned int allocIdx:32;                                       // Index in the alloc list
     unsigned int size:32;                                           // Allocation size (4GB max)
-    void *buffer;                                                   // Allocated buffer
 } MemContextAlloc;
 
+#define MEM_CONTEXT_ALLOC_HEADER_SIZE                               MEM_CONTEXT_ALIGN_SIZE(sizeof(MemContextAlloc))
+
+// Get the buffer for an allocation header
+#define MEM_CONTEXT_ALLOC_BUFFER(header)                                                                                           \
+    ((void *)((unsigned char *)(header) + MEM_CONTEXT_ALLOC_HEADER_SIZE))
+
+// Get the allocation header for a buffer
+#define MEM_CONTEXT_ALLOC_HEADER(buffer)                                                                                           \
+    ((MemContextAlloc *)((unsigned char *)(buffer) - MEM_CONTEXT_ALLOC_HEADER_SIZE))
+
+/***********************************************************************************************************************************
+Contains information about an arena block
+
+Allocations are made from the space following the block header.  Each allocation is preceded by its size so it can be grown.
+***********************************************************************************************************************************/
+typedef struct MemContextArenaBlock
+{
+    struct MemContextArenaBlock *next;                              // Next block in the arena
+    size_t size;                                                    // Space available for allocations
+    size_t used;                                                    // Space used by allocations
+} MemContextArenaBlock;
+
+// Size of block and allocation headers
+#define MEM_CONTEXT_ARENA_BLOCK_HEADER_SIZE                         MEM_CONTEXT_ALIGN_SIZE(sizeof(MemContextArenaBlock))
+#define MEM_CONTEXT_ARENA_ALLOC_HEADER_SIZE                         MEM_CONTEXT_ALIGN_SIZE(sizeof(size_t))
+
+// Get the start of the allocation space in a block
+#define MEM_CONTEXT_ARENA_BLOCK_DATA(block)                                                                                        \
+    ((unsigned char *)(block) + MEM_CONTEXT_ARENA_BLOCK_HEADER_SIZE)
+
+// Get the size stored in the header of an allocation
+#define MEM_CONTEXT_ARENA_ALLOC_SIZE(buffer)                                                                                       \
+    (*(size_t *)((unsigned char *)(buffer) - MEM_CONTEXT_ARENA_ALLOC_HEADER_SIZE))
+
 /***********************************************************************************************************************************
 Contains information about the memory context
 ***********************************************************************************************************************************/
@@ -38,10 +81,13 @@ struct MemContext
     unsigned int contextChildListSize;                              // Size of child context list (not the actual count of contexts)
     unsigned int contextChildFreeIdx;                               // Index of first free space in the context list
 
-    MemContextAlloc *allocList;                                     // List of memory allocations created in this context
+    MemContextAlloc **allocList;                                    // List of memory allocations created in this context
     unsigned int allocListSize;                                     // Size of alloc list (not the actual count of allocations)
     unsigned int allocFreeIdx;                                      // Index of first free space in the alloc list
 
+    bool arena;                                                     // Are allocations made from arena blocks?
+    MemContextArenaBlock *arenaBlock;                               // Arena blocks with the current block first
+
     MemContextCallback callbackFunction;                            // Function to call before the context is freed
     void *callbackArgument;                                         // Argument to pass to callback function
 };
@@ -191,11 +237,12 @@ memContextNewIndex(MemContext *memContext, bool allowFree)
 /***********************************************************************************************************************************
 Create a new memory context
 ***********************************************************************************************************************************/
-MemContext *
-memContextNew(const char *name)
+static MemContext *
+memContextNewInternal(const char *name, bool arena)
 {
     FUNCTION_TEST_BEGIN();
         FUNCTION_TEST_PARAM(STRINGZ, name);
+        FUNCTION_TEST_PARAM(BOOL, arena);
     FUNCTION_TEST_END();
 
     ASSERT(name != NULL);
@@ -213,9 +260,14 @@ memContextNew(const char *name)
     // Get the context
     MemContext *this = contextCurrent->contextChildList[contextIdx];
 
-    // Create initial space for allocations
-    this->allocList = memAllocInternal(sizeof(MemContextAlloc) * MEM_CONTEXT_ALLOC_INITIAL_SIZE, true);
-    this->allocListSize = MEM_CONTEXT_ALLOC_INITIAL_SIZE;
+    // Create initial space for allocations.  Arena contexts do not track allocations so the first block is created on demand.
+    if (arena)
+        this->arena = true;
+    else
+    {
+        this->allocList = memAllocInternal(sizeof(MemContextAlloc *) * MEM_CONTEXT_ALLOC_INITIAL_SIZE, true);
+        this->allocListSize = MEM_CONTEXT_ALLOC_INITIAL_SIZE;
+    }
 
     // Set the context name
     this->name = name;
@@ -234,6 +286,29 @@ memContextNew(const char *name)
     FUNCTION_TEST_RETURN(this);
 }
 
+MemContext *
+memContextNew(const char *name)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRINGZ, name);
+    FUNCTION_TEST_END();
+
+    FUNCTION_TEST_RETURN(memContextNewInternal(name, false));
+}
+
+/***********************************************************************************************************************************
+Create a new arena memory context
+***********************************************************************************************************************************/
+MemContext *
+memContextNewArena(const char *name)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRINGZ, name);
+    FUNCTION_TEST_END();
+
+    FUNCTION_TEST_RETURN(memContextNewInternal(name, true));
+}
+
 /***********************************************************************************************************************************
 Register a callback to be called just before the context is freed
 ***********************************************************************************************************************************/
@@ -294,6 +369,153 @@ memContextCallbackClear(MemContext *this)
     FUNCTION_TEST_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Allocate memory from the current block of an arena context, adding a block when there is not enough space
+***********************************************************************************************************************************/
+static void *
+memContextArenaAlloc(size_t size, bool zero)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(SIZE, size);
+        FUNCTION_TEST_PARAM(BOOL, zero);
+    FUNCTION_TEST_END();
+
+    ASSERT(contextCurrent->arena);
+
+    size_t allocSize = MEM_CONTEXT_ARENA_ALLOC_HEADER_SIZE + MEM_CONTEXT_ALIGN_SIZE(size);
+    MemContextArenaBlock *block = contextCurrent->arenaBlock;
+
+    // If there is not enough space in the current block then add a block
+    if (block == NULL || block->size - block->used < allocSize)
+    {
+        // Large allocations get a block of their own
+        size_t blockSize = allocSize > MEM_CONTEXT_ARENA_BLOCK_SIZE / 4 ? allocSize : MEM_CONTEXT_ARENA_BLOCK_SIZE;
+
+        block = memAllocInternal(MEM_CONTEXT_ARENA_BLOCK_HEADER_SIZE + blockSize, false);
+        block->size = blockSize;
+        block->used = 0;
+
+        // Add the block after the current block when it is for a large allocation so the current block can still be used.
+        // Otherwise make it the current block.
+        if (contextCurrent->arenaBlock != NULL && blockSize != MEM_CONTEXT_ARENA_BLOCK_SIZE)
+        {
+            block->next = contextCurrent->arenaBlock->next;
+            contextCurrent->arenaBlock->next = block;
+        }
+        else
+        {
+            block->next = contextCurrent->arenaBlock;
+            contextCurrent->arenaBlock = block;
+        }
+    }
+
+    // Bump past the allocation and store the size in the header
+    unsigned char *buffer = MEM_CONTEXT_ARENA_BLOCK_DATA(block) + block->used + MEM_CONTEXT_ARENA_ALLOC_HEADER_SIZE;
+    block->used += allocSize;
+    MEM_CONTEXT_ARENA_ALLOC_SIZE(buffer) = size;
+
+    // Zero the memory when requested
+    if (zero)
+        memset(buffer, 0, size);
+
+    FUNCTION_TEST_RETURN(buffer);
+}
+
+/***********************************************************************************************************************************
+Make sure a buffer was allocated in the current arena context.  Arena allocations have no index to check so the blocks are searched,
+starting with the current block since that is where most frees and resizes happen.  This must be done before the allocation header
+is read or the current block is used since neither is valid for a foreign buffer.
+***********************************************************************************************************************************/
+static void
+memContextArenaFind(const void *buffer)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, buffer);
+    FUNCTION_TEST_END();
+
+    ASSERT(contextCurrent->arena);
+    ASSERT(buffer != NULL);
+
+    bool found = false;
+
+    for (MemContextArenaBlock *block = contextCurrent->arenaBlock; block != NULL && !found; block = block->next)
+    {
+        found =
+            (const unsigned char *)buffer >= MEM_CONTEXT_ARENA_BLOCK_DATA(block) + MEM_CONTEXT_ARENA_ALLOC_HEADER_SIZE &&
+            (const unsigned char *)buffer < MEM_CONTEXT_ARENA_BLOCK_DATA(block) + block->used;
+    }
+
+    if (!found)
+        THROW(AssertError, "unable to find allocation");
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Is the buffer the most recent allocation in the current block of an arena context?  If so it can be resized in place.
+***********************************************************************************************************************************/
+static bool
+memContextArenaLast(const void *buffer)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, buffer);
+    FUNCTION_TEST_END();
+
+    ASSERT(contextCurrent->arena);
+    ASSERT(buffer != NULL);
+
+    // Make sure the allocation is in the current context.  This also ensures there is a block.
+    memContextArenaFind(buffer);
+
+    FUNCTION_TEST_RETURN(
+        (const unsigned char *)buffer + MEM_CONTEXT_ALIGN_SIZE(MEM_CONTEXT_ARENA_ALLOC_SIZE(buffer)) ==
+            MEM_CONTEXT_ARENA_BLOCK_DATA(contextCurrent->arenaBlock) + contextCurrent->arenaBlock->used);
+}
+
+/***********************************************************************************************************************************
+Resize an allocation in an arena context.  The most recent allocation is resized in place when there is space, otherwise the
+allocation is copied.
+***********************************************************************************************************************************/
+static void *
+memContextArenaResize(const void *buffer, size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, buffer);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(contextCurrent->arena);
+    ASSERT(buffer != NULL);
+
+    void *result = NULL;
+
+    // Check for the most recent allocation first since this also makes sure the allocation is in the current context
+    bool last = memContextArenaLast(buffer);
+    size_t sizeOld = MEM_CONTEXT_ARENA_ALLOC_SIZE(buffer);
+
+    if (last)
+    {
+        MemContextArenaBlock *block = contextCurrent->arenaBlock;
+        size_t offset = (size_t)((const unsigned char *)buffer - MEM_CONTEXT_ARENA_BLOCK_DATA(block));
+
+        if (offset + MEM_CONTEXT_ALIGN_SIZE(size) <= block->size)
+        {
+            block->used = offset + MEM_CONTEXT_ALIGN_SIZE(size);
+            MEM_CONTEXT_ARENA_ALLOC_SIZE(buffer) = size;
+            result = (void *)buffer;
+        }
+    }
+
+    // Copy to a new allocation if the allocation could not be resized in place
+    if (result == NULL)
+    {
+        result = memContextArenaAlloc(size, false);
+        memcpy(result, buffer, sizeOld < size ? sizeOld : size);
+    }
+
+    FUNCTION_TEST_RETURN(result);
+}
+
 /***********************************************************************************************************************************
 Allocate memory in the memory context and optionally zero it.
 ***********************************************************************************************************************************/
@@ -307,7 +529,7 @@ memContextAlloc(size_t size, bool zero)
 
     // Find space for the new allocation
     for (; contextCurrent->allocFreeIdx < contextCurrent->allocListSize; contextCurrent->allocFreeIdx++)
-        if (!contextCurrent->allocList[contextCurrent->allocFreeIdx].active)
+        if (contextCurrent->allocList[contextCurrent->allocFreeIdx] == NULL)
             break;
 
     // If no space was found then allocate more
@@ -317,7 +539,7 @@ memContextAlloc(size_t size, bool zero)
         if (contextCurrent->allocListSize == 0)
         {
             // Allocate memory before modifying anything else in case there is an error
-            contextCurrent->allocList = memAllocInternal(sizeof(MemContextAlloc) * MEM_CONTEXT_ALLOC_INITIAL_SIZE, true);
+            contextCurrent->allocList = memAllocInternal(sizeof(MemContextAlloc *) * MEM_CONTEXT_ALLOC_INITIAL_SIZE, true);
 
             // Set new size
             contextCurrent->allocListSize = MEM_CONTEXT_ALLOC_INITIAL_SIZE;
@@ -330,22 +552,28 @@ memContextAlloc(size_t size, bool zero)
 
             // ReAllocate memory before modifying anything else in case there is an error
             contextCurrent->allocList = memReAllocInternal(
-                contextCurrent->allocList, sizeof(MemContextAlloc) * contextCurrent->allocListSize,
-                sizeof(MemContextAlloc) * allocListSizeNew, true);
+                contextCurrent->allocList, sizeof(MemContextAlloc *) * contextCurrent->allocListSize,
+                sizeof(MemContextAlloc *) * allocListSizeNew, true);
 
             // Set new size
             contextCurrent->allocListSize = allocListSizeNew;
         }
     }
 
-    // Allocate the memory
-    contextCurrent->allocList[contextCurrent->allocFreeIdx].active = true;
-    contextCurrent->allocList[contextCurrent->allocFreeIdx].size = (unsigned int)size;
-    contextCurrent->allocList[contextCurrent->allocFreeIdx].buffer = memAllocInternal(size, zero);
+    // Allocate the memory with the header before the buffer
+    MemContextAlloc *header = memAllocInternal(MEM_CONTEXT_ALLOC_HEADER_SIZE + size, false);
+    header->allocIdx = contextCurrent->allocFreeIdx;
+    header->size = (unsigned int)size;
+
+    contextCurrent->allocList[contextCurrent->allocFreeIdx] = header;
     contextCurrent->allocFreeIdx++;
 
+    // Zero the buffer when requested
+    if (zero)
+        memset(MEM_CONTEXT_ALLOC_BUFFER(header), 0, size);
+
     // Return buffer
-    FUNCTION_TEST_RETURN(contextCurrent->allocList[contextCurrent->allocFreeIdx - 1].buffer);
+    FUNCTION_TEST_RETURN(MEM_CONTEXT_ALLOC_BUFFER(header));
 }
 
 /***********************************************************************************************************************************
@@ -360,15 +588,11 @@ memFind(const void *buffer)
 
     ASSERT(buffer != NULL);
 
-    // Find memory allocation
-    unsigned int allocIdx;
+    // Get the index from the header and make sure the allocation is in the current context
+    MemContextAlloc *header = MEM_CONTEXT_ALLOC_HEADER(buffer);
+    unsigned int allocIdx = header->allocIdx;
 
-    for (allocIdx = 0; allocIdx < contextCurrent->allocListSize; allocIdx++)
-        if (contextCurrent->allocList[allocIdx].buffer == buffer && contextCurrent->allocList[allocIdx].active)
-            break;
-
-    // Error if the buffer was not found
-    if (allocIdx == contextCurrent->allocListSize)
+    if (allocIdx >= contextCurrent->allocListSize || contextCurrent->allocList[allocIdx] != header)
         THROW(AssertError, "unable to find allocation");
 
     FUNCTION_TEST_RETURN(allocIdx);
@@ -384,7 +608,7 @@ memNew(size_t size)
         FUNCTION_TEST_PARAM(SIZE, size);
     FUNCTION_TEST_END();
 
-    FUNCTION_TEST_RETURN(memContextAlloc(size, true));
+    FUNCTION_TEST_RETURN(contextCurrent->arena ? memContextArenaAlloc(size, true) : memContextAlloc(size, true));
 }
 
 /***********************************************************************************************************************************
@@ -400,14 +624,27 @@ memGrowRaw(const void *buffer, size_t size)
 
     ASSERT(buffer != NULL);
 
-    // Find the allocation
-    MemContextAlloc *alloc = &(contextCurrent->allocList[memFind(buffer)]);
+    void *result = NULL;
+
+    // Resize in the arena if this is an arena context
+    if (contextCurrent->arena)
+        result = memContextArenaResize(buffer, size);
+    else
+    {
+        // Find the allocation
+        unsigned int allocIdx = memFind(buffer);
+        MemContextAlloc *header = contextCurrent->allocList[allocIdx];
 
-    // Grow the buffer
-    alloc->buffer = memReAllocInternal(alloc->buffer, alloc->size, size, false);
-    alloc->size = (unsigned int)size;
+        // Grow the allocation, which may move the header
+        header = memReAllocInternal(
+            header, MEM_CONTEXT_ALLOC_HEADER_SIZE + header->size, MEM_CONTEXT_ALLOC_HEADER_SIZE + size, false);
+        header->size = (unsigned int)size;
+        contextCurrent->allocList[allocIdx] = header;
+
+        result = MEM_CONTEXT_ALLOC_BUFFER(header);
+    }
 
-    FUNCTION_TEST_RETURN(alloc->buffer);
+    FUNCTION_TEST_RETURN(result);
 }
 
 /***********************************************************************************************************************************
@@ -420,7 +657,7 @@ memNewRaw(size_t size)
         FUNCTION_TEST_PARAM(SIZE, size);
     FUNCTION_TEST_END();
 
-    FUNCTION_TEST_RETURN(memContextAlloc(size, false));
+    FUNCTION_TEST_RETURN(contextCurrent->arena ? memContextArenaAlloc(size, false) : memContextAlloc(size, false));
 }
 
 /***********************************************************************************************************************************
@@ -435,17 +672,29 @@ memFree(void *buffer)
 
     ASSERT(buffer != NULL);
 
-    // Find the allocation
-    unsigned int allocIdx = memFind(buffer);
-    MemContextAlloc *alloc = &(contextCurrent->allocList[allocIdx]);
+    // Arena memory is released when the context is freed, except for the most recent allocation which can be reclaimed now
+    if (contextCurrent->arena)
+    {
+        if (memContextArenaLast(buffer))
+        {
+            contextCurrent->arenaBlock->used =
+                (size_t)((unsigned char *)buffer - MEM_CONTEXT_ARENA_BLOCK_DATA(contextCurrent->arenaBlock)) -
+                MEM_CONTEXT_ARENA_ALLOC_HEADER_SIZE;
+        }
+    }
+    else
+    {
+        // Find the allocation
+        unsigned int allocIdx = memFind(buffer);
 
-    // Free the buffer
-    memFreeInternal(alloc->buffer);
-    alloc->active = false;
+        // Free the allocation
+        memFreeInternal(contextCurrent->allocList[allocIdx]);
+        contextCurrent->allocList[allocIdx] = NULL;
 
-    // If this allocation is before the current free allocation then make it the current free allocation
-    if (allocIdx < contextCurrent->allocFreeIdx)
-        contextCurrent->allocFreeIdx = allocIdx;
+        // If this allocation is before the current free allocation then make it the current free allocation
+        if (allocIdx < contextCurrent->allocFreeIdx)
+            contextCurrent->allocFreeIdx = allocIdx;
+    }
 
     FUNCTION_TEST_RETURN_VOID();
 }
@@ -559,6 +808,68 @@ memContextName(MemContext *this)
     FUNCTION_TEST_RETURN(this->name);
 }
 
+/***********************************************************************************************************************************
+Free all child contexts and allocations but keep the context so it can be reused
+
+The child and alloc lists are kept so they do not need to be grown again, and freed child contexts are reused by memContextNew().
+For an arena context the current block is kept (unless it was created for a large allocation) and the rest are freed.  The callback
+is not run so a context that has one should not be reset.
+***********************************************************************************************************************************/
+void
+memContextReset(MemContext *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MEM_CONTEXT, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->callbackFunction == NULL);
+
+    // Error if context is not active
+    if (this->state != memContextStateActive)
+        THROW(AssertError, "cannot reset inactive context");
+
+    // Free child contexts
+    for (unsigned int contextIdx = 0; contextIdx < this->contextChildListSize; contextIdx++)
+        if (this->contextChildList[contextIdx] && this->contextChildList[contextIdx]->state == memContextStateActive)
+            memContextFree(this->contextChildList[contextIdx]);
+
+    // Free memory allocations
+    for (unsigned int allocIdx = 0; allocIdx < this->allocListSize; allocIdx++)
+    {
+        if (this->allocList[allocIdx] != NULL)
+        {
+            memFreeInternal(this->allocList[allocIdx]);
+            this->allocList[allocIdx] = NULL;
+        }
+    }
+
+    this->allocFreeIdx = 0;
+
+    // Free arena blocks except the current block
+    MemContextArenaBlock *blockKeep = NULL;
+
+    while (this->arenaBlock != NULL)
+    {
+        MemContextArenaBlock *block = this->arenaBlock;
+        this->arenaBlock = block->next;
+
+        if (blockKeep == NULL && block->size == MEM_CONTEXT_ARENA_BLOCK_SIZE)
+            blockKeep = block;
+        else
+            memFreeInternal(block);
+    }
+
+    if (blockKeep != NULL)
+    {
+        blockKeep->next = NULL;
+        blockKeep->used = 0;
+        this->arenaBlock = blockKeep;
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 memContextFree - free all memory used by the context and all child contexts
 ***********************************************************************************************************************************/
@@ -612,16 +923,23 @@ memContextFree(MemContext *this)
         {
             for (unsigned int allocIdx = 0; allocIdx < this->allocListSize; allocIdx++)
             {
-                MemContextAlloc *alloc = &(this->allocList[allocIdx]);
-
-                if (alloc->active)
-                    memFreeInternal(alloc->buffer);
+                if (this->allocList[allocIdx] != NULL)
+                    memFreeInternal(this->allocList[allocIdx]);
             }
 
             memFreeInternal(this->allocList);
             this->allocListSize = 0;
         }
 
+        // Free arena blocks
+        while (this->arenaBlock != NULL)
+        {
+            MemContextArenaBlock *block = this->arenaBlock;
+
+            this->arenaBlock = block->next;
+            memFreeInternal(block);
+        }
+
         // If the context index is lower than the current free index in the parent then replace it
         if (this->contextParent != NULL && this->contextParentIdx < this->contextParent->contextChildFreeIdx)
             this->contextParent->contextChildFreeIdx = this->contextParentIdx;
@@ -28,6 +28,14 @@ Space is reserved for this many allocations when a context is created.  When mor
 ***********************************************************************************************************************************/
 #define MEM_CONTEXT_ALLOC_INITIAL_SIZE                              4
 
+/***********************************************************************************************************************************
+Define arena block size
+
+Arena contexts allocate memory from blocks of this size rather than calling malloc() for each allocation.  Allocations larger than a
+quarter of the block size get a block of their own so the space left in the current block is not wasted.
+***********************************************************************************************************************************/
+#define MEM_CONTEXT_ARENA_BLOCK_SIZE                                16384
+
 /***********************************************************************************************************************************
 Memory context callback function type, useful for casts in memContextCallback()
 ***********************************************************************************************************************************/
@@ -57,12 +65,21 @@ FINALLY
 TRY_END();
 
 Use the MEM_CONTEXT*() macros when possible rather than implement error-handling for every memory context block.
+
+A context created with memContextNewArena() allocates memory by bumping a pointer through large blocks rather than calling malloc()
+for each allocation.  memFree() only reclaims the most recent allocation and all other memory is released when the context is freed,
+so arena contexts are best for short-lived contexts that make many small allocations, e.g. temp contexts in loops and parsers.
+
+memContextReset() frees all child contexts and allocations but keeps the context and the lists used to track them so the context can
+be reused without the cost of creating it again.
 ***********************************************************************************************************************************/
 MemContext *memContextNew(const char *name);
+MemContext *memContextNewArena(const char *name);
 void memContextMove(MemContext *this, MemContext *parentNew);
 void memContextCallback(MemContext *this, void (*callbackFunction)(void *), void *callbackArgument);
 void memContextCallbackClear(MemContext *this);
 MemContext *memContextSwitch(MemContext *this);
+void memContextReset(MemContext *this);
 void memContextFree(MemContext *this);
 
 /***********************************************************************************************************************************
@@ -186,6 +203,68 @@ MEM_CONTEXT_TEMP_END();
     }                                                                                                                              \
 }
 
+/***********************************************************************************************************************************
+Create a temporary memory context that is reset in a loop rather than being created and freed for each iteration
+
+MEM_CONTEXT_TEMP_RESET_BEGIN()
+{
+    <A temp memory context is now the current context>
+
+    do
+    {
+        MEM_CONTEXT_TEMP_RESET(<iterations>);
+
+        <Do something in the temp context>
+    }
+    while (<condition>);
+}
+MEM_CONTEXT_TEMP_END();
+
+<Old memory context is restored>
+<Temp memory context is freed>
+
+MEM_CONTEXT_TEMP_RESET() must be the first statement of the loop body.  It counts the iterations and resets the temp context (see
+memContextReset()) before an iteration begins once the specified number of iterations have run since the last reset.  Since it runs
+before the body, a continue cannot skip it.  Anything that must survive the reset, including anything the loop condition or the next
+iteration uses, should be allocated in the old context.
+***********************************************************************************************************************************/
+#define MEM_CONTEXT_TEMP_RESET_BEGIN()                                                                                             \
+{                                                                                                                                  \
+    MemContext *MEM_CONTEXT_TEMP() = memContextNew("temporary");                                                                   \
+    unsigned int MEM_CONTEXT_TEMP_loopTotal = 0;                                                                                   \
+                                                                                                                                   \
+    MEM_CONTEXT_BEGIN(MEM_CONTEXT_TEMP())
+
+#define MEM_CONTEXT_TEMP_RESET(resetTotal)                                                                                         \
+    do                                                                                                                             \
+    {                                                                                                                              \
+        if (MEM_CONTEXT_TEMP_loopTotal >= resetTotal)                                                                              \
+        {                                                                                                                          \
+            memContextReset(MEM_CONTEXT_TEMP());                                                                                   \
+            MEM_CONTEXT_TEMP_loopTotal = 0;                                                                                        \
+        }                                                                                                                          \
+                                                                                                                                   \
+        MEM_CONTEXT_TEMP_loopTotal++;                                                                                              \
+    }                                                                                                                              \
+    while (0)
+
+/***********************************************************************************************************************************
+Create a temporary arena memory context and make sure it is freed when done (even on error)
+
+MEM_CONTEXT_TEMP_ARENA_BEGIN()
+{
+    <An arena temp memory context is now the current context>
+}
+MEM_CONTEXT_TEMP_END();
+
+This works the same as MEM_CONTEXT_TEMP_BEGIN() except that the temp context is an arena (see memContextNewArena()).
+***********************************************************************************************************************************/
+#define MEM_CONTEXT_TEMP_ARENA_BEGIN()                                                                                             \
+{                                                                                                                                  \
+    MemContext *MEM_CONTEXT_TEMP() = memContextNewArena("temporary");                                                              \
+                                                                                                                                   \
+    MEM_CONTEXT_BEGIN(MEM_CONTEXT_TEMP())
+
 /***********************************************************************************************************************************
 Macros for function logging
 ***********************************************************************************************************************************/
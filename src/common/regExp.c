@@ -84,8 +84,25 @@ regExpMatch(RegExp *this, const String *string)
     ASSERT(this != NULL);
     ASSERT(string != NULL);
 
+    FUNCTION_TEST_RETURN(regExpMatchZ(this, strPtr(string)));
+}
+
+/***********************************************************************************************************************************
+Match a zero-terminated string on a regular expression so callers that already have a char * do not need to create a String
+***********************************************************************************************************************************/
+bool
+regExpMatchZ(RegExp *this, const char *string)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(REGEXP, this);
+        FUNCTION_TEST_PARAM(STRINGZ, string);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(string != NULL);
+
     // Test for a match
-    int result = regexec(&this->regExp, strPtr(string), 0, NULL, 0);
+    int result = regexec(&this->regExp, string, 0, NULL, 0);
 
     // Check for an error
     if (result != 0 && result != REG_NOMATCH)                                   // {uncoverable - no error condition known}
@@ -16,6 +16,7 @@ Functions
 ***********************************************************************************************************************************/
 RegExp *regExpNew(const String *expression);
 bool regExpMatch(RegExp *this, const String *string);
+bool regExpMatchZ(RegExp *this, const char *string);
 void regExpFree(RegExp *this);
 
 bool regExpMatchOne(const String *expression, const String *string);
@@ -17,6 +17,7 @@ struct Buffer
     bool limitSet;                                                  // Has a limit been set?
     size_t limit;                                                   // Limited reported size of the buffer to make it appear smaller
     size_t used;                                                    // Amount of buffer used
+    bool view;                                                      // Does the buffer point to memory owned by someone else?
     unsigned char *buffer;                                          // Buffer allocation
 };
 
@@ -110,6 +111,28 @@ bufNewZ(const char *string)
     FUNCTION_TEST_RETURN(this);
 }
 
+/***********************************************************************************************************************************
+Create a new buffer that is a view of memory owned by the caller
+
+The memory is not copied so it must remain valid for as long as the buffer is used.  The buffer is considered full and cannot be
+resized.  The memory is not freed with the buffer.  This allows data that is already in memory (e.g. a mapped file) to be passed to
+functions that accept a buffer without copying it first.
+***********************************************************************************************************************************/
+Buffer *
+bufNewView(const void *buffer, size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, buffer);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    Buffer *this = bufNew(0);
+    this->view = true;
+    bufViewSet(this, buffer, size);
+
+    FUNCTION_TEST_RETURN(this);
+}
+
 /***********************************************************************************************************************************
 Append the contents of another buffer
 ***********************************************************************************************************************************/
@@ -259,6 +282,7 @@ bufResize(Buffer *this, size_t size)
     FUNCTION_TEST_END();
 
     ASSERT(this != NULL);
+    ASSERT(!this->view);
 
     // Only resize if it the new size is different
     if (this->size != size)
@@ -476,6 +500,32 @@ bufUsedZero(Buffer *this)
     FUNCTION_TEST_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Point a view at different memory
+
+The buffer must have been created with bufNewView().  Reusing the buffer avoids creating a new buffer for each view.
+***********************************************************************************************************************************/
+void
+bufViewSet(Buffer *this, const void *buffer, size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, this);
+        FUNCTION_TEST_PARAM_P(VOID, buffer);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->view);
+    ASSERT(buffer != NULL || size == 0);
+
+    this->buffer = (unsigned char *)buffer;
+    this->size = size;
+    this->used = size;
+    this->limitSet = false;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Render as string for logging
 ***********************************************************************************************************************************/
@@ -19,6 +19,7 @@ Buffer *bufNew(size_t size);
 Buffer *bufNewC(size_t size, const void *buffer);
 Buffer *bufNewStr(const String *string);
 Buffer *bufNewZ(const char *string);
+Buffer *bufNewView(const void *buffer, size_t size);
 
 Buffer *bufCat(Buffer *this, const Buffer *cat);
 Buffer *bufCatC(Buffer *this, const unsigned char *cat, size_t catOffset, size_t catSize);
@@ -39,6 +40,7 @@ size_t bufUsed(const Buffer *this);
 void bufUsedInc(Buffer *this, size_t inc);
 void bufUsedSet(Buffer *this, size_t used);
 void bufUsedZero(Buffer *this);
+void bufViewSet(Buffer *this, const void *buffer, size_t size);
 
 void bufFree(Buffer *this);
 
@@ -6,112 +6,298 @@ Convert JSON to/from KeyValue
 
 #include "common/debug.h"
 #include "common/log.h"
+#include "common/memContext.h"
+#include "common/type/convert.h"
 #include "common/type/json.h"
 
 /***********************************************************************************************************************************
-Given a character array and its size, return a variant from the extracted string
+Position in the JSON being parsed
+
+The JSON does not need to be zero-terminated so it can be parsed directly from a buffer.  Reading past the end returns a zero
+character, which is never valid JSON and so is always reported as an error.
 ***********************************************************************************************************************************/
-static Variant *
-jsonToStr(const char *json, unsigned int *jsonPos)
+typedef struct JsonCursor
+{
+    const char *json;                                               // JSON to parse
+    size_t size;                                                    // Size of the JSON
+    size_t pos;                                                     // Current position
+} JsonCursor;
+
+#define JSON_CHR(cursor)                                                                                                           \
+    ((cursor)->pos < (cursor)->size ? (cursor)->json[(cursor)->pos] : '\0')
+
+// Arguments for a "%.*s" format to output the JSON remaining after the current position in error messages
+#define JSON_REMAINS(cursor)                                                                                                       \
+    (int)((cursor)->size - (cursor)->pos), (cursor)->json + (cursor)->pos
+
+/***********************************************************************************************************************************
+Object types
+***********************************************************************************************************************************/
+struct JsonRead
+{
+    MemContext *memContext;                                         // Mem context
+    const Buffer *json;                                             // JSON to read
+    JsonCursor cursor;                                              // Current position in the JSON
+    bool valueDone;                                                 // Was a value just read (so a comma must come next)?
+};
+
+struct JsonWrite
+{
+    MemContext *memContext;                                         // Mem context
+    Buffer *json;                                                   // JSON output
+    bool valueDone;                                                 // Was a value just written (so a comma must come next)?
+};
+
+/***********************************************************************************************************************************
+Decode the next character of a string, handling escapes
+***********************************************************************************************************************************/
+static char
+jsonStrChr(JsonCursor *cursor)
 {
     FUNCTION_TEST_BEGIN();
-        FUNCTION_TEST_PARAM(STRINGZ, json);
-        FUNCTION_TEST_PARAM_P(UINT, jsonPos);
+        FUNCTION_TEST_PARAM_P(VOID, cursor);
     FUNCTION_TEST_END();
 
-    Variant *result = NULL;
-
-    if (json[*jsonPos] != '"')
-        THROW_FMT(JsonFormatError, "expected '\"' at '%s'", json + *jsonPos);
+    char result = JSON_CHR(cursor);
 
-    MEM_CONTEXT_TEMP_BEGIN()
+    if (result == '\\')
     {
-        *jsonPos = *jsonPos + 1;
+        cursor->pos++;
+
+        switch (JSON_CHR(cursor))
+        {
+            case '"':
+                result = '"';
+                break;
+
+            case '\\':
+                result = '\\';
+                break;
+
+            case '/':
+                result = '/';
+                break;
+
+            case 'n':
+                result = '\n';
+                break;
+
+            case 'r':
+                result = '\r';
+                break;
+
+            case 't':
+                result = '\t';
+                break;
+
+            case 'b':
+                result = '\b';
+                break;
+
+            case 'f':
+                result = '\f';
+                break;
+
+            default:
+                THROW_FMT(JsonFormatError, "invalid escape character '%c'", JSON_CHR(cursor));
+        }
+    }
+    else if (result == '\0')
+        THROW(JsonFormatError, "expected '\"' but found null delimiter");
+
+    cursor->pos++;
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Skip past the opening quote of a string and the characters that follow it up to the first quote or escape. Returns the position
+where the characters began.
+***********************************************************************************************************************************/
+static size_t
+jsonStrRun(JsonCursor *cursor)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, cursor);
+    FUNCTION_TEST_END();
+
+    if (JSON_CHR(cursor) != '"')
+        THROW_FMT(JsonFormatError, "expected '\"' at '%.*s'", JSON_REMAINS(cursor));
+
+    cursor->pos++;
+
+    size_t result = cursor->pos;
+
+    while (cursor->pos < cursor->size && cursor->json[cursor->pos] != '"' && cursor->json[cursor->pos] != '\\')
+        cursor->pos++;
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Extract a string
+***********************************************************************************************************************************/
+static String *
+jsonToStr(JsonCursor *cursor)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, cursor);
+    FUNCTION_TEST_END();
+
+    // Most strings have no escapes so the leading run can be copied directly
+    size_t begin = jsonStrRun(cursor);
+    String *result = strNewN(cursor->json + begin, cursor->pos - begin);
+
+    // Decode the rest of the string
+    while (JSON_CHR(cursor) != '"')
+        strCatChr(result, jsonStrChr(cursor));
+
+    // Advance past the closing quote
+    cursor->pos++;
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Extract an object key
+
+Keys come from a small set of names so they are interned.  Keys without escapes are looked up directly in the JSON without creating
+a string.
+***********************************************************************************************************************************/
+static const String *
+jsonToKey(JsonCursor *cursor)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, cursor);
+    FUNCTION_TEST_END();
 
-        String *resultStr = strNew("");
+    const String *result = NULL;
+    size_t quotePos = cursor->pos;
+    size_t begin = jsonStrRun(cursor);
 
-        while (json[*jsonPos] != '"')
+    if (JSON_CHR(cursor) == '"')
+    {
+        result = strInternN(cursor->json + begin, cursor->pos - begin);
+        cursor->pos++;
+    }
+    else
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
         {
-            if (json[*jsonPos] == '\\')
-            {
-                *jsonPos = *jsonPos + 1;
+            cursor->pos = quotePos;
+            result = strIntern(jsonToStr(cursor));
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
 
-                switch (json[*jsonPos])
-                {
-                    case '"':
-                            strCatChr(resultStr, '"');
-                        break;
+    FUNCTION_TEST_RETURN(result);
+}
 
-                    case '\\':
-                            strCatChr(resultStr, '\\');
-                        break;
+/***********************************************************************************************************************************
+Extract a number into a zero-terminated buffer. Returns true if the number is signed.
+***********************************************************************************************************************************/
+static bool
+jsonToNumber(JsonCursor *cursor, char *buffer, size_t bufferSize)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, cursor);
+        FUNCTION_TEST_PARAM_P(CHARDATA, buffer);
+        FUNCTION_TEST_PARAM(SIZE, bufferSize);
+    FUNCTION_TEST_END();
 
-                    case '/':
-                            strCatChr(resultStr, '/');
-                        break;
+    size_t beginPos = cursor->pos;
+    bool result = false;
 
-                    case 'n':
-                            strCatChr(resultStr, '\n');
-                        break;
+    // Consume the -
+    if (JSON_CHR(cursor) == '-')
+    {
+        cursor->pos++;
+        result = true;
+    }
 
-                    case 'r':
-                            strCatChr(resultStr, '\r');
-                        break;
+    // Consume all digits
+    while (isdigit(JSON_CHR(cursor)))
+        cursor->pos++;
 
-                    case 't':
-                            strCatChr(resultStr, '\t');
-                        break;
+    // Invalid if only a - was found or there was no number at all
+    if (cursor->pos == beginPos + (result ? 1 : 0))
+    {
+        cursor->pos = beginPos;
 
-                    case 'b':
-                            strCatChr(resultStr, '\b');
-                        break;
+        if (result)
+            THROW_FMT(JsonFormatError, "found '-' with no integer at '%.*s'", JSON_REMAINS(cursor));
 
-                    case 'f':
-                            strCatChr(resultStr, '\f');
-                        break;
+        THROW_FMT(JsonFormatError, "expected number at '%.*s'", JSON_REMAINS(cursor));
+    }
 
-                    default:
-                        THROW_FMT(JsonFormatError, "invalid escape character '%c'", json[*jsonPos]);
-                }
-            }
-            else
-            {
-                if (json[*jsonPos] == '\0')
-                    THROW(JsonFormatError, "expected '\"' but found null delimiter");
+    if (cursor->pos - beginPos >= bufferSize)
+    {
+        cursor->pos = beginPos;
+        THROW_FMT(JsonFormatError, "number is too long at '%.*s'", JSON_REMAINS(cursor));
+    }
 
-                    strCatChr(resultStr, json[*jsonPos]);
-            }
+    memcpy(buffer, cursor->json + beginPos, cursor->pos - beginPos);
+    buffer[cursor->pos - beginPos] = '\0';
 
-            *jsonPos = *jsonPos + 1;
-        };
+    FUNCTION_TEST_RETURN(result);
+}
 
-        // Create a variant result for the string
-        memContextSwitch(MEM_CONTEXT_OLD());
-        result = varNewStr(resultStr);
-        memContextSwitch(MEM_CONTEXT_TEMP());
+/***********************************************************************************************************************************
+Extract a boolean
+***********************************************************************************************************************************/
+static bool
+jsonToBool(JsonCursor *cursor)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, cursor);
+    FUNCTION_TEST_END();
+
+    bool result = false;
 
-        // Advance the character array pointer to the next element after the string
-        *jsonPos = *jsonPos + 1;
+    if (cursor->size - cursor->pos >= 4 && strncmp(cursor->json + cursor->pos, "true", 4) == 0)
+    {
+        result = true;
+        cursor->pos += 4;
     }
-    MEM_CONTEXT_TEMP_END();
+    else if (cursor->size - cursor->pos >= 5 && strncmp(cursor->json + cursor->pos, "false", 5) == 0)
+        cursor->pos += 5;
+    else
+        THROW_FMT(JsonFormatError, "expected boolean at '%.*s'", JSON_REMAINS(cursor));
 
     FUNCTION_TEST_RETURN(result);
 }
 
+/***********************************************************************************************************************************
+Consume a null
+***********************************************************************************************************************************/
+static void
+jsonToNull(JsonCursor *cursor)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, cursor);
+    FUNCTION_TEST_END();
+
+    if (cursor->size - cursor->pos >= 4 && strncmp(cursor->json + cursor->pos, "null", 4) == 0)
+        cursor->pos += 4;
+    else
+        THROW_FMT(JsonFormatError, "expected null at '%.*s'", JSON_REMAINS(cursor));
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Consume whitespace
 ***********************************************************************************************************************************/
 static void
-jsonConsumeWhiteSpace(const char *json, unsigned int *jsonPos)
+jsonConsumeWhiteSpace(JsonCursor *cursor)
 {
     FUNCTION_TEST_BEGIN();
-        FUNCTION_TEST_PARAM(STRINGZ, json);
-        FUNCTION_TEST_PARAM_P(UINT, jsonPos);
+        FUNCTION_TEST_PARAM_P(VOID, cursor);
     FUNCTION_TEST_END();
 
     // Consume whitespace
-    while (json[*jsonPos] == ' ' || json[*jsonPos] == '\t' || json[*jsonPos] == '\n'  || json[*jsonPos] == '\r')
-        (*jsonPos)++;
+    while (JSON_CHR(cursor) == ' ' || JSON_CHR(cursor) == '\t' || JSON_CHR(cursor) == '\n'  || JSON_CHR(cursor) == '\r')
+        cursor->pos++;
 
     FUNCTION_TEST_RETURN_VOID();
 }
@@ -120,28 +306,31 @@ jsonConsumeWhiteSpace(const char *json, unsigned int *jsonPos)
 Convert JSON to a variant
 ***********************************************************************************************************************************/
 static Variant *
-jsonToVarInternal(const char *json, unsigned int *jsonPos)
+jsonToVarInternal(JsonCursor *cursor)
 {
     FUNCTION_TEST_BEGIN();
-        FUNCTION_TEST_PARAM(STRINGZ, json);
-        FUNCTION_TEST_PARAM_P(UINT, jsonPos);
+        FUNCTION_TEST_PARAM_P(VOID, cursor);
     FUNCTION_TEST_END();
 
     Variant *result = NULL;
 
-    jsonConsumeWhiteSpace(json, jsonPos);
+    jsonConsumeWhiteSpace(cursor);
 
     // There should be some data
-    if (json[*jsonPos] == '\0')
+    if (JSON_CHR(cursor) == '\0')
         THROW(JsonFormatError, "expected data");
 
     // Determine data type
-    switch (json[*jsonPos])
+    switch (JSON_CHR(cursor))
     {
         // String
         case '"':
         {
-            result = jsonToStr(json, jsonPos);
+            String *resultStr = jsonToStr(cursor);
+
+            result = varNewStr(resultStr);
+            strFree(resultStr);
+
             break;
         }
 
@@ -149,40 +338,13 @@ jsonToVarInternal(const char *json, unsigned int *jsonPos)
         case '-':
         case '0' ... '9':
         {
-            unsigned int beginPos = *jsonPos;
-            bool intSigned = false;
-
-            // Consume the -
-            if (json[*jsonPos] == '-')
-            {
-                (*jsonPos)++;
-                intSigned = true;
-            }
-
-            // Consume all digits
-            while (isdigit(json[*jsonPos]))
-                (*jsonPos)++;
-
-            // Invalid if only a - was found
-            if (json[*jsonPos - 1] == '-')
-                THROW_FMT(JsonFormatError, "found '-' with no integer at '%s'", json + beginPos);
-
-            MEM_CONTEXT_TEMP_BEGIN()
-            {
-                // Extract the numeric as a string
-                String *resultStr = strNewN(json + beginPos, *jsonPos - beginPos);
-
-                // Convert the string to a int64 variant
-                memContextSwitch(MEM_CONTEXT_OLD());
+            char working[64];
 
-                if (intSigned)
-                    result = varNewInt64(cvtZToInt64(strPtr(resultStr)));
-                else
-                    result = varNewUInt64(cvtZToUInt64(strPtr(resultStr)));
-
-                memContextSwitch(MEM_CONTEXT_TEMP());
-            }
-            MEM_CONTEXT_TEMP_END();
+            // Convert the number to a signed or unsigned int64 variant
+            if (jsonToNumber(cursor, working, sizeof(working)))
+                result = varNewInt64(cvtZToInt64(working));
+            else
+                result = varNewUInt64(cvtZToUInt64(working));
 
             break;
         }
@@ -191,65 +353,49 @@ jsonToVarInternal(const char *json, unsigned int *jsonPos)
         case 't':
         case 'f':
         {
-            if (strncmp(json + *jsonPos, "true", 4) == 0)
-            {
-                result = varNewBool(true);
-                *jsonPos += 4;
-            }
-            else if (strncmp(json + *jsonPos, "false", 5) == 0)
-            {
-                result = varNewBool(false);
-                *jsonPos += 5;
-            }
-            else
-                THROW_FMT(JsonFormatError, "expected boolean at '%s'", json + *jsonPos);
-
+            result = varNewBool(jsonToBool(cursor));
             break;
         }
 
         // Null
         case 'n':
         {
-            if (strncmp(json + *jsonPos, "null", 4) == 0)
-                *jsonPos += 4;
-            else
-                THROW_FMT(JsonFormatError, "expected null at '%s'", json + *jsonPos);
-
+            jsonToNull(cursor);
             break;
         }
 
         // Array
         case '[':
         {
-            MEM_CONTEXT_TEMP_BEGIN()
+            MEM_CONTEXT_TEMP_ARENA_BEGIN()
             {
                 VariantList *valueList = varLstNew();
 
                 // Move position to the first element in the array
-                (*jsonPos)++;
-                jsonConsumeWhiteSpace(json, jsonPos);
+                cursor->pos++;
+                jsonConsumeWhiteSpace(cursor);
 
                 // Only proceed if the array is not empty
-                if (json[*jsonPos] != ']')
+                if (JSON_CHR(cursor) != ']')
                 {
                     do
                     {
-                        if (json[*jsonPos] == ',')
+                        if (JSON_CHR(cursor) == ',')
                         {
-                            (*jsonPos)++;
-                            jsonConsumeWhiteSpace(json, jsonPos);
+                            cursor->pos++;
+                            jsonConsumeWhiteSpace(cursor);
                         }
 
-                        varLstAdd(valueList, jsonToVarInternal(json, jsonPos));
+                        varLstAdd(valueList, jsonToVarInternal(cursor));
 
-                        jsonConsumeWhiteSpace(json, jsonPos);
+                        jsonConsumeWhiteSpace(cursor);
                     }
-                    while (json[*jsonPos] == ',');
+                    while (JSON_CHR(cursor) == ',');
                 }
 
-                if (json[*jsonPos] != ']')
-                    THROW_FMT(JsonFormatError, "expected ']' at '%s'", json + *jsonPos);
-                (*jsonPos)++;
+                if (JSON_CHR(cursor) != ']')
+                    THROW_FMT(JsonFormatError, "expected ']' at '%.*s'", JSON_REMAINS(cursor));
+                cursor->pos++;
 
                 memContextSwitch(MEM_CONTEXT_OLD());
                 result = varNewVarLst(varLstMove(valueList, MEM_CONTEXT_OLD()));
@@ -263,45 +409,45 @@ jsonToVarInternal(const char *json, unsigned int *jsonPos)
         // Object
         case '{':
         {
-            MEM_CONTEXT_TEMP_BEGIN()
+            MEM_CONTEXT_TEMP_ARENA_BEGIN()
             {
                 memContextSwitch(MEM_CONTEXT_OLD());
                 result = varNewKv();
                 memContextSwitch(MEM_CONTEXT_TEMP());
 
                 // Move position to the first key/value in the object
-                (*jsonPos)++;
-                jsonConsumeWhiteSpace(json, jsonPos);
+                cursor->pos++;
+                jsonConsumeWhiteSpace(cursor);
 
                 // Only proceed if the array is not empty
-                if (json[*jsonPos] != '}')
+                if (JSON_CHR(cursor) != '}')
                 {
                     do
                     {
-                        if (json[*jsonPos] == ',')
+                        if (JSON_CHR(cursor) == ',')
                         {
-                            (*jsonPos)++;
-                            jsonConsumeWhiteSpace(json, jsonPos);
+                            cursor->pos++;
+                            jsonConsumeWhiteSpace(cursor);
                         }
 
-                        Variant *key = jsonToStr(json, jsonPos);
+                        Variant *key = varNewStr(jsonToKey(cursor));
 
-                        jsonConsumeWhiteSpace(json, jsonPos);
+                        jsonConsumeWhiteSpace(cursor);
 
-                        if (json[*jsonPos] != ':')
-                            THROW_FMT(JsonFormatError, "expected ':' at '%s'", json + *jsonPos);
-                        (*jsonPos)++;
+                        if (JSON_CHR(cursor) != ':')
+                            THROW_FMT(JsonFormatError, "expected ':' at '%.*s'", JSON_REMAINS(cursor));
+                        cursor->pos++;
 
-                        jsonConsumeWhiteSpace(json, jsonPos);
+                        jsonConsumeWhiteSpace(cursor);
 
-                        kvPut(varKv(result), key, jsonToVarInternal(json, jsonPos));
+                        kvPut(varKv(result), key, jsonToVarInternal(cursor));
                     }
-                    while (json[*jsonPos] == ',');
+                    while (JSON_CHR(cursor) == ',');
                 }
 
-                if (json[*jsonPos] != '}')
-                    THROW_FMT(JsonFormatError, "expected '}' at '%s'", json + *jsonPos);
-                (*jsonPos)++;
+                if (JSON_CHR(cursor) != '}')
+                    THROW_FMT(JsonFormatError, "expected '}' at '%.*s'", JSON_REMAINS(cursor));
+                cursor->pos++;
             }
             MEM_CONTEXT_TEMP_END();
 
@@ -311,12 +457,12 @@ jsonToVarInternal(const char *json, unsigned int *jsonPos)
         // Object
         default:
         {
-            THROW_FMT(JsonFormatError, "invalid type at '%s'", json + *jsonPos);
+            THROW_FMT(JsonFormatError, "invalid type at '%.*s'", JSON_REMAINS(cursor));
             break;
         }
     }
 
-    jsonConsumeWhiteSpace(json, jsonPos);
+    jsonConsumeWhiteSpace(cursor);
 
     FUNCTION_TEST_RETURN(result);
 }
@@ -328,183 +474,614 @@ jsonToVar(const String *json)
         FUNCTION_LOG_PARAM(STRING, json);
     FUNCTION_LOG_END();
 
-    const char *jsonPtr = strPtr(json);
-    unsigned int jsonPos = 0;
+    JsonCursor cursor = {.json = strPtr(json), .size = strSize(json)};
 
-    FUNCTION_LOG_RETURN(VARIANT, jsonToVarInternal(jsonPtr, &jsonPos));
+    FUNCTION_LOG_RETURN(VARIANT, jsonToVarInternal(&cursor));
 }
 
 /***********************************************************************************************************************************
-Output and escape a string
+Create a pull reader for JSON in a buffer
+
+Values are read in order directly from the buffer.  Only the values requested as strings or variants are allocated.
 ***********************************************************************************************************************************/
-static void
-jsonStringRender(String *json, const String *string)
+JsonRead *
+jsonReadNew(const Buffer *json)
 {
     FUNCTION_TEST_BEGIN();
-        FUNCTION_TEST_PARAM(STRING, json);
-        FUNCTION_TEST_PARAM(STRING, string);
+        FUNCTION_TEST_PARAM(BUFFER, json);
     FUNCTION_TEST_END();
 
     ASSERT(json != NULL);
 
-    // If string is null
-    if (string == NULL)
+    JsonRead *this = NULL;
+
+    MEM_CONTEXT_NEW_BEGIN("JsonRead")
     {
-        strCat(json, "null");
+        this = memNew(sizeof(JsonRead));
+        this->memContext = MEM_CONTEXT_NEW();
+        this->json = json;
+
+        jsonReadReset(this);
     }
-    // Else escape and output string
-    else
+    MEM_CONTEXT_NEW_END();
+
+    FUNCTION_TEST_RETURN(this);
+}
+
+/***********************************************************************************************************************************
+Start reading from the beginning of the buffer again, e.g. after new JSON has been loaded into it
+***********************************************************************************************************************************/
+void
+jsonReadReset(JsonRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_READ, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    this->cursor = (JsonCursor){.json = (const char *)bufPtr(this->json), .size = bufUsed(this->json)};
+    this->valueDone = false;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Consume whitespace and the comma that separates the next value from the prior value
+***********************************************************************************************************************************/
+static void
+jsonReadValueBegin(JsonRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_READ, this);
+    FUNCTION_TEST_END();
+
+    jsonConsumeWhiteSpace(&this->cursor);
+
+    if (this->valueDone)
     {
-        strCatChr(json, '"');
+        if (JSON_CHR(&this->cursor) != ',')
+            THROW_FMT(JsonFormatError, "expected ',' at '%.*s'", JSON_REMAINS(&this->cursor));
 
-        for (unsigned int stringIdx = 0; stringIdx < strSize(string); stringIdx++)
+        this->cursor.pos++;
+        this->valueDone = false;
+
+        jsonConsumeWhiteSpace(&this->cursor);
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Get the type of the next value, or whether the current array or object has ended
+***********************************************************************************************************************************/
+JsonType
+jsonReadTypeNext(JsonRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_READ, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    JsonType result;
+
+    jsonConsumeWhiteSpace(&this->cursor);
+
+    switch (JSON_CHR(&this->cursor))
+    {
+        case ']':
+            result = jsonTypeArrayEnd;
+            break;
+
+        case '}':
+            result = jsonTypeObjectEnd;
+            break;
+
+        default:
         {
-            char stringChr = strPtr(string)[stringIdx];
+            jsonReadValueBegin(this);
 
-            switch (stringChr)
+            switch (JSON_CHR(&this->cursor))
             {
                 case '"':
-                    strCat(json, "\\\"");
-                    break;
-
-                case '\\':
-                    strCat(json, "\\\\");
+                    result = jsonTypeString;
                     break;
 
-                case '/':
-                    strCat(json, "\\/");
+                case '-':
+                case '0' ... '9':
+                    result = jsonTypeNumber;
                     break;
 
-                case '\n':
-                    strCat(json, "\\n");
+                case 't':
+                case 'f':
+                    result = jsonTypeBool;
                     break;
 
-                case '\r':
-                    strCat(json, "\\r");
+                case 'n':
+                    result = jsonTypeNull;
                     break;
 
-                case '\t':
-                    strCat(json, "\\t");
+                case '[':
+                    result = jsonTypeArrayBegin;
                     break;
 
-                case '\b':
-                    strCat(json, "\\b");
+                case '{':
+                    result = jsonTypeObjectBegin;
                     break;
 
-                case '\f':
-                    strCat(json, "\\f");
-                    break;
+                case '\0':
+                    THROW(JsonFormatError, "expected data");
 
                 default:
-                    strCatChr(json, stringChr);
-                    break;
+                    THROW_FMT(JsonFormatError, "invalid type at '%.*s'", JSON_REMAINS(&this->cursor));
             }
-        }
 
-        strCatChr(json, '"');
+            break;
+        }
     }
 
-    FUNCTION_TEST_RETURN_VOID();
+    FUNCTION_TEST_RETURN(result);
 }
 
 /***********************************************************************************************************************************
-Internal recursive function to walk a KeyValue and return a json string
+Begin/end arrays and objects
 ***********************************************************************************************************************************/
-static String *
-kvToJsonInternal(const KeyValue *kv, String *indentSpace, String *indentDepth)
+static void
+jsonReadContainerBegin(JsonRead *this, char begin)
 {
     FUNCTION_TEST_BEGIN();
-        FUNCTION_TEST_PARAM(KEY_VALUE, kv);
-        FUNCTION_TEST_PARAM(STRING, indentSpace);
-        FUNCTION_TEST_PARAM(STRING, indentDepth);
+        FUNCTION_TEST_PARAM(JSON_READ, this);
+        FUNCTION_TEST_PARAM(CHAR, begin);
     FUNCTION_TEST_END();
 
-    ASSERT(kv != NULL);
-    ASSERT(indentSpace != NULL);
-    ASSERT(indentDepth != NULL);
-
-    String *result = strNew("{");
+    ASSERT(this != NULL);
 
-    MEM_CONTEXT_TEMP_BEGIN()
-    {
-        const StringList *keyList = strLstSort(strLstNewVarLst(kvKeyList(kv)), sortOrderAsc);
+    jsonReadValueBegin(this);
 
-        // If not an empty list, then add indent formatting
-        if (strLstSize(keyList) > 0)
-            strCatFmt(result, "%s", strPtr(indentDepth));
+    if (JSON_CHR(&this->cursor) != begin)
+        THROW_FMT(JsonFormatError, "expected '%c' at '%.*s'", begin, JSON_REMAINS(&this->cursor));
 
-        for (unsigned int keyIdx = 0; keyIdx < strLstSize(keyList); keyIdx++)
-        {
-            String *key = strLstGet(keyList, keyIdx);
-            const Variant *value = kvGet(kv, varNewStr(key));
+    this->cursor.pos++;
 
-            // If going to add another key, prepend a comma
-            if (keyIdx > 0)
-                strCatFmt(result, ",%s", strPtr(indentDepth));
+    FUNCTION_TEST_RETURN_VOID();
+}
 
-            // Keys are always strings in the output, so add starting quote and colon.
-            // Note if indent is 0 then spaces do not surround the colon, else they do.
-            if (strSize(indentSpace) == 0)
-                strCatFmt(result, "\"%s\":", strPtr(key));
-            else
-                strCatFmt(result, "\"%s\" : ", strPtr(key));
+static void
+jsonReadContainerEnd(JsonRead *this, char end)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_READ, this);
+        FUNCTION_TEST_PARAM(CHAR, end);
+    FUNCTION_TEST_END();
 
-            // NULL value
-            if (value == NULL)
+    ASSERT(this != NULL);
+
+    jsonConsumeWhiteSpace(&this->cursor);
+
+    if (JSON_CHR(&this->cursor) != end)
+        THROW_FMT(JsonFormatError, "expected '%c' at '%.*s'", end, JSON_REMAINS(&this->cursor));
+
+    this->cursor.pos++;
+    this->valueDone = true;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+void
+jsonReadArrayBegin(JsonRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_READ, this);
+    FUNCTION_TEST_END();
+
+    jsonReadContainerBegin(this, '[');
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+void
+jsonReadArrayEnd(JsonRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_READ, this);
+    FUNCTION_TEST_END();
+
+    jsonReadContainerEnd(this, ']');
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+void
+jsonReadObjectBegin(JsonRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_READ, this);
+    FUNCTION_TEST_END();
+
+    jsonReadContainerBegin(this, '{');
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+void
+jsonReadObjectEnd(JsonRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_READ, this);
+    FUNCTION_TEST_END();
+
+    jsonReadContainerEnd(this, '}');
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Read an object key. The key is interned so it does not need to be freed and can be compared cheaply.
+***********************************************************************************************************************************/
+const String *
+jsonReadKey(JsonRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_READ, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    jsonReadValueBegin(this);
+
+    const String *result = jsonToKey(&this->cursor);
+
+    jsonConsumeWhiteSpace(&this->cursor);
+
+    if (JSON_CHR(&this->cursor) != ':')
+        THROW_FMT(JsonFormatError, "expected ':' at '%.*s'", JSON_REMAINS(&this->cursor));
+
+    this->cursor.pos++;
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Read values
+***********************************************************************************************************************************/
+bool
+jsonReadBool(JsonRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_READ, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    jsonReadValueBegin(this);
+
+    bool result = jsonToBool(&this->cursor);
+    this->valueDone = true;
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+int
+jsonReadInt(JsonRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_READ, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    char working[64];
+
+    jsonReadValueBegin(this);
+    jsonToNumber(&this->cursor, working, sizeof(working));
+    this->valueDone = true;
+
+    FUNCTION_TEST_RETURN(cvtZToInt(working));
+}
+
+int64_t
+jsonReadInt64(JsonRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_READ, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    char working[64];
+
+    jsonReadValueBegin(this);
+    jsonToNumber(&this->cursor, working, sizeof(working));
+    this->valueDone = true;
+
+    FUNCTION_TEST_RETURN(cvtZToInt64(working));
+}
+
+uint64_t
+jsonReadUInt64(JsonRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_READ, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    char working[64];
+
+    jsonReadValueBegin(this);
+    jsonToNumber(&this->cursor, working, sizeof(working));
+    this->valueDone = true;
+
+    FUNCTION_TEST_RETURN(cvtZToUInt64(working));
+}
+
+void
+jsonReadNull(JsonRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_READ, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    jsonReadValueBegin(this);
+    jsonToNull(&this->cursor);
+    this->valueDone = true;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+String *
+jsonReadStr(JsonRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_READ, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    jsonReadValueBegin(this);
+
+    String *result = jsonToStr(&this->cursor);
+    this->valueDone = true;
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Read a value of any type, including arrays and objects, as a variant.  Null is returned as NULL.
+***********************************************************************************************************************************/
+Variant *
+jsonReadVar(JsonRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_READ, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    jsonReadValueBegin(this);
+
+    Variant *result = jsonToVarInternal(&this->cursor);
+    this->valueDone = true;
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Free the reader
+***********************************************************************************************************************************/
+void
+jsonReadFree(JsonRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_READ, this);
+    FUNCTION_TEST_END();
+
+    if (this != NULL)
+        memContextFree(this->memContext);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Output and escape a string
+***********************************************************************************************************************************/
+static void
+jsonStringRender(String *json, const String *string)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, json);
+        FUNCTION_TEST_PARAM(STRING, string);
+    FUNCTION_TEST_END();
+
+    ASSERT(json != NULL);
+
+    // If string is null
+    if (string == NULL)
+    {
+        strCat(json, "null");
+    }
+    // Else escape and output string
+    else
+    {
+        strCatChr(json, '"');
+
+        for (unsigned int stringIdx = 0; stringIdx < strSize(string); stringIdx++)
+        {
+            char stringChr = strPtr(string)[stringIdx];
+
+            switch (stringChr)
+            {
+                case '"':
+                    strCat(json, "\\\"");
+                    break;
+
+                case '\\':
+                    strCat(json, "\\\\");
+                    break;
+
+                case '/':
+                    strCat(json, "\\/");
+                    break;
+
+                case '\n':
+                    strCat(json, "\\n");
+                    break;
+
+                case '\r':
+                    strCat(json, "\\r");
+                    break;
+
+                case '\t':
+                    strCat(json, "\\t");
+                    break;
+
+                case '\b':
+                    strCat(json, "\\b");
+                    break;
+
+                case '\f':
+                    strCat(json, "\\f");
+                    break;
+
+                default:
+                    strCatChr(json, stringChr);
+                    break;
+            }
+        }
+
+        strCatChr(json, '"');
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Internal recursive function to render a VariantList as a json array.  Lists may contain other lists, e.g. protocol parameters.
+***********************************************************************************************************************************/
+static String *kvToJsonInternal(const KeyValue *kv, String *indentSpace, String *indentDepth);
+
+static void
+varLstToJsonInternal(String *result, const VariantList *list, String *indentSpace, String *indentDepth)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, result);
+        FUNCTION_TEST_PARAM(VARIANT_LIST, list);
+        FUNCTION_TEST_PARAM(STRING, indentSpace);
+        FUNCTION_TEST_PARAM(STRING, indentDepth);
+    FUNCTION_TEST_END();
+
+    ASSERT(result != NULL);
+    ASSERT(indentSpace != NULL);
+    ASSERT(indentDepth != NULL);
+
+    // If the array is empty, then do not add formatting, else process the array.
+    if (list == NULL)
+        strCat(result, "null");
+    else if (varLstSize(list) == 0)
+        strCat(result, "[]");
+    else
+    {
+        strCat(indentDepth, strPtr(indentSpace));
+        strCatFmt(result, "[%s", strPtr(indentDepth));
+
+        for (unsigned int arrayIdx = 0; arrayIdx < varLstSize(list); arrayIdx++)
+        {
+            Variant *arrayValue = varLstGet(list, arrayIdx);
+
+            // If going to add another element, add a comma
+            if (arrayIdx > 0)
+                strCatFmt(result, ",%s", strPtr(indentDepth));
+
+            // If array value is null
+            if (arrayValue == NULL)
+            {
                 strCat(result, "null");
-            // KeyValue
-            else if (varType(value) == varTypeKeyValue)
+            }
+            // If the type is a string, add leading and trailing double quotes
+            else if (varType(arrayValue) == varTypeString)
+            {
+                jsonStringRender(result, varStr(arrayValue));
+            }
+            else if (varType(arrayValue) == varTypeKeyValue)
             {
                 strCat(indentDepth, strPtr(indentSpace));
-                strCat(result, strPtr(kvToJsonInternal(kvDup(varKv(value)), indentSpace, indentDepth)));
+                strCat(result, strPtr(kvToJsonInternal(kvDup(varKv(arrayValue)), indentSpace, indentDepth)));
             }
-            // VariantList
-            else if (varType(value) == varTypeVariantList)
+            else if (varType(arrayValue) == varTypeVariantList)
             {
-                // If the array is empty, then do not add formatting, else process the array.
-                if (varVarLst(value) == NULL)
-                    strCat(result, "null");
-                else if (varLstSize(varVarLst(value)) == 0)
-                    strCat(result, "[]");
-                else
-                {
-                    strCat(indentDepth, strPtr(indentSpace));
-                    strCatFmt(result, "[%s", strPtr(indentDepth));
+                varLstToJsonInternal(result, varVarLst(arrayValue), indentSpace, indentDepth);
+            }
+            // Numeric, Boolean or other type
+            else
+                strCat(result, strPtr(varStrForce(arrayValue)));
+        }
 
-                    for (unsigned int arrayIdx = 0; arrayIdx < varLstSize(varVarLst(value)); arrayIdx++)
-                    {
-                        Variant *arrayValue = varLstGet(varVarLst(value), arrayIdx);
+        if (strSize(indentDepth) > strSize(indentSpace))
+            strTrunc(indentDepth, (int)(strSize(indentDepth) - strSize(indentSpace)));
 
-                        // If going to add another element, add a comma
-                        if (arrayIdx > 0)
-                            strCatFmt(result, ",%s", strPtr(indentDepth));
+        strCatFmt(result, "%s]", strPtr(indentDepth));
+    }
 
-                        // If array value is null
-                        if (arrayValue == NULL)
-                        {
-                            strCat(result, "null");
-                        }
-                        // If the type is a string, add leading and trailing double quotes
-                        else if (varType(arrayValue) == varTypeString)
-                        {
-                            jsonStringRender(result, varStr(arrayValue));
-                        }
-                        else if (varType(arrayValue) == varTypeKeyValue)
-                        {
-                            strCat(indentDepth, strPtr(indentSpace));
-                            strCat(result, strPtr(kvToJsonInternal(kvDup(varKv(arrayValue)), indentSpace, indentDepth)));
-                        }
-                        // Numeric, Boolean or other type
-                        else
-                            strCat(result, strPtr(varStrForce(arrayValue)));
-                    }
+    FUNCTION_TEST_RETURN_VOID();
+}
 
-                    if (strSize(indentDepth) > strSize(indentSpace))
-                        strTrunc(indentDepth, (int)(strSize(indentDepth) - strSize(indentSpace)));
+/***********************************************************************************************************************************
+Internal recursive function to walk a KeyValue and return a json string
+***********************************************************************************************************************************/
+static String *
+kvToJsonInternal(const KeyValue *kv, String *indentSpace, String *indentDepth)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(KEY_VALUE, kv);
+        FUNCTION_TEST_PARAM(STRING, indentSpace);
+        FUNCTION_TEST_PARAM(STRING, indentDepth);
+    FUNCTION_TEST_END();
+
+    ASSERT(kv != NULL);
+    ASSERT(indentSpace != NULL);
+    ASSERT(indentDepth != NULL);
+
+    String *result = strNew("{");
+
+    MEM_CONTEXT_TEMP_ARENA_BEGIN()
+    {
+        const StringList *keyList = strLstSort(strLstNewVarLst(kvKeyList(kv)), sortOrderAsc);
+
+        // If not an empty list, then add indent formatting
+        if (strLstSize(keyList) > 0)
+            strCatFmt(result, "%s", strPtr(indentDepth));
+
+        for (unsigned int keyIdx = 0; keyIdx < strLstSize(keyList); keyIdx++)
+        {
+            String *key = strLstGet(keyList, keyIdx);
+            const Variant *value = kvGetStr(kv, key);
+
+            // If going to add another key, prepend a comma
+            if (keyIdx > 0)
+                strCatFmt(result, ",%s", strPtr(indentDepth));
+
+            // Keys are always strings in the output, so add starting quote and colon.
+            // Note if indent is 0 then spaces do not surround the colon, else they do.
+            if (strSize(indentSpace) == 0)
+                strCatFmt(result, "\"%s\":", strPtr(key));
+            else
+                strCatFmt(result, "\"%s\" : ", strPtr(key));
 
-                    strCatFmt(result, "%s]", strPtr(indentDepth));
-                }
+            // NULL value
+            if (value == NULL)
+                strCat(result, "null");
+            // KeyValue
+            else if (varType(value) == varTypeKeyValue)
+            {
+                strCat(indentDepth, strPtr(indentSpace));
+                strCat(result, strPtr(kvToJsonInternal(kvDup(varKv(value)), indentSpace, indentDepth)));
             }
+            // VariantList
+            else if (varType(value) == varTypeVariantList)
+                varLstToJsonInternal(result, varVarLst(value), indentSpace, indentDepth);
             // String
             else if (varType(value) == varTypeString)
             {
@@ -667,3 +1244,467 @@ varToJson(const Variant *var, unsigned int indent)
 
     FUNCTION_LOG_RETURN(STRING, result);
 }
+
+/***********************************************************************************************************************************
+Create a writer that appends JSON to a buffer
+
+The buffer is grown as needed and can be reused for the next document after jsonWriteReset() so steady-state writes do not allocate.
+Output is not formatted.
+***********************************************************************************************************************************/
+JsonWrite *
+jsonWriteNew(Buffer *json)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, json);
+    FUNCTION_TEST_END();
+
+    ASSERT(json != NULL);
+
+    JsonWrite *this = NULL;
+
+    MEM_CONTEXT_NEW_BEGIN("JsonWrite")
+    {
+        this = memNew(sizeof(JsonWrite));
+        this->memContext = MEM_CONTEXT_NEW();
+        this->json = json;
+    }
+    MEM_CONTEXT_NEW_END();
+
+    FUNCTION_TEST_RETURN(this);
+}
+
+/***********************************************************************************************************************************
+Clear the buffer to start writing a new document
+***********************************************************************************************************************************/
+void
+jsonWriteReset(JsonWrite *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    bufUsedZero(this->json);
+    this->valueDone = false;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Append to the buffer, doubling its size when it is full so appends do not resize on every call
+***********************************************************************************************************************************/
+static void
+jsonWriteBuf(JsonWrite *this, const char *data, size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, this);
+        FUNCTION_TEST_PARAM_P(CHARDATA, data);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    if (bufRemains(this->json) < size)
+        bufResize(this->json, (bufUsed(this->json) + size) * 2);
+
+    memcpy(bufRemainsPtr(this->json), data, size);
+    bufUsedInc(this->json, size);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Write the comma that separates the next value from the prior value
+***********************************************************************************************************************************/
+static void
+jsonWriteValueBegin(JsonWrite *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, this);
+    FUNCTION_TEST_END();
+
+    if (this->valueDone)
+    {
+        jsonWriteBuf(this, ",", 1);
+        this->valueDone = false;
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Write an escaped string. Runs of characters that do not need to be escaped are copied together.
+***********************************************************************************************************************************/
+static void
+jsonWriteStrInternal(JsonWrite *this, const String *string)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, this);
+        FUNCTION_TEST_PARAM(STRING, string);
+    FUNCTION_TEST_END();
+
+    const char *stringPtr = strPtr(string);
+    size_t runBegin = 0;
+
+    jsonWriteBuf(this, "\"", 1);
+
+    for (size_t stringIdx = 0; stringIdx < strSize(string); stringIdx++)
+    {
+        const char *escape = NULL;
+
+        switch (stringPtr[stringIdx])
+        {
+            case '"':
+                escape = "\\\"";
+                break;
+
+            case '\\':
+                escape = "\\\\";
+                break;
+
+            case '/':
+                escape = "\\/";
+                break;
+
+            case '\n':
+                escape = "\\n";
+                break;
+
+            case '\r':
+                escape = "\\r";
+                break;
+
+            case '\t':
+                escape = "\\t";
+                break;
+
+            case '\b':
+                escape = "\\b";
+                break;
+
+            case '\f':
+                escape = "\\f";
+                break;
+        }
+
+        if (escape != NULL)
+        {
+            jsonWriteBuf(this, stringPtr + runBegin, stringIdx - runBegin);
+            jsonWriteBuf(this, escape, 2);
+            runBegin = stringIdx + 1;
+        }
+    }
+
+    jsonWriteBuf(this, stringPtr + runBegin, strSize(string) - runBegin);
+    jsonWriteBuf(this, "\"", 1);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Write a value that has already been rendered
+***********************************************************************************************************************************/
+static JsonWrite *
+jsonWriteValueZ(JsonWrite *this, const char *value, size_t valueSize)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, this);
+        FUNCTION_TEST_PARAM(STRINGZ, value);
+        FUNCTION_TEST_PARAM(SIZE, valueSize);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    jsonWriteValueBegin(this);
+    jsonWriteBuf(this, value, valueSize);
+    this->valueDone = true;
+
+    FUNCTION_TEST_RETURN(this);
+}
+
+/***********************************************************************************************************************************
+Begin/end arrays and objects
+***********************************************************************************************************************************/
+JsonWrite *
+jsonWriteArrayBegin(JsonWrite *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, this);
+    FUNCTION_TEST_END();
+
+    jsonWriteValueZ(this, "[", 1);
+    this->valueDone = false;
+
+    FUNCTION_TEST_RETURN(this);
+}
+
+JsonWrite *
+jsonWriteArrayEnd(JsonWrite *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    jsonWriteBuf(this, "]", 1);
+    this->valueDone = true;
+
+    FUNCTION_TEST_RETURN(this);
+}
+
+JsonWrite *
+jsonWriteObjectBegin(JsonWrite *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, this);
+    FUNCTION_TEST_END();
+
+    jsonWriteValueZ(this, "{", 1);
+    this->valueDone = false;
+
+    FUNCTION_TEST_RETURN(this);
+}
+
+JsonWrite *
+jsonWriteObjectEnd(JsonWrite *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    jsonWriteBuf(this, "}", 1);
+    this->valueDone = true;
+
+    FUNCTION_TEST_RETURN(this);
+}
+
+/***********************************************************************************************************************************
+Write an object key
+***********************************************************************************************************************************/
+JsonWrite *
+jsonWriteKey(JsonWrite *this, const String *key)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, this);
+        FUNCTION_TEST_PARAM(STRING, key);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(key != NULL);
+
+    jsonWriteValueBegin(this);
+    jsonWriteStrInternal(this, key);
+    jsonWriteBuf(this, ":", 1);
+
+    FUNCTION_TEST_RETURN(this);
+}
+
+/***********************************************************************************************************************************
+Write values
+***********************************************************************************************************************************/
+JsonWrite *
+jsonWriteBool(JsonWrite *this, bool value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, this);
+        FUNCTION_TEST_PARAM(BOOL, value);
+    FUNCTION_TEST_END();
+
+    const char *valueZ = cvtBoolToConstZ(value);
+
+    FUNCTION_TEST_RETURN(jsonWriteValueZ(this, valueZ, strlen(valueZ)));
+}
+
+JsonWrite *
+jsonWriteInt(JsonWrite *this, int value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, this);
+        FUNCTION_TEST_PARAM(INT, value);
+    FUNCTION_TEST_END();
+
+    char working[64];
+
+    FUNCTION_TEST_RETURN(jsonWriteValueZ(this, working, cvtIntToZ(value, working, sizeof(working))));
+}
+
+JsonWrite *
+jsonWriteInt64(JsonWrite *this, int64_t value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, this);
+        FUNCTION_TEST_PARAM(INT64, value);
+    FUNCTION_TEST_END();
+
+    char working[64];
+
+    FUNCTION_TEST_RETURN(jsonWriteValueZ(this, working, cvtInt64ToZ(value, working, sizeof(working))));
+}
+
+JsonWrite *
+jsonWriteUInt64(JsonWrite *this, uint64_t value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, this);
+        FUNCTION_TEST_PARAM(UINT64, value);
+    FUNCTION_TEST_END();
+
+    char working[64];
+
+    FUNCTION_TEST_RETURN(jsonWriteValueZ(this, working, cvtUInt64ToZ(value, working, sizeof(working))));
+}
+
+JsonWrite *
+jsonWriteNull(JsonWrite *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, this);
+    FUNCTION_TEST_END();
+
+    FUNCTION_TEST_RETURN(jsonWriteValueZ(this, "null", 4));
+}
+
+JsonWrite *
+jsonWriteStr(JsonWrite *this, const String *value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, this);
+        FUNCTION_TEST_PARAM(STRING, value);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    if (value == NULL)
+        jsonWriteNull(this);
+    else
+    {
+        jsonWriteValueBegin(this);
+        jsonWriteStrInternal(this, value);
+        this->valueDone = true;
+    }
+
+    FUNCTION_TEST_RETURN(this);
+}
+
+/***********************************************************************************************************************************
+Write a variant of any type.  KeyValue keys are written in sorted order to match kvToJson().
+***********************************************************************************************************************************/
+JsonWrite *
+jsonWriteVar(JsonWrite *this, const Variant *value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, this);
+        FUNCTION_TEST_PARAM(VARIANT, value);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    if (value == NULL)
+        jsonWriteNull(this);
+    else
+    {
+        switch (varType(value))
+        {
+            case varTypeBool:
+            {
+                jsonWriteBool(this, varBool(value));
+                break;
+            }
+
+            case varTypeDouble:
+            {
+                char working[64];
+
+                jsonWriteValueZ(this, working, cvtDoubleToZ(varDbl(value), working, sizeof(working)));
+                break;
+            }
+
+            case varTypeInt:
+            {
+                jsonWriteInt(this, varInt(value));
+                break;
+            }
+
+            case varTypeInt64:
+            {
+                jsonWriteInt64(this, varInt64(value));
+                break;
+            }
+
+            case varTypeKeyValue:
+            {
+                const KeyValue *kv = varKv(value);
+
+                jsonWriteObjectBegin(this);
+
+                MEM_CONTEXT_TEMP_BEGIN()
+                {
+                    const StringList *keyList = strLstSort(strLstNewVarLst(kvKeyList(kv)), sortOrderAsc);
+
+                    for (unsigned int keyIdx = 0; keyIdx < strLstSize(keyList); keyIdx++)
+                    {
+                        const String *key = strLstGet(keyList, keyIdx);
+
+                        jsonWriteKey(this, key);
+                        jsonWriteVar(this, kvGetStr(kv, key));
+                    }
+                }
+                MEM_CONTEXT_TEMP_END();
+
+                jsonWriteObjectEnd(this);
+                break;
+            }
+
+            case varTypeString:
+            {
+                jsonWriteStr(this, varStr(value));
+                break;
+            }
+
+            case varTypeUInt64:
+            {
+                jsonWriteUInt64(this, varUInt64(value));
+                break;
+            }
+
+            case varTypeVariantList:
+            {
+                const VariantList *valueList = varVarLst(value);
+
+                if (valueList == NULL)
+                    jsonWriteNull(this);
+                else
+                {
+                    jsonWriteArrayBegin(this);
+
+                    for (unsigned int valueIdx = 0; valueIdx < varLstSize(valueList); valueIdx++)
+                        jsonWriteVar(this, varLstGet(valueList, valueIdx));
+
+                    jsonWriteArrayEnd(this);
+                }
+
+                break;
+            }
+        }
+    }
+
+    FUNCTION_TEST_RETURN(this);
+}
+
+/***********************************************************************************************************************************
+Free the writer.  The buffer belongs to the caller and is not freed.
+***********************************************************************************************************************************/
+void
+jsonWriteFree(JsonWrite *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(JSON_WRITE, this);
+    FUNCTION_TEST_END();
+
+    if (this != NULL)
+        memContextFree(this->memContext);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
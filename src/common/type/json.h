@@ -1,11 +1,38 @@
 /***********************************************************************************************************************************
 Convert JSON to/from KeyValue
+
+jsonToVar() and kvToJson()/varToJson() convert whole documents.  JsonRead and JsonWrite read and write JSON value by value directly
+in a buffer so they can be reused for each message without building intermediate objects.
 ***********************************************************************************************************************************/
 #ifndef COMMON_TYPE_JSON_H
 #define COMMON_TYPE_JSON_H
 
+#include <stdint.h>
+
+#include "common/type/buffer.h"
 #include "common/type/keyValue.h"
 
+/***********************************************************************************************************************************
+Object types
+***********************************************************************************************************************************/
+typedef struct JsonRead JsonRead;
+typedef struct JsonWrite JsonWrite;
+
+/***********************************************************************************************************************************
+JSON types returned by jsonReadTypeNext()
+***********************************************************************************************************************************/
+typedef enum
+{
+    jsonTypeArrayBegin,
+    jsonTypeArrayEnd,
+    jsonTypeBool,
+    jsonTypeNull,
+    jsonTypeNumber,
+    jsonTypeObjectBegin,
+    jsonTypeObjectEnd,
+    jsonTypeString,
+} JsonType;
+
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
@@ -14,4 +41,63 @@ Variant *jsonToVar(const String *json);
 String *kvToJson(const KeyValue *kv, unsigned int indent);
 String *varToJson(const Variant *var, unsigned int indent);
 
+/***********************************************************************************************************************************
+Read functions
+***********************************************************************************************************************************/
+JsonRead *jsonReadNew(const Buffer *json);
+void jsonReadReset(JsonRead *this);
+
+JsonType jsonReadTypeNext(JsonRead *this);
+
+void jsonReadArrayBegin(JsonRead *this);
+void jsonReadArrayEnd(JsonRead *this);
+void jsonReadObjectBegin(JsonRead *this);
+void jsonReadObjectEnd(JsonRead *this);
+const String *jsonReadKey(JsonRead *this);
+
+bool jsonReadBool(JsonRead *this);
+int jsonReadInt(JsonRead *this);
+int64_t jsonReadInt64(JsonRead *this);
+uint64_t jsonReadUInt64(JsonRead *this);
+void jsonReadNull(JsonRead *this);
+String *jsonReadStr(JsonRead *this);
+Variant *jsonReadVar(JsonRead *this);
+
+void jsonReadFree(JsonRead *this);
+
+/***********************************************************************************************************************************
+Write functions
+***********************************************************************************************************************************/
+JsonWrite *jsonWriteNew(Buffer *json);
+void jsonWriteReset(JsonWrite *this);
+
+JsonWrite *jsonWriteArrayBegin(JsonWrite *this);
+JsonWrite *jsonWriteArrayEnd(JsonWrite *this);
+JsonWrite *jsonWriteObjectBegin(JsonWrite *this);
+JsonWrite *jsonWriteObjectEnd(JsonWrite *this);
+JsonWrite *jsonWriteKey(JsonWrite *this, const String *key);
+
+JsonWrite *jsonWriteBool(JsonWrite *this, bool value);
+JsonWrite *jsonWriteInt(JsonWrite *this, int value);
+JsonWrite *jsonWriteInt64(JsonWrite *this, int64_t value);
+JsonWrite *jsonWriteUInt64(JsonWrite *this, uint64_t value);
+JsonWrite *jsonWriteNull(JsonWrite *this);
+JsonWrite *jsonWriteStr(JsonWrite *this, const String *value);
+JsonWrite *jsonWriteVar(JsonWrite *this, const Variant *value);
+
+void jsonWriteFree(JsonWrite *this);
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+#define FUNCTION_LOG_JSON_READ_TYPE                                                                                                \
+    JsonRead *
+#define FUNCTION_LOG_JSON_READ_FORMAT(value, buffer, bufferSize)                                                                   \
+    objToLog(value, "JsonRead", buffer, bufferSize)
+
+#define FUNCTION_LOG_JSON_WRITE_TYPE                                                                                               \
+    JsonWrite *
+#define FUNCTION_LOG_JSON_WRITE_FORMAT(value, buffer, bufferSize)                                                                  \
+    objToLog(value, "JsonWrite", buffer, bufferSize)
+
 #endif
@@ -2,6 +2,7 @@
 Key Value Handler
 ***********************************************************************************************************************************/
 #include <limits.h>
+#include <string.h>
 
 #include "common/debug.h"
 #include "common/memContext.h"
@@ -14,6 +15,12 @@ Constant to indicate key not found
 ***********************************************************************************************************************************/
 #define KEY_NOT_FOUND                                               UINT_MAX
 
+/***********************************************************************************************************************************
+Minimum number of keys before the hash index is built.  Smaller stores are searched linearly (comparing the stored key hashes first)
+since that is faster than maintaining an index for the handful of keys in a typical protocol message.
+***********************************************************************************************************************************/
+#define KEY_VALUE_INDEX_MIN                                         8
+
 /***********************************************************************************************************************************
 Contains information about the key value store
 ***********************************************************************************************************************************/
@@ -22,6 +29,9 @@ struct KeyValue
     MemContext *memContext;                                         // Mem context for the store
     List *list;                                                     // List of keys/values
     VariantList *keyList;                                           // List of keys
+
+    unsigned int *index;                                            // Hash index of list positions + 1 (0 marks an empty slot)
+    unsigned int indexSize;                                         // Size of the index (always a power of two)
 };
 
 /***********************************************************************************************************************************
@@ -31,8 +41,101 @@ typedef struct KeyValuePair
 {
     Variant *key;                                                   // The key
     Variant *value;                                                 // The value (this may be NULL)
+    unsigned int hash;                                              // Hash of the key
 } KeyValuePair;
 
+/***********************************************************************************************************************************
+Hash a key (FNV-1a).  String keys are hashed on their contents so lookups by String or zero-terminated string do not need a Variant.
+***********************************************************************************************************************************/
+static unsigned int
+kvHashZ(const char *key, size_t keySize)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRINGZ, key);
+        FUNCTION_TEST_PARAM(SIZE, keySize);
+    FUNCTION_TEST_END();
+
+    ASSERT(key != NULL);
+
+    unsigned int result = 2166136261U;
+
+    for (size_t keyIdx = 0; keyIdx < keySize; keyIdx++)
+        result = (result ^ (unsigned char)key[keyIdx]) * 16777619U;
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+static unsigned int
+kvHashVar(const Variant *key)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(VARIANT, key);
+    FUNCTION_TEST_END();
+
+    ASSERT(key != NULL);
+
+    unsigned int result = 0;
+    uint64_t data = 0;
+
+    switch (varType(key))
+    {
+        case varTypeBool:
+        {
+            data = varBool(key);
+            break;
+        }
+
+        case varTypeDouble:
+        {
+            // Add zero so -0.0 hashes the same as 0.0 since they are equal
+            double dataDbl = varDbl(key) + 0.0;
+            memcpy(&data, &dataDbl, sizeof(data));
+            break;
+        }
+
+        case varTypeInt:
+        {
+            data = (uint64_t)varInt(key);
+            break;
+        }
+
+        case varTypeInt64:
+        {
+            data = (uint64_t)varInt64(key);
+            break;
+        }
+
+        case varTypeString:
+        {
+            result = kvHashZ(strPtr(varStr(key)), strSize(varStr(key)));
+            break;
+        }
+
+        case varTypeUInt64:
+        {
+            data = varUInt64(key);
+            break;
+        }
+
+        // Key/value and list keys are hashed on type only -- varEq() will throw an error if two of them are ever compared
+        case varTypeKeyValue:
+        case varTypeVariantList:
+            break;
+    }
+
+    // Hash the type with the value for other types so keys that can never be equal (e.g. int 1 and uint64 1) are spread out
+    if (varType(key) != varTypeString)
+    {
+        unsigned char buffer[sizeof(data) + 1];
+        buffer[0] = (unsigned char)varType(key);
+        memcpy(buffer + 1, &data, sizeof(data));
+
+        result = kvHashZ((const char *)buffer, sizeof(buffer));
+    }
+
+    FUNCTION_TEST_RETURN(result);
+}
+
 /***********************************************************************************************************************************
 Create a new key/value store
 ***********************************************************************************************************************************/
@@ -58,6 +161,60 @@ kvNew(void)
     FUNCTION_TEST_RETURN(this);
 }
 
+/***********************************************************************************************************************************
+Add a pair that was just added to the list to the index
+
+The index is built once the store reaches KEY_VALUE_INDEX_MIN keys and is rebuilt at double the size whenever it becomes half full,
+so probe sequences stay short. The correct mem context should be set before calling this function.
+***********************************************************************************************************************************/
+static void
+kvIndexAdd(KeyValue *this, unsigned int listIdx)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(KEY_VALUE, this);
+        FUNCTION_TEST_PARAM(UINT, listIdx);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(listIdx == lstSize(this->list) - 1);
+
+    unsigned int listSize = lstSize(this->list);
+
+    if (listSize >= KEY_VALUE_INDEX_MIN)
+    {
+        unsigned int listIdxBegin = listIdx;
+
+        // Rebuild the index when it does not exist yet or is getting full
+        if (this->index == NULL || listSize * 2 > this->indexSize)
+        {
+            if (this->indexSize == 0)
+                this->indexSize = KEY_VALUE_INDEX_MIN;
+
+            while (listSize * 2 > this->indexSize)
+                this->indexSize *= 2;
+
+            if (this->index != NULL)
+                memFree(this->index);
+
+            this->index = memNew(sizeof(unsigned int) * this->indexSize);
+            listIdxBegin = 0;
+        }
+
+        // Add pairs to the first empty slot at or after the slot for the hash
+        for (; listIdxBegin <= listIdx; listIdxBegin++)
+        {
+            unsigned int slotIdx = ((const KeyValuePair *)lstGet(this->list, listIdxBegin))->hash & (this->indexSize - 1);
+
+            while (this->index[slotIdx] != 0)
+                slotIdx = (slotIdx + 1) & (this->indexSize - 1);
+
+            this->index[slotIdx] = listIdxBegin + 1;
+        }
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Duplicate key/value store
 ***********************************************************************************************************************************/
@@ -72,57 +229,147 @@ kvDup(const KeyValue *source)
 
     KeyValue *this = kvNew();
 
-    // Duplicate all key/values
-    for (unsigned int listIdx = 0; listIdx < lstSize(source->list); listIdx++)
+    MEM_CONTEXT_BEGIN(this->memContext)
     {
-        const KeyValuePair *sourcePair = (const KeyValuePair *)lstGet(source->list, listIdx);
+        // Duplicate all key/values
+        for (unsigned int listIdx = 0; listIdx < lstSize(source->list); listIdx++)
+        {
+            const KeyValuePair *sourcePair = (const KeyValuePair *)lstGet(source->list, listIdx);
 
-        // Copy the pair
-        KeyValuePair pair;
-        pair.key = varDup(sourcePair->key);
-        pair.value = varDup(sourcePair->value);
+            // Copy the pair
+            KeyValuePair pair;
+            pair.key = varDup(sourcePair->key);
+            pair.value = varDup(sourcePair->value);
+            pair.hash = sourcePair->hash;
 
-        // Add to the list
-        lstAdd(this->list, &pair);
-    }
+            // Add to the list and index
+            lstAdd(this->list, &pair);
+            kvIndexAdd(this, listIdx);
+        }
 
-    this->keyList = varLstDup(source->keyList);
+        varLstFree(this->keyList);
+        this->keyList = varLstDup(source->keyList);
+    }
+    MEM_CONTEXT_END();
 
     FUNCTION_TEST_RETURN(this);
 }
 
+/***********************************************************************************************************************************
+Does the pair match the key?  Exactly one of key or keyZ is set -- string keys are always matched on keyZ/keySize.
+***********************************************************************************************************************************/
+static bool
+kvPairEq(const KeyValuePair *pair, unsigned int hash, const Variant *key, const char *keyZ, size_t keySize)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, pair);
+        FUNCTION_TEST_PARAM(UINT, hash);
+        FUNCTION_TEST_PARAM(VARIANT, key);
+        FUNCTION_TEST_PARAM(STRINGZ, keyZ);
+        FUNCTION_TEST_PARAM(SIZE, keySize);
+    FUNCTION_TEST_END();
+
+    ASSERT(pair != NULL);
+    ASSERT((key == NULL) != (keyZ == NULL));
+
+    bool result = false;
+
+    if (pair->hash == hash)
+    {
+        if (key != NULL)
+            result = varEq(key, pair->key);
+        else
+        {
+            result =
+                varType(pair->key) == varTypeString && strSize(varStr(pair->key)) == keySize &&
+                memcmp(strPtr(varStr(pair->key)), keyZ, keySize) == 0;
+        }
+    }
+
+    FUNCTION_TEST_RETURN(result);
+}
+
 /***********************************************************************************************************************************
 Get key index if it exists
+
+Stores below KEY_VALUE_INDEX_MIN keys are searched linearly, otherwise the index is probed starting at the slot for the hash.
 ***********************************************************************************************************************************/
 static unsigned int
-kvGetIdx(const KeyValue *this, const Variant *key)
+kvFind(const KeyValue *this, unsigned int hash, const Variant *key, const char *keyZ, size_t keySize)
 {
     FUNCTION_TEST_BEGIN();
         FUNCTION_TEST_PARAM(KEY_VALUE, this);
+        FUNCTION_TEST_PARAM(UINT, hash);
         FUNCTION_TEST_PARAM(VARIANT, key);
+        FUNCTION_TEST_PARAM(STRINGZ, keyZ);
+        FUNCTION_TEST_PARAM(SIZE, keySize);
     FUNCTION_TEST_END();
 
     ASSERT(this != NULL);
-    ASSERT(key != NULL);
 
-    // Search for the key
     unsigned int result = KEY_NOT_FOUND;
 
-    for (unsigned int listIdx = 0; listIdx < lstSize(this->list); listIdx++)
+    if (this->index == NULL)
     {
-        const KeyValuePair *pair = (const KeyValuePair *)lstGet(this->list, listIdx);
-
-        // Break if the key matches
-        if (varEq(key, pair->key))
+        for (unsigned int listIdx = 0; listIdx < lstSize(this->list); listIdx++)
         {
-            result = listIdx;
-            break;
+            // Break if the key matches
+            if (kvPairEq((const KeyValuePair *)lstGet(this->list, listIdx), hash, key, keyZ, keySize))
+            {
+                result = listIdx;
+                break;
+            }
+        }
+    }
+    else
+    {
+        // Probe until the key or an empty slot is found.  The index is never full so an empty slot will always be found.
+        for (unsigned int slotIdx = hash & (this->indexSize - 1); this->index[slotIdx] != 0;
+             slotIdx = (slotIdx + 1) & (this->indexSize - 1))
+        {
+            // Break if the key matches
+            if (kvPairEq((const KeyValuePair *)lstGet(this->list, this->index[slotIdx] - 1), hash, key, keyZ, keySize))
+            {
+                result = this->index[slotIdx] - 1;
+                break;
+            }
         }
     }
 
     FUNCTION_TEST_RETURN(result);
 }
 
+static unsigned int
+kvGetIdxHash(const KeyValue *this, const Variant *key, unsigned int hash)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(KEY_VALUE, this);
+        FUNCTION_TEST_PARAM(VARIANT, key);
+        FUNCTION_TEST_PARAM(UINT, hash);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(key != NULL);
+
+    FUNCTION_TEST_RETURN(
+        varType(key) == varTypeString ?
+            kvFind(this, hash, NULL, strPtr(varStr(key)), strSize(varStr(key))) : kvFind(this, hash, key, NULL, 0));
+}
+
+static unsigned int
+kvGetIdx(const KeyValue *this, const Variant *key)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(KEY_VALUE, this);
+        FUNCTION_TEST_PARAM(VARIANT, key);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(key != NULL);
+
+    FUNCTION_TEST_RETURN(kvGetIdxHash(this, key, kvHashVar(key)));
+}
+
 /***********************************************************************************************************************************
 Does the key exist (even if the value is NULL)
 ***********************************************************************************************************************************/
@@ -170,7 +417,8 @@ kvPutInternal(KeyValue *this, const Variant *key, Variant *value)
     ASSERT(key != NULL);
 
     // Find the key
-    unsigned int listIdx = kvGetIdx(this, key);
+    unsigned int hash = kvHashVar(key);
+    unsigned int listIdx = kvGetIdxHash(this, key, hash);
 
     // If the key was not found then add it
     if (listIdx == KEY_NOT_FOUND)
@@ -179,9 +427,11 @@ kvPutInternal(KeyValue *this, const Variant *key, Variant *value)
         KeyValuePair pair;
         pair.key = varDup(key);
         pair.value = value;
+        pair.hash = hash;
 
-        // Add to the list
+        // Add to the list and index
         lstAdd(this->list, &pair);
+        kvIndexAdd(this, lstSize(this->list) - 1);
 
         // Add to the key list
         varLstAdd(this->keyList, varDup(key));
@@ -328,6 +578,59 @@ kvGet(const KeyValue *this, const Variant *key)
     FUNCTION_TEST_RETURN(result);
 }
 
+/***********************************************************************************************************************************
+Get a value using a String or zero-terminated string key.  These do not allocate a Variant for the key so they are preferred for
+lookups on hot paths.
+***********************************************************************************************************************************/
+static const Variant *
+kvGetKeyZ(const KeyValue *this, const char *key, size_t keySize)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(KEY_VALUE, this);
+        FUNCTION_TEST_PARAM(STRINGZ, key);
+        FUNCTION_TEST_PARAM(SIZE, keySize);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(key != NULL);
+
+    Variant *result = NULL;
+
+    // Find the key
+    unsigned int listIdx = kvFind(this, kvHashZ(key, keySize), NULL, key, keySize);
+
+    if (listIdx != KEY_NOT_FOUND)
+        result = ((KeyValuePair *)lstGet(this->list, listIdx))->value;
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+const Variant *
+kvGetStr(const KeyValue *this, const String *key)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(KEY_VALUE, this);
+        FUNCTION_TEST_PARAM(STRING, key);
+    FUNCTION_TEST_END();
+
+    ASSERT(key != NULL);
+
+    FUNCTION_TEST_RETURN(kvGetKeyZ(this, strPtr(key), strSize(key)));
+}
+
+const Variant *
+kvGetZ(const KeyValue *this, const char *key)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(KEY_VALUE, this);
+        FUNCTION_TEST_PARAM(STRINGZ, key);
+    FUNCTION_TEST_END();
+
+    ASSERT(key != NULL);
+
+    FUNCTION_TEST_RETURN(kvGetKeyZ(this, key, strlen(key)));
+}
+
 /***********************************************************************************************************************************
 Get a value as a list (even if there is only one value) using the key
 ***********************************************************************************************************************************/
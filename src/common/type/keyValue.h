@@ -22,6 +22,8 @@ KeyValue *kvMove(KeyValue *this, MemContext *parentNew);
 KeyValue *kvPut(KeyValue *this, const Variant *key, const Variant *value);
 KeyValue *kvPutKv(KeyValue *this, const Variant *key);
 const Variant *kvGet(const KeyValue *this, const Variant *key);
+const Variant *kvGetStr(const KeyValue *this, const String *key);
+const Variant *kvGetZ(const KeyValue *this, const char *key);
 bool kvKeyExists(const KeyValue *this, const Variant *key);
 VariantList *kvGetList(const KeyValue *this, const Variant *key);
 void kvFree(KeyValue *this);
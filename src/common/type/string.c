@@ -48,6 +48,54 @@ struct String
     MemContext *memContext;                                         // Required for dynamically allocated strings
 };
 
+// Interned strings are immutable so extra is never used and can be set to a value that is otherwise impossible to mark them
+#define STRING_EXTRA_INTERNED                                       UINT32_MAX
+
+#define STRING_INTERNED(this)                                                                                                      \
+    ((this)->common.extra == STRING_EXTRA_INTERNED)
+
+// Is the buffer allocated inline with the object?
+#define STRING_BUFFER_INLINE(this)                                                                                                 \
+    ((this)->common.buffer == (char *)((this) + 1))
+
+/***********************************************************************************************************************************
+Interned strings
+***********************************************************************************************************************************/
+#define STRING_INTERN_TABLE_SIZE_MIN                                64
+
+static struct
+{
+    MemContext *memContext;                                         // Context for interned strings and the table
+    String **table;                                                 // Hash table of interned strings (open addressing)
+    unsigned int size;                                              // Slots in the table (always a power of 2)
+    unsigned int total;                                             // Interned strings in the table
+} strInternLocal;
+
+/***********************************************************************************************************************************
+Create a new string object with the buffer allocated inline so only one allocation is required
+
+The buffer is moved to a separate allocation if the string needs to grow.
+***********************************************************************************************************************************/
+static String *
+strNewInternal(size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    // Check size
+    CHECK_SIZE(size);
+
+    // Create object and buffer
+    String *this = memNewRaw(sizeof(String) + size + 1);
+    this->memContext = memContextCurrent();
+    this->common.size = (unsigned int)size;
+    this->common.extra = 0;
+    this->common.buffer = (char *)(this + 1);
+
+    FUNCTION_TEST_RETURN(this);
+}
+
 /***********************************************************************************************************************************
 Create a new string from a zero-terminated string
 ***********************************************************************************************************************************/
@@ -60,18 +108,10 @@ strNew(const char *string)
 
     ASSERT(string != NULL);
 
-    // Check size
+    // Create object and assign string
     size_t stringSize = strlen(string);
-    CHECK_SIZE(stringSize);
-
-    // Create object
-    String *this = memNew(sizeof(String));
-    this->memContext = memContextCurrent();
-    this->common.size = (unsigned int)stringSize;
-
-    // Allocate and assign string
-    this->common.buffer = memNewRaw(this->common.size + 1);
-    strcpy(this->common.buffer, string);
+    String *this = strNewInternal(stringSize);
+    memcpy(this->common.buffer, string, stringSize + 1);
 
     FUNCTION_TEST_RETURN(this);
 }
@@ -91,16 +131,8 @@ strNewBuf(const Buffer *buffer)
 
     ASSERT(buffer != NULL);
 
-    // Check size
-    CHECK_SIZE(bufUsed(buffer));
-
-    // Create object
-    String *this = memNew(sizeof(String));
-    this->memContext = memContextCurrent();
-    this->common.size = (unsigned int)bufUsed(buffer);
-
-    // Allocate and assign string
-    this->common.buffer = memNewRaw(this->common.size + 1);
+    // Create object and assign string
+    String *this = strNewInternal(bufUsed(buffer));
     memcpy(this->common.buffer, (char *)bufPtr(buffer), this->common.size);
     this->common.buffer[this->common.size] = 0;
 
@@ -119,22 +151,14 @@ strNewFmt(const char *format, ...)
 
     ASSERT(format != NULL);
 
-    // Create object
-    String *this = memNew(sizeof(String));
-    this->memContext = memContextCurrent();
-
     // Determine how long the allocated string needs to be
     va_list argumentList;
     va_start(argumentList, format);
     size_t formatSize = (size_t)vsnprintf(NULL, 0, format, argumentList);
     va_end(argumentList);
 
-    // Check size
-    CHECK_SIZE(formatSize);
-
-    // Allocate and assign string
-    this->common.size = (unsigned int)formatSize;
-    this->common.buffer = memNewRaw(this->common.size + 1);
+    // Create object and assign string
+    String *this = strNewInternal(formatSize);
     va_start(argumentList, format);
     vsnprintf(this->common.buffer, this->common.size + 1, format, argumentList);
     va_end(argumentList);
@@ -157,16 +181,8 @@ strNewN(const char *string, size_t size)
 
     ASSERT(string != NULL);
 
-    // Check size
-    CHECK_SIZE(size);
-
-    // Create object
-    String *this = memNew(sizeof(String));
-    this->memContext = memContextCurrent();
-    this->common.size = (unsigned int)size;
-
-    // Allocate and assign string
-    this->common.buffer = memNewRaw(this->common.size + 1);
+    // Create object and assign string
+    String *this = strNewInternal(size);
     strncpy(this->common.buffer, string, this->common.size);
     this->common.buffer[this->common.size] = 0;
 
@@ -252,7 +268,15 @@ strResize(String *this, size_t requested)
 
         MEM_CONTEXT_BEGIN(this->memContext)
         {
-            this->common.buffer = memGrowRaw(this->common.buffer, this->common.size + this->common.extra + 1);
+            // An inline buffer cannot be grown so move it to a separate allocation
+            if (STRING_BUFFER_INLINE(this))
+            {
+                char *buffer = memNewRaw(this->common.size + this->common.extra + 1);
+                memcpy(buffer, this->common.buffer, this->common.size + 1);
+                this->common.buffer = buffer;
+            }
+            else
+                this->common.buffer = memGrowRaw(this->common.buffer, this->common.size + this->common.extra + 1);
         }
         MEM_CONTEXT_END();
     }
@@ -272,6 +296,7 @@ strCat(String *this, const char *cat)
     FUNCTION_TEST_END();
 
     ASSERT(this != NULL);
+    ASSERT(!STRING_INTERNED(this));
     ASSERT(cat != NULL);
 
     // Determine length of string to append
@@ -300,6 +325,7 @@ strCatChr(String *this, char cat)
     FUNCTION_TEST_END();
 
     ASSERT(this != NULL);
+    ASSERT(!STRING_INTERNED(this));
     ASSERT(cat != 0);
 
     // Ensure there is enough space to grow the string
@@ -325,6 +351,7 @@ strCatFmt(String *this, const char *format, ...)
     FUNCTION_TEST_END();
 
     ASSERT(this != NULL);
+    ASSERT(!STRING_INTERNED(this));
     ASSERT(format != NULL);
 
     // Determine how long the allocated string needs to be
@@ -391,11 +418,173 @@ strDup(const String *this)
     String *result = NULL;
 
     if (this != NULL)
-        result = strNew(strPtr(this));
+        result = strNewN(strPtr(this), strSize(this));
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Hash a string for the intern table (FNV-1a)
+***********************************************************************************************************************************/
+static unsigned int
+strInternHash(const char *string, size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(CHARDATA, string);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(string != NULL);
+
+    unsigned int result = 2166136261U;
+
+    for (size_t stringIdx = 0; stringIdx < size; stringIdx++)
+        result = (result ^ (unsigned char)string[stringIdx]) * 16777619U;
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Find the slot for a string in the intern table.  The slot is empty if the string has not been interned.
+***********************************************************************************************************************************/
+static unsigned int
+strInternSlot(const char *string, size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(CHARDATA, string);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(string != NULL);
+
+    unsigned int result = strInternHash(string, size) & (strInternLocal.size - 1);
+    const String *interned = strInternLocal.table[result];
+
+    while (interned != NULL && (interned->common.size != size || memcmp(interned->common.buffer, string, size) != 0))
+    {
+        result = (result + 1) & (strInternLocal.size - 1);
+        interned = strInternLocal.table[result];
+    }
 
     FUNCTION_TEST_RETURN(result);
 }
 
+/***********************************************************************************************************************************
+Reset the intern table when its context is freed so the table is recreated on next use rather than left dangling
+***********************************************************************************************************************************/
+static void
+strInternFree(void *data)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+    FUNCTION_TEST_END();
+
+    ASSERT(data == &strInternLocal);
+
+    memset(data, 0, sizeof(strInternLocal));
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Intern a string
+
+Returns the single immutable copy of the string that is shared by all callers, so strEq() on two interned strings only needs to
+compare pointers.  Interned strings are not freed until the top context's children are freed so only strings from a bounded set
+(e.g. key names) should be interned.
+***********************************************************************************************************************************/
+const String *
+strInternN(const char *string, size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(CHARDATA, string);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(string != NULL);
+
+    // Create the table on first use
+    if (strInternLocal.memContext == NULL)
+    {
+        MEM_CONTEXT_BEGIN(memContextTop())
+        {
+            strInternLocal.memContext = memContextNew("StringIntern");
+            memContextCallback(strInternLocal.memContext, strInternFree, &strInternLocal);
+        }
+        MEM_CONTEXT_END();
+
+        MEM_CONTEXT_BEGIN(strInternLocal.memContext)
+        {
+            strInternLocal.size = STRING_INTERN_TABLE_SIZE_MIN;
+            strInternLocal.table = memNew(sizeof(String *) * strInternLocal.size);
+        }
+        MEM_CONTEXT_END();
+    }
+
+    unsigned int slot = strInternSlot(string, size);
+
+    if (strInternLocal.table[slot] == NULL)
+    {
+        MEM_CONTEXT_BEGIN(strInternLocal.memContext)
+        {
+            // Double the table when it would be more than half full so probe sequences stay short
+            if ((strInternLocal.total + 1) * 2 > strInternLocal.size)
+            {
+                String **tableOld = strInternLocal.table;
+                unsigned int sizeOld = strInternLocal.size;
+
+                strInternLocal.size *= 2;
+                strInternLocal.table = memNew(sizeof(String *) * strInternLocal.size);
+
+                for (unsigned int slotOld = 0; slotOld < sizeOld; slotOld++)
+                {
+                    if (tableOld[slotOld] != NULL)
+                    {
+                        strInternLocal.table[strInternSlot(strPtr(tableOld[slotOld]), strSize(tableOld[slotOld]))] =
+                            tableOld[slotOld];
+                    }
+                }
+
+                memFree(tableOld);
+                slot = strInternSlot(string, size);
+            }
+
+            String *interned = strNewN(string, size);
+            interned->common.extra = STRING_EXTRA_INTERNED;
+
+            strInternLocal.table[slot] = interned;
+            strInternLocal.total++;
+        }
+        MEM_CONTEXT_END();
+    }
+
+    FUNCTION_TEST_RETURN(strInternLocal.table[slot]);
+}
+
+const String *
+strIntern(const String *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(STRING_INTERNED(this) ? this : strInternN(strPtr(this), strSize(this)));
+}
+
+const String *
+strInternZ(const char *string)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRINGZ, string);
+    FUNCTION_TEST_END();
+
+    ASSERT(string != NULL);
+
+    FUNCTION_TEST_RETURN(strInternN(string, strlen(string)));
+}
+
 /***********************************************************************************************************************************
 Is the string empty?
 ***********************************************************************************************************************************/
@@ -450,7 +639,7 @@ strEndsWithZ(const String *this, const char *endsWith)
 Are two strings equal?
 
 There are two separate implementations because string objects can get the size very efficiently whereas the zero-terminated strings
-would need a call to strlen().
+would need a call to strlen().  Interned strings are unique so two different interned strings are never equal.
 ***********************************************************************************************************************************/
 bool
 strEq(const String *this, const String *compare)
@@ -465,8 +654,10 @@ strEq(const String *this, const String *compare)
 
     bool result = false;
 
-    if (this->common.size == compare->common.size)
-        result = strcmp(strPtr(this), strPtr(compare)) == 0;
+    if (this == compare)
+        result = true;
+    else if (!(STRING_INTERNED(this) && STRING_INTERNED(compare)) && this->common.size == compare->common.size)
+        result = memcmp(strPtr(this), strPtr(compare), this->common.size) == 0;
 
     FUNCTION_TEST_RETURN(result);
 }
@@ -496,6 +687,7 @@ strFirstUpper(String *this)
     FUNCTION_TEST_END();
 
     ASSERT(this != NULL);
+    ASSERT(!STRING_INTERNED(this));
 
     if (this->common.size > 0)
         this->common.buffer[0] = (char)toupper(this->common.buffer[0]);
@@ -514,6 +706,7 @@ strFirstLower(String *this)
     FUNCTION_TEST_END();
 
     ASSERT(this != NULL);
+    ASSERT(!STRING_INTERNED(this));
 
     if (this->common.size > 0)
         this->common.buffer[0] = (char)tolower(this->common.buffer[0]);
@@ -532,6 +725,7 @@ strUpper(String *this)
     FUNCTION_TEST_END();
 
     ASSERT(this != NULL);
+    ASSERT(!STRING_INTERNED(this));
 
     if (this->common.size > 0)
         for (unsigned int idx = 0; idx <= this->common.size; idx++)
@@ -551,6 +745,7 @@ strLower(String *this)
     FUNCTION_TEST_END();
 
     ASSERT(this != NULL);
+    ASSERT(!STRING_INTERNED(this));
 
     if (this->common.size > 0)
         for (unsigned int idx = 0; idx <= this->common.size; idx++)
@@ -644,6 +839,7 @@ strReplaceChr(String *this, char find, char replace)
     FUNCTION_TEST_END();
 
     ASSERT(this != NULL);
+    ASSERT(!STRING_INTERNED(this));
 
     for (unsigned int stringIdx = 0; stringIdx < this->common.size; stringIdx++)
     {
@@ -716,6 +912,7 @@ strTrim(String *this)
     FUNCTION_TEST_END();
 
     ASSERT(this != NULL);
+    ASSERT(!STRING_INTERNED(this));
 
     // Nothing to trim if size is zero
     if (this->common.size > 0)
@@ -745,12 +942,15 @@ strTrim(String *this)
             this->common.buffer[this->common.size] = 0;
             this->common.extra = 0;
 
-            MEM_CONTEXT_BEGIN(this->memContext)
+            // Resize the buffer unless it is inline
+            if (!STRING_BUFFER_INLINE(this))
             {
-                // Resize the buffer
-                this->common.buffer = memGrowRaw(this->common.buffer, this->common.size + 1);
+                MEM_CONTEXT_BEGIN(this->memContext)
+                {
+                    this->common.buffer = memGrowRaw(this->common.buffer, this->common.size + 1);
+                }
+                MEM_CONTEXT_END();
             }
-            MEM_CONTEXT_END();
         }
     }
 
@@ -794,6 +994,7 @@ strTrunc(String *this, int idx)
     FUNCTION_TEST_END();
 
     ASSERT(this != NULL);
+    ASSERT(!STRING_INTERNED(this));
     ASSERT(idx >= 0 && (size_t)idx <= this->common.size);
 
     if (this->common.size > 0)
@@ -803,12 +1004,15 @@ strTrunc(String *this, int idx)
         this->common.buffer[this->common.size] = 0;
         this->common.extra = 0;
 
-        MEM_CONTEXT_BEGIN(this->memContext)
+        // Resize the buffer unless it is inline
+        if (!STRING_BUFFER_INLINE(this))
         {
-            // Resize the buffer
-            this->common.buffer = memGrowRaw(this->common.buffer, this->common.size + 1);
+            MEM_CONTEXT_BEGIN(this->memContext)
+            {
+                this->common.buffer = memGrowRaw(this->common.buffer, this->common.size + 1);
+            }
+            MEM_CONTEXT_END();
         }
-        MEM_CONTEXT_END();
     }
 
     FUNCTION_TEST_RETURN(this);
@@ -896,11 +1100,14 @@ strFree(String *this)
         FUNCTION_TEST_PARAM(STRING, this);
     FUNCTION_TEST_END();
 
-    if (this != NULL)
+    // Interned strings are shared so they are never freed
+    if (this != NULL && !STRING_INTERNED(this))
     {
         MEM_CONTEXT_BEGIN(this->memContext)
         {
-            memFree(this->common.buffer);
+            if (!STRING_BUFFER_INLINE(this))
+                memFree(this->common.buffer);
+
             memFree(this);
         }
         MEM_CONTEXT_END();
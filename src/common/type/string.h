@@ -49,6 +49,9 @@ bool strEndsWith(const String *this, const String *endsWith);
 bool strEndsWithZ(const String *this, const char *endsWith);
 bool strEq(const String *this, const String *compare);
 bool strEqZ(const String *this, const char *compare);
+const String *strIntern(const String *this);
+const String *strInternN(const char *string, size_t size);
+const String *strInternZ(const char *string);
 String *strFirstUpper(String *this);
 String *strFirstLower(String *this);
 String *strUpper(String *this);
@@ -19,10 +19,18 @@ Information about the variant
 ***********************************************************************************************************************************/
 struct Variant
 {
-    MemContext *memContext;                                         // Mem context
-    unsigned int type:3;                                            // Variant Type
+    // This struct must always be declared first.  These are the fields that are shared in common with constant variants.
+    struct VariantCommon common;
+
+    MemContext *memContext;                                         // Required for dynamically allocated variants
 };
 
+/***********************************************************************************************************************************
+Constant variants that are generally useful
+***********************************************************************************************************************************/
+VARIANT_EXTERN(BOOL_FALSE_VAR,                                      VARBOOL(false));
+VARIANT_EXTERN(BOOL_TRUE_VAR,                                       VARBOOL(true));
+
 /***********************************************************************************************************************************
 Variant type names
 ***********************************************************************************************************************************/
@@ -39,46 +47,23 @@ static const char *variantTypeName[] =
 };
 
 /***********************************************************************************************************************************
-New variant of any supported type
+New variant of any supported type.  The data is stored inline so the caller sets it after the variant is allocated.
 ***********************************************************************************************************************************/
 static Variant *
-varNewInternal(VariantType type, void *data, size_t dataSize)
+varNewInternal(VariantType type)
 {
     FUNCTION_TEST_BEGIN();
         FUNCTION_TEST_PARAM(ENUM, type);
-        FUNCTION_TEST_PARAM_P(VOID, data);
-        FUNCTION_TEST_PARAM(SIZE, dataSize);
     FUNCTION_TEST_END();
 
-    ASSERT(data != NULL);
-    ASSERT(dataSize > 0);
-
     // Allocate memory for the variant and set the type
-    Variant *this = memNew(sizeof(Variant) + dataSize);
+    Variant *this = memNew(sizeof(Variant));
+    this->common.type = type;
     this->memContext = memContextCurrent();
-    this->type = type;
-
-    // Copy data
-    memcpy((unsigned char *)this + sizeof(Variant), data, dataSize);
 
     FUNCTION_TEST_RETURN(this);
 }
 
-/***********************************************************************************************************************************
-Get a pointer to the data stored in the variant.  This hides the complicated pointer arithmetic.
-***********************************************************************************************************************************/
-static void *
-varData(const Variant *this)
-{
-    FUNCTION_TEST_BEGIN();
-        FUNCTION_TEST_PARAM(VARIANT, this);
-    FUNCTION_TEST_END();
-
-    ASSERT(this != NULL);
-
-    FUNCTION_TEST_RETURN((void *)((unsigned char *)this + sizeof(Variant)));
-}
-
 /***********************************************************************************************************************************
 Duplicate a variant
 ***********************************************************************************************************************************/
@@ -93,7 +78,7 @@ varDup(const Variant *this)
 
     if (this != NULL)
     {
-        switch (this->type)
+        switch (this->common.type)
         {
             case varTypeBool:
             {
@@ -127,8 +112,8 @@ varDup(const Variant *this)
 
             case varTypeKeyValue:
             {
-                KeyValue *data = kvDup(varKv(this));
-                result = varNewInternal(varTypeKeyValue, (void *)&data, sizeof(data));
+                result = varNewInternal(varTypeKeyValue);
+                result->common.data.keyValue = kvDup(varKv(this));
                 break;
             }
 
@@ -208,7 +193,7 @@ varEq(const Variant *this1, const Variant *this2)
 
                 case varTypeKeyValue:
                 case varTypeVariantList:
-                    THROW_FMT(AssertError, "unable to test equality for %s", variantTypeName[this1->type]);
+                    THROW_FMT(AssertError, "unable to test equality for %s", variantTypeName[this1->common.type]);
             }
         }
     }
@@ -231,7 +216,7 @@ varType(const Variant *this)
 
     ASSERT(this != NULL);
 
-    FUNCTION_TEST_RETURN(this->type);
+    FUNCTION_TEST_RETURN(this->common.type);
 }
 
 /***********************************************************************************************************************************
@@ -244,7 +229,10 @@ varNewBool(bool data)
         FUNCTION_TEST_PARAM(BOOL, data);
     FUNCTION_TEST_END();
 
-    FUNCTION_TEST_RETURN(varNewInternal(varTypeBool, (void *)&data, sizeof(data)));
+    Variant *this = varNewInternal(varTypeBool);
+    this->common.data.boolean = data;
+
+    FUNCTION_TEST_RETURN(this);
 }
 
 /***********************************************************************************************************************************
@@ -259,9 +247,9 @@ varBool(const Variant *this)
 
     ASSERT(this != NULL);
 
-    ASSERT(this->type == varTypeBool);
+    ASSERT(this->common.type == varTypeBool);
 
-    FUNCTION_TEST_RETURN(*((bool *)varData(this)));
+    FUNCTION_TEST_RETURN(this->common.data.boolean);
 }
 
 /***********************************************************************************************************************************
@@ -278,7 +266,7 @@ varBoolForce(const Variant *this)
 
     bool result = false;
 
-    switch (this->type)
+    switch (this->common.type)
     {
         case varTypeBool:
             result = varBool(this);
@@ -324,7 +312,7 @@ varBoolForce(const Variant *this)
         }
 
         default:
-            THROW_FMT(AssertError, "unable to force %s to %s", variantTypeName[this->type], variantTypeName[varTypeBool]);
+            THROW_FMT(AssertError, "unable to force %s to %s", variantTypeName[this->common.type], variantTypeName[varTypeBool]);
     }
 
     FUNCTION_TEST_RETURN(result);
@@ -340,7 +328,10 @@ varNewDbl(double data)
         FUNCTION_TEST_PARAM(DOUBLE, data);
     FUNCTION_TEST_END();
 
-    FUNCTION_TEST_RETURN(varNewInternal(varTypeDouble, (unsigned char *)&data, sizeof(data)));
+    Variant *this = varNewInternal(varTypeDouble);
+    this->common.data.dbl = data;
+
+    FUNCTION_TEST_RETURN(this);
 }
 
 /***********************************************************************************************************************************
@@ -355,9 +346,9 @@ varDbl(const Variant *this)
 
     ASSERT(this != NULL);
 
-    ASSERT(this->type == varTypeDouble);
+    ASSERT(this->common.type == varTypeDouble);
 
-    FUNCTION_TEST_RETURN(*((double *)varData(this)));
+    FUNCTION_TEST_RETURN(this->common.data.dbl);
 }
 
 /***********************************************************************************************************************************
@@ -374,7 +365,7 @@ varDblForce(const Variant *this)
 
     double result = 0;
 
-    switch (this->type)
+    switch (this->common.type)
     {
         case varTypeBool:
         {
@@ -413,7 +404,7 @@ varDblForce(const Variant *this)
         }
 
         default:
-            THROW_FMT(AssertError, "unable to force %s to %s", variantTypeName[this->type], variantTypeName[varTypeDouble]);
+            THROW_FMT(AssertError, "unable to force %s to %s", variantTypeName[this->common.type], variantTypeName[varTypeDouble]);
     }
 
     FUNCTION_TEST_RETURN(result);
@@ -429,7 +420,10 @@ varNewInt(int data)
         FUNCTION_TEST_PARAM(INT, data);
     FUNCTION_TEST_END();
 
-    FUNCTION_TEST_RETURN(varNewInternal(varTypeInt, (void *)&data, sizeof(data)));
+    Variant *this = varNewInternal(varTypeInt);
+    this->common.data.integer = data;
+
+    FUNCTION_TEST_RETURN(this);
 }
 
 /***********************************************************************************************************************************
@@ -444,9 +438,9 @@ varInt(const Variant *this)
 
     ASSERT(this != NULL);
 
-    ASSERT(this->type == varTypeInt);
+    ASSERT(this->common.type == varTypeInt);
 
-    FUNCTION_TEST_RETURN(*((int *)varData(this)));
+    FUNCTION_TEST_RETURN(this->common.data.integer);
 }
 
 /***********************************************************************************************************************************
@@ -463,7 +457,7 @@ varIntForce(const Variant *this)
 
     int result = 0;
 
-    switch (this->type)
+    switch (this->common.type)
     {
         case varTypeBool:
         {
@@ -484,7 +478,7 @@ varIntForce(const Variant *this)
             // Make sure the value fits into a normal 32-bit int range since 32-bit platforms are supported
             if (resultTest > INT32_MAX || resultTest < INT32_MIN)
                 THROW_FMT(
-                    FormatError, "unable to convert %s %" PRId64 " to %s", variantTypeName[this->type], resultTest,
+                    FormatError, "unable to convert %s %" PRId64 " to %s", variantTypeName[this->common.type], resultTest,
                     variantTypeName[varTypeInt]);
 
             result = (int)resultTest;
@@ -498,7 +492,7 @@ varIntForce(const Variant *this)
             // Make sure the value fits into a normal 32-bit int range
             if (resultTest > INT32_MAX)
                 THROW_FMT(
-                    FormatError, "unable to convert %s %" PRIu64 " to %s", variantTypeName[this->type], resultTest,
+                    FormatError, "unable to convert %s %" PRIu64 " to %s", variantTypeName[this->common.type], resultTest,
                     variantTypeName[varTypeInt]);
 
             result = (int)resultTest;
@@ -512,7 +506,7 @@ varIntForce(const Variant *this)
         }
 
         default:
-            THROW_FMT(AssertError, "unable to force %s to %s", variantTypeName[this->type], variantTypeName[varTypeInt]);
+            THROW_FMT(AssertError, "unable to force %s to %s", variantTypeName[this->common.type], variantTypeName[varTypeInt]);
     }
 
     FUNCTION_TEST_RETURN(result);
@@ -528,7 +522,10 @@ varNewInt64(int64_t data)
         FUNCTION_TEST_PARAM(INT64, data);
     FUNCTION_TEST_END();
 
-    FUNCTION_TEST_RETURN(varNewInternal(varTypeInt64, (void *)&data, sizeof(data)));
+    Variant *this = varNewInternal(varTypeInt64);
+    this->common.data.int64 = data;
+
+    FUNCTION_TEST_RETURN(this);
 }
 
 /***********************************************************************************************************************************
@@ -543,9 +540,9 @@ varInt64(const Variant *this)
 
     ASSERT(this != NULL);
 
-    ASSERT(this->type == varTypeInt64);
+    ASSERT(this->common.type == varTypeInt64);
 
-    FUNCTION_TEST_RETURN(*((int64_t *)varData(this)));
+    FUNCTION_TEST_RETURN(this->common.data.int64);
 }
 
 /***********************************************************************************************************************************
@@ -562,7 +559,7 @@ varInt64Force(const Variant *this)
 
     int64_t result = 0;
 
-    switch (this->type)
+    switch (this->common.type)
     {
         case varTypeBool:
         {
@@ -592,7 +589,7 @@ varInt64Force(const Variant *this)
             else
             {
                 THROW_FMT(
-                    FormatError, "unable to convert %s %" PRIu64 " to %s", variantTypeName[this->type], resultTest,
+                    FormatError, "unable to convert %s %" PRIu64 " to %s", variantTypeName[this->common.type], resultTest,
                     variantTypeName[varTypeInt64]);
             }
 
@@ -606,7 +603,7 @@ varInt64Force(const Variant *this)
         }
 
         default:
-            THROW_FMT(AssertError, "unable to force %s to %s", variantTypeName[this->type], variantTypeName[varTypeInt64]);
+            THROW_FMT(AssertError, "unable to force %s to %s", variantTypeName[this->common.type], variantTypeName[varTypeInt64]);
     }
 
     FUNCTION_TEST_RETURN(result);
@@ -622,7 +619,10 @@ varNewUInt64(uint64_t data)
         FUNCTION_TEST_PARAM(UINT64, data);
     FUNCTION_TEST_END();
 
-    FUNCTION_TEST_RETURN(varNewInternal(varTypeUInt64, (void *)&data, sizeof(data)));
+    Variant *this = varNewInternal(varTypeUInt64);
+    this->common.data.uint64 = data;
+
+    FUNCTION_TEST_RETURN(this);
 }
 
 /***********************************************************************************************************************************
@@ -637,9 +637,9 @@ varUInt64(const Variant *this)
 
     ASSERT(this != NULL);
 
-    ASSERT(this->type == varTypeUInt64);
+    ASSERT(this->common.type == varTypeUInt64);
 
-    FUNCTION_TEST_RETURN(*((uint64_t *)varData(this)));
+    FUNCTION_TEST_RETURN(this->common.data.uint64);
 }
 
 /***********************************************************************************************************************************
@@ -656,7 +656,7 @@ varUInt64Force(const Variant *this)
 
     uint64_t result = 0;
 
-    switch (this->type)
+    switch (this->common.type)
     {
         case varTypeBool:
         {
@@ -674,7 +674,7 @@ varUInt64Force(const Variant *this)
             else
             {
                 THROW_FMT(
-                    FormatError, "unable to convert %s %d to %s", variantTypeName[this->type], resultTest,
+                    FormatError, "unable to convert %s %d to %s", variantTypeName[this->common.type], resultTest,
                     variantTypeName[varTypeUInt64]);
             }
 
@@ -691,7 +691,7 @@ varUInt64Force(const Variant *this)
             else
             {
                 THROW_FMT(
-                    FormatError, "unable to convert %s %" PRId64 " to %s", variantTypeName[this->type], resultTest,
+                    FormatError, "unable to convert %s %" PRId64 " to %s", variantTypeName[this->common.type], resultTest,
                     variantTypeName[varTypeUInt64]);
             }
 
@@ -711,7 +711,7 @@ varUInt64Force(const Variant *this)
         }
 
         default:
-            THROW_FMT(AssertError, "unable to force %s to %s", variantTypeName[this->type], variantTypeName[varTypeUInt64]);
+            THROW_FMT(AssertError, "unable to force %s to %s", variantTypeName[this->common.type], variantTypeName[varTypeUInt64]);
     }
 
     FUNCTION_TEST_RETURN(result);
@@ -728,7 +728,10 @@ varNewKv(void)
     // Create a new kv for the variant
     KeyValue *data = kvNew();
 
-    FUNCTION_TEST_RETURN(varNewInternal(varTypeKeyValue, (void *)&data, sizeof(data)));
+    Variant *this = varNewInternal(varTypeKeyValue);
+    this->common.data.keyValue = data;
+
+    FUNCTION_TEST_RETURN(this);
 }
 
 /***********************************************************************************************************************************
@@ -745,8 +748,8 @@ varKv(const Variant *this)
 
     if (this != NULL)
     {
-        ASSERT(this->type == varTypeKeyValue);
-        result = *((KeyValue **)varData(this));
+        ASSERT(this->common.type == varTypeKeyValue);
+        result = this->common.data.keyValue;
     }
 
     FUNCTION_TEST_RETURN(result);
@@ -765,7 +768,10 @@ varNewStr(const String *data)
     // Create a copy of the string for the variant
     String *dataCopy = strDup(data);
 
-    FUNCTION_TEST_RETURN(varNewInternal(varTypeString, (void *)&dataCopy, sizeof(dataCopy)));
+    Variant *this = varNewInternal(varTypeString);
+    this->common.data.string = dataCopy;
+
+    FUNCTION_TEST_RETURN(this);
 }
 
 /***********************************************************************************************************************************
@@ -784,25 +790,28 @@ varNewStrZ(const char *data)
     if (data != NULL)
         dataCopy = strNew(data);
 
-    FUNCTION_TEST_RETURN(varNewInternal(varTypeString, (void *)&dataCopy, sizeof(dataCopy)));
+    Variant *this = varNewInternal(varTypeString);
+    this->common.data.string = dataCopy;
+
+    FUNCTION_TEST_RETURN(this);
 }
 
 /***********************************************************************************************************************************
 Return string
 ***********************************************************************************************************************************/
-String *
+const String *
 varStr(const Variant *this)
 {
     FUNCTION_TEST_BEGIN();
         FUNCTION_TEST_PARAM(VARIANT, this);
     FUNCTION_TEST_END();
 
-    String *result = NULL;
+    const String *result = NULL;
 
     if (this != NULL)
     {
-        ASSERT(this->type == varTypeString);
-        result = *((String **)varData(this));
+        ASSERT(this->common.type == varTypeString);
+        result = this->common.data.string;
     }
 
     FUNCTION_TEST_RETURN(result);
@@ -876,7 +885,7 @@ varStrForce(const Variant *this)
 
         case varTypeKeyValue:
         case varTypeVariantList:
-            THROW_FMT(FormatError, "unable to force %s to %s", variantTypeName[this->type], variantTypeName[varTypeString]);
+            THROW_FMT(FormatError, "unable to force %s to %s", variantTypeName[this->common.type], variantTypeName[varTypeString]);
     }
 
     FUNCTION_TEST_RETURN(result);
@@ -898,7 +907,10 @@ varNewVarLst(const VariantList *data)
     if (data != NULL)
         dataCopy = varLstDup(data);
 
-    FUNCTION_TEST_RETURN(varNewInternal(varTypeVariantList, (void *)&dataCopy, sizeof(dataCopy)));
+    Variant *this = varNewInternal(varTypeVariantList);
+    this->common.data.variantList = dataCopy;
+
+    FUNCTION_TEST_RETURN(this);
 }
 
 /***********************************************************************************************************************************
@@ -915,8 +927,8 @@ varVarLst(const Variant *this)
 
     if (this != NULL)
     {
-        ASSERT(this->type == varTypeVariantList);
-        result = *((VariantList **)varData(this));
+        ASSERT(this->common.type == varTypeVariantList);
+        result = this->common.data.variantList;
     }
 
     FUNCTION_TEST_RETURN(result);
@@ -983,7 +995,7 @@ varFree(Variant *this)
     {
         MEM_CONTEXT_BEGIN(this->memContext)
         {
-            switch (this->type)
+            switch (this->common.type)
             {
                 case varTypeKeyValue:
                 {
@@ -993,7 +1005,8 @@ varFree(Variant *this)
 
                 case varTypeString:
                 {
-                    strFree(varStr(this));
+                    // The string is a copy owned by the variant so it can be freed even though it is stored as const
+                    strFree((String *)varStr(this));
                     break;
                 }
 
@@ -44,6 +44,29 @@ typedef enum
 #include "common/type/string.h"
 #include "common/type/variantList.h"
 
+/***********************************************************************************************************************************
+Fields that are common between dynamically allocated and constant variants
+
+There is nothing user-accessible here but this construct allows constant variants to be created and then handled by the same
+functions that process dynamically allocated variants.  Scalar data is stored inline in the union so no additional allocation is
+required to box it.
+***********************************************************************************************************************************/
+struct VariantCommon
+{
+    unsigned int type:3;                                            // Variant type
+    union
+    {
+        bool boolean;                                               // varTypeBool
+        double dbl;                                                 // varTypeDouble
+        int integer;                                                // varTypeInt
+        int64_t int64;                                              // varTypeInt64
+        struct KeyValue *keyValue;                                  // varTypeKeyValue
+        const struct String *string;                                // varTypeString
+        uint64_t uint64;                                            // varTypeUInt64
+        struct VariantList *variantList;                            // varTypeVariantList
+    } data;
+};
+
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
@@ -68,7 +91,7 @@ KeyValue *varKv(const Variant *this);
 
 Variant *varNewStr(const String *data);
 Variant *varNewStrZ(const char *data);
-String *varStr(const Variant *this);
+const String *varStr(const Variant *this);
 String *varStrForce(const Variant *this);
 
 Variant *varNewUInt64(uint64_t data);
@@ -84,6 +107,53 @@ VariantType varType(const Variant *this);
 
 void varFree(Variant *this);
 
+/***********************************************************************************************************************************
+Macros for constant variants
+
+Frequently used constant variants can be declared with these macros at compile time rather than dynamically at run time.  They can
+also be used to pass a value to a function that accepts a const Variant * (e.g. protocolCommandParamAdd()) without allocating a
+variant that will only be copied or serialized.
+
+Note that variants created in this way are declared as const so can't be modified or freed by the var*() methods.  Casting to
+Variant * will result in a segfault due to modifying read-only memory.
+
+By convention all variant constant identifiers are appended with _VAR.
+***********************************************************************************************************************************/
+// Create constant variants inline.  Compound literals declared in a function have automatic storage so these variants must not be
+// used after the enclosing block exits.
+#define VARBOOL(dataParam)                                                                                                         \
+    ((const Variant *)&(const struct VariantCommon){.type = varTypeBool, .data.boolean = dataParam})
+#define VARDBL(dataParam)                                                                                                          \
+    ((const Variant *)&(const struct VariantCommon){.type = varTypeDouble, .data.dbl = dataParam})
+#define VARINT(dataParam)                                                                                                          \
+    ((const Variant *)&(const struct VariantCommon){.type = varTypeInt, .data.integer = dataParam})
+#define VARINT64(dataParam)                                                                                                        \
+    ((const Variant *)&(const struct VariantCommon){.type = varTypeInt64, .data.int64 = dataParam})
+#define VARSTR(dataParam)                                                                                                          \
+    ((const Variant *)&(const struct VariantCommon){.type = varTypeString, .data.string = dataParam})
+#define VARSTRDEF(dataParam)                                                                                                       \
+    VARSTR(STRING_CONST(dataParam))
+#define VARUINT64(dataParam)                                                                                                       \
+    ((const Variant *)&(const struct VariantCommon){.type = varTypeUInt64, .data.uint64 = dataParam})
+
+// Used to declare variant constants that will be externed using VARIANT_DECLARE().  Must be used in a .c file.
+#define VARIANT_EXTERN(name, variant)                                                                                              \
+    const Variant *name = variant
+
+// Used to declare variant constants that will be local to the .c file.  Must be used in a .c file.
+#define VARIANT_STATIC(name, variant)                                                                                              \
+    static const Variant *name = variant
+
+// Used to extern variant constants declared with VARIANT_EXTERN().  Must be used in a .h file.
+#define VARIANT_DECLARE(name)                                                                                                      \
+    extern const Variant *name
+
+/***********************************************************************************************************************************
+Constant variants that are generally useful
+***********************************************************************************************************************************/
+VARIANT_DECLARE(BOOL_FALSE_VAR);
+VARIANT_DECLARE(BOOL_TRUE_VAR);
+
 /***********************************************************************************************************************************
 Macros for function logging
 ***********************************************************************************************************************************/
@@ -5,8 +5,10 @@ Xml Handler
 
 #include <libxml/parser.h>
 #include <libxml/tree.h>
+#include <libxml/xmlreader.h>
 
 #include "common/debug.h"
+#include "common/io/io.h"
 #include "common/log.h"
 #include "common/memContext.h"
 #include "common/type/list.h"
@@ -30,6 +32,20 @@ struct XmlDocument
     XmlNode *root;
 };
 
+/***********************************************************************************************************************************
+Reader type
+***********************************************************************************************************************************/
+struct XmlReader
+{
+    MemContext *memContext;
+    xmlTextReaderPtr reader;                                        // libxml2 reader
+    IoRead *read;                                                   // Source of the xml
+    Buffer *buffer;                                                 // Buffer used to read from the source
+
+    const ErrorType *errorType;                                     // Type of error thrown while reading from the source (if any)
+    String *errorMessage;                                           // Message of error thrown while reading from the source
+};
+
 /***********************************************************************************************************************************
 Error handler
 
@@ -44,6 +60,30 @@ void xmlErrorHandler(void *ctx, const char *format, ...)
     (void)format;
 }
 
+/***********************************************************************************************************************************
+Initialize xml if it is not already initialized
+***********************************************************************************************************************************/
+static void
+xmlInitLib(void)
+{
+    FUNCTION_TEST_VOID();
+
+    static bool xmlInit = false;
+
+    if (!xmlInit)
+    {
+        LIBXML_TEST_VERSION;
+
+        // It's a pretty weird that we can't just pass a handler function but instead have to assign it to a var...
+        static xmlGenericErrorFunc xmlErrorHandlerFunc = xmlErrorHandler;
+        initGenericErrorDefaultFunc(&xmlErrorHandlerFunc);
+
+        xmlInit = true;
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Create node list
 ***********************************************************************************************************************************/
@@ -290,6 +330,44 @@ xmlNodeChildTotal(XmlNode *this, const String *name)
     FUNCTION_TEST_RETURN(result);
 }
 
+/***********************************************************************************************************************************
+Add a child node
+***********************************************************************************************************************************/
+XmlNode *
+xmlNodeAdd(XmlNode *this, const String *name)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(XML_NODE, this);
+        FUNCTION_TEST_PARAM(STRING, name);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(name != NULL);
+
+    FUNCTION_TEST_RETURN(xmlNodeNew(xmlNewChild(this->node, NULL, (unsigned char *)strPtr(name), NULL)));
+}
+
+/***********************************************************************************************************************************
+Set node content
+
+The content is added as a text node so special characters are escaped when the document is rendered.
+***********************************************************************************************************************************/
+void
+xmlNodeContentSet(XmlNode *this, const String *content)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(XML_NODE, this);
+        FUNCTION_TEST_PARAM(STRING, content);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(content != NULL);
+
+    xmlAddChild(this->node, xmlNewText((unsigned char *)strPtr(content)));
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Free node
 ***********************************************************************************************************************************/
@@ -306,6 +384,43 @@ xmlNodeFree(XmlNode *this)
     FUNCTION_TEST_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Create an empty document with the specified root node
+***********************************************************************************************************************************/
+XmlDocument *
+xmlDocumentNew(const String *rootName)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, rootName);
+    FUNCTION_TEST_END();
+
+    ASSERT(rootName != NULL);
+
+    // Initialize xml if it is not already initialized
+    xmlInitLib();
+
+    // Create object
+    XmlDocument *this = NULL;
+
+    MEM_CONTEXT_NEW_BEGIN("XmlDocument")
+    {
+        this = memNew(sizeof(XmlDocument));
+        this->memContext = MEM_CONTEXT_NEW();
+
+        this->xml = xmlNewDoc((unsigned char *)"1.0");
+
+        // Set callback to ensure xml document is freed
+        memContextCallback(this->memContext, (MemContextCallback)xmlDocumentFree, this);
+
+        // Create the root node
+        this->root = xmlNodeNew(xmlNewNode(NULL, (unsigned char *)strPtr(rootName)));
+        xmlDocSetRootElement(this->xml, this->root->node);
+    }
+    MEM_CONTEXT_NEW_END();
+
+    FUNCTION_TEST_RETURN(this);
+}
+
 /***********************************************************************************************************************************
 Create document from C buffer
 ***********************************************************************************************************************************/
@@ -321,18 +436,7 @@ xmlDocumentNewC(const unsigned char *buffer, size_t bufferSize)
     ASSERT(bufferSize > 0);
 
     // Initialize xml if it is not already initialized
-    static bool xmlInit = false;
-
-    if (!xmlInit)
-    {
-        LIBXML_TEST_VERSION;
-
-        // It's a pretty weird that we can't just pass a handler function but instead have to assign it to a var...
-        static xmlGenericErrorFunc xmlErrorHandlerFunc = xmlErrorHandler;
-        initGenericErrorDefaultFunc(&xmlErrorHandlerFunc);
-
-        xmlInit = true;
-    }
+    xmlInitLib();
 
     // Create object
     XmlDocument *this = NULL;
@@ -388,6 +492,28 @@ xmlDocumentNewZ(const char *string)
     FUNCTION_TEST_RETURN(xmlDocumentNewC((const unsigned char *)string, strlen(string)));
 }
 
+/***********************************************************************************************************************************
+Render the document to a buffer
+***********************************************************************************************************************************/
+Buffer *
+xmlDocumentBuf(const XmlDocument *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(XML_DOCUMENT, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    xmlChar *xml;
+    int xmlSize;
+
+    xmlDocDumpMemoryEnc(this->xml, &xml, &xmlSize, "UTF-8");
+    Buffer *result = bufNewC((size_t)xmlSize, xml);
+    xmlFree(xml);
+
+    FUNCTION_TEST_RETURN(result);
+}
+
 /***********************************************************************************************************************************
 Get the root node
 ***********************************************************************************************************************************/
@@ -423,3 +549,208 @@ xmlDocumentFree(XmlDocument *this)
 
     FUNCTION_TEST_RETURN_VOID();
 }
+
+/***********************************************************************************************************************************
+Read callback for the libxml2 reader
+
+Errors cannot be thrown through libxml2 so they are stored and rethrown by xmlReaderNext() after libxml2 returns.
+***********************************************************************************************************************************/
+static int
+xmlReaderRead(void *context, char *buffer, int bufferSize)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, context);
+        FUNCTION_TEST_PARAM_P(CHARDATA, buffer);
+        FUNCTION_TEST_PARAM(INT, bufferSize);
+    FUNCTION_TEST_END();
+
+    ASSERT(context != NULL);
+    ASSERT(buffer != NULL);
+    ASSERT(bufferSize > 0);
+
+    XmlReader *this = context;
+    volatile int result = 0;
+
+    TRY_BEGIN()
+    {
+        if (!ioReadEof(this->read))
+        {
+            // Limit the read to the size requested by libxml2
+            bufUsedZero(this->buffer);
+
+            if (bufSize(this->buffer) > (size_t)bufferSize)
+                bufLimitSet(this->buffer, (size_t)bufferSize);
+
+            ioRead(this->read, this->buffer);
+            bufLimitClear(this->buffer);
+
+            memcpy(buffer, bufPtr(this->buffer), bufUsed(this->buffer));
+            result = (int)bufUsed(this->buffer);
+        }
+    }
+    CATCH_ANY()
+    {
+        MEM_CONTEXT_BEGIN(this->memContext)
+        {
+            this->errorType = errorType();
+            this->errorMessage = strNew(errorMessage());
+        }
+        MEM_CONTEXT_END();
+
+        result = -1;
+    }
+    TRY_END();
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Create a reader on an IoRead
+
+The IoRead must already be open.  libxml2 reads the source to eof before reporting the end of the document so the source is fully
+consumed once xmlReaderNext() returns false.
+***********************************************************************************************************************************/
+XmlReader *
+xmlReaderNew(IoRead *read)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_READ, read);
+    FUNCTION_TEST_END();
+
+    ASSERT(read != NULL);
+
+    // Initialize xml if it is not already initialized
+    xmlInitLib();
+
+    // Create object
+    XmlReader *this = NULL;
+
+    MEM_CONTEXT_NEW_BEGIN("XmlReader")
+    {
+        this = memNew(sizeof(XmlReader));
+        this->memContext = MEM_CONTEXT_NEW();
+        this->read = read;
+        this->buffer = bufNew(ioBufferSize());
+
+        this->reader = xmlReaderForIO(xmlReaderRead, NULL, this, "noname.xml", NULL, 0);
+
+        if (this->reader == NULL)                                                               // {uncoverable - no failure case}
+            THROW(MemoryError, "unable to create xml reader");                                  // {+uncoverable}
+
+        // Set callback to ensure the reader is freed
+        memContextCallback(this->memContext, (MemContextCallback)xmlReaderFree, this);
+    }
+    MEM_CONTEXT_NEW_END();
+
+    FUNCTION_TEST_RETURN(this);
+}
+
+/***********************************************************************************************************************************
+Move to the next element
+
+Only element start nodes are returned.  Text, comments, and end elements are skipped.  Returns false when the document is complete.
+***********************************************************************************************************************************/
+bool
+xmlReaderNext(XmlReader *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(XML_READER, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    bool result = false;
+    int status;
+
+    while ((status = xmlTextReaderRead(this->reader)) == 1)
+    {
+        if (xmlTextReaderNodeType(this->reader) == XML_READER_TYPE_ELEMENT)
+        {
+            result = true;
+            break;
+        }
+    }
+
+    // Rethrow an error from the source or report invalid xml
+    if (status == -1)
+    {
+        if (this->errorType != NULL)
+            THROWP(this->errorType, strPtr(this->errorMessage));
+
+        THROW(FormatError, "invalid xml");
+    }
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Get the text content of the current element
+***********************************************************************************************************************************/
+String *
+xmlReaderContent(XmlReader *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(XML_READER, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    xmlChar *content = xmlTextReaderReadString(this->reader);
+    String *result = strNew(content == NULL ? "" : (char *)content);
+    xmlFree(content);
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Get the depth of the current element (the root element is zero)
+***********************************************************************************************************************************/
+unsigned int
+xmlReaderDepth(const XmlReader *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(XML_READER, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN((unsigned int)xmlTextReaderDepth(this->reader));
+}
+
+/***********************************************************************************************************************************
+Does the name of the current element match?  This does not allocate memory so is suitable for tight loops.
+***********************************************************************************************************************************/
+bool
+xmlReaderNameEq(const XmlReader *this, const String *name)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(XML_READER, this);
+        FUNCTION_TEST_PARAM(STRING, name);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(name != NULL);
+
+    FUNCTION_TEST_RETURN(strEqZ(name, (const char *)xmlTextReaderConstLocalName(this->reader)));
+}
+
+/***********************************************************************************************************************************
+Free reader
+***********************************************************************************************************************************/
+void
+xmlReaderFree(XmlReader *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(XML_READER, this);
+    FUNCTION_TEST_END();
+
+    if (this != NULL)
+    {
+        xmlFreeTextReader(this->reader);
+
+        memContextCallbackClear(this->memContext);
+        memContextFree(this->memContext);
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
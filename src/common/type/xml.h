@@ -4,6 +4,10 @@ Xml Handler
 A thin wrapper around the libxml2 library.
 
 There are many capabilities of libxml2 that are not exposed here and may need to be added to when implementing new features.
+
+XmlDocument loads the entire document into a tree which is convenient for small documents that are accessed randomly.  XmlReader is
+a pull parser that reads elements in document order directly from an IoRead without building a tree, so it should be used for large
+documents (e.g. S3 list responses) where only a few elements per record are needed.
 ***********************************************************************************************************************************/
 #ifndef COMMON_TYPE_XML_H
 #define COMMON_TYPE_XML_H
@@ -14,13 +18,16 @@ Objects
 typedef struct XmlDocument XmlDocument;
 typedef struct XmlNode XmlNode;
 typedef struct XmlNodeList XmlNodeList;
+typedef struct XmlReader XmlReader;
 
+#include "common/io/read.h"
 #include "common/memContext.h"
 #include "common/type/string.h"
 
 /***********************************************************************************************************************************
 Document Contructors
 ***********************************************************************************************************************************/
+XmlDocument *xmlDocumentNew(const String *rootName);
 XmlDocument *xmlDocumentNewBuf(const Buffer *);
 XmlDocument *xmlDocumentNewC(const unsigned char *buffer, size_t bufferSize);
 XmlDocument *xmlDocumentNewZ(const char *string);
@@ -28,6 +35,7 @@ XmlDocument *xmlDocumentNewZ(const char *string);
 /***********************************************************************************************************************************
 Document Getters
 ***********************************************************************************************************************************/
+Buffer *xmlDocumentBuf(const XmlDocument *this);
 XmlNode *xmlDocumentRoot(const XmlDocument *this);
 
 /***********************************************************************************************************************************
@@ -35,6 +43,11 @@ Document Destructor
 ***********************************************************************************************************************************/
 void xmlDocumentFree(XmlDocument *this);
 
+/***********************************************************************************************************************************
+Node Functions
+***********************************************************************************************************************************/
+XmlNode *xmlNodeAdd(XmlNode *this, const String *name);
+
 /***********************************************************************************************************************************
 Node Getters
 ***********************************************************************************************************************************/
@@ -45,6 +58,11 @@ XmlNode *xmlNodeChildN(XmlNode *this, const String *name, unsigned int index, bo
 unsigned int xmlNodeChildTotal(XmlNode *this, const String *name);
 String *xmlNodeContent(XmlNode *this);
 
+/***********************************************************************************************************************************
+Node Setters
+***********************************************************************************************************************************/
+void xmlNodeContentSet(XmlNode *this, const String *content);
+
 /***********************************************************************************************************************************
 Node Destructor
 ***********************************************************************************************************************************/
@@ -61,6 +79,28 @@ Node List Destructor
 ***********************************************************************************************************************************/
 void xmlNodeLstFree(XmlNodeList *this);
 
+/***********************************************************************************************************************************
+Reader Constructor
+***********************************************************************************************************************************/
+XmlReader *xmlReaderNew(IoRead *read);
+
+/***********************************************************************************************************************************
+Reader Functions
+***********************************************************************************************************************************/
+bool xmlReaderNext(XmlReader *this);
+
+/***********************************************************************************************************************************
+Reader Getters
+***********************************************************************************************************************************/
+String *xmlReaderContent(XmlReader *this);
+unsigned int xmlReaderDepth(const XmlReader *this);
+bool xmlReaderNameEq(const XmlReader *this, const String *name);
+
+/***********************************************************************************************************************************
+Reader Destructor
+***********************************************************************************************************************************/
+void xmlReaderFree(XmlReader *this);
+
 /***********************************************************************************************************************************
 Macros for function logging
 ***********************************************************************************************************************************/
@@ -79,4 +119,9 @@ Macros for function logging
 #define FUNCTION_LOG_XML_NODE_LIST_FORMAT(value, buffer, bufferSize)                                                               \
     objToLog(value, "XmlNodeList", buffer, bufferSize)
 
+#define FUNCTION_LOG_XML_READER_TYPE                                                                                               \
+    XmlReader *
+#define FUNCTION_LOG_XML_READER_FORMAT(value, buffer, bufferSize)                                                                  \
+    objToLog(value, "XmlReader", buffer, bufferSize)
+
 #endif
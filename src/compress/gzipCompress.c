@@ -94,39 +94,44 @@ gzipCompressProcess(GzipCompress *this, const Buffer *uncompressed, Buffer *comp
     ASSERT(!this->flush || uncompressed == NULL);
     ASSERT(this->flush || (!this->inputSame || this->stream->avail_in != 0));
 
-    // Flushing
-    if (uncompressed == NULL)
+    // Empty input can happen when reading at eof.  There is nothing to compress and deflate() would error since no progress can be
+    // made.
+    if (uncompressed == NULL || bufUsed(uncompressed) > 0)
     {
-        this->stream->avail_in = 0;
-        this->flush = true;
-    }
-    // More input
-    else
-    {
-        // Is new input allowed?
-        if (!this->inputSame)
+        // Flushing
+        if (uncompressed == NULL)
         {
-            this->stream->avail_in = (unsigned int)bufUsed(uncompressed);
-            this->stream->next_in = bufPtr(uncompressed);
+            this->stream->avail_in = 0;
+            this->flush = true;
+        }
+        // More input
+        else
+        {
+            // Is new input allowed?
+            if (!this->inputSame)
+            {
+                this->stream->avail_in = (unsigned int)bufUsed(uncompressed);
+                this->stream->next_in = bufPtr(uncompressed);
+            }
         }
-    }
 
-    // Initialize compressed output buffer
-    this->stream->avail_out = (unsigned int)bufRemains(compressed);
-    this->stream->next_out = bufPtr(compressed) + bufUsed(compressed);
+        // Initialize compressed output buffer
+        this->stream->avail_out = (unsigned int)bufRemains(compressed);
+        this->stream->next_out = bufPtr(compressed) + bufUsed(compressed);
 
-    // Perform compression
-    gzipError(deflate(this->stream, this->flush ? Z_FINISH : Z_NO_FLUSH));
+        // Perform compression
+        gzipError(deflate(this->stream, this->flush ? Z_FINISH : Z_NO_FLUSH));
 
-    // Set buffer used space
-    bufUsedSet(compressed, bufSize(compressed) - (size_t)this->stream->avail_out);
+        // Set buffer used space
+        bufUsedSet(compressed, bufSize(compressed) - (size_t)this->stream->avail_out);
 
-    // Is compression done?
-    if (this->flush && this->stream->avail_out > 0)
-        this->done = true;
+        // Is compression done?
+        if (this->flush && this->stream->avail_out > 0)
+            this->done = true;
 
-    // Can more input be provided on the next call?
-    this->inputSame = this->flush ? !this->done : this->stream->avail_in != 0;
+        // Can more input be provided on the next call?
+        this->inputSame = this->flush ? !this->done : this->stream->avail_in != 0;
+    }
 
     FUNCTION_LOG_RETURN_VOID();
 }
@@ -55,7 +55,7 @@ cfgExecParam(ConfigCommand commandId, const KeyValue *optionReplace)
             if (value == NULL && cfgOptionValid(optionId))
             {
                 if (cfgOptionNegate(optionId))
-                    value = varNewBool(false);
+                    value = BOOL_FALSE_VAR;
                 else if (cfgOptionSource(optionId) != cfgSourceDefault)
                     value = cfgOption(optionId);
             }
@@ -79,7 +79,7 @@ cfgLoadUpdateOption(void)
     {
         // If protocol-timeout is default then increase it to be greater than db-timeout
         if (cfgOptionSource(cfgOptProtocolTimeout) == cfgSourceDefault)
-            cfgOptionSet(cfgOptProtocolTimeout, cfgSourceDefault, varNewDbl(cfgOptionDbl(cfgOptDbTimeout) + 30));
+            cfgOptionSet(cfgOptProtocolTimeout, cfgSourceDefault, VARDBL(cfgOptionDbl(cfgOptDbTimeout) + 30));
         else if (cfgOptionSource(cfgOptDbTimeout) == cfgSourceDefault)
         {
             double dbTimeout = cfgOptionDbl(cfgOptProtocolTimeout) - 30;
@@ -87,11 +87,11 @@ cfgLoadUpdateOption(void)
             // Normally the protocol time will be greater than 45 seconds so db timeout can be at least 15 seconds
             if (dbTimeout >= 15)
             {
-                cfgOptionSet(cfgOptDbTimeout, cfgSourceDefault, varNewDbl(dbTimeout));
+                cfgOptionSet(cfgOptDbTimeout, cfgSourceDefault, VARDBL(dbTimeout));
             }
             // But in some test cases the protocol timeout will be very small so make db timeout half of protocol timeout
             else
-                cfgOptionSet(cfgOptDbTimeout, cfgSourceDefault, varNewDbl(cfgOptionDbl(cfgOptProtocolTimeout) / 2));
+                cfgOptionSet(cfgOptDbTimeout, cfgSourceDefault, VARDBL(cfgOptionDbl(cfgOptProtocolTimeout) / 2));
         }
         else
         {
@@ -219,7 +219,7 @@ void
 cfgLoadLogFile(const String *logFile)
 {
     if (!logFileSet(strPtr(logFile)))
-        cfgOptionSet(cfgOptLogLevelFile, cfgSourceParam, varNewStrZ("off"));
+        cfgOptionSet(cfgOptLogLevelFile, cfgSourceParam, VARSTRDEF("off"));
 }
 
 /***********************************************************************************************************************************
@@ -672,7 +672,7 @@ configParse(unsigned int argListSize, const char *argList[], bool resetLogLevel)
                 for (unsigned int sectionIdx = 0; sectionIdx < strLstSize(sectionList); sectionIdx++)
                 {
                     String *section = strLstGet(sectionList, sectionIdx);
-                    StringList *keyList = iniSectionKeyList(config, section);
+                    const StringList *keyList = iniSectionKeyList(config, section);
                     KeyValue *optionFound = kvNew();
 
                     // Loop through keys to search for options
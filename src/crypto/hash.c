@@ -17,8 +17,7 @@ Cryptographic Hash
 /***********************************************************************************************************************************
 Filter type constant
 ***********************************************************************************************************************************/
-#define CRYPTO_HASH_FILTER_TYPE                                     "hash"
-    STRING_STATIC(CRYPTO_HASH_FILTER_TYPE_STR,                      CRYPTO_HASH_FILTER_TYPE);
+STRING_EXTERN(CRYPTO_HASH_FILTER_TYPE_STR,                          CRYPTO_HASH_FILTER_TYPE);
 
 /***********************************************************************************************************************************
 Hash types
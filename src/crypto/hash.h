@@ -14,6 +14,12 @@ typedef struct CryptoHash CryptoHash;
 #include "common/io/filter/filter.h"
 #include "common/type/string.h"
 
+/***********************************************************************************************************************************
+Filter type constant
+***********************************************************************************************************************************/
+#define CRYPTO_HASH_FILTER_TYPE                                     "hash"
+    STRING_DECLARE(CRYPTO_HASH_FILTER_TYPE_STR);
+
 /***********************************************************************************************************************************
 Hash types
 ***********************************************************************************************************************************/
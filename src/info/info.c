@@ -40,78 +40,89 @@ struct Info
 };
 
 /***********************************************************************************************************************************
-Return a hash of the contents of the info file
+Data used to hash the contents of the info file while it is loaded
 ***********************************************************************************************************************************/
-static CryptoHash *
-infoHash(const Ini *ini)
+typedef struct InfoLoadData
+{
+    MemContext *memContext;                                         // Mem context for the section
+    CryptoHash *hash;                                               // Hash of the contents in canonical JSON form
+    String *section;                                                // Current section
+    unsigned int keyTotal;                                          // Keys hashed in the current section
+    InfoLoadCallback *callback;                                     // Caller callback for each key/value
+    void *callbackData;                                             // Caller callback data
+} InfoLoadData;
+
+/***********************************************************************************************************************************
+Hash each key/value as it is loaded
+
+The hash is computed on the JSON form of the file, i.e. {"section":{"key":value,...},...}, excluding the checksum itself.  Values
+are already stored as JSON in the file so they are hashed as is.  The caller callback, if any, decides whether the key/value is
+stored.
+***********************************************************************************************************************************/
+static bool
+infoLoadCallback(void *data, const String *section, const String *key, const String *value)
 {
     FUNCTION_TEST_BEGIN();
-        FUNCTION_TEST_PARAM(INI, ini);
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(STRING, section);
+        FUNCTION_TEST_PARAM(STRING, key);
+        FUNCTION_TEST_PARAM(STRING, value);
     FUNCTION_TEST_END();
 
-    ASSERT(ini != NULL);
+    ASSERT(data != NULL);
+    ASSERT(section != NULL);
+    ASSERT(key != NULL);
+    ASSERT(value != NULL);
 
-    CryptoHash *result = cryptoHashNew(HASH_TYPE_SHA1_STR);
+    InfoLoadData *loadData = (InfoLoadData *)data;
 
-    MEM_CONTEXT_TEMP_BEGIN()
+    // Start a new section when the section changes
+    if (loadData->section == NULL || !strEq(section, loadData->section))
     {
-        StringList *sectionList = iniSectionList(ini);
+        // Close the prior section and add a comma before additional sections
+        if (loadData->section != NULL)
+            cryptoHashProcessC(loadData->hash, (const unsigned char *)"},", 2);
 
-        // Initial JSON opening bracket
-        cryptoHashProcessC(result, (const unsigned char *)"{", 1);
+        // Create the section header
+        cryptoHashProcessC(loadData->hash, (const unsigned char *)"\"", 1);
+        cryptoHashProcessStr(loadData->hash, section);
+        cryptoHashProcessC(loadData->hash, (const unsigned char *)"\":{", 3);
 
-        // Loop through sections and create hash for checking checksum
-        for (unsigned int sectionIdx = 0; sectionIdx < strLstSize(sectionList); sectionIdx++)
+        MEM_CONTEXT_BEGIN(loadData->memContext)
         {
-            String *section = strLstGet(sectionList, sectionIdx);
-
-            // Add a comma before additional sections
-            if (sectionIdx != 0)
-                cryptoHashProcessC(result, (const unsigned char *)",", 1);
-
-            // Create the section header
-            cryptoHashProcessC(result, (const unsigned char *)"\"", 1);
-            cryptoHashProcessStr(result, section);
-            cryptoHashProcessC(result, (const unsigned char *)"\":{", 3);
+            strFree(loadData->section);
+            loadData->section = strDup(section);
+        }
+        MEM_CONTEXT_END();
 
-            StringList *keyList = iniSectionKeyList(ini, section);
-            unsigned int keyListSize = strLstSize(keyList);
+        loadData->keyTotal = 0;
+    }
 
-            // Loop through values and build the section
-            for (unsigned int keyIdx = 0; keyIdx < keyListSize; keyIdx++)
-            {
-                String *key = strLstGet(keyList, keyIdx);
-
-                // Skip the backrest checksum in the file
-                if ((strEq(section, INFO_SECTION_BACKREST_STR) && !strEq(key, INFO_KEY_CHECKSUM_STR)) ||
-                    !strEq(section, INFO_SECTION_BACKREST_STR))
-                {
-                    cryptoHashProcessC(result, (const unsigned char *)"\"", 1);
-                    cryptoHashProcessStr(result, key);
-                    cryptoHashProcessC(result, (const unsigned char *)"\":", 2);
-                    cryptoHashProcessStr(result, varStr(iniGet(ini, section, strLstGet(keyList, keyIdx))));
-                    if ((keyListSize > 1) && (keyIdx < keyListSize - 1))
-                        cryptoHashProcessC(result, (const unsigned char *)",", 1);
-                }
-            }
+    // Skip the backrest checksum in the file
+    if (!strEq(section, INFO_SECTION_BACKREST_STR) || !strEq(key, INFO_KEY_CHECKSUM_STR))
+    {
+        // Add a comma before additional keys
+        if (loadData->keyTotal > 0)
+            cryptoHashProcessC(loadData->hash, (const unsigned char *)",", 1);
 
-            // Close the key/value list
-            cryptoHashProcessC(result, (const unsigned char *)"}", 1);
-        }
+        cryptoHashProcessC(loadData->hash, (const unsigned char *)"\"", 1);
+        cryptoHashProcessStr(loadData->hash, key);
+        cryptoHashProcessC(loadData->hash, (const unsigned char *)"\":", 2);
+        cryptoHashProcessStr(loadData->hash, value);
 
-        // JSON closing bracket
-        cryptoHashProcessC(result, (const unsigned char *)"}", 1);
+        loadData->keyTotal++;
     }
-    MEM_CONTEXT_TEMP_END();
 
-    FUNCTION_TEST_RETURN(result);
+    FUNCTION_TEST_RETURN(loadData->callback == NULL ? true : loadData->callback(loadData->callbackData, section, key, value));
 }
 
 /***********************************************************************************************************************************
 Load and validate the info file (or copy)
 ***********************************************************************************************************************************/
 static bool
-infoLoad(Info *this, const Storage *storage, bool copyFile, CipherType cipherType, const String *cipherPass)
+infoLoad(
+    Info *this, const Storage *storage, bool copyFile, CipherType cipherType, const String *cipherPass, InfoLoadCallback *callback,
+    void *callbackData)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace)
         FUNCTION_LOG_PARAM(INFO, this);
@@ -119,6 +130,8 @@ infoLoad(Info *this, const Storage *storage, bool copyFile, CipherType cipherTyp
         FUNCTION_LOG_PARAM(BOOL, copyFile);                       // Is this the copy file?
         FUNCTION_LOG_PARAM(ENUM, cipherType);
         // cipherPass omitted for security
+        FUNCTION_LOG_PARAM(FUNCTIONP, callback);
+        FUNCTION_LOG_PARAM_P(VOID, callbackData);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -141,12 +154,26 @@ infoLoad(Info *this, const Storage *storage, bool copyFile, CipherType cipherTyp
                     NULL))));
         }
 
-        // Load and parse the info file
-        Buffer *buffer = NULL;
+        // Load and parse the info file, hashing the contents in the same pass
+        InfoLoadData loadData =
+        {
+            .memContext = MEM_CONTEXT_TEMP(),
+            .hash = cryptoHashNew(HASH_TYPE_SHA1_STR),
+            .callback = callback,
+            .callbackData = callbackData,
+        };
+
+        // Let the caller discard values consumed during a prior attempt
+        if (callback != NULL)
+            callback(callbackData, NULL, NULL, NULL);
+
+        cryptoHashProcessC(loadData.hash, (const unsigned char *)"{", 1);
 
         TRY_BEGIN()
         {
-            buffer = storageGetNP(infoRead);
+            ioReadOpen(storageFileReadIo(infoRead));
+            iniLoad(this->ini, storageFileReadIo(infoRead), infoLoadCallback, &loadData);
+            ioReadClose(storageFileReadIo(infoRead));
         }
         CATCH(CryptoError)
         {
@@ -156,22 +183,24 @@ infoLoad(Info *this, const Storage *storage, bool copyFile, CipherType cipherTyp
         }
         TRY_END();
 
-        iniParse(this->ini, strNewBuf(buffer));
+        // Close the last section and the JSON
+        if (loadData.section != NULL)
+            cryptoHashProcessC(loadData.hash, (const unsigned char *)"}", 1);
 
-        // Make sure the ini is valid by testing the checksum
-        String *infoChecksum = varStr(iniGet(this->ini, INFO_SECTION_BACKREST_STR, INFO_KEY_CHECKSUM_STR));
+        cryptoHashProcessC(loadData.hash, (const unsigned char *)"}", 1);
 
-        CryptoHash *hash = infoHash(this->ini);
+        // Make sure the ini is valid by testing the checksum
+        const String *infoChecksum = varStr(iniGet(this->ini, INFO_SECTION_BACKREST_STR, INFO_KEY_CHECKSUM_STR));
 
         // ??? Temporary hack until get json parser: add quotes around hash before comparing
-        if (!strEq(infoChecksum, strQuoteZ(bufHex(cryptoHash(hash)), "\"")))
+        if (!strEq(infoChecksum, strQuoteZ(bufHex(cryptoHash(loadData.hash)), "\"")))
         {
             // Is the checksum present?
             bool checksumMissing = strSize(infoChecksum) < 3;
 
             THROW_FMT(
                 ChecksumError, "invalid checksum in '%s', expected '%s' but %s%s%s", strPtr(storagePathNP(storage, fileName)),
-                strPtr(bufHex(cryptoHash(hash))), checksumMissing ? "no checksum found" : "found '",
+                strPtr(bufHex(cryptoHash(loadData.hash))), checksumMissing ? "no checksum found" : "found '",
                 // ??? Temporary hack until get json parser: remove quotes around hash before displaying in messsage
                 checksumMissing ? "" : strPtr(strSubN(infoChecksum, 1, strSize(infoChecksum) - 2)),
                 checksumMissing ? "" : "'");
@@ -206,6 +235,26 @@ infoNew(const Storage *storage, const String *fileName, CipherType cipherType, c
         // cipherPass omitted for security
     FUNCTION_LOG_END();
 
+    FUNCTION_LOG_RETURN(INFO, infoNewLoad(storage, fileName, cipherType, cipherPass, NULL, NULL));
+}
+
+/***********************************************************************************************************************************
+Load an Info object and pass each key/value to a callback as it is loaded
+***********************************************************************************************************************************/
+Info *
+infoNewLoad(
+    const Storage *storage, const String *fileName, CipherType cipherType, const String *cipherPass, InfoLoadCallback *callback,
+    void *callbackData)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE, storage);
+        FUNCTION_LOG_PARAM(STRING, fileName);                     // Full path/filename to load
+        FUNCTION_LOG_PARAM(ENUM, cipherType);
+        // cipherPass omitted for security
+        FUNCTION_LOG_PARAM(FUNCTIONP, callback);
+        FUNCTION_LOG_PARAM_P(VOID, callbackData);
+    FUNCTION_LOG_END();
+
     ASSERT(fileName != NULL);
 
     Info *this = NULL;
@@ -222,7 +271,7 @@ infoNew(const Storage *storage, const String *fileName, CipherType cipherType, c
         // Attempt to load the primary file
         TRY_BEGIN()
         {
-            infoLoad(this, storage, false, cipherType, cipherPass);
+            infoLoad(this, storage, false, cipherType, cipherPass, callback, callbackData);
         }
         CATCH_ANY()
         {
@@ -233,7 +282,7 @@ infoNew(const Storage *storage, const String *fileName, CipherType cipherType, c
 
             TRY_BEGIN()
             {
-                infoLoad(this, storage, true, cipherType, cipherPass);
+                infoLoad(this, storage, true, cipherType, cipherPass, callback, callbackData);
             }
             CATCH_ANY()
             {
@@ -253,12 +302,11 @@ infoNew(const Storage *storage, const String *fileName, CipherType cipherType, c
         TRY_END();
 
         // Load the cipher passphrase if it exists
-        String *cipherPass = varStr(iniGetDefault(this->ini, INFO_SECTION_CIPHER_STR, INFO_KEY_CIPHER_PASS_STR, NULL));
+        const String *cipherPass = varStr(iniGetDefault(this->ini, INFO_SECTION_CIPHER_STR, INFO_KEY_CIPHER_PASS_STR, NULL));
 
         if (cipherPass != NULL)
         {
             this->cipherPass = strSubN(cipherPass, 1, strSize(cipherPass) - 2);
-            strFree(cipherPass);
         }
     }
     MEM_CONTEXT_NEW_END();
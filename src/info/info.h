@@ -22,10 +22,20 @@ Constants
 #define INFO_KEY_VERSION                                            "backrest-version"
     STRING_DECLARE(INFO_KEY_FORMAT_STR);
 
+/***********************************************************************************************************************************
+Callback for each key/value loaded by infoNewLoad().  Return true to store the key/value in the ini or false if the callback has
+consumed it.  Before each attempt to load the file (primary then copy) the callback is called with NULL section/key/value so values
+consumed during a failed attempt can be discarded.
+***********************************************************************************************************************************/
+typedef bool InfoLoadCallback(void *data, const String *section, const String *key, const String *value);
+
 /***********************************************************************************************************************************
 Constructor
 ***********************************************************************************************************************************/
 Info *infoNew(const Storage *storage, const String *fileName, CipherType cipherType, const String *cipherPass);
+Info *infoNewLoad(
+    const Storage *storage, const String *fileName, CipherType cipherType, const String *cipherPass, InfoLoadCallback *callback,
+    void *callbackData);
 
 /***********************************************************************************************************************************
 Getters
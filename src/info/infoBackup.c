@@ -101,35 +101,35 @@ infoBackupNew(const Storage *storage, const String *fileName, bool ignoreMissing
 
                 InfoBackupData infoBackupData =
                 {
-                    .backrestFormat = (unsigned int)varUInt64(kvGet(backupKv, varNewStr(INFO_KEY_FORMAT_STR))),
-                    .backrestVersion = varStrForce(kvGet(backupKv, varNewStr(INFO_KEY_VERSION_STR))),
-                    .backupInfoRepoSize = varUInt64(kvGet(backupKv, varNewStr(INFO_BACKUP_KEY_BACKUP_INFO_REPO_SIZE_STR))),
+                    .backrestFormat = (unsigned int)varUInt64(kvGetStr(backupKv, INFO_KEY_FORMAT_STR)),
+                    .backrestVersion = varStrForce(kvGetStr(backupKv, INFO_KEY_VERSION_STR)),
+                    .backupInfoRepoSize = varUInt64(kvGetStr(backupKv, INFO_BACKUP_KEY_BACKUP_INFO_REPO_SIZE_STR)),
                     .backupInfoRepoSizeDelta = varUInt64(
-                        kvGet(backupKv, varNewStr(INFO_BACKUP_KEY_BACKUP_INFO_REPO_SIZE_DELTA_STR))),
-                    .backupInfoSize = varUInt64(kvGet(backupKv, varNewStr(INFO_BACKUP_KEY_BACKUP_INFO_SIZE_STR))),
-                    .backupInfoSizeDelta = varUInt64(kvGet(backupKv, varNewStr(INFO_BACKUP_KEY_BACKUP_INFO_SIZE_DELTA_STR))),
+                        kvGetStr(backupKv, INFO_BACKUP_KEY_BACKUP_INFO_REPO_SIZE_DELTA_STR)),
+                    .backupInfoSize = varUInt64(kvGetStr(backupKv, INFO_BACKUP_KEY_BACKUP_INFO_SIZE_STR)),
+                    .backupInfoSizeDelta = varUInt64(kvGetStr(backupKv, INFO_BACKUP_KEY_BACKUP_INFO_SIZE_DELTA_STR)),
                     .backupLabel = strDup(backupLabelKey),
-                    .backupPgId = cvtZToUInt(strPtr(varStrForce(kvGet(backupKv, varNewStr(INFO_KEY_DB_ID_STR))))),
-                    .backupTimestampStart = varUInt64(kvGet(backupKv, varNewStr(INFO_MANIFEST_KEY_BACKUP_TIMESTAMP_START_STR))),
-                    .backupTimestampStop= varUInt64(kvGet(backupKv, varNewStr(INFO_MANIFEST_KEY_BACKUP_TIMESTAMP_STOP_STR))),
-                    .backupType = varStrForce(kvGet(backupKv, varNewStr(INFO_MANIFEST_KEY_BACKUP_TYPE_STR))),
+                    .backupPgId = cvtZToUInt(strPtr(varStrForce(kvGetStr(backupKv, INFO_KEY_DB_ID_STR)))),
+                    .backupTimestampStart = varUInt64(kvGetStr(backupKv, INFO_MANIFEST_KEY_BACKUP_TIMESTAMP_START_STR)),
+                    .backupTimestampStop= varUInt64(kvGetStr(backupKv, INFO_MANIFEST_KEY_BACKUP_TIMESTAMP_STOP_STR)),
+                    .backupType = varStrForce(kvGetStr(backupKv, INFO_MANIFEST_KEY_BACKUP_TYPE_STR)),
 
                     // Possible NULL values
-                    .backupArchiveStart = varStr(kvGet(backupKv, varNewStr(INFO_MANIFEST_KEY_BACKUP_ARCHIVE_START_STR))),
-                    .backupArchiveStop = varStr(kvGet(backupKv, varNewStr(INFO_MANIFEST_KEY_BACKUP_ARCHIVE_STOP_STR))),
-                    .backupPrior = varStr(kvGet(backupKv, varNewStr(INFO_MANIFEST_KEY_BACKUP_PRIOR_STR))),
-                    .backupReference = (kvGet(backupKv, varNewStr(INFO_BACKUP_KEY_BACKUP_REFERENCE_STR)) != NULL ?
-                        strLstNewVarLst(varVarLst(kvGet(backupKv, varNewStr(INFO_BACKUP_KEY_BACKUP_REFERENCE_STR)))) :
+                    .backupArchiveStart = varStr(kvGetStr(backupKv, INFO_MANIFEST_KEY_BACKUP_ARCHIVE_START_STR)),
+                    .backupArchiveStop = varStr(kvGetStr(backupKv, INFO_MANIFEST_KEY_BACKUP_ARCHIVE_STOP_STR)),
+                    .backupPrior = varStr(kvGetStr(backupKv, INFO_MANIFEST_KEY_BACKUP_PRIOR_STR)),
+                    .backupReference = (kvGetStr(backupKv, INFO_BACKUP_KEY_BACKUP_REFERENCE_STR) != NULL ?
+                        strLstNewVarLst(varVarLst(kvGetStr(backupKv, INFO_BACKUP_KEY_BACKUP_REFERENCE_STR))) :
                         NULL),
 
                     // Options
-                    .optionArchiveCheck = varBool(kvGet(backupKv, varNewStr(INFO_MANIFEST_KEY_OPT_ARCHIVE_CHECK_STR))),
-                    .optionArchiveCopy = varBool(kvGet(backupKv, varNewStr(INFO_MANIFEST_KEY_OPT_ARCHIVE_COPY_STR))),
-                    .optionBackupStandby = varBool(kvGet(backupKv, varNewStr(INFO_MANIFEST_KEY_OPT_BACKUP_STANDBY_STR))),
-                    .optionChecksumPage = varBool(kvGet(backupKv, varNewStr(INFO_MANIFEST_KEY_OPT_CHECKSUM_PAGE_STR))),
-                    .optionCompress = varBool(kvGet(backupKv, varNewStr(INFO_MANIFEST_KEY_OPT_COMPRESS_STR))),
-                    .optionHardlink = varBool(kvGet(backupKv, varNewStr(INFO_MANIFEST_KEY_OPT_HARDLINK_STR))),
-                    .optionOnline = varBool(kvGet(backupKv, varNewStr(INFO_MANIFEST_KEY_OPT_ONLINE_STR))),
+                    .optionArchiveCheck = varBool(kvGetStr(backupKv, INFO_MANIFEST_KEY_OPT_ARCHIVE_CHECK_STR)),
+                    .optionArchiveCopy = varBool(kvGetStr(backupKv, INFO_MANIFEST_KEY_OPT_ARCHIVE_COPY_STR)),
+                    .optionBackupStandby = varBool(kvGetStr(backupKv, INFO_MANIFEST_KEY_OPT_BACKUP_STANDBY_STR)),
+                    .optionChecksumPage = varBool(kvGetStr(backupKv, INFO_MANIFEST_KEY_OPT_CHECKSUM_PAGE_STR)),
+                    .optionCompress = varBool(kvGetStr(backupKv, INFO_MANIFEST_KEY_OPT_COMPRESS_STR)),
+                    .optionHardlink = varBool(kvGetStr(backupKv, INFO_MANIFEST_KEY_OPT_HARDLINK_STR)),
+                    .optionOnline = varBool(kvGetStr(backupKv, INFO_MANIFEST_KEY_OPT_ONLINE_STR)),
                 };
 
                 // Add the backup data to the list
@@ -1,7 +1,19 @@
 /***********************************************************************************************************************************
 Manifest Info Handler
 ***********************************************************************************************************************************/
+#include <inttypes.h>
+#include <limits.h>
+#include <string.h>
+
+#include "common/debug.h"
+#include "common/log.h"
+#include "common/memContext.h"
+#include "common/type/convert.h"
+#include "common/type/json.h"
+#include "common/type/keyValue.h"
+#include "common/type/list.h"
 #include "common/type/string.h"
+#include "info/info.h"
 #include "info/infoManifest.h"
 
 /***********************************************************************************************************************************
@@ -20,3 +32,832 @@ STRING_EXTERN(INFO_MANIFEST_KEY_OPT_CHECKSUM_PAGE_STR,              INFO_MANIFES
 STRING_EXTERN(INFO_MANIFEST_KEY_OPT_COMPRESS_STR,                   INFO_MANIFEST_KEY_OPT_COMPRESS);
 STRING_EXTERN(INFO_MANIFEST_KEY_OPT_HARDLINK_STR,                   INFO_MANIFEST_KEY_OPT_HARDLINK);
 STRING_EXTERN(INFO_MANIFEST_KEY_OPT_ONLINE_STR,                     INFO_MANIFEST_KEY_OPT_ONLINE);
+
+/***********************************************************************************************************************************
+Internal constants
+***********************************************************************************************************************************/
+STRING_STATIC(INFO_MANIFEST_SECTION_TARGET_FILE_STR,                "target:file");
+STRING_STATIC(INFO_MANIFEST_SECTION_TARGET_FILE_DEFAULT_STR,        "target:file:default");
+
+STRING_STATIC(INFO_MANIFEST_KEY_CHECKSUM_STR,                       "checksum");
+STRING_STATIC(INFO_MANIFEST_KEY_CHECKSUM_PAGE_STR,                  "checksum-page");
+STRING_STATIC(INFO_MANIFEST_KEY_CHECKSUM_PAGE_ERROR_STR,            "checksum-page-error");
+STRING_STATIC(INFO_MANIFEST_KEY_GROUP_STR,                          "group");
+STRING_STATIC(INFO_MANIFEST_KEY_MASTER_STR,                         "master");
+STRING_STATIC(INFO_MANIFEST_KEY_MODE_STR,                           "mode");
+STRING_STATIC(INFO_MANIFEST_KEY_REFERENCE_STR,                      "reference");
+STRING_STATIC(INFO_MANIFEST_KEY_SIZE_STR,                           "size");
+STRING_STATIC(INFO_MANIFEST_KEY_SIZE_REPO_STR,                      "repo-size");
+STRING_STATIC(INFO_MANIFEST_KEY_TIMESTAMP_STR,                      "timestamp");
+STRING_STATIC(INFO_MANIFEST_KEY_USER_STR,                           "user");
+
+// Initial number of files and leaf name bytes allocated -- both are doubled as needed
+#define INFO_MANIFEST_FILE_MIN                                      64
+#define INFO_MANIFEST_LEAF_POOL_MIN                                 1024
+
+// Dictionary index when there is no value and when the value should be set from the default section
+#define INFO_MANIFEST_DICT_NONE                                     UINT32_MAX
+#define INFO_MANIFEST_DICT_DEFAULT                                  (UINT32_MAX - 1)
+
+// File flags
+#define INFO_MANIFEST_FILE_FLAG_MASTER                              0x01
+#define INFO_MANIFEST_FILE_FLAG_MASTER_DEFAULT                      0x02
+#define INFO_MANIFEST_FILE_FLAG_MODE_DEFAULT                        0x04
+#define INFO_MANIFEST_FILE_FLAG_CHECKSUM                            0x08
+#define INFO_MANIFEST_FILE_FLAG_CHECKSUM_PAGE                       0x10
+#define INFO_MANIFEST_FILE_FLAG_CHECKSUM_PAGE_ERROR                 0x20
+
+/***********************************************************************************************************************************
+Dictionary of distinct values referenced by index
+***********************************************************************************************************************************/
+typedef struct InfoManifestDict
+{
+    StringList *list;                                               // Values in the order they were added
+    KeyValue *index;                                                // Index of each value in the list
+} InfoManifestDict;
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+struct InfoManifest
+{
+    MemContext *memContext;                                         // Context that contains the manifest
+    Info *info;                                                     // Base info object (all sections except files)
+
+    InfoManifestDict path;                                          // Parent paths of files (including trailing /)
+    InfoManifestDict user;                                          // Users
+    InfoManifestDict group;                                         // Groups
+    InfoManifestDict reference;                                     // References to prior backups
+
+    char *leafPool;                                                 // Leaf names of files (zero-terminated)
+    size_t leafPoolSize;                                            // Bytes used in the leaf pool
+    size_t leafPoolMax;                                             // Bytes allocated for the leaf pool
+
+    unsigned int fileTotal;                                         // Total files
+    unsigned int fileMax;                                           // Files allocated in each column
+    bool fileSorted;                                                // Were files loaded in name order?
+    unsigned int *fileSort;                                         // File indexes in name order (NULL if fileSorted)
+
+    uint32_t *filePath;                                             // Index of parent path in the path dictionary
+    uint32_t *fileLeaf;                                             // Offset of leaf name in the leaf pool
+    uint64_t *fileSize;                                             // Original size
+    uint64_t *fileSizeRepo;                                         // Size in the repo
+    int64_t *fileTimestamp;                                         // Modification time
+    uint16_t *fileMode;                                             // Mode
+    uint32_t *fileUser;                                             // Index of user in the user dictionary
+    uint32_t *fileGroup;                                            // Index of group in the group dictionary
+    uint32_t *fileReference;                                        // Index of reference in the reference dictionary
+    uint8_t *fileFlag;                                              // Flags (see INFO_MANIFEST_FILE_FLAG_*)
+    unsigned char *fileChecksum;                                    // Binary SHA1 checksums
+    KeyValue *fileChecksumPageError;                                // Page checksum error lists (sparse, keyed by file index)
+};
+
+/***********************************************************************************************************************************
+Create a dictionary in the current mem context
+***********************************************************************************************************************************/
+static InfoManifestDict
+infoManifestDictNew(void)
+{
+    FUNCTION_TEST_VOID();
+
+    InfoManifestDict result = {.list = strLstNew(), .index = kvNew()};
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Add a value to a dictionary (if it does not already exist) and return the index
+***********************************************************************************************************************************/
+static uint32_t
+infoManifestDictAdd(InfoManifestDict *this, const String *value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+        FUNCTION_TEST_PARAM(STRING, value);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(value != NULL);
+
+    const Variant *index = kvGetStr(this->index, value);
+    uint32_t result = 0;
+
+    if (index == NULL)
+    {
+        result = strLstSize(this->list);
+
+        strLstAdd(this->list, value);
+        kvPut(this->index, VARSTR(value), VARUINT64(result));
+    }
+    else
+        result = (uint32_t)varUInt64(index);
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Add a user/group to a dictionary and return the index.  A missing value means the default should be used and false means the id was
+not mapped to a name.
+***********************************************************************************************************************************/
+static uint32_t
+infoManifestDictAddOwner(InfoManifestDict *this, const Variant *value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+        FUNCTION_TEST_PARAM(VARIANT, value);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    uint32_t result = INFO_MANIFEST_DICT_DEFAULT;
+
+    if (value != NULL)
+        result = varType(value) == varTypeBool ? INFO_MANIFEST_DICT_NONE : infoManifestDictAdd(this, varStr(value));
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Get a value from a dictionary by index
+***********************************************************************************************************************************/
+static const String *
+infoManifestDictGet(const InfoManifestDict *this, uint32_t index)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+        FUNCTION_TEST_PARAM(UINT32, index);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(index != INFO_MANIFEST_DICT_DEFAULT);
+
+    FUNCTION_TEST_RETURN(index == INFO_MANIFEST_DICT_NONE ? NULL : strLstGet(this->list, index));
+}
+
+/***********************************************************************************************************************************
+Compare a file to a name without constructing the file name
+***********************************************************************************************************************************/
+static int
+infoManifestFileCmp(const InfoManifest *this, unsigned int fileIdx, const String *name)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INFO_MANIFEST, this);
+        FUNCTION_TEST_PARAM(UINT, fileIdx);
+        FUNCTION_TEST_PARAM(STRING, name);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(fileIdx < this->fileTotal);
+    ASSERT(name != NULL);
+
+    const String *path = strLstGet(this->path.list, this->filePath[fileIdx]);
+    size_t pathSize = strSize(path);
+    size_t nameSize = strSize(name);
+
+    // Compare the path to the beginning of the name, then the leaf to the remainder of the name
+    int result = memcmp(strPtr(path), strPtr(name), pathSize < nameSize ? pathSize : nameSize);
+
+    if (result == 0)
+        result = pathSize > nameSize ? 1 : strcmp(this->leafPool + this->fileLeaf[fileIdx], strPtr(name) + pathSize);
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Construct a file name in the current mem context
+***********************************************************************************************************************************/
+static String *
+infoManifestFileName(const InfoManifest *this, unsigned int fileIdx)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INFO_MANIFEST, this);
+        FUNCTION_TEST_PARAM(UINT, fileIdx);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(fileIdx < this->fileTotal);
+
+    FUNCTION_TEST_RETURN(
+        strNewFmt("%s%s", strPtr(strLstGet(this->path.list, this->filePath[fileIdx])), this->leafPool + this->fileLeaf[fileIdx]));
+}
+
+/***********************************************************************************************************************************
+Decode a hex SHA1 checksum to binary
+***********************************************************************************************************************************/
+static int
+infoManifestHexValue(char hex)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(CHAR, hex);
+    FUNCTION_TEST_END();
+
+    int result = -1;
+
+    if (hex >= '0' && hex <= '9')
+        result = hex - '0';
+    else if (hex >= 'a' && hex <= 'f')
+        result = hex - 'a' + 10;
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+static void
+infoManifestChecksumDecode(const String *checksum, const String *name, unsigned char *destination)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, checksum);
+        FUNCTION_TEST_PARAM(STRING, name);
+        FUNCTION_TEST_PARAM_P(UCHARDATA, destination);
+    FUNCTION_TEST_END();
+
+    ASSERT(checksum != NULL);
+    ASSERT(name != NULL);
+    ASSERT(destination != NULL);
+
+    bool valid = strSize(checksum) == INFO_MANIFEST_CHECKSUM_SIZE * 2;
+
+    for (unsigned int checksumIdx = 0; valid && checksumIdx < INFO_MANIFEST_CHECKSUM_SIZE; checksumIdx++)
+    {
+        int high = infoManifestHexValue(strPtr(checksum)[checksumIdx * 2]);
+        int low = infoManifestHexValue(strPtr(checksum)[checksumIdx * 2 + 1]);
+
+        valid = high != -1 && low != -1;
+        destination[checksumIdx] = (unsigned char)(high << 4 | low);
+    }
+
+    if (!valid)
+        THROW_FMT(FormatError, "invalid checksum '%s' for file '%s'", strPtr(checksum), strPtr(name));
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Grow file columns
+***********************************************************************************************************************************/
+static void
+infoManifestFileGrow(InfoManifest *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INFO_MANIFEST, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    this->fileMax *= 2;
+
+    MEM_CONTEXT_BEGIN(this->memContext)
+    {
+        this->filePath = memGrowRaw(this->filePath, sizeof(uint32_t) * this->fileMax);
+        this->fileLeaf = memGrowRaw(this->fileLeaf, sizeof(uint32_t) * this->fileMax);
+        this->fileSize = memGrowRaw(this->fileSize, sizeof(uint64_t) * this->fileMax);
+        this->fileSizeRepo = memGrowRaw(this->fileSizeRepo, sizeof(uint64_t) * this->fileMax);
+        this->fileTimestamp = memGrowRaw(this->fileTimestamp, sizeof(int64_t) * this->fileMax);
+        this->fileMode = memGrowRaw(this->fileMode, sizeof(uint16_t) * this->fileMax);
+        this->fileUser = memGrowRaw(this->fileUser, sizeof(uint32_t) * this->fileMax);
+        this->fileGroup = memGrowRaw(this->fileGroup, sizeof(uint32_t) * this->fileMax);
+        this->fileReference = memGrowRaw(this->fileReference, sizeof(uint32_t) * this->fileMax);
+        this->fileFlag = memGrowRaw(this->fileFlag, sizeof(uint8_t) * this->fileMax);
+        this->fileChecksum = memGrowRaw(this->fileChecksum, INFO_MANIFEST_CHECKSUM_SIZE * this->fileMax);
+    }
+    MEM_CONTEXT_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Get an integer attribute of a file.  The manifest is read from the repository so a missing or invalid attribute is a format error
+rather than an assertion.
+***********************************************************************************************************************************/
+static const Variant *
+infoManifestFileAttributeInt(const KeyValue *fileKv, const String *key, const String *name)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(KEY_VALUE, fileKv);
+        FUNCTION_TEST_PARAM(STRING, key);
+        FUNCTION_TEST_PARAM(STRING, name);
+    FUNCTION_TEST_END();
+
+    ASSERT(fileKv != NULL);
+    ASSERT(key != NULL);
+    ASSERT(name != NULL);
+
+    const Variant *result = kvGetStr(fileKv, key);
+
+    if (result == NULL)
+        THROW_FMT(FormatError, "missing '%s' for file '%s'", strPtr(key), strPtr(name));
+
+    if (varType(result) != varTypeUInt64 && varType(result) != varTypeInt64)
+        THROW_FMT(FormatError, "invalid '%s' for file '%s'", strPtr(key), strPtr(name));
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Add a file to the columns
+***********************************************************************************************************************************/
+static void
+infoManifestFileAdd(InfoManifest *this, const String *name, const String *value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INFO_MANIFEST, this);
+        FUNCTION_TEST_PARAM(STRING, name);
+        FUNCTION_TEST_PARAM(STRING, value);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(name != NULL);
+    ASSERT(value != NULL);
+
+    // Parse the attributes and check the required attributes before anything is stored so an invalid file is not partly added
+    const Variant *fileVar = jsonToVar(value);
+
+    if (varType(fileVar) != varTypeKeyValue)
+        THROW_FMT(FormatError, "invalid attributes for file '%s'", strPtr(name));
+
+    const KeyValue *fileKv = varKv(fileVar);
+    uint64_t size = varUInt64Force(infoManifestFileAttributeInt(fileKv, INFO_MANIFEST_KEY_SIZE_STR, name));
+    int64_t timestamp = varInt64Force(infoManifestFileAttributeInt(fileKv, INFO_MANIFEST_KEY_TIMESTAMP_STR, name));
+
+    if (this->fileTotal == this->fileMax)
+        infoManifestFileGrow(this);
+
+    // Files are written in name order so it only takes a compare with the prior file to know if they are still in order
+    if (this->fileSorted && this->fileTotal > 0 && infoManifestFileCmp(this, this->fileTotal - 1, name) >= 0)
+        this->fileSorted = false;
+
+    unsigned int fileIdx = this->fileTotal;
+
+    // Split the name into an interned parent path and a leaf stored in the pool
+    const char *leaf = strrchr(strPtr(name), '/');
+    size_t pathSize = leaf == NULL ? 0 : (size_t)(leaf - strPtr(name)) + 1;
+    size_t leafSize = strSize(name) - pathSize + 1;
+
+    this->filePath[fileIdx] = infoManifestDictAdd(&this->path, strNewN(strPtr(name), pathSize));
+
+    if (this->leafPoolSize + leafSize > this->leafPoolMax)
+    {
+        while (this->leafPoolSize + leafSize > this->leafPoolMax)
+            this->leafPoolMax *= 2;
+
+        MEM_CONTEXT_BEGIN(this->memContext)
+        {
+            this->leafPool = memGrowRaw(this->leafPool, this->leafPoolMax);
+        }
+        MEM_CONTEXT_END();
+    }
+
+    memcpy(this->leafPool + this->leafPoolSize, strPtr(name) + pathSize, leafSize);
+    this->fileLeaf[fileIdx] = (uint32_t)this->leafPoolSize;
+    this->leafPoolSize += leafSize;
+
+    // Store the attributes
+    const Variant *attribute = NULL;
+    uint8_t flag = 0;
+
+    this->fileSize[fileIdx] = size;
+    this->fileTimestamp[fileIdx] = timestamp;
+
+    // The repo size is only stored when it differs from the original size
+    attribute = kvGetStr(fileKv, INFO_MANIFEST_KEY_SIZE_REPO_STR);
+    this->fileSizeRepo[fileIdx] =
+        attribute == NULL ? size : varUInt64Force(infoManifestFileAttributeInt(fileKv, INFO_MANIFEST_KEY_SIZE_REPO_STR, name));
+
+    attribute = kvGetStr(fileKv, INFO_MANIFEST_KEY_REFERENCE_STR);
+    this->fileReference[fileIdx] =
+        attribute == NULL ? INFO_MANIFEST_DICT_NONE : infoManifestDictAdd(&this->reference, varStr(attribute));
+
+    this->fileUser[fileIdx] = infoManifestDictAddOwner(&this->user, kvGetStr(fileKv, INFO_MANIFEST_KEY_USER_STR));
+    this->fileGroup[fileIdx] = infoManifestDictAddOwner(&this->group, kvGetStr(fileKv, INFO_MANIFEST_KEY_GROUP_STR));
+
+    // Mode and master are set from the default section if they are not set for the file
+    attribute = kvGetStr(fileKv, INFO_MANIFEST_KEY_MODE_STR);
+
+    if (attribute == NULL)
+        flag |= INFO_MANIFEST_FILE_FLAG_MODE_DEFAULT;
+    else
+        this->fileMode[fileIdx] = (uint16_t)cvtZToUIntBase(strPtr(varStr(attribute)), 8);
+
+    attribute = kvGetStr(fileKv, INFO_MANIFEST_KEY_MASTER_STR);
+
+    if (attribute == NULL)
+        flag |= INFO_MANIFEST_FILE_FLAG_MASTER_DEFAULT;
+    else if (varBool(attribute))
+        flag |= INFO_MANIFEST_FILE_FLAG_MASTER;
+
+    // Checksums
+    attribute = kvGetStr(fileKv, INFO_MANIFEST_KEY_CHECKSUM_STR);
+
+    if (attribute != NULL)
+    {
+        infoManifestChecksumDecode(varStr(attribute), name, this->fileChecksum + fileIdx * INFO_MANIFEST_CHECKSUM_SIZE);
+        flag |= INFO_MANIFEST_FILE_FLAG_CHECKSUM;
+    }
+
+    attribute = kvGetStr(fileKv, INFO_MANIFEST_KEY_CHECKSUM_PAGE_STR);
+
+    if (attribute != NULL)
+    {
+        flag |= INFO_MANIFEST_FILE_FLAG_CHECKSUM_PAGE;
+
+        if (!varBool(attribute))
+        {
+            flag |= INFO_MANIFEST_FILE_FLAG_CHECKSUM_PAGE_ERROR;
+
+            // Error lists are rare so they are stored sparsely
+            attribute = kvGetStr(fileKv, INFO_MANIFEST_KEY_CHECKSUM_PAGE_ERROR_STR);
+
+            if (attribute != NULL)
+                kvPut(this->fileChecksumPageError, VARUINT64(fileIdx), attribute);
+        }
+    }
+
+    this->fileFlag[fileIdx] = flag;
+    this->fileTotal++;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Store files in columns as they are loaded rather than in the ini
+***********************************************************************************************************************************/
+static bool
+infoManifestLoadCallback(void *data, const String *section, const String *key, const String *value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(STRING, section);
+        FUNCTION_TEST_PARAM(STRING, key);
+        FUNCTION_TEST_PARAM(STRING, value);
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL);
+
+    InfoManifest *this = (InfoManifest *)data;
+    bool result = true;
+
+    // Discard files from a prior attempt to load.  Dictionaries are kept since unused values do no harm.
+    if (section == NULL)
+    {
+        this->fileTotal = 0;
+        this->fileSorted = true;
+        this->leafPoolSize = 0;
+
+        kvFree(this->fileChecksumPageError);
+
+        MEM_CONTEXT_BEGIN(this->memContext)
+        {
+            this->fileChecksumPageError = kvNew();
+        }
+        MEM_CONTEXT_END();
+    }
+    else if (strEq(section, INFO_MANIFEST_SECTION_TARGET_FILE_STR))
+    {
+        infoManifestFileAdd(this, key, value);
+        result = false;
+    }
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Get a value from the file default section (NULL if missing)
+***********************************************************************************************************************************/
+static const Variant *
+infoManifestFileDefault(const InfoManifest *this, const String *key)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INFO_MANIFEST, this);
+        FUNCTION_TEST_PARAM(STRING, key);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(key != NULL);
+
+    const Variant *result = iniGetDefault(infoIni(this->info), INFO_MANIFEST_SECTION_TARGET_FILE_DEFAULT_STR, key, NULL);
+
+    FUNCTION_TEST_RETURN(result == NULL ? NULL : jsonToVar(varStr(result)));
+}
+
+/***********************************************************************************************************************************
+Sort files by name when they were not loaded in name order
+***********************************************************************************************************************************/
+typedef struct InfoManifestSort
+{
+    String *name;                                                   // File name
+    unsigned int fileIdx;                                           // File index in the columns
+} InfoManifestSort;
+
+static int
+infoManifestSortComparator(const void *item1, const void *item2)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, item1);
+        FUNCTION_TEST_PARAM_P(VOID, item2);
+    FUNCTION_TEST_END();
+
+    ASSERT(item1 != NULL);
+    ASSERT(item2 != NULL);
+
+    FUNCTION_TEST_RETURN(strCmp(((const InfoManifestSort *)item1)->name, ((const InfoManifestSort *)item2)->name));
+}
+
+/***********************************************************************************************************************************
+Load a manifest
+***********************************************************************************************************************************/
+InfoManifest *
+infoManifestNew(const Storage *storage, const String *fileName, CipherType cipherType, const String *cipherPass)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE, storage);
+        FUNCTION_LOG_PARAM(STRING, fileName);
+        FUNCTION_LOG_PARAM(ENUM, cipherType);
+        // cipherPass omitted for security
+    FUNCTION_LOG_END();
+
+    ASSERT(fileName != NULL);
+
+    InfoManifest *this = NULL;
+
+    MEM_CONTEXT_NEW_BEGIN("infoManifest")
+    {
+        // Create object
+        this = memNew(sizeof(InfoManifest));
+        this->memContext = MEM_CONTEXT_NEW();
+
+        this->path = infoManifestDictNew();
+        this->user = infoManifestDictNew();
+        this->group = infoManifestDictNew();
+        this->reference = infoManifestDictNew();
+
+        this->leafPoolMax = INFO_MANIFEST_LEAF_POOL_MIN;
+        this->leafPool = memNewRaw(this->leafPoolMax);
+
+        this->fileMax = INFO_MANIFEST_FILE_MIN;
+        this->filePath = memNewRaw(sizeof(uint32_t) * this->fileMax);
+        this->fileLeaf = memNewRaw(sizeof(uint32_t) * this->fileMax);
+        this->fileSize = memNewRaw(sizeof(uint64_t) * this->fileMax);
+        this->fileSizeRepo = memNewRaw(sizeof(uint64_t) * this->fileMax);
+        this->fileTimestamp = memNewRaw(sizeof(int64_t) * this->fileMax);
+        this->fileMode = memNewRaw(sizeof(uint16_t) * this->fileMax);
+        this->fileUser = memNewRaw(sizeof(uint32_t) * this->fileMax);
+        this->fileGroup = memNewRaw(sizeof(uint32_t) * this->fileMax);
+        this->fileReference = memNewRaw(sizeof(uint32_t) * this->fileMax);
+        this->fileFlag = memNewRaw(sizeof(uint8_t) * this->fileMax);
+        this->fileChecksum = memNewRaw(INFO_MANIFEST_CHECKSUM_SIZE * this->fileMax);
+        this->fileChecksumPageError = kvNew();
+
+        // Load the manifest, storing files in the columns
+        this->info = infoNewLoad(storage, fileName, cipherType, cipherPass, infoManifestLoadCallback, this);
+
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            // Files appear before the default section so apply defaults now that it has been loaded
+            uint32_t userDefault = infoManifestDictAddOwner(
+                &this->user, infoManifestFileDefault(this, INFO_MANIFEST_KEY_USER_STR));
+            uint32_t groupDefault = infoManifestDictAddOwner(
+                &this->group, infoManifestFileDefault(this, INFO_MANIFEST_KEY_GROUP_STR));
+            const Variant *modeDefault = infoManifestFileDefault(this, INFO_MANIFEST_KEY_MODE_STR);
+            const Variant *masterDefault = infoManifestFileDefault(this, INFO_MANIFEST_KEY_MASTER_STR);
+
+            for (unsigned int fileIdx = 0; fileIdx < this->fileTotal; fileIdx++)
+            {
+                if (this->fileUser[fileIdx] == INFO_MANIFEST_DICT_DEFAULT)
+                    this->fileUser[fileIdx] = userDefault == INFO_MANIFEST_DICT_DEFAULT ? INFO_MANIFEST_DICT_NONE : userDefault;
+
+                if (this->fileGroup[fileIdx] == INFO_MANIFEST_DICT_DEFAULT)
+                    this->fileGroup[fileIdx] = groupDefault == INFO_MANIFEST_DICT_DEFAULT ? INFO_MANIFEST_DICT_NONE : groupDefault;
+
+                if (this->fileFlag[fileIdx] & INFO_MANIFEST_FILE_FLAG_MODE_DEFAULT)
+                {
+                    this->fileMode[fileIdx] = modeDefault == NULL ? 0 : (uint16_t)cvtZToUIntBase(strPtr(varStr(modeDefault)), 8);
+                    this->fileFlag[fileIdx] &= (uint8_t)~INFO_MANIFEST_FILE_FLAG_MODE_DEFAULT;
+                }
+
+                if (this->fileFlag[fileIdx] & INFO_MANIFEST_FILE_FLAG_MASTER_DEFAULT)
+                {
+                    if (masterDefault != NULL && varBool(masterDefault))
+                        this->fileFlag[fileIdx] |= INFO_MANIFEST_FILE_FLAG_MASTER;
+
+                    this->fileFlag[fileIdx] &= (uint8_t)~INFO_MANIFEST_FILE_FLAG_MASTER_DEFAULT;
+                }
+            }
+
+            // Build a sort index if the files were not loaded in name order so they can still be searched
+            if (!this->fileSorted)
+            {
+                List *sortList = lstNew(sizeof(InfoManifestSort));
+
+                for (unsigned int fileIdx = 0; fileIdx < this->fileTotal; fileIdx++)
+                {
+                    InfoManifestSort sort = {.name = infoManifestFileName(this, fileIdx), .fileIdx = fileIdx};
+                    lstAdd(sortList, &sort);
+                }
+
+                lstSort(sortList, infoManifestSortComparator);
+
+                MEM_CONTEXT_BEGIN(this->memContext)
+                {
+                    this->fileSort = memNewRaw(sizeof(unsigned int) * this->fileTotal);
+                }
+                MEM_CONTEXT_END();
+
+                for (unsigned int fileIdx = 0; fileIdx < this->fileTotal; fileIdx++)
+                    this->fileSort[fileIdx] = ((InfoManifestSort *)lstGet(sortList, fileIdx))->fileIdx;
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+    MEM_CONTEXT_NEW_END();
+
+    FUNCTION_LOG_RETURN(INFO_MANIFEST, this);
+}
+
+/***********************************************************************************************************************************
+Search for a file by name with a binary search.  Returns the index in name order or UINT_MAX if not found.
+***********************************************************************************************************************************/
+static unsigned int
+infoManifestFileSearch(const InfoManifest *this, const String *name)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INFO_MANIFEST, this);
+        FUNCTION_TEST_PARAM(STRING, name);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(name != NULL);
+
+    unsigned int result = UINT_MAX;
+    unsigned int low = 0;
+    unsigned int high = this->fileTotal;
+
+    while (low < high)
+    {
+        unsigned int middle = low + (high - low) / 2;
+        int compare = infoManifestFileCmp(this, this->fileSort == NULL ? middle : this->fileSort[middle], name);
+
+        if (compare == 0)
+        {
+            result = middle;
+            break;
+        }
+
+        if (compare < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Does a file exist in the manifest?
+***********************************************************************************************************************************/
+bool
+infoManifestFileExists(const InfoManifest *this, const String *name)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(INFO_MANIFEST, this);
+        FUNCTION_LOG_PARAM(STRING, name);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(name != NULL);
+
+    FUNCTION_LOG_RETURN(BOOL, infoManifestFileSearch(this, name) != UINT_MAX);
+}
+
+/***********************************************************************************************************************************
+Find a file by name.  It is an error if the file does not exist so infoManifestFileExists() should be called first if it may not.
+***********************************************************************************************************************************/
+InfoManifestFile
+infoManifestFileFind(const InfoManifest *this, const String *name)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(INFO_MANIFEST, this);
+        FUNCTION_LOG_PARAM(STRING, name);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(name != NULL);
+
+    unsigned int fileIdx = infoManifestFileSearch(this, name);
+
+    if (fileIdx == UINT_MAX)
+        THROW_FMT(AssertError, "unable to find '%s' in manifest file list", strPtr(name));
+
+    FUNCTION_LOG_RETURN(INFO_MANIFEST_FILE, infoManifestFile(this, fileIdx));
+}
+
+/***********************************************************************************************************************************
+Get a file by index in name order
+***********************************************************************************************************************************/
+InfoManifestFile
+infoManifestFile(const InfoManifest *this, unsigned int fileIdx)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(INFO_MANIFEST, this);
+        FUNCTION_LOG_PARAM(UINT, fileIdx);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(fileIdx < this->fileTotal);
+
+    // Get the index in the columns
+    unsigned int columnIdx = this->fileSort == NULL ? fileIdx : this->fileSort[fileIdx];
+    uint8_t flag = this->fileFlag[columnIdx];
+
+    InfoManifestFile result =
+    {
+        .name = infoManifestFileName(this, columnIdx),
+        .reference = infoManifestDictGet(&this->reference, this->fileReference[columnIdx]),
+        .size = this->fileSize[columnIdx],
+        .sizeRepo = this->fileSizeRepo[columnIdx],
+        .timestamp = (time_t)this->fileTimestamp[columnIdx],
+        .mode = this->fileMode[columnIdx],
+        .user = infoManifestDictGet(&this->user, this->fileUser[columnIdx]),
+        .group = infoManifestDictGet(&this->group, this->fileGroup[columnIdx]),
+        .master = flag & INFO_MANIFEST_FILE_FLAG_MASTER,
+        .checksumPage = flag & INFO_MANIFEST_FILE_FLAG_CHECKSUM_PAGE,
+        .checksumPageError = flag & INFO_MANIFEST_FILE_FLAG_CHECKSUM_PAGE_ERROR,
+    };
+
+    if (result.checksumPageError)
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            const Variant *errorList = kvGet(this->fileChecksumPageError, VARUINT64(columnIdx));
+
+            if (errorList != NULL)
+                result.checksumPageErrorList = varVarLst(errorList);
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    // Encode the checksum as hex
+    if (flag & INFO_MANIFEST_FILE_FLAG_CHECKSUM)
+    {
+        static const char hex[] = "0123456789abcdef";
+        const unsigned char *checksum = this->fileChecksum + columnIdx * INFO_MANIFEST_CHECKSUM_SIZE;
+
+        for (unsigned int checksumIdx = 0; checksumIdx < INFO_MANIFEST_CHECKSUM_SIZE; checksumIdx++)
+        {
+            result.checksumSha1[checksumIdx * 2] = hex[checksum[checksumIdx] >> 4];
+            result.checksumSha1[checksumIdx * 2 + 1] = hex[checksum[checksumIdx] & 0xF];
+        }
+    }
+
+    FUNCTION_LOG_RETURN(INFO_MANIFEST_FILE, result);
+}
+
+/***********************************************************************************************************************************
+Getters
+***********************************************************************************************************************************/
+unsigned int
+infoManifestFileTotal(const InfoManifest *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INFO_MANIFEST, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->fileTotal);
+}
+
+Ini *
+infoManifestIni(const InfoManifest *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INFO_MANIFEST, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(infoIni(this->info));
+}
+
+/***********************************************************************************************************************************
+Render as string for logging
+***********************************************************************************************************************************/
+String *
+infoManifestFileToLog(const InfoManifestFile *this)
+{
+    return strNewFmt("{name: %s, size: %" PRIu64 "}", strPtr(this->name), this->size);
+}
+
+/***********************************************************************************************************************************
+Free the object
+***********************************************************************************************************************************/
+void
+infoManifestFree(InfoManifest *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(INFO_MANIFEST, this);
+    FUNCTION_LOG_END();
+
+    if (this != NULL)
+        memContextFree(this->memContext);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
@@ -1,9 +1,34 @@
 /***********************************************************************************************************************************
 Manifest Info Handler
+
+Files make up nearly all of a manifest so they are not stored in the ini.  Instead each file is parsed as it is loaded and stored in
+columns, i.e. parallel arrays for size, timestamp, mode, checksum, etc.  Names are split into an interned parent path and a leaf
+name stored in a shared pool, and user, group, and reference are stored as indexes into dictionaries, so each file requires tens of
+bytes rather than the kilobytes required to store it as a key/value.  The remaining sections are small and are available from the
+ini.
 ***********************************************************************************************************************************/
 #ifndef INFO_INFOMANIFEST_H
 #define INFO_INFOMANIFEST_H
 
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef struct InfoManifest InfoManifest;
+
+#include <sys/types.h>
+#include <time.h>
+
+#include "common/ini.h"
+#include "common/type/string.h"
+#include "common/type/variantList.h"
+#include "crypto/crypto.h"
+#include "storage/storage.h"
+
+/***********************************************************************************************************************************
+Constants
+***********************************************************************************************************************************/
+#define INFO_MANIFEST_CHECKSUM_SIZE                                 20
+
 #define INFO_MANIFEST_KEY_BACKUP_ARCHIVE_START                      "backup-archive-start"
     STRING_DECLARE(INFO_MANIFEST_KEY_BACKUP_ARCHIVE_START_STR);
 #define INFO_MANIFEST_KEY_BACKUP_ARCHIVE_STOP                       "backup-archive-stop"
@@ -31,4 +56,61 @@ Manifest Info Handler
 #define INFO_MANIFEST_KEY_OPT_ONLINE                                "option-online"
     STRING_DECLARE(INFO_MANIFEST_KEY_OPT_ONLINE_STR);
 
+/***********************************************************************************************************************************
+Information about a file in the manifest
+***********************************************************************************************************************************/
+typedef struct InfoManifestFile
+{
+    String *name;                                                   // Name (allocated in the current mem context)
+    const String *reference;                                        // Backup where the file is stored (NULL if this backup)
+    uint64_t size;                                                  // Original size
+    uint64_t sizeRepo;                                              // Size in the repo
+    time_t timestamp;                                               // Modification time
+    mode_t mode;                                                    // Mode
+    const String *user;                                             // User name (NULL if not mapped to a name)
+    const String *group;                                            // Group name (NULL if not mapped to a name)
+    bool master;                                                    // Copied from the master during a standby backup?
+    bool checksumPage;                                              // Were page checksums verified?
+    bool checksumPageError;                                         // Were page checksum errors found?
+    const VariantList *checksumPageErrorList;                       // Pages/ranges with errors (NULL if none listed)
+    char checksumSha1[INFO_MANIFEST_CHECKSUM_SIZE * 2 + 1];         // SHA1 checksum (zero-length if none)
+} InfoManifestFile;
+
+/***********************************************************************************************************************************
+Constructor
+***********************************************************************************************************************************/
+InfoManifest *infoManifestNew(const Storage *storage, const String *fileName, CipherType cipherType, const String *cipherPass);
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+bool infoManifestFileExists(const InfoManifest *this, const String *name);
+InfoManifestFile infoManifestFileFind(const InfoManifest *this, const String *name);
+
+/***********************************************************************************************************************************
+Getters
+***********************************************************************************************************************************/
+InfoManifestFile infoManifestFile(const InfoManifest *this, unsigned int fileIdx);
+unsigned int infoManifestFileTotal(const InfoManifest *this);
+Ini *infoManifestIni(const InfoManifest *this);
+
+/***********************************************************************************************************************************
+Destructor
+***********************************************************************************************************************************/
+void infoManifestFree(InfoManifest *this);
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+String *infoManifestFileToLog(const InfoManifestFile *this);
+
+#define FUNCTION_LOG_INFO_MANIFEST_TYPE                                                                                            \
+    InfoManifest *
+#define FUNCTION_LOG_INFO_MANIFEST_FORMAT(value, buffer, bufferSize)                                                               \
+    objToLog(value, "InfoManifest", buffer, bufferSize)
+#define FUNCTION_LOG_INFO_MANIFEST_FILE_TYPE                                                                                       \
+    InfoManifestFile
+#define FUNCTION_LOG_INFO_MANIFEST_FILE_FORMAT(value, buffer, bufferSize)                                                          \
+    FUNCTION_LOG_STRING_OBJECT_FORMAT(&value, infoManifestFileToLog, buffer, bufferSize)
+
 #endif
@@ -29,7 +29,7 @@ perlOptionJson(void)
             Variant *optionVar = varNewKv();
 
             // Add valid
-            kvPut(varKv(optionVar), varNewStr(strNew("valid")), varNewBool(true));
+            kvPut(varKv(optionVar), VARSTRDEF("valid"), BOOL_TRUE_VAR);
 
             // Add source
             const char *source = NULL;
@@ -55,11 +55,11 @@ perlOptionJson(void)
                 }
             }
 
-            kvPut(varKv(optionVar), varNewStr(strNew("source")), varNewStr(strNew(source)));
+            kvPut(varKv(optionVar), VARSTRDEF("source"), varNewStr(strNew(source)));
 
             // Add negate and reset
-            kvPut(varKv(optionVar), varNewStr(strNew("negate")), varNewBool(cfgOptionNegate(optionId)));
-            kvPut(varKv(optionVar), varNewStr(strNew("reset")), varNewBool(cfgOptionReset(optionId)));
+            kvPut(varKv(optionVar), VARSTRDEF("negate"), VARBOOL(cfgOptionNegate(optionId)));
+            kvPut(varKv(optionVar), VARSTRDEF("reset"), VARBOOL(cfgOptionReset(optionId)));
 
             // Add value if it is set
             if (cfgOptionTest(optionId))
@@ -98,13 +98,13 @@ perlOptionJson(void)
                         const VariantList *valueList = cfgOptionLst(optionId);
 
                         for (unsigned int listIdx = 0; listIdx < varLstSize(valueList); listIdx++)
-                            kvPut(varKv(valueVar), varLstGet(valueList, listIdx), varNewBool(true));
+                            kvPut(varKv(valueVar), varLstGet(valueList, listIdx), BOOL_TRUE_VAR);
 
                         break;
                     }
                 }
 
-                kvPut(varKv(optionVar), varNewStr(strNew("value")), valueVar);
+                kvPut(varKv(optionVar), VARSTRDEF("value"), valueVar);
             }
 
             kvPut(configKv, varNewStr(strNew(cfgOptionName(optionId))), optionVar);
@@ -35,6 +35,9 @@ struct ProtocolClient
     IoRead *read;
     IoWrite *write;
     TimeMSec keepAliveTime;
+
+    Buffer *responseBuf;                                            // Response JSON, reused for each response
+    JsonRead *responseJson;                                         // Reader for the response JSON
 };
 
 /***********************************************************************************************************************************
@@ -67,6 +70,9 @@ protocolClientNew(const String *name, const String *service, IoRead *read, IoWri
         this->write = write;
         this->keepAliveTime = timeMSec();
 
+        this->responseBuf = bufNew(0);
+        this->responseJson = jsonReadNew(this->responseBuf);
+
         // Read, parse, and check the protocol greeting
         MEM_CONTEXT_TEMP_BEGIN()
         {
@@ -85,7 +91,7 @@ protocolClientNew(const String *name, const String *service, IoRead *read, IoWri
                 const String *expectedKey = expected[expectedIdx * 2];
                 const String *expectedValue = expected[expectedIdx * 2 + 1];
 
-                const Variant *actualValue = kvGet(greetingKv, varNewStr(expectedKey));
+                const Variant *actualValue = kvGetStr(greetingKv, expectedKey);
 
                 if (actualValue == NULL)
                     THROW_FMT(ProtocolError, "unable to find greeting key '%s'", strPtr(expectedKey));
@@ -129,36 +135,55 @@ protocolClientReadOutput(ProtocolClient *this, bool outputRequired)
 
     const Variant *result = NULL;
 
-    MEM_CONTEXT_TEMP_BEGIN()
+    MEM_CONTEXT_TEMP_ARENA_BEGIN()
     {
-        // Read the response
-        String *response = ioReadLine(this->read);
-        KeyValue *responseKv = varKv(jsonToVar(response));
+        // Read the response.  The response is parsed directly from the line buffer so only the output is allocated.
+        ioReadLineBuf(this->read, this->responseBuf);
+        jsonReadReset(this->responseJson);
+        jsonReadObjectBegin(this->responseJson);
 
-        // Process error if any
-        const Variant *error = kvGet(responseKv, varNewStr(PROTOCOL_ERROR_STR));
+        bool error = false;
+        int errorCode = 0;
+        Variant *output = NULL;
 
-        if (error != NULL)
+        while (jsonReadTypeNext(this->responseJson) != jsonTypeObjectEnd)
         {
-            const String *message = varStr(kvGet(responseKv, varNewStr(PROTOCOL_OUTPUT_STR)));
+            const String *key = jsonReadKey(this->responseJson);
 
-            THROWP_FMT(
-                errorTypeFromCode(varIntForce(error)), "%s: %s", strPtr(this->errorPrefix),
-                message == NULL ? "no details available" : strPtr(message));
+            if (strEq(key, PROTOCOL_ERROR_STR))
+            {
+                error = true;
+                errorCode = jsonReadInt(this->responseJson);
+            }
+            else if (strEq(key, PROTOCOL_OUTPUT_STR))
+            {
+                // Read output directly into the calling context when it will be returned
+                memContextSwitch(outputRequired ? MEM_CONTEXT_OLD() : MEM_CONTEXT_TEMP());
+                output = jsonReadVar(this->responseJson);
+                memContextSwitch(MEM_CONTEXT_TEMP());
+            }
+            else
+                THROW_FMT(ProtocolError, "invalid response key '%s'", strPtr(key));
         }
 
-        // Get output
-        result = kvGet(responseKv, varNewStr(PROTOCOL_OUTPUT_STR));
+        jsonReadObjectEnd(this->responseJson);
 
-        if (outputRequired)
+        // Process error if any
+        if (error)
         {
-            // Just move the entire response kv since the output is the largest part if it
-            kvMove(responseKv, MEM_CONTEXT_OLD());
+            const String *message = varStr(output);
+
+            THROWP_FMT(
+                errorTypeFromCode(errorCode), "%s: %s", strPtr(this->errorPrefix),
+                message == NULL ? "no details available" : strPtr(message));
         }
-        // Else if no output is required then there should not be any
-        else if (result != NULL)
+
+        // If no output is required then there should not be any
+        if (!outputRequired && output != NULL)
             THROW(AssertError, "no output required by command");
 
+        result = output;
+
         // Reset the keep alive time
         this->keepAliveTime = timeMSec();
     }
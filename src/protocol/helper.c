@@ -3,6 +3,8 @@ Protocol Helper
 ***********************************************************************************************************************************/
 #include "common/debug.h"
 #include "common/exec.h"
+#include "common/io/handleWrite.h"
+#include "common/io/io.h"
 #include "common/memContext.h"
 #include "crypto/crypto.h"
 #include "config/config.h"
@@ -88,13 +90,13 @@ protocolLocalParam(ProtocolStorageType protocolStorageType, unsigned int protoco
         kvPut(optionReplace, varNewStr(strNew(cfgOptionName(cfgOptCommand))), varNewStr(strNew(cfgCommandName(cfgCommand()))));
 
         // Add the process id -- used when more than one process will be called
-        kvPut(optionReplace, varNewStr(strNew(cfgOptionName(cfgOptProcess))), varNewInt((int)protocolId));
+        kvPut(optionReplace, varNewStr(strNew(cfgOptionName(cfgOptProcess))), VARINT((int)protocolId));
 
         // Add the host id -- for now this is hard-coded to 1
-        kvPut(optionReplace, varNewStr(strNew(cfgOptionName(cfgOptHostId))), varNewInt(1));
+        kvPut(optionReplace, varNewStr(strNew(cfgOptionName(cfgOptHostId))), VARINT(1));
 
         // Add the type
-        kvPut(optionReplace, varNewStr(strNew(cfgOptionName(cfgOptType))), varNewStr(strNew("backup")));
+        kvPut(optionReplace, varNewStr(strNew(cfgOptionName(cfgOptType))), VARSTRDEF("backup"));
 
         result = strLstMove(cfgExecParam(cfgCmdLocal, optionReplace), MEM_CONTEXT_OLD());
     }
@@ -208,7 +210,7 @@ protocolRemoteParam(ProtocolStorageType protocolStorageType, unsigned int protoc
 
     // Add the process id (or use the current process id if it is valid)
     if (!cfgOptionTest(cfgOptProcess))
-        kvPut(optionReplace, varNewStr(strNew(cfgOptionName(cfgOptProcess))), varNewInt((int)protocolId));
+        kvPut(optionReplace, varNewStr(strNew(cfgOptionName(cfgOptProcess))), VARINT((int)protocolId));
 
     // Don't pass the stanza if it is set.  It is better if the remote is stanza-agnostic so the client can operate on multiple
     // stanzas without starting a new remote.  Once the Perl code is removed the stanza option can be removed from the remote
@@ -216,7 +218,7 @@ protocolRemoteParam(ProtocolStorageType protocolStorageType, unsigned int protoc
     kvPut(optionReplace, varNewStr(strNew(cfgOptionName(cfgOptStanza))), NULL);
 
     // Add the type
-    kvPut(optionReplace, varNewStr(strNew(cfgOptionName(cfgOptType))), varNewStr(strNew("backup")));
+    kvPut(optionReplace, varNewStr(strNew(cfgOptionName(cfgOptType))), VARSTRDEF("backup"));
 
     StringList *commandExec = cfgExecParam(cfgCmdRemote, optionReplace);
     strLstInsert(commandExec, 0, cfgOptionStr(cfgOptRepoHostCmd));
@@ -277,6 +279,9 @@ protocolRemoteGet(ProtocolStorageType protocolStorageType)
                 (TimeMSec)(cfgOptionDbl(cfgOptProtocolTimeout) * 1000));
             execOpen(protocolHelperClient->exec);
 
+            // Allow the remote to get ahead of the client when sending data
+            ioHandlePipeSizeSet(execHandleRead(protocolHelperClient->exec), ioBufferSize() * PROTOCOL_READ_AHEAD_BLOCKS);
+
             // Create protocol object
             protocolHelperClient->client = protocolClientNew(
                 strNewFmt(PROTOCOL_SERVICE_REMOTE "-%u protocol on '%s'", protocolId, strPtr(cfgOptionStr(cfgOptRepoHost))),
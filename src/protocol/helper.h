@@ -23,6 +23,10 @@ Constants
 #define PROTOCOL_SERVICE_REMOTE                                     "remote"
     STRING_DECLARE(PROTOCOL_SERVICE_REMOTE_STR);
 
+// Number of buffer-sized blocks that can be in flight between the remote and the client.  The pipes are grown to hold this many blocks
+// so the remote can keep reading while the client (or ssh) drains the pipe instead of alternating with it.
+#define PROTOCOL_READ_AHEAD_BLOCKS                                  4
+
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
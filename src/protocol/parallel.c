@@ -164,17 +164,20 @@ protocolParallelProcess(ProtocolParallel *this)
         // If any jobs have completed then get the results
         if (completed > 0)
         {
-            for (unsigned int clientIdx = 0; clientIdx < lstSize(this->clientList); clientIdx++)
+            MEM_CONTEXT_TEMP_RESET_BEGIN()
             {
-                ProtocolParallelJob *job = this->clientJobList[clientIdx];
-
-                if (job != NULL &&
-                    FD_ISSET(
-                        (unsigned int)ioReadHandle(protocolClientIoRead(*(ProtocolClient **)lstGet(this->clientList, clientIdx))),
-                        &selectSet))
+                for (unsigned int clientIdx = 0; clientIdx < lstSize(this->clientList); clientIdx++)
                 {
-                    MEM_CONTEXT_TEMP_BEGIN()
+                    ProtocolParallelJob *job = this->clientJobList[clientIdx];
+
+                    if (job != NULL &&
+                        FD_ISSET(
+                            (unsigned int)ioReadHandle(
+                                protocolClientIoRead(*(ProtocolClient **)lstGet(this->clientList, clientIdx))),
+                            &selectSet))
                     {
+                        MEM_CONTEXT_TEMP_RESET(1);
+
                         TRY_BEGIN()
                         {
                             protocolParallelJobResultSet(
@@ -189,9 +192,9 @@ protocolParallelProcess(ProtocolParallel *this)
                         protocolParallelJobStateSet(job, protocolParallelJobStateDone);
                         this->clientJobList[clientIdx] = NULL;
                     }
-                    MEM_CONTEXT_TEMP_END();
                 }
             }
+            MEM_CONTEXT_TEMP_END();
 
             result = (unsigned int)completed;
         }
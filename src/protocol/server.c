@@ -23,6 +23,11 @@ struct ProtocolServer
     IoWrite *write;
 
     List *handlerList;
+
+    Buffer *commandBuf;                                             // Command JSON, reused for each command
+    JsonRead *commandJson;                                          // Reader for the command JSON
+    Buffer *responseBuf;                                            // Response JSON, reused for each response
+    JsonWrite *responseJson;                                        // Writer for the response JSON
 };
 
 /***********************************************************************************************************************************
@@ -55,13 +60,18 @@ protocolServerNew(const String *name, const String *service, IoRead *read, IoWri
 
         this->handlerList = lstNew(sizeof(ProtocolServerProcessHandler));
 
+        this->commandBuf = bufNew(0);
+        this->commandJson = jsonReadNew(this->commandBuf);
+        this->responseBuf = bufNew(0);
+        this->responseJson = jsonWriteNew(this->responseBuf);
+
         // Send the protocol greeting
         MEM_CONTEXT_TEMP_BEGIN()
         {
             KeyValue *greetingKv = kvNew();
-            kvPut(greetingKv, varNewStr(PROTOCOL_GREETING_NAME_STR), varNewStr(strNew(PROJECT_NAME)));
-            kvPut(greetingKv, varNewStr(PROTOCOL_GREETING_SERVICE_STR), varNewStr(service));
-            kvPut(greetingKv, varNewStr(PROTOCOL_GREETING_VERSION_STR), varNewStr(strNew(PROJECT_VERSION)));
+            kvPut(greetingKv, VARSTR(PROTOCOL_GREETING_NAME_STR), VARSTRDEF(PROJECT_NAME));
+            kvPut(greetingKv, VARSTR(PROTOCOL_GREETING_SERVICE_STR), VARSTR(service));
+            kvPut(greetingKv, VARSTR(PROTOCOL_GREETING_VERSION_STR), VARSTRDEF(PROJECT_VERSION));
 
             ioWriteLine(this->write, kvToJson(greetingKv, 0));
             ioWriteFlush(this->write);
@@ -89,6 +99,24 @@ protocolServerHandlerAdd(ProtocolServer *this, ProtocolServerProcessHandler hand
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Write the response in the response buffer as a line and flush it
+***********************************************************************************************************************************/
+static void
+protocolServerWriteResponse(ProtocolServer *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PROTOCOL_SERVER, this);
+    FUNCTION_TEST_END();
+
+    bufCatC(this->responseBuf, (const unsigned char *)"\n", 0, 1);
+
+    ioWrite(this->write, this->responseBuf);
+    ioWriteFlush(this->write);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Process requests
 ***********************************************************************************************************************************/
@@ -99,19 +127,42 @@ protocolServerProcess(ProtocolServer *this)
         FUNCTION_LOG_PARAM(PROTOCOL_SERVER, this);
     FUNCTION_LOG_END();
 
-    // Loop until exit command is received
+    // Loop until exit command is received.  The temp context is reset after each command rather than being created and freed.
     bool exit = false;
 
-    do
+    MEM_CONTEXT_TEMP_RESET_BEGIN()
     {
-        TRY_BEGIN()
+        do
         {
-            MEM_CONTEXT_TEMP_BEGIN()
+            MEM_CONTEXT_TEMP_RESET(1);
+
+            TRY_BEGIN()
             {
-                // Read command
-                KeyValue *commandKv = varKv(jsonToVar(ioReadLine(this->read)));
-                String *command = varStr(kvGet(commandKv, varNewStr(PROTOCOL_KEY_COMMAND_STR)));
-                VariantList *paramList = varVarLst(kvGet(commandKv, varNewStr(PROTOCOL_KEY_PARAMETER_STR)));
+                // Read command.  The command is parsed directly from the line buffer so only the command name and parameters are
+                // allocated.
+                ioReadLineBuf(this->read, this->commandBuf);
+                jsonReadReset(this->commandJson);
+                jsonReadObjectBegin(this->commandJson);
+
+                String *command = NULL;
+                VariantList *paramList = NULL;
+
+                while (jsonReadTypeNext(this->commandJson) != jsonTypeObjectEnd)
+                {
+                    const String *key = jsonReadKey(this->commandJson);
+
+                    if (strEq(key, PROTOCOL_KEY_COMMAND_STR))
+                        command = jsonReadStr(this->commandJson);
+                    else if (strEq(key, PROTOCOL_KEY_PARAMETER_STR))
+                        paramList = varVarLst(jsonReadVar(this->commandJson));
+                    else
+                        THROW_FMT(ProtocolError, "invalid command key '%s'", strPtr(key));
+                }
+
+                jsonReadObjectEnd(this->commandJson);
+
+                if (command == NULL)
+                    THROW(ProtocolError, "command is missing");
 
                 // Process command
                 bool found = false;
@@ -139,25 +190,26 @@ protocolServerProcess(ProtocolServer *this)
                         THROW_FMT(ProtocolError, "invalid command '%s'", strPtr(command));
                 }
             }
-            MEM_CONTEXT_TEMP_END();
-        }
-        // Asserts are thrown so a stack trace will be output to aid in debugging
-        CATCH(AssertError)
-        {
-            RETHROW();
-        }
-        CATCH_ANY()
-        {
-            KeyValue *error = kvNew();
-            kvPut(error, varNewStr(PROTOCOL_ERROR_STR), varNewInt(errorCode()));
-            kvPut(error, varNewStr(PROTOCOL_OUTPUT_STR), varNewStr(strNew(errorMessage())));
+            // Asserts are thrown so a stack trace will be output to aid in debugging
+            CATCH(AssertError)
+            {
+                RETHROW();
+            }
+            CATCH_ANY()
+            {
+                jsonWriteReset(this->responseJson);
+                jsonWriteObjectBegin(this->responseJson);
+                jsonWriteInt(jsonWriteKey(this->responseJson, PROTOCOL_ERROR_STR), errorCode());
+                jsonWriteStr(jsonWriteKey(this->responseJson, PROTOCOL_OUTPUT_STR), strNew(errorMessage()));
+                jsonWriteObjectEnd(this->responseJson);
 
-            ioWriteLine(this->write, kvToJson(error, 0));
-            ioWriteFlush(this->write);
+                protocolServerWriteResponse(this);
+            }
+            TRY_END();
         }
-        TRY_END();
+        while (!exit);
     }
-    while (!exit);
+    MEM_CONTEXT_TEMP_END();
 
     FUNCTION_LOG_RETURN_VOID();
 }
@@ -173,13 +225,17 @@ protocolServerResponse(ProtocolServer *this, const Variant *output)
         FUNCTION_LOG_PARAM(VARIANT, output);
     FUNCTION_LOG_END();
 
-    KeyValue *result = kvNew();
+    ASSERT(this != NULL);
+
+    jsonWriteReset(this->responseJson);
+    jsonWriteObjectBegin(this->responseJson);
 
     if (output != NULL)
-        kvAdd(result, varNewStr(PROTOCOL_OUTPUT_STR), output);
+        jsonWriteVar(jsonWriteKey(this->responseJson, PROTOCOL_OUTPUT_STR), output);
 
-    ioWriteLine(this->write, kvToJson(result, 0));
-    ioWriteFlush(this->write);
+    jsonWriteObjectEnd(this->responseJson);
+
+    protocolServerWriteResponse(this);
 
     FUNCTION_LOG_RETURN_VOID();
 }
@@ -45,6 +45,27 @@ storageDriverPosixFileOpen(
     FUNCTION_TEST_RETURN(result);
 }
 
+/***********************************************************************************************************************************
+Drop a range of a file from the cache (a size of 0 drops to the end of the file)
+
+This is only advice so errors are ignored.  Dirty pages are not dropped so written data must be written back first.
+***********************************************************************************************************************************/
+void
+storageDriverPosixFileCacheDrop(int handle, uint64_t offset, uint64_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INT, handle);
+        FUNCTION_TEST_PARAM(UINT64, offset);
+        FUNCTION_TEST_PARAM(UINT64, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(handle != -1);
+
+    posix_fadvise(handle, (off_t)offset, (off_t)size, POSIX_FADV_DONTNEED);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Sync a file/directory handle
 ***********************************************************************************************************************************/
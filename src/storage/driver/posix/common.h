@@ -4,13 +4,21 @@ Posix Common File Routines
 #ifndef STORAGE_DRIVER_POSIX_COMMON_H
 #define STORAGE_DRIVER_POSIX_COMMON_H
 
+#include <stdint.h>
+
 #include "common/error.h"
 #include "common/type/string.h"
 
+/***********************************************************************************************************************************
+Bytes to read or write before pages are dropped from the cache (or written back) for files that should not be cached
+***********************************************************************************************************************************/
+#define STORAGE_DRIVER_POSIX_CACHE_DROP_SIZE                        ((uint64_t)8 * 1024 * 1024)
+
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
 int storageDriverPosixFileOpen(const String *name, int flags, mode_t mode, bool ignoreMissing, bool file, const char *purpose);
+void storageDriverPosixFileCacheDrop(int handle, uint64_t offset, uint64_t size);
 void storageDriverPosixFileSync(int handle, const String *name, bool file, bool closeOnError);
 void storageDriverPosixFileClose(int handle, const String *name, bool file);
 
@@ -1,15 +1,21 @@
 /***********************************************************************************************************************************
 Posix Storage File Read Driver
 ***********************************************************************************************************************************/
+#include <errno.h>
 #include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include "common/debug.h"
+#include "common/io/io.h"
 #include "common/io/read.intern.h"
 #include "common/log.h"
 #include "common/memContext.h"
 #include "storage/driver/posix/common.h"
 #include "storage/driver/posix/fileRead.h"
+#include "storage/driver/posix/map.h"
+#include "storage/driver/posix/uring.h"
 #include "storage/fileRead.intern.h"
 
 /***********************************************************************************************************************************
@@ -23,20 +29,40 @@ struct StorageDriverPosixFileRead
     IoRead *io;
     String *name;
     bool ignoreMissing;
+    bool noCache;                                                   // Drop the file from the cache as it is read?
 
     int handle;
     bool eof;
+    uint64_t size;                                                  // Bytes read so far
+    uint64_t cacheDropSize;                                         // Bytes dropped from the cache so far
+
+    bool mapInit;                                                   // Has mapping the file been attempted?
+    StorageDriverPosixMap *map;                                     // Mapped file (NULL when not mapped)
+    size_t mapOffset;                                               // Offset of the next view of the mapped file
+    size_t mapDropOffset;                                           // Offset of the mapped file dropped from the cache so far
+    Buffer *mapView;                                                // View of the mapped file
+
+    bool uringInit;                                                 // Has creating the io_uring queue been attempted?
+    StorageDriverPosixUring *uring;                                 // io_uring queue (NULL when using read())
+    uint64_t uringOffset;                                           // Offset of the next read to queue
+    unsigned int uringSlot;                                         // Slot being consumed
+    uint64_t uringSlotOffset;                                       // Offset of the read in the slot being consumed
+    size_t uringSlotSize;                                           // Size of the read in the slot being consumed
+    bool uringReady;                                                // Has the read in the current slot completed?
+    size_t uringSize;                                               // Bytes read into the current slot
+    size_t uringUsed;                                               // Bytes consumed from the current slot
 };
 
 /***********************************************************************************************************************************
 Create a new file
 ***********************************************************************************************************************************/
 StorageDriverPosixFileRead *
-storageDriverPosixFileReadNew(StorageDriverPosix *storage, const String *name, bool ignoreMissing)
+storageDriverPosixFileReadNew(StorageDriverPosix *storage, const String *name, bool ignoreMissing, bool noCache)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STRING, name);
         FUNCTION_LOG_PARAM(BOOL, ignoreMissing);
+        FUNCTION_LOG_PARAM(BOOL, noCache);
     FUNCTION_LOG_END();
 
     ASSERT(name != NULL);
@@ -51,6 +77,7 @@ storageDriverPosixFileReadNew(StorageDriverPosix *storage, const String *name, b
         this->storage = storage;
         this->name = strDup(name);
         this->ignoreMissing = ignoreMissing;
+        this->noCache = noCache;
 
         this->handle = -1;
 
@@ -63,7 +90,8 @@ storageDriverPosixFileReadNew(StorageDriverPosix *storage, const String *name, b
         this->io = ioReadNewP(
             this, .eof = (IoReadInterfaceEof)storageDriverPosixFileReadEof,
             .close = (IoReadInterfaceClose)storageDriverPosixFileReadClose,
-            .open = (IoReadInterfaceOpen)storageDriverPosixFileReadOpen, .read = (IoReadInterfaceRead)storageDriverPosixFileRead);
+            .open = (IoReadInterfaceOpen)storageDriverPosixFileReadOpen, .read = (IoReadInterfaceRead)storageDriverPosixFileRead,
+            .view = (IoReadInterfaceView)storageDriverPosixFileReadView);
     }
     MEM_CONTEXT_NEW_END();
 
@@ -93,11 +121,120 @@ storageDriverPosixFileReadOpen(StorageDriverPosixFileRead *this)
     {
         memContextCallback(this->memContext, (MemContextCallback)storageDriverPosixFileReadFree, this);
         result = true;
+
+        // Files are always read from beginning to end so let the kernel read ahead more aggressively.  This is only advice so
+        // errors are ignored.
+        posix_fadvise(this->handle, 0, 0, POSIX_FADV_SEQUENTIAL);
     }
 
     FUNCTION_LOG_RETURN(BOOL, result);
 }
 
+/***********************************************************************************************************************************
+Queue a read of the next block of the file into a slot
+***********************************************************************************************************************************/
+static void
+storageDriverPosixFileReadUringQueue(StorageDriverPosixFileRead *this, unsigned int slot)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX_FILE_READ, this);
+        FUNCTION_TEST_PARAM(UINT, slot);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->uring != NULL);
+
+    size_t size = storageDriverPosixUringBufferSize(this->uring);
+
+    storageDriverPosixUringRead(this->uring, slot, this->handle, this->uringOffset, size);
+    this->uringOffset += size;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Read from a file with io_uring
+
+Reads are queued ahead in every slot and consumed in order.  Each slot is queued again for the next unread block as soon as it has
+been consumed so the kernel is reading while the caller processes data.  A read may complete with fewer bytes than requested without
+being at EOF (e.g. when interrupted or when the file is growing) so the remainder of the slot is queued again.  Only a read that
+returns no data means EOF, after which no more reads are queued.  Returns the number of bytes copied into the buffer.
+***********************************************************************************************************************************/
+static size_t
+storageDriverPosixFileReadUring(StorageDriverPosixFileRead *this, Buffer *buffer)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX_FILE_READ, this);
+        FUNCTION_TEST_PARAM(BUFFER, buffer);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->uring != NULL);
+    ASSERT(buffer != NULL);
+
+    size_t result = 0;
+
+    while (!bufFull(buffer) && !this->eof)
+    {
+        // Wait for the read in the current slot to complete
+        if (!this->uringReady)
+        {
+            int actualBytes = storageDriverPosixUringWait(this->uring, this->uringSlot);
+
+            if (actualBytes < 0)
+            {
+                errno = -actualBytes;
+                THROW_SYS_ERROR_FMT(FileReadError, "unable to read '%s'", strPtr(this->name));
+            }
+
+            this->uringReady = true;
+            this->uringSize = (size_t)actualBytes;
+            this->uringUsed = 0;
+
+            // EOF when nothing was read
+            if (actualBytes == 0)
+            {
+                this->eof = true;
+                break;
+            }
+        }
+
+        // Copy as much of the slot as will fit
+        size_t copySize = this->uringSize - this->uringUsed;
+
+        if (copySize > bufRemains(buffer))
+            copySize = bufRemains(buffer);
+
+        memcpy(
+            bufRemainsPtr(buffer), storageDriverPosixUringBuffer(this->uring, this->uringSlot) + this->uringUsed, copySize);
+        bufUsedInc(buffer, copySize);
+        this->uringUsed += copySize;
+        result += copySize;
+
+        // When the slot has been consumed either read the rest of a short read into the same slot or reuse the slot for the next
+        // unread block.  Reads in the other slots are for later blocks so they are still in order.
+        if (this->uringUsed == this->uringSize)
+        {
+            this->uringSlotOffset += this->uringSize;
+            this->uringSlotSize -= this->uringSize;
+
+            if (this->uringSlotSize > 0)
+                storageDriverPosixUringRead(this->uring, this->uringSlot, this->handle, this->uringSlotOffset, this->uringSlotSize);
+            else
+            {
+                storageDriverPosixFileReadUringQueue(this, this->uringSlot);
+
+                this->uringSlot = (this->uringSlot + 1) % storageDriverPosixUringDepth(this->uring);
+                this->uringSlotSize = storageDriverPosixUringBufferSize(this->uring);
+            }
+
+            this->uringReady = false;
+        }
+    }
+
+    FUNCTION_TEST_RETURN(result);
+}
+
 /***********************************************************************************************************************************
 Read from a file
 ***********************************************************************************************************************************/
@@ -118,16 +255,74 @@ storageDriverPosixFileRead(StorageDriverPosixFileRead *this, Buffer *buffer, boo
 
     if (!this->eof)
     {
+        // Create the io_uring queue on the first read when enabled.  The file offset is used as the starting point since a kernel
+        // copy may have already read part of the file.  Files that would not fill the queue are read with read() since setting up
+        // the queue costs more than it saves, e.g. for info files.
+        if (!this->uringInit)
+        {
+            this->uringInit = true;
+
+            unsigned int uringDepth = storageDriverPosixUring(this->storage);
+
+            if (uringDepth > 0)
+            {
+                struct stat statFile;
+
+                THROW_ON_SYS_ERROR_FMT(
+                    fstat(this->handle, &statFile) == -1, FileOpenError, "unable to get info for '%s'", strPtr(this->name));
+
+                uint64_t offset = (uint64_t)lseek(this->handle, 0, SEEK_CUR);
+
+                if ((uint64_t)statFile.st_size >= offset + (uint64_t)uringDepth * ioBufferSize())
+                {
+                    MEM_CONTEXT_BEGIN(this->memContext)
+                    {
+                        this->uring = storageDriverPosixUringNew(uringDepth, ioBufferSize());
+                    }
+                    MEM_CONTEXT_END();
+
+                    // Don't pay for setup again on every file when io_uring is not available
+                    if (this->uring == NULL)
+                        storageDriverPosixUringSet(this->storage, 0);
+                }
+
+                if (this->uring != NULL)
+                {
+                    this->uringOffset = offset;
+                    this->uringSlotOffset = offset;
+                    this->uringSlotSize = ioBufferSize();
+
+                    for (unsigned int slotIdx = 0; slotIdx < uringDepth; slotIdx++)
+                        storageDriverPosixFileReadUringQueue(this, slotIdx);
+                }
+            }
+        }
+
         // Read and handle errors
         size_t expectedBytes = bufRemains(buffer);
-        actualBytes = read(this->handle, bufRemainsPtr(buffer), expectedBytes);
 
-        // Error occurred during read
-        if (actualBytes == -1)
-            THROW_SYS_ERROR_FMT(FileReadError, "unable to read '%s'", strPtr(this->name));
+        if (this->uring != NULL)
+            actualBytes = (ssize_t)storageDriverPosixFileReadUring(this, buffer);
+        else
+        {
+            actualBytes = read(this->handle, bufRemainsPtr(buffer), expectedBytes);
+
+            // Error occurred during read
+            if (actualBytes == -1)
+                THROW_SYS_ERROR_FMT(FileReadError, "unable to read '%s'", strPtr(this->name));
+
+            // Update amount of buffer used
+            bufUsedInc(buffer, (size_t)actualBytes);
+        }
 
-        // Update amount of buffer used
-        bufUsedInc(buffer, (size_t)actualBytes);
+        this->size += (uint64_t)actualBytes;
+
+        // Drop data that has been read from the cache so large files do not evict more useful data
+        if (this->noCache && this->size - this->cacheDropSize >= STORAGE_DRIVER_POSIX_CACHE_DROP_SIZE)
+        {
+            storageDriverPosixFileCacheDrop(this->handle, this->cacheDropSize, this->size - this->cacheDropSize);
+            this->cacheDropSize = this->size;
+        }
 
         // If less data than expected was read then EOF.  The file may not actually be EOF but we are not concerned with files that
         // are growing.  Just read up to the point where the file is being extended.
@@ -138,6 +333,140 @@ storageDriverPosixFileRead(StorageDriverPosixFileRead *this, Buffer *buffer, boo
     FUNCTION_LOG_RETURN(SIZE, (size_t)actualBytes);
 }
 
+/***********************************************************************************************************************************
+Error if the mapped file was truncated while being read since zeroes will have been returned for the missing data
+
+Truncation only raises SIGBUS for pages entirely past the new end of the file.  The rest of the page holding the new end reads as
+zeroes, so when size is set the file size is also checked against the data returned so far.  This is done when the views end or the
+file is closed rather than for every view to avoid an fstat() per view.
+***********************************************************************************************************************************/
+static void
+storageDriverPosixFileReadMapCheck(StorageDriverPosixFileRead *this, bool size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX_FILE_READ, this);
+        FUNCTION_TEST_PARAM(BOOL, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->map != NULL);
+
+    bool truncated = storageDriverPosixMapTruncated(this->map);
+
+    if (!truncated && size)
+    {
+        struct stat statFile;
+
+        THROW_ON_SYS_ERROR_FMT(
+            fstat(this->handle, &statFile) == -1, FileReadError, "unable to get info for '%s'", strPtr(this->name));
+
+        truncated = (uint64_t)statFile.st_size < this->mapOffset;
+    }
+
+    if (truncated)
+        THROW_FMT(FileReadError, "unable to read '%s': file was truncated while being read", strPtr(this->name));
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Get a view of the mapped file
+
+The file is mapped on the first call when mmap() is enabled and the file is small enough.  Mapping starts at the file offset since a
+kernel copy may have already read part of the file.  If the file is not mapped then NULL is returned so read() is used instead.
+
+Each view is faulted in and checked for truncation before it is returned.  When the end of the mapping is reached the file is
+unmapped and read() continues from the end of the mapping until EOF since the file may have grown after it was mapped.
+***********************************************************************************************************************************/
+const Buffer *
+storageDriverPosixFileReadView(StorageDriverPosixFileRead *this, size_t size)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_POSIX_FILE_READ, this);
+        FUNCTION_LOG_PARAM(SIZE, size);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL && this->handle != -1);
+    ASSERT(!this->eof);
+    ASSERT(size > 0);
+
+    const Buffer *result = NULL;
+
+    if (!this->mapInit)
+    {
+        this->mapInit = true;
+
+        uint64_t mmapSizeMax = storageDriverPosixMmap(this->storage);
+
+        if (mmapSizeMax > 0)
+        {
+            struct stat statFile;
+
+            THROW_ON_SYS_ERROR_FMT(
+                fstat(this->handle, &statFile) == -1, FileOpenError, "unable to get info for '%s'", strPtr(this->name));
+
+            uint64_t offset = (uint64_t)lseek(this->handle, 0, SEEK_CUR);
+
+            // Only regular files with data left to read can be mapped
+            if (S_ISREG(statFile.st_mode) && (uint64_t)statFile.st_size > offset && (uint64_t)statFile.st_size <= mmapSizeMax)
+            {
+                MEM_CONTEXT_BEGIN(this->memContext)
+                {
+                    this->map = storageDriverPosixMapNew(this->handle, (size_t)statFile.st_size);
+                    this->mapOffset = (size_t)offset;
+                    this->mapDropOffset = (size_t)offset;
+                    this->mapView = bufNewView(NULL, 0);
+                }
+                MEM_CONTEXT_END();
+            }
+        }
+    }
+
+    if (this->map != NULL)
+    {
+        // Check that the prior view was not truncated while it was being processed
+        storageDriverPosixFileReadMapCheck(this, false);
+
+        // The prior view has been processed so views that have been consumed can be dropped from the cache
+        if (this->noCache && this->mapOffset - this->mapDropOffset >= STORAGE_DRIVER_POSIX_CACHE_DROP_SIZE)
+        {
+            storageDriverPosixMapDrop(this->map, this->mapDropOffset, this->mapOffset - this->mapDropOffset);
+            storageDriverPosixFileCacheDrop(this->handle, this->mapDropOffset, this->mapOffset - this->mapDropOffset);
+            this->mapDropOffset = this->mapOffset;
+        }
+
+        size_t viewSize = storageDriverPosixMapSize(this->map) - this->mapOffset;
+
+        // At the end of the mapping unmap the file and continue with read() from the end of the mapping
+        if (viewSize == 0)
+        {
+            storageDriverPosixFileReadMapCheck(this, true);
+            lseek(this->handle, (off_t)this->mapOffset, SEEK_SET);
+
+            storageDriverPosixMapFree(this->map);
+            this->map = NULL;
+        }
+        // Else return as much of the file as requested
+        else
+        {
+            if (viewSize > size)
+                viewSize = size;
+
+            // Fault in the view so truncation is detected before the view is returned
+            storageDriverPosixMapTouch(this->map, this->mapOffset, viewSize);
+            storageDriverPosixFileReadMapCheck(this, false);
+
+            bufViewSet(this->mapView, storageDriverPosixMapPtr(this->map) + this->mapOffset, viewSize);
+            this->mapOffset += viewSize;
+            this->size += viewSize;
+
+            result = this->mapView;
+        }
+    }
+
+    FUNCTION_LOG_RETURN(BUFFER, (Buffer *)result);
+}
+
 /***********************************************************************************************************************************
 Close the file
 ***********************************************************************************************************************************/
@@ -153,6 +482,22 @@ storageDriverPosixFileReadClose(StorageDriverPosixFileRead *this)
     // Close if the file has not already been closed
     if (this->handle != -1)
     {
+        // Wait for reads queued ahead of EOF since the kernel may still be writing to the slot buffers
+        storageDriverPosixUringFree(this->uring);
+        this->uring = NULL;
+
+        // Unmap the file after checking that the last view was not truncated
+        if (this->map != NULL)
+        {
+            storageDriverPosixFileReadMapCheck(this, true);
+            storageDriverPosixMapFree(this->map);
+            this->map = NULL;
+        }
+
+        // Drop the remainder of the file from the cache
+        if (this->noCache)
+            storageDriverPosixFileCacheDrop(this->handle, this->cacheDropSize, 0);
+
         // Close the file
         storageDriverPosixFileClose(this->handle, this->name, true);
 
@@ -177,6 +522,21 @@ storageDriverPosixFileReadEof(const StorageDriverPosixFileRead *this)
     FUNCTION_TEST_RETURN(this->eof);
 }
 
+/***********************************************************************************************************************************
+Get the file handle (-1 when the file is not open)
+***********************************************************************************************************************************/
+int
+storageDriverPosixFileReadHandle(const StorageDriverPosixFileRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX_FILE_READ, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->handle);
+}
+
 /***********************************************************************************************************************************
 Should a missing file be ignored?
 ***********************************************************************************************************************************/
@@ -249,6 +609,12 @@ storageDriverPosixFileReadFree(StorageDriverPosixFileRead *this)
 
     if (this != NULL)
     {
+        // The io_uring queue and mapping are freed with their own contexts, which has already happened if this was called from
+        // the callback.  It is safe for the queue to drain after the handle is closed since the kernel holds a reference to the
+        // file for each request, and a mapping does not need the handle at all.
+        this->uring = NULL;
+        this->map = NULL;
+
         storageDriverPosixFileReadClose(this);
 
         memContextCallbackClear(this->memContext);
@@ -17,19 +17,22 @@ typedef struct StorageDriverPosixFileRead StorageDriverPosixFileRead;
 /***********************************************************************************************************************************
 Constructor
 ***********************************************************************************************************************************/
-StorageDriverPosixFileRead *storageDriverPosixFileReadNew(StorageDriverPosix *storage, const String *name, bool ignoreMissing);
+StorageDriverPosixFileRead *storageDriverPosixFileReadNew(
+    StorageDriverPosix *storage, const String *name, bool ignoreMissing, bool noCache);
 
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
 bool storageDriverPosixFileReadOpen(StorageDriverPosixFileRead *this);
 size_t storageDriverPosixFileRead(StorageDriverPosixFileRead *this, Buffer *buffer, bool block);
+const Buffer *storageDriverPosixFileReadView(StorageDriverPosixFileRead *this, size_t size);
 void storageDriverPosixFileReadClose(StorageDriverPosixFileRead *this);
 
 /***********************************************************************************************************************************
 Getters
 ***********************************************************************************************************************************/
 bool storageDriverPosixFileReadEof(const StorageDriverPosixFileRead *this);
+int storageDriverPosixFileReadHandle(const StorageDriverPosixFileRead *this);
 bool storageDriverPosixFileReadIgnoreMissing(const StorageDriverPosixFileRead *this);
 StorageFileRead *storageDriverPosixFileReadInterface(const StorageDriverPosixFileRead *this);
 IoRead *storageDriverPosixFileReadIo(const StorageDriverPosixFileRead *this);
@@ -1,16 +1,23 @@
 /***********************************************************************************************************************************
 Posix Storage File Write Driver
 ***********************************************************************************************************************************/
+#include <errno.h>
 #include <fcntl.h>
 #include <stdio.h>
+#include <string.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
 #include "common/debug.h"
+#include "common/io/io.h"
 #include "common/io/write.intern.h"
 #include "common/log.h"
 #include "common/memContext.h"
 #include "storage/driver/posix/common.h"
+#include "storage/driver/posix/fileRead.h"
 #include "storage/driver/posix/fileWrite.h"
+#include "storage/driver/posix/uring.h"
 #include "storage/fileWrite.intern.h"
 
 /***********************************************************************************************************************************
@@ -32,10 +39,33 @@ struct StorageDriverPosixFileWrite
     bool syncFile;
     bool syncPath;
     bool atomic;
+    bool noCache;                                                   // Drop the file from the cache as it is written?
 
     int handle;
+    uint64_t size;                                                  // Bytes written so far
+    uint64_t writebackBegin;                                        // Start of the range being written back
+    uint64_t writebackEnd;                                          // End of the range being written back
+
+    bool uringInit;                                                 // Has creating the io_uring queue been attempted?
+    StorageDriverPosixUring *uring;                                 // io_uring queue (NULL when using write())
+    uint64_t uringOffset;                                           // Offset of the slot being filled
+    unsigned int uringSlot;                                         // Slot being filled
+    size_t uringUsed;                                               // Bytes in the slot being filled
 };
 
+/***********************************************************************************************************************************
+Maximum bytes to copy in the kernel with each call
+***********************************************************************************************************************************/
+#define STORAGE_DRIVER_POSIX_COPY_SIZE                              ((size_t)1 << 30)
+
+/***********************************************************************************************************************************
+Local variables
+***********************************************************************************************************************************/
+static struct
+{
+    bool copyRangeUnsupported;                                      // Does the kernel lack copy_file_range()?
+} storageDriverPosixFileWriteLocal;
+
 /***********************************************************************************************************************************
 File open constants
 
@@ -50,7 +80,7 @@ Create a new file
 StorageDriverPosixFileWrite *
 storageDriverPosixFileWriteNew(
     StorageDriverPosix *storage, const String *name, mode_t modeFile, mode_t modePath, bool createPath, bool syncFile,
-    bool syncPath, bool atomic)
+    bool syncPath, bool atomic, bool noCache)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STRING, name);
@@ -60,6 +90,7 @@ storageDriverPosixFileWriteNew(
         FUNCTION_LOG_PARAM(BOOL, syncFile);
         FUNCTION_LOG_PARAM(BOOL, syncPath);
         FUNCTION_LOG_PARAM(BOOL, atomic);
+        FUNCTION_LOG_PARAM(BOOL, noCache);
     FUNCTION_LOG_END();
 
     ASSERT(name != NULL);
@@ -77,6 +108,7 @@ storageDriverPosixFileWriteNew(
 
         this->interface = storageFileWriteNewP(
             STORAGE_DRIVER_POSIX_TYPE_STR, this, .atomic = (StorageFileWriteInterfaceAtomic)storageDriverPosixFileWriteAtomic,
+            .copy = (StorageFileWriteInterfaceCopy)storageDriverPosixFileWriteCopy,
             .createPath = (StorageFileWriteInterfaceCreatePath)storageDriverPosixFileWriteCreatePath,
             .io = (StorageFileWriteInterfaceIo)storageDriverPosixFileWriteIo,
             .modeFile = (StorageFileWriteInterfaceModeFile)storageDriverPosixFileWriteModeFile,
@@ -99,6 +131,7 @@ storageDriverPosixFileWriteNew(
         this->syncFile = syncFile;
         this->syncPath = syncPath;
         this->atomic = atomic;
+        this->noCache = noCache;
 
         this->handle = -1;
     }
@@ -141,6 +174,176 @@ storageDriverPosixFileWriteOpen(StorageDriverPosixFileWrite *this)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Start writeback of data written since the last call and wait for the range started by the prior call to complete
+
+Waiting one range behind keeps the device busy without letting dirty data build up.  Errors are not checked since this is only an
+optimization and the sync at close will report any errors.  The end must not be past data that has actually been written to the
+file, otherwise queued writes that land later would be missed by the writeback and the cache drop.
+***********************************************************************************************************************************/
+static void
+storageDriverPosixFileWriteWriteback(StorageDriverPosixFileWrite *this, uint64_t end)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_POSIX_FILE_WRITE, this);
+        FUNCTION_LOG_PARAM(UINT64, end);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->handle != -1);
+    ASSERT(end >= this->writebackEnd);
+
+#ifdef SYNC_FILE_RANGE_WRITE
+    sync_file_range(this->handle, (off_t)this->writebackEnd, (off_t)(end - this->writebackEnd), SYNC_FILE_RANGE_WRITE);
+
+    if (this->writebackEnd > this->writebackBegin)
+    {
+        sync_file_range(
+            this->handle, (off_t)this->writebackBegin, (off_t)(this->writebackEnd - this->writebackBegin),
+            SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+    }
+#endif
+
+    // The prior range has been written back so it can be dropped from the cache
+    if (this->noCache)
+        storageDriverPosixFileCacheDrop(this->handle, this->writebackBegin, this->writebackEnd - this->writebackBegin);
+
+    this->writebackBegin = this->writebackEnd;
+    this->writebackEnd = end;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Wait for the write in a slot to complete and check that all bytes were written
+***********************************************************************************************************************************/
+static void
+storageDriverPosixFileWriteUringWait(StorageDriverPosixFileWrite *this, unsigned int slot, size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX_FILE_WRITE, this);
+        FUNCTION_TEST_PARAM(UINT, slot);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->uring != NULL);
+
+    int actualBytes = storageDriverPosixUringWait(this->uring, slot);
+
+    if (actualBytes != (int)size)
+    {
+        // Report short writes as no space left since that is the usual reason
+        errno = actualBytes < 0 ? -actualBytes : ENOSPC;
+        THROW_SYS_ERROR_FMT(FileWriteError, "unable to write '%s'", strPtr(this->name));
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Wait for all queued writes to complete
+
+Only full slots are queued until the flush at close, so every busy slot must have written a full buffer.
+***********************************************************************************************************************************/
+static void
+storageDriverPosixFileWriteUringWaitAll(StorageDriverPosixFileWrite *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX_FILE_WRITE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->uring != NULL);
+
+    for (unsigned int slotIdx = 0; slotIdx < storageDriverPosixUringDepth(this->uring); slotIdx++)
+    {
+        if (storageDriverPosixUringBusy(this->uring, slotIdx))
+            storageDriverPosixFileWriteUringWait(this, slotIdx, storageDriverPosixUringBufferSize(this->uring));
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Write to a file with io_uring
+
+Data is collected into slot buffers and each full slot is queued so the kernel is writing while the caller produces more data.
+Before a slot is reused the prior write in the slot is checked.  The last partial slot is written at close.
+***********************************************************************************************************************************/
+static void
+storageDriverPosixFileWriteUring(StorageDriverPosixFileWrite *this, const Buffer *buffer)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX_FILE_WRITE, this);
+        FUNCTION_TEST_PARAM(BUFFER, buffer);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->uring != NULL);
+    ASSERT(buffer != NULL);
+
+    size_t bufferSize = storageDriverPosixUringBufferSize(this->uring);
+    size_t bufferUsed = 0;
+
+    while (bufferUsed < bufUsed(buffer))
+    {
+        // Make sure the prior write in the slot has completed before filling it
+        if (this->uringUsed == 0 && storageDriverPosixUringBusy(this->uring, this->uringSlot))
+            storageDriverPosixFileWriteUringWait(this, this->uringSlot, bufferSize);
+
+        // Copy as much as will fit into the slot
+        size_t copySize = bufferSize - this->uringUsed;
+
+        if (copySize > bufUsed(buffer) - bufferUsed)
+            copySize = bufUsed(buffer) - bufferUsed;
+
+        memcpy(
+            storageDriverPosixUringBuffer(this->uring, this->uringSlot) + this->uringUsed, bufPtr(buffer) + bufferUsed, copySize);
+        this->uringUsed += copySize;
+        bufferUsed += copySize;
+
+        // Queue the slot when it is full
+        if (this->uringUsed == bufferSize)
+        {
+            storageDriverPosixUringWrite(this->uring, this->uringSlot, this->handle, this->uringOffset, bufferSize);
+
+            this->uringOffset += bufferSize;
+            this->uringSlot = (this->uringSlot + 1) % storageDriverPosixUringDepth(this->uring);
+            this->uringUsed = 0;
+        }
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Write the last partial slot and wait for all writes to complete
+***********************************************************************************************************************************/
+static void
+storageDriverPosixFileWriteUringFlush(StorageDriverPosixFileWrite *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX_FILE_WRITE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->uring != NULL);
+
+    // Wait for queued slots, including the slot being filled which may still be busy with a full write from the last time around
+    // if nothing has been copied into it yet
+    storageDriverPosixFileWriteUringWaitAll(this);
+
+    // Write the partial slot
+    if (this->uringUsed > 0)
+    {
+        storageDriverPosixUringWrite(this->uring, this->uringSlot, this->handle, this->uringOffset, this->uringUsed);
+        storageDriverPosixFileWriteUringWait(this, this->uringSlot, this->uringUsed);
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Write to a file
 ***********************************************************************************************************************************/
@@ -156,13 +359,148 @@ storageDriverPosixFileWrite(StorageDriverPosixFileWrite *this, const Buffer *buf
     ASSERT(buffer != NULL);
     ASSERT(this->handle != -1);
 
+    // Create the io_uring queue when enabled once the file is large enough to fill the queue.  Smaller files, e.g. info files, are
+    // written with write() since setting up the queue costs more than it saves.  Writes start after any data already written.
+    unsigned int uringDepth = storageDriverPosixUring(this->storage);
+
+    if (!this->uringInit && uringDepth > 0 && this->size + bufUsed(buffer) >= (uint64_t)uringDepth * ioBufferSize())
+    {
+        this->uringInit = true;
+
+        MEM_CONTEXT_BEGIN(this->memContext)
+        {
+            this->uring = storageDriverPosixUringNew(uringDepth, ioBufferSize());
+        }
+        MEM_CONTEXT_END();
+
+        // Don't pay for setup again on every file when io_uring is not available
+        if (this->uring == NULL)
+            storageDriverPosixUringSet(this->storage, 0);
+
+        this->uringOffset = this->size;
+    }
+
     // Write the data
-    if (write(this->handle, bufPtr(buffer), bufUsed(buffer)) != (ssize_t)bufUsed(buffer))
+    if (this->uring != NULL)
+        storageDriverPosixFileWriteUring(this, buffer);
+    else if (write(this->handle, bufPtr(buffer), bufUsed(buffer)) != (ssize_t)bufUsed(buffer))
         THROW_SYS_ERROR_FMT(FileWriteError, "unable to write '%s'", strPtr(this->name));
 
+    this->size += bufUsed(buffer);
+
+    // Write back incrementally so the sync at close does not have to flush the entire file at once, and so written data can be
+    // dropped from the cache
+    if ((this->syncFile || this->noCache) && this->size - this->writebackEnd >= STORAGE_DRIVER_POSIX_CACHE_DROP_SIZE)
+    {
+        // Queued io_uring writes must complete before they can be written back, and the partial slot has not been written yet
+        uint64_t end = this->size;
+
+        if (this->uring != NULL)
+        {
+            storageDriverPosixFileWriteUringWaitAll(this);
+            end = this->uringOffset;
+        }
+
+        storageDriverPosixFileWriteWriteback(this, end);
+    }
+
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Can the kernel copy fall back to another method after this error?  These errors mean the kernel cannot copy these files with the
+method attempted, while any other error (e.g. EIO or ENOSPC) is a real failure that must be reported.
+***********************************************************************************************************************************/
+static bool
+storageDriverPosixFileWriteCopyFallback(int error)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INT, error);
+    FUNCTION_TEST_END();
+
+    FUNCTION_TEST_RETURN(error == EXDEV || error == EINVAL || error == ENOSYS || error == EOPNOTSUPP);
+}
+
+/***********************************************************************************************************************************
+Copy from an open source file in the kernel so the data never passes through user space
+
+copy_file_range() is preferred since filesystems that support reflinks (e.g. XFS, btrfs) can share extents rather than copying data.
+If it cannot copy these files (e.g. across filesystems on older kernels) then sendfile() is used.  Some filesystems (e.g. /proc)
+report a zero size so copy_file_range() returns 0 before anything has been copied -- sendfile() is tried in that case as well.  If
+neither can copy the file then false is returned so the caller can copy through the IO layer instead.  Both calls advance the file
+offsets so the IO layer will resume wherever the kernel copy stopped.
+***********************************************************************************************************************************/
+bool
+storageDriverPosixFileWriteCopy(StorageDriverPosixFileWrite *this, StorageDriverPosixFileRead *source)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_POSIX_FILE_WRITE, this);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_POSIX_FILE_READ, source);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->handle != -1);
+    ASSERT(source != NULL);
+    ASSERT(storageDriverPosixFileReadHandle(source) != -1);
+
+    bool result = true;
+    bool copyRange = !storageDriverPosixFileWriteLocal.copyRangeUnsupported;
+    int handleSource = storageDriverPosixFileReadHandle(source);
+    uint64_t copiedTotal = 0;
+    bool done = false;
+
+    do
+    {
+        ssize_t copied;
+
+        if (copyRange)
+            copied = syscall(SYS_copy_file_range, handleSource, NULL, this->handle, NULL, STORAGE_DRIVER_POSIX_COPY_SIZE, 0);
+        else
+            copied = sendfile(this->handle, handleSource, NULL, STORAGE_DRIVER_POSIX_COPY_SIZE);
+
+        if (copied == -1)
+        {
+            if (!storageDriverPosixFileWriteCopyFallback(errno))
+                THROW_SYS_ERROR_FMT(FileWriteError, "unable to copy to '%s'", strPtr(this->name));
+
+            // Use sendfile() when copy_file_range() cannot copy these files and remember if the kernel does not implement it
+            if (copyRange)
+            {
+                storageDriverPosixFileWriteLocal.copyRangeUnsupported = errno == ENOSYS;
+                copyRange = false;
+            }
+            // Else let the IO layer finish the copy
+            else
+            {
+                result = false;
+                done = true;
+            }
+        }
+        // Nothing copied on the first call may mean the kernel cannot see the size of the file rather than that it is empty
+        else if (copied == 0 && copiedTotal == 0)
+        {
+            // Try sendfile() before giving up on the kernel copy
+            if (copyRange)
+                copyRange = false;
+            // Let the IO layer confirm the file is empty or copy it
+            else
+            {
+                result = false;
+                done = true;
+            }
+        }
+        else
+        {
+            this->size += (uint64_t)copied;
+            copiedTotal += (uint64_t)copied;
+            done = copied == 0;
+        }
+    }
+    while (!done);
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
+
 /***********************************************************************************************************************************
 Close the file
 ***********************************************************************************************************************************/
@@ -178,10 +516,22 @@ storageDriverPosixFileWriteClose(StorageDriverPosixFileWrite *this)
     // Close if the file has not already been closed
     if (this->handle != -1)
     {
+        // Finish io_uring writes so errors are reported before the file is synced
+        if (this->uring != NULL)
+        {
+            storageDriverPosixFileWriteUringFlush(this);
+            storageDriverPosixUringFree(this->uring);
+            this->uring = NULL;
+        }
+
         // Sync the file
         if (this->syncFile)
             storageDriverPosixFileSync(this->handle, this->name, true, false);
 
+        // Drop the file from the cache.  If the file was not synced then pages not yet written back will remain in the cache.
+        if (this->noCache)
+            storageDriverPosixFileCacheDrop(this->handle, this->writebackBegin, 0);
+
         // Close the file
         storageDriverPosixFileClose(this->handle, this->name, true);
 
@@ -12,6 +12,7 @@ Object type
 typedef struct StorageDriverPosixFileWrite StorageDriverPosixFileWrite;
 
 #include "common/type/buffer.h"
+#include "storage/driver/posix/fileRead.h"
 #include "storage/driver/posix/storage.h"
 #include "storage/fileWrite.h"
 
@@ -20,12 +21,13 @@ Constructor
 ***********************************************************************************************************************************/
 StorageDriverPosixFileWrite *storageDriverPosixFileWriteNew(
     StorageDriverPosix *storage, const String *name, mode_t modeFile, mode_t modePath, bool createPath, bool syncFile,
-    bool syncPath, bool atomic);
+    bool syncPath, bool atomic, bool noCache);
 
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
 void storageDriverPosixFileWriteOpen(StorageDriverPosixFileWrite *this);
+bool storageDriverPosixFileWriteCopy(StorageDriverPosixFileWrite *this, StorageDriverPosixFileRead *source);
 void storageDriverPosixFileWrite(StorageDriverPosixFileWrite *this, const Buffer *buffer);
 void storageDriverPosixFileWriteClose(StorageDriverPosixFileWrite *this);
 
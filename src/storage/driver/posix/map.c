@@ -0,0 +1,268 @@
+/***********************************************************************************************************************************
+Posix Memory Mapped File
+***********************************************************************************************************************************/
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "common/debug.h"
+#include "common/log.h"
+#include "common/memContext.h"
+#include "storage/driver/posix/map.h"
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+struct StorageDriverPosixMap
+{
+    MemContext *memContext;                                         // Object memory context
+    unsigned char *map;                                             // Mapped file
+    size_t size;                                                    // Size of mapping
+    volatile bool truncated;                                        // Was the file truncated while mapped? (set by SIGBUS handler)
+
+    StorageDriverPosixMap *next;                                    // Next active mapping
+};
+
+/***********************************************************************************************************************************
+Local variables
+***********************************************************************************************************************************/
+static struct
+{
+    bool handlerInstalled;                                          // Is the SIGBUS handler installed?
+    struct sigaction handlerPrior;                                  // SIGBUS action before the handler was installed
+    size_t pageSize;                                                // System page size
+    StorageDriverPosixMap *mapList;                                 // Active mappings checked by the SIGBUS handler
+} storageDriverPosixMapLocal;
+
+/***********************************************************************************************************************************
+Handle SIGBUS raised by accessing a mapped page past the end of a truncated file
+
+Anonymous zeroed pages are mapped over the mapping from the faulting page to the end so the access can be retried, and the mapping
+is marked as truncated.  If the fault is not in an active mapping then the prior action is restored so the retried access will raise
+the signal again and be handled as it would have been without this handler.
+***********************************************************************************************************************************/
+static void
+storageDriverPosixMapSigBus(int signalType, siginfo_t *signalInfo, void *context)
+{
+    (void)signalType;
+    (void)context;
+
+    unsigned char *address = signalInfo->si_addr;
+
+    for (StorageDriverPosixMap *map = storageDriverPosixMapLocal.mapList; map != NULL;   // {uncoverable - fault is in a mapping}
+         map = map->next)
+    {
+        if (address >= map->map && address < map->map + map->size)                  // {uncoverable - depends on mapping order}
+        {
+            unsigned char *page = map->map + (size_t)(address - map->map) / storageDriverPosixMapLocal.pageSize *
+                storageDriverPosixMapLocal.pageSize;
+
+            if (mmap(                                                   // {uncoverable - mapping over a mapping cannot fail}
+                    page, (size_t)(map->map + map->size - page), PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1,
+                    0) != MAP_FAILED)
+            {
+                map->truncated = true;
+                return;
+            }
+        }
+    }
+
+    sigaction(SIGBUS, &storageDriverPosixMapLocal.handlerPrior, NULL);  // {uncoverable - SIGBUS outside a mapping is fatal}
+}
+
+/***********************************************************************************************************************************
+Map a file.  Returns NULL if the file cannot be mapped so the caller can read it instead.
+***********************************************************************************************************************************/
+StorageDriverPosixMap *
+storageDriverPosixMapNew(int handle, size_t size)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(INT, handle);
+        FUNCTION_LOG_PARAM(SIZE, size);
+    FUNCTION_LOG_END();
+
+    ASSERT(handle != -1);
+    ASSERT(size > 0);
+
+    StorageDriverPosixMap *this = NULL;
+
+    // Map the file.  Not all files can be mapped (e.g. files in /proc).
+    unsigned char *map = mmap(NULL, size, PROT_READ, MAP_SHARED, handle, 0);
+
+    if (map != MAP_FAILED)
+    {
+        // Files are always read from beginning to end so let the kernel read ahead more aggressively.  This is only advice so
+        // errors are ignored.
+        madvise(map, size, MADV_SEQUENTIAL);
+
+        // Install the SIGBUS handler while any file is mapped.  The prior action is restored when the last mapping is freed.
+        if (!storageDriverPosixMapLocal.handlerInstalled)
+        {
+            struct sigaction handler = {.sa_sigaction = storageDriverPosixMapSigBus, .sa_flags = SA_SIGINFO};
+            sigemptyset(&handler.sa_mask);
+
+            THROW_ON_SYS_ERROR(
+                sigaction(SIGBUS, &handler, &storageDriverPosixMapLocal.handlerPrior) == -1, KernelError,
+                "unable to install SIGBUS handler");
+
+            storageDriverPosixMapLocal.pageSize = (size_t)sysconf(_SC_PAGESIZE);
+            storageDriverPosixMapLocal.handlerInstalled = true;
+        }
+
+        MEM_CONTEXT_NEW_BEGIN("StorageDriverPosixMap")
+        {
+            this = memNew(sizeof(StorageDriverPosixMap));
+            this->memContext = MEM_CONTEXT_NEW();
+            this->map = map;
+            this->size = size;
+
+            // Add to the list of active mappings so the SIGBUS handler can find it
+            this->next = storageDriverPosixMapLocal.mapList;
+            storageDriverPosixMapLocal.mapList = this;
+
+            // Set free callback to ensure the mapping is released
+            memContextCallback(this->memContext, (MemContextCallback)storageDriverPosixMapFree, this);
+        }
+        MEM_CONTEXT_NEW_END();
+    }
+
+    FUNCTION_LOG_RETURN(STORAGE_DRIVER_POSIX_MAP, this);
+}
+
+/***********************************************************************************************************************************
+Get a pointer to the mapped file
+***********************************************************************************************************************************/
+const unsigned char *
+storageDriverPosixMapPtr(const StorageDriverPosixMap *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX_MAP, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->map);
+}
+
+/***********************************************************************************************************************************
+Get the size of the mapping
+***********************************************************************************************************************************/
+size_t
+storageDriverPosixMapSize(const StorageDriverPosixMap *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX_MAP, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->size);
+}
+
+/***********************************************************************************************************************************
+Was the file truncated while it was mapped?  If so some of the mapping has been replaced with zeroes.
+***********************************************************************************************************************************/
+bool
+storageDriverPosixMapTruncated(const StorageDriverPosixMap *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX_MAP, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->truncated);
+}
+
+/***********************************************************************************************************************************
+Touch each page of a range so any truncation is detected now rather than when the range is processed.  Truncated pages are replaced
+with zeroes by the SIGBUS handler and storageDriverPosixMapTruncated() will return true.
+***********************************************************************************************************************************/
+void
+storageDriverPosixMapTouch(const StorageDriverPosixMap *this, size_t offset, size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX_MAP, this);
+        FUNCTION_TEST_PARAM(SIZE, offset);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(size > 0);
+    ASSERT(offset + size <= this->size);
+
+    size_t pageSize = storageDriverPosixMapLocal.pageSize;
+
+    // Touch the first byte of each page in the range (the first page may start before the offset)
+    for (size_t pageOffset = offset / pageSize * pageSize; pageOffset < offset + size; pageOffset += pageSize)
+        (void)*(volatile const unsigned char *)(this->map + pageOffset);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Drop a range that has been consumed from the mapping so the pages can be dropped from the cache.  The range is aligned down to page
+boundaries so the page holding the end of the range, which may still be in use, is not dropped.  This is only advice so errors are
+ignored.
+***********************************************************************************************************************************/
+void
+storageDriverPosixMapDrop(StorageDriverPosixMap *this, size_t offset, size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX_MAP, this);
+        FUNCTION_TEST_PARAM(SIZE, offset);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(offset + size <= this->size);
+
+    size_t pageSize = storageDriverPosixMapLocal.pageSize;
+    size_t begin = offset / pageSize * pageSize;
+
+    madvise(this->map + begin, (offset + size) / pageSize * pageSize - begin, MADV_DONTNEED);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Unmap the file
+***********************************************************************************************************************************/
+void
+storageDriverPosixMapFree(StorageDriverPosixMap *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_POSIX_MAP, this);
+    FUNCTION_LOG_END();
+
+    if (this != NULL)
+    {
+        // Remove from the list of active mappings before unmapping so the SIGBUS handler never sees a stale mapping
+        StorageDriverPosixMap **map = &storageDriverPosixMapLocal.mapList;
+
+        while (*map != this)
+            map = &(*map)->next;
+
+        *map = this->next;
+
+        munmap(this->map, this->size);
+
+        // Restore the prior SIGBUS action when nothing is mapped so the handler does not outlive the mappings it protects.  This
+        // may be called from a free callback so only warn on error.  The handler then stays installed and passes signals to the
+        // prior action, so it is left marked as installed to avoid saving it as the prior action later.
+        if (storageDriverPosixMapLocal.mapList == NULL)
+        {
+            if (sigaction(SIGBUS, &storageDriverPosixMapLocal.handlerPrior, NULL) == -1)      // {uncoverable - cannot fail}
+                LOG_WARN("unable to restore SIGBUS action: [%d] %s", errno, strerror(errno));   // {+uncoverable}
+            else
+                storageDriverPosixMapLocal.handlerInstalled = false;
+        }
+
+        memContextCallbackClear(this->memContext);
+        memContextFree(this->memContext);
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
@@ -0,0 +1,57 @@
+/***********************************************************************************************************************************
+Posix Memory Mapped File
+
+Maps a file read-only so the contents can be passed to filters without first being copied into buffers.
+
+If the file is truncated while it is mapped then accessing pages past the new end of the file raises SIGBUS.  A handler maps zeroed
+pages over the rest of the mapping so processing can continue and storageDriverPosixMapTruncated() reports the truncation so the
+caller can throw an error rather than return bad data.
+
+The SIGBUS handler is process-wide so it is only installed while at least one file is mapped and the prior action is restored when
+the last mapping is freed.  Nothing else in the process handles SIGBUS (exit.c handles only SIGHUP, SIGINT, and SIGTERM, and ignores
+SIGPIPE) so outside of mappings SIGBUS keeps its default action.  A SIGBUS that is not in an active mapping restores the prior action
+so the retried access is handled as if the handler had never been installed.
+***********************************************************************************************************************************/
+#ifndef STORAGE_DRIVER_POSIX_MAP_H
+#define STORAGE_DRIVER_POSIX_MAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef struct StorageDriverPosixMap StorageDriverPosixMap;
+
+/***********************************************************************************************************************************
+Constructor
+***********************************************************************************************************************************/
+StorageDriverPosixMap *storageDriverPosixMapNew(int handle, size_t size);
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+void storageDriverPosixMapDrop(StorageDriverPosixMap *this, size_t offset, size_t size);
+void storageDriverPosixMapTouch(const StorageDriverPosixMap *this, size_t offset, size_t size);
+
+/***********************************************************************************************************************************
+Getters
+***********************************************************************************************************************************/
+const unsigned char *storageDriverPosixMapPtr(const StorageDriverPosixMap *this);
+size_t storageDriverPosixMapSize(const StorageDriverPosixMap *this);
+bool storageDriverPosixMapTruncated(const StorageDriverPosixMap *this);
+
+/***********************************************************************************************************************************
+Destructor
+***********************************************************************************************************************************/
+void storageDriverPosixMapFree(StorageDriverPosixMap *this);
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+#define FUNCTION_LOG_STORAGE_DRIVER_POSIX_MAP_TYPE                                                                                 \
+    StorageDriverPosixMap *
+#define FUNCTION_LOG_STORAGE_DRIVER_POSIX_MAP_FORMAT(value, buffer, bufferSize)                                                    \
+    objToLog(value, "StorageDriverPosixMap", buffer, bufferSize)
+
+#endif
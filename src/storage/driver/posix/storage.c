@@ -5,7 +5,9 @@ Posix Storage Driver
 #include <errno.h>
 #include <fcntl.h>
 #include <stdio.h>
+#include <string.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
 #include "common/debug.h"
@@ -27,8 +29,188 @@ struct StorageDriverPosix
 {
     MemContext *memContext;                                         // Object memory context
     Storage *interface;                                             // Driver interface
+
+    String *listExpression;                                         // Expression for the cached list filter
+    RegExp *listRegExp;                                             // Compiled expression (NULL when prefix is sufficient)
+    String *listPrefix;                                             // Constant prefix of the expression, if any
+
+    uint64_t mmapSizeMax;                                           // Largest file to read with mmap() (0 to disable)
+    unsigned int uringDepth;                                        // io_uring requests in flight per file (0 to disable)
 };
 
+/***********************************************************************************************************************************
+Directory reader
+
+When getdents64() is available entries are read directly into a large buffer so directories with many entries (e.g. pg_wal or a
+large database) are read with few system calls and names can be filtered in place without creating a String for each entry.
+Otherwise readdir() is used.
+
+A subpath opened while its parent is being read shares the parent's buffer so a recursive list uses a single buffer no matter how
+deep it goes.  Any entries the parent had buffered are discarded and the parent seeks back to the first of them to read them again.
+***********************************************************************************************************************************/
+#define STORAGE_DRIVER_POSIX_DIR_BUFFER_SIZE                        (256 * 1024)
+
+typedef struct StorageDriverPosixDir
+{
+    const char *path;                                               // Path being read (for error messages)
+    int handle;                                                     // Directory handle
+
+#ifdef SYS_getdents64
+    char *buffer;                                                   // Entries read from the kernel (shared with subpaths)
+    bool bufferOwner;                                               // Was the buffer allocated by this reader?
+    size_t bufferUsed;                                              // Bytes in the buffer
+    size_t bufferPos;                                               // Position of the next entry in the buffer
+    off_t offset;                                                   // Directory offset of the next entry in the buffer
+#else
+    DIR *dir;                                                       // Directory stream
+#endif
+} StorageDriverPosixDir;
+
+/***********************************************************************************************************************************
+Open a directory for reading.  When parent is NULL the name is a path.  Otherwise it is the name of a subpath of the parent, which
+is opened relative to the parent handle.  Returns false with errno set if the directory could not be opened so the caller can decide
+which errors to report.
+***********************************************************************************************************************************/
+static bool
+storageDriverPosixDirOpen(StorageDriverPosixDir *this, StorageDriverPosixDir *parent, const char *name, const char *path)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+        FUNCTION_TEST_PARAM_P(VOID, parent);
+        FUNCTION_TEST_PARAM(STRINGZ, name);
+        FUNCTION_TEST_PARAM(STRINGZ, path);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(name != NULL);
+    ASSERT(path != NULL);
+
+    *this = (StorageDriverPosixDir)
+    {
+        .path = path,
+        .handle = openat(parent == NULL ? AT_FDCWD : parent->handle, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC),
+    };
+
+    if (this->handle != -1)
+    {
+#ifdef SYS_getdents64
+        if (parent == NULL)
+        {
+            this->buffer = memNewRaw(STORAGE_DRIVER_POSIX_DIR_BUFFER_SIZE);
+            this->bufferOwner = true;
+        }
+        else
+        {
+            this->buffer = parent->buffer;
+
+            // Entries the parent has not consumed yet will be overwritten so it must read them again
+            if (parent->bufferPos < parent->bufferUsed)
+            {
+                if (lseek(parent->handle, parent->offset, SEEK_SET) == -1)                  // {uncoverable - offset is from kernel}
+                    THROW_SYS_ERROR_FMT(PathOpenError, "unable to seek path '%s'", parent->path);   // {+uncoverable}
+            }
+
+            parent->bufferUsed = 0;
+            parent->bufferPos = 0;
+        }
+#else
+        this->dir = fdopendir(this->handle);
+
+        if (this->dir == NULL)
+        {
+            close(this->handle);
+            THROW_SYS_ERROR_FMT(PathOpenError, "unable to open path '%s' for read", path);
+        }
+#endif
+    }
+
+    FUNCTION_TEST_RETURN(this->handle != -1);
+}
+
+/***********************************************************************************************************************************
+Get the next entry name in a directory, skipping the current and parent directory.  NULL is returned when there are no more
+entries.  The name is only valid until the next call or until a subpath is opened.
+***********************************************************************************************************************************/
+static const char *
+storageDriverPosixDirNext(StorageDriverPosixDir *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->handle != -1);
+
+    const char *result = NULL;
+
+    do
+    {
+#ifdef SYS_getdents64
+        // Read more entries when the buffer has been consumed
+        if (this->bufferPos == this->bufferUsed)
+        {
+            long bufferUsed = syscall(SYS_getdents64, this->handle, this->buffer, STORAGE_DRIVER_POSIX_DIR_BUFFER_SIZE);
+
+            if (bufferUsed == -1)                                                           // {uncoverable - no known error}
+                THROW_SYS_ERROR_FMT(PathOpenError, "unable to read path '%s'", this->path); // {+uncoverable}
+
+            // No more entries
+            if (bufferUsed == 0)
+                break;
+
+            this->bufferUsed = (size_t)bufferUsed;
+            this->bufferPos = 0;
+        }
+
+        // The entry offset is where the directory continues after the entry so it is where to seek if the buffer is lost
+        const struct dirent64 *entry = (const struct dirent64 *)(this->buffer + this->bufferPos);
+        this->bufferPos += entry->d_reclen;
+        this->offset = entry->d_off;
+#else
+        const struct dirent *entry = readdir(this->dir);
+
+        if (entry == NULL)
+            break;
+#endif
+        result = entry->d_name;
+
+        // Skip current/parent directory
+        if (result[0] == '.' && (result[1] == '\0' || (result[1] == '.' && result[2] == '\0')))
+            result = NULL;
+    }
+    while (result == NULL);
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Close a directory
+***********************************************************************************************************************************/
+static void
+storageDriverPosixDirClose(StorageDriverPosixDir *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    if (this->handle != -1)
+    {
+#ifdef SYS_getdents64
+        if (this->bufferOwner)
+            memFree(this->buffer);
+
+        close(this->handle);
+#else
+        closedir(this->dir);
+#endif
+        this->handle = -1;
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 New object
 ***********************************************************************************************************************************/
@@ -59,7 +241,8 @@ storageDriverPosixNew(
         this->interface = storageNewP(
             STORAGE_DRIVER_POSIX_TYPE_STR, path, modeFile, modePath, write, pathExpressionFunction, this,
             .exists = (StorageInterfaceExists)storageDriverPosixExists, .info = (StorageInterfaceInfo)storageDriverPosixInfo,
-            .list = (StorageInterfaceList)storageDriverPosixList, .move = (StorageInterfaceMove)storageDriverPosixMove,
+            .list = (StorageInterfaceList)storageDriverPosixList, .listInfo = (StorageInterfaceListInfo)storageDriverPosixListInfo,
+            .move = (StorageInterfaceMove)storageDriverPosixMove,
             .newRead = (StorageInterfaceNewRead)storageDriverPosixNewRead,
             .newWrite = (StorageInterfaceNewWrite)storageDriverPosixNewWrite,
             .pathCreate = (StorageInterfacePathCreate)storageDriverPosixPathCreate,
@@ -104,6 +287,42 @@ storageDriverPosixExists(StorageDriverPosix *this, const String *path)
     FUNCTION_LOG_RETURN(BOOL, result);
 }
 
+/***********************************************************************************************************************************
+Load info from a stat structure.  Returns false if the type is not supported, e.g. a socket or pipe.
+***********************************************************************************************************************************/
+static bool
+storageDriverPosixInfoStat(StorageInfo *info, const struct stat *statFile)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, info);
+        FUNCTION_TEST_PARAM_P(VOID, statFile);
+    FUNCTION_TEST_END();
+
+    ASSERT(info != NULL);
+    ASSERT(statFile != NULL);
+
+    bool result = true;
+
+    info->exists = true;
+
+    if (S_ISREG(statFile->st_mode))
+    {
+        info->type = storageTypeFile;
+        info->size = (size_t)statFile->st_size;
+    }
+    else if (S_ISDIR(statFile->st_mode))
+        info->type = storageTypePath;
+    else if (S_ISLNK(statFile->st_mode))
+        info->type = storageTypeLink;
+    else
+        result = false;
+
+    info->mode = statFile->st_mode & (S_IRWXU | S_IRWXG | S_IRWXO);
+    info->timeModified = statFile->st_mtime;
+
+    FUNCTION_TEST_RETURN(result);
+}
+
 /***********************************************************************************************************************************
 File/path info
 ***********************************************************************************************************************************/
@@ -130,26 +349,206 @@ storageDriverPosixInfo(StorageDriverPosix *this, const String *file, bool ignore
             THROW_SYS_ERROR_FMT(FileOpenError, "unable to get info for '%s'", strPtr(file));
     }
     // On success load info into a structure
-    else
+    else if (!storageDriverPosixInfoStat(&result, &statFile))
+        THROW_FMT(FileInfoError, "invalid type for '%s'", strPtr(file));
+
+    FUNCTION_LOG_RETURN(STORAGE_INFO, result);
+}
+
+/***********************************************************************************************************************************
+Get info for the contents of an open directory and recurse into subpaths when requested.  Each entry is stat'd (and each subpath
+opened) relative to the directory handle so the kernel does not need to resolve the full path again for every entry.
+***********************************************************************************************************************************/
+static void
+storageDriverPosixListInfoDir(
+    StorageDriverPosixDir *dir, const String *name, bool recurse, StorageListInfoCallback callback, void *callbackData)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM_P(VOID, dir);
+        FUNCTION_LOG_PARAM(STRING, name);
+        FUNCTION_LOG_PARAM(BOOL, recurse);
+        FUNCTION_LOG_PARAM(FUNCTIONP, callback);
+        FUNCTION_LOG_PARAM_P(VOID, callbackData);
+    FUNCTION_LOG_END();
+
+    ASSERT(dir != NULL);
+    ASSERT(callback != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
     {
-        result.exists = true;
+        const char *entry = storageDriverPosixDirNext(dir);
 
-        if (S_ISREG(statFile.st_mode))
+        while (entry != NULL)
         {
-            result.type = storageTypeFile;
-            result.size = (size_t)statFile.st_size;
+            struct stat statFile;
+
+            if (fstatat(dir->handle, entry, &statFile, AT_SYMLINK_NOFOLLOW) == -1)
+            {
+                // Files may be removed while the directory is being scanned, e.g. WAL being recycled
+                if (errno != ENOENT)
+                    THROW_SYS_ERROR_FMT(FileOpenError, "unable to get info for '%s/%s'", dir->path, entry);
+            }
+            else
+            {
+                StorageInfo info = {0};
+
+                // Skip types that cannot be stored, e.g. sockets and pipes
+                if (storageDriverPosixInfoStat(&info, &statFile))
+                {
+                    String *entryName = name == NULL ? strNew(entry) : strNewFmt("%s/%s", strPtr(name), entry);
+                    info.name = entryName;
+
+                    callback(callbackData, &info);
+
+                    // Recurse into the path after it has been reported
+                    if (recurse && info.type == storageTypePath)
+                    {
+                        String *pathSub = strNewFmt("%s/%s", dir->path, entry);
+                        StorageDriverPosixDir dirSub = {.handle = -1};
+
+                        TRY_BEGIN()
+                        {
+                            // The path may have been removed since it was read
+                            if (!storageDriverPosixDirOpen(&dirSub, dir, entry, strPtr(pathSub)))
+                            {
+                                if (errno != ENOENT)
+                                    THROW_SYS_ERROR_FMT(PathOpenError, "unable to open path '%s' for read", strPtr(pathSub));
+                            }
+                            else
+                                storageDriverPosixListInfoDir(&dirSub, entryName, recurse, callback, callbackData);
+                        }
+                        FINALLY()
+                        {
+                            storageDriverPosixDirClose(&dirSub);
+                        }
+                        TRY_END();
+
+                        strFree(pathSub);
+                    }
+
+                    strFree(entryName);
+                }
+            }
+
+            entry = storageDriverPosixDirNext(dir);
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Get info for the contents of a path
+***********************************************************************************************************************************/
+bool
+storageDriverPosixListInfo(
+    StorageDriverPosix *this, const String *path, bool errorOnMissing, bool recurse, StorageListInfoCallback callback,
+    void *callbackData)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_POSIX, this);
+        FUNCTION_LOG_PARAM(STRING, path);
+        FUNCTION_LOG_PARAM(BOOL, errorOnMissing);
+        FUNCTION_LOG_PARAM(BOOL, recurse);
+        FUNCTION_LOG_PARAM(FUNCTIONP, callback);
+        FUNCTION_LOG_PARAM_P(VOID, callbackData);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(path != NULL);
+    ASSERT(callback != NULL);
+
+    bool result = false;
+    StorageDriverPosixDir dir = {.handle = -1};
+
+    TRY_BEGIN()
+    {
+        // Open the directory for read.  If the directory could not be opened process errors but ignore missing directories when
+        // specified.
+        if (!storageDriverPosixDirOpen(&dir, NULL, strPtr(path), strPtr(path)))
+        {
+            if (errorOnMissing || errno != ENOENT)
+                THROW_SYS_ERROR_FMT(PathOpenError, "unable to open path '%s' for read", strPtr(path));
         }
-        else if (S_ISDIR(statFile.st_mode))
-            result.type = storageTypePath;
-        else if (S_ISLNK(statFile.st_mode))
-            result.type = storageTypeLink;
         else
-            THROW_FMT(FileInfoError, "invalid type for '%s'", strPtr(file));
+        {
+            storageDriverPosixListInfoDir(&dir, NULL, recurse, callback, callbackData);
+            result = true;
+        }
+    }
+    FINALLY()
+    {
+        storageDriverPosixDirClose(&dir);
+    }
+    TRY_END();
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
 
-        result.mode = statFile.st_mode & (S_IRWXU | S_IRWXG | S_IRWXO);
+/***********************************************************************************************************************************
+Set the filter used to match names when listing.  The compiled expression is cached since the same expression is often used to list
+many paths, e.g. WAL segments in each archive path.  If the expression is only a constant prefix then the name is matched with a
+simple compare and the expression is not compiled at all.  Otherwise the prefix (if any) is used to quickly reject names before
+running the expression.
+***********************************************************************************************************************************/
+static void
+storageDriverPosixListFilterSet(StorageDriverPosix *this, const String *expression)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX, this);
+        FUNCTION_TEST_PARAM(STRING, expression);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(expression != NULL);
+
+    if (this->listExpression == NULL || !strEq(this->listExpression, expression))
+    {
+        // Free the prior filter
+        strFree(this->listExpression);
+        regExpFree(this->listRegExp);
+        strFree(this->listPrefix);
+
+        this->listExpression = NULL;
+        this->listRegExp = NULL;
+        this->listPrefix = NULL;
+
+        MEM_CONTEXT_BEGIN(this->memContext)
+        {
+            // Compile the expression unless it is only an anchor and a prefix
+            String *prefix = regExpPrefix(expression);
+            RegExp *regExp = prefix != NULL && strSize(prefix) + 1 == strSize(expression) ? NULL : regExpNew(expression);
+
+            // Set the expression last so the filter is not cached if the expression is invalid
+            this->listPrefix = prefix;
+            this->listRegExp = regExp;
+            this->listExpression = strDup(expression);
+        }
+        MEM_CONTEXT_END();
     }
 
-    FUNCTION_LOG_RETURN(STORAGE_INFO, result);
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Does a name match the filter set with storageDriverPosixListFilterSet()?
+***********************************************************************************************************************************/
+static bool
+storageDriverPosixListFilterMatch(StorageDriverPosix *this, const char *name)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX, this);
+        FUNCTION_TEST_PARAM(STRINGZ, name);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->listExpression != NULL);
+    ASSERT(name != NULL);
+
+    FUNCTION_TEST_RETURN(
+        (this->listPrefix == NULL || strncmp(name, strPtr(this->listPrefix), strSize(this->listPrefix)) == 0) &&
+        (this->listRegExp == NULL || regExpMatchZ(this->listRegExp, name)));
 }
 
 /***********************************************************************************************************************************
@@ -169,55 +568,41 @@ storageDriverPosixList(StorageDriverPosix *this, const String *path, bool errorO
     ASSERT(path != NULL);
 
     StringList *result = NULL;
-    DIR *dir = NULL;
+    StorageDriverPosixDir dir = {.handle = -1};
 
     TRY_BEGIN()
     {
-        // Open the directory for read
-        dir = opendir(strPtr(path));
-
-        // If the directory could not be opened process errors but ignore missing directories when specified
-        if (!dir)
+        // Open the directory for read.  If the directory could not be opened process errors but ignore missing directories when
+        // specified.
+        if (!storageDriverPosixDirOpen(&dir, NULL, strPtr(path), strPtr(path)))
         {
             if (errorOnMissing || errno != ENOENT)
                 THROW_SYS_ERROR_FMT(PathOpenError, "unable to open path '%s' for read", strPtr(path));
         }
         else
         {
-            MEM_CONTEXT_TEMP_BEGIN()
-            {
-                // Prepare regexp if an expression was passed
-                RegExp *regExp = (expression == NULL) ? NULL : regExpNew(expression);
-
-                // Create the string list now that we know the directory is valid
-                result = strLstNew();
+            // Prepare the filter if an expression was passed
+            if (expression != NULL)
+                storageDriverPosixListFilterSet(this, expression);
 
-                // Read the directory entries
-                struct dirent *dirEntry = readdir(dir);
+            // Create the string list now that we know the directory is valid
+            result = strLstNew();
 
-                while (dirEntry != NULL)
-                {
-                    String *entry = strNew(dirEntry->d_name);
-
-                    // Exclude current/parent directory and apply the expression if specified
-                    if (!strEqZ(entry, ".") && !strEqZ(entry, "..") && (regExp == NULL || regExpMatch(regExp, entry)))
-                        strLstAdd(result, entry);
+            // Read the directory entries.  Names are matched in place so only entries added to the list are copied.
+            const char *entry = storageDriverPosixDirNext(&dir);
 
-                    strFree(entry);
-
-                    dirEntry = readdir(dir);
-                }
+            while (entry != NULL)
+            {
+                if (expression == NULL || storageDriverPosixListFilterMatch(this, entry))
+                    strLstAddZ(result, entry);
 
-                // Move finished list up to the old context
-                strLstMove(result, MEM_CONTEXT_OLD());
+                entry = storageDriverPosixDirNext(&dir);
             }
-            MEM_CONTEXT_TEMP_END();
         }
     }
     FINALLY()
     {
-        if (dir != NULL)
-            closedir(dir);
+        storageDriverPosixDirClose(&dir);
     }
     TRY_END();
 
@@ -293,22 +678,24 @@ storageDriverPosixMove(StorageDriverPosix *this, StorageDriverPosixFileRead *sou
 }
 
 /***********************************************************************************************************************************
-New file read object
+New file read object.  Local reads are not transferred so compressible is ignored.
 ***********************************************************************************************************************************/
 StorageFileRead *
-storageDriverPosixNewRead(StorageDriverPosix *this, const String *file, bool ignoreMissing)
+storageDriverPosixNewRead(StorageDriverPosix *this, const String *file, bool ignoreMissing, bool noCache, bool compressible)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_DRIVER_POSIX, this);
         FUNCTION_LOG_PARAM(STRING, file);
         FUNCTION_LOG_PARAM(BOOL, ignoreMissing);
+        FUNCTION_LOG_PARAM(BOOL, noCache);
+        FUNCTION_LOG_PARAM(BOOL, compressible);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
     ASSERT(file != NULL);
 
     FUNCTION_LOG_RETURN(
-        STORAGE_FILE_READ, storageDriverPosixFileReadInterface(storageDriverPosixFileReadNew(this, file, ignoreMissing)));
+        STORAGE_FILE_READ, storageDriverPosixFileReadInterface(storageDriverPosixFileReadNew(this, file, ignoreMissing, noCache)));
 }
 
 /***********************************************************************************************************************************
@@ -317,7 +704,7 @@ New file write object
 StorageFileWrite *
 storageDriverPosixNewWrite(
     StorageDriverPosix *this, const String *file, mode_t modeFile, mode_t modePath, bool createPath, bool syncFile, bool syncPath,
-    bool atomic)
+    bool atomic, bool noCache)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_DRIVER_POSIX, this);
@@ -328,6 +715,7 @@ storageDriverPosixNewWrite(
         FUNCTION_LOG_PARAM(BOOL, syncFile);
         FUNCTION_LOG_PARAM(BOOL, syncPath);
         FUNCTION_LOG_PARAM(BOOL, atomic);
+        FUNCTION_LOG_PARAM(BOOL, noCache);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -336,7 +724,7 @@ storageDriverPosixNewWrite(
     FUNCTION_LOG_RETURN(
         STORAGE_FILE_WRITE,
         storageDriverPosixFileWriteInterface(
-            storageDriverPosixFileWriteNew(this, file, modeFile, modePath, createPath, syncFile, syncPath, atomic)));
+            storageDriverPosixFileWriteNew(this, file, modeFile, modePath, createPath, syncFile, syncPath, atomic, noCache)));
 }
 
 /***********************************************************************************************************************************
@@ -488,7 +876,7 @@ storageDriverPosixRemove(StorageDriverPosix *this, const String *file, bool erro
 }
 
 /***********************************************************************************************************************************
-Getters
+Getters/Setters
 ***********************************************************************************************************************************/
 Storage *
 storageDriverPosixInterface(const StorageDriverPosix *this)
@@ -502,6 +890,77 @@ storageDriverPosixInterface(const StorageDriverPosix *this)
     FUNCTION_TEST_RETURN(this->interface);
 }
 
+/***********************************************************************************************************************************
+Largest file to read with mmap() (0 when mmap() is not used)
+***********************************************************************************************************************************/
+uint64_t
+storageDriverPosixMmap(const StorageDriverPosix *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->mmapSizeMax);
+}
+
+/***********************************************************************************************************************************
+Read files up to sizeMax bytes with mmap() so filters can process the data without it being copied.  Larger files are read with
+read() (or io_uring) since mapping them would use too much address space and page tables.
+
+mmap() is disabled by default since a SIGBUS handler is installed for the whole process while any file is mapped, so callers must
+opt in.
+***********************************************************************************************************************************/
+void
+storageDriverPosixMmapSet(StorageDriverPosix *this, uint64_t sizeMax)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_POSIX, this);
+        FUNCTION_LOG_PARAM(UINT64, sizeMax);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    this->mmapSizeMax = sizeMax;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Number of io_uring requests in flight per file (0 when io_uring is not used)
+***********************************************************************************************************************************/
+unsigned int
+storageDriverPosixUring(const StorageDriverPosix *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->uringDepth);
+}
+
+/***********************************************************************************************************************************
+Read and write files with io_uring, keeping up to depth requests in flight per file.  If io_uring is not available then regular
+system calls are used.
+***********************************************************************************************************************************/
+void
+storageDriverPosixUringSet(StorageDriverPosix *this, unsigned int depth)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_POSIX, this);
+        FUNCTION_LOG_PARAM(UINT, depth);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    this->uringDepth = depth;
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Free the file
 ***********************************************************************************************************************************/
@@ -24,6 +24,16 @@ Driver type constant
 #define STORAGE_DRIVER_POSIX_TYPE                                   "posix"
     STRING_DECLARE(STORAGE_DRIVER_POSIX_TYPE_STR);
 
+/***********************************************************************************************************************************
+Default number of io_uring requests to keep in flight per file
+***********************************************************************************************************************************/
+#define STORAGE_DRIVER_POSIX_URING_DEPTH_DEFAULT                    4
+
+/***********************************************************************************************************************************
+Default size of the largest file to read with mmap()
+***********************************************************************************************************************************/
+#define STORAGE_DRIVER_POSIX_MMAP_SIZE_DEFAULT                      ((uint64_t)64 * 1024 * 1024)
+
 /***********************************************************************************************************************************
 Constructor
 ***********************************************************************************************************************************/
@@ -36,11 +46,15 @@ Functions
 bool storageDriverPosixExists(StorageDriverPosix *this, const String *path);
 StorageInfo storageDriverPosixInfo(StorageDriverPosix *this, const String *file, bool ignoreMissing);
 StringList *storageDriverPosixList(StorageDriverPosix *this, const String *path, bool errorOnMissing, const String *expression);
+bool storageDriverPosixListInfo(
+    StorageDriverPosix *this, const String *path, bool errorOnMissing, bool recurse, StorageListInfoCallback callback,
+    void *callbackData);
 bool storageDriverPosixMove(StorageDriverPosix *this, StorageDriverPosixFileRead *source, StorageDriverPosixFileWrite *destination);
-StorageFileRead *storageDriverPosixNewRead(StorageDriverPosix *this, const String *file, bool ignoreMissing);
+StorageFileRead *storageDriverPosixNewRead(
+    StorageDriverPosix *this, const String *file, bool ignoreMissing, bool noCache, bool compressible);
 StorageFileWrite *storageDriverPosixNewWrite(
     StorageDriverPosix *this, const String *file, mode_t modeFile, mode_t modePath, bool createPath, bool syncFile, bool syncPath,
-    bool atomic);
+    bool atomic, bool noCache);
 void storageDriverPosixPathCreate(
     StorageDriverPosix *this, const String *path, bool errorOnExists, bool noParentCreate, mode_t mode);
 void storageDriverPosixPathRemove(StorageDriverPosix *this, const String *path, bool errorOnMissing, bool recurse);
@@ -48,9 +62,13 @@ void storageDriverPosixPathSync(StorageDriverPosix *this, const String *path, bo
 void storageDriverPosixRemove(StorageDriverPosix *this, const String *file, bool errorOnMissing);
 
 /***********************************************************************************************************************************
-Getters
+Getters/Setters
 ***********************************************************************************************************************************/
 Storage *storageDriverPosixInterface(const StorageDriverPosix *this);
+uint64_t storageDriverPosixMmap(const StorageDriverPosix *this);
+void storageDriverPosixMmapSet(StorageDriverPosix *this, uint64_t sizeMax);
+unsigned int storageDriverPosixUring(const StorageDriverPosix *this);
+void storageDriverPosixUringSet(StorageDriverPosix *this, unsigned int depth);
 
 /***********************************************************************************************************************************
 Destructor
@@ -0,0 +1,462 @@
+/***********************************************************************************************************************************
+Posix io_uring Queue
+***********************************************************************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+/***********************************************************************************************************************************
+io_uring is only built when both the system call and the kernel header are available.  The header must be new enough to have
+IORING_FEAT_SINGLE_MMAP since only kernels that map both rings at once are supported (5.4+).
+***********************************************************************************************************************************/
+#if defined(SYS_io_uring_setup) && defined(__has_include)
+    #if __has_include(<linux/io_uring.h>)
+        #include <linux/io_uring.h>
+
+        #ifdef IORING_FEAT_SINGLE_MMAP
+            #define STORAGE_DRIVER_POSIX_URING_BUILD
+        #endif
+    #endif
+#endif
+
+#include "common/debug.h"
+#include "common/log.h"
+#include "common/memContext.h"
+#include "storage/driver/posix/uring.h"
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef struct StorageDriverPosixUringSlot
+{
+    bool busy;                                                      // Is a request in flight?
+    int result;                                                     // Result of the last completed request (-errno on error)
+} StorageDriverPosixUringSlot;
+
+struct StorageDriverPosixUring
+{
+    MemContext *memContext;                                         // Object memory context
+    unsigned int depth;                                             // Number of slots
+    size_t bufferSize;                                              // Size of each slot buffer
+    unsigned char *buffer;                                          // Slot buffers (registered with the kernel)
+    StorageDriverPosixUringSlot *slotList;                          // Slot state
+
+    int handle;                                                     // Ring handle
+    void *ring;                                                     // Submission and completion rings (one mapping)
+    size_t ringSize;                                                // Size of ring mapping
+    void *sqeList;                                                  // Submission queue entries
+    size_t sqeListSize;                                             // Size of submission queue entry mapping
+    unsigned int submitTotal;                                       // Entries queued but not yet submitted
+
+    unsigned int *sqTail;                                           // Submission queue tail (written by us)
+    unsigned int *sqMask;                                           // Submission queue index mask
+    unsigned int *sqArray;                                          // Submission queue index array
+    unsigned int *cqHead;                                           // Completion queue head (written by us)
+    unsigned int *cqTail;                                           // Completion queue tail (written by the kernel)
+    unsigned int *cqMask;                                           // Completion queue index mask
+    void *cqeList;                                                  // Completion queue entries
+};
+
+#ifdef STORAGE_DRIVER_POSIX_URING_BUILD
+
+/***********************************************************************************************************************************
+Create the rings and register the slot buffers.  Returns 0 on success or the errno that prevented io_uring from being initialized.
+***********************************************************************************************************************************/
+static int
+storageDriverPosixUringInit(StorageDriverPosixUring *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX_URING, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    int result = 0;
+    struct io_uring_params params = {0};
+
+    // Create the ring.  This fails when the kernel does not support io_uring or it has been disabled.
+    this->handle = (int)syscall(SYS_io_uring_setup, this->depth, &params);
+
+    if (this->handle == -1)
+        result = errno;
+    // Only kernels that map both rings at once are supported to keep things simple
+    else if (!(params.features & IORING_FEAT_SINGLE_MMAP))          // {uncoverable - test kernels are all newer}
+    {
+        close(this->handle);                                        // {+uncoverable}
+        this->handle = -1;                                          // {+uncoverable}
+        result = EOPNOTSUPP;                                        // {+uncoverable}
+    }
+
+    if (this->handle != -1)
+    {
+        // Map the rings
+        size_t sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+        size_t cqSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        this->ringSize = sqSize > cqSize ? sqSize : cqSize;
+
+        this->ring = mmap(
+            NULL, this->ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->handle, IORING_OFF_SQ_RING);
+
+        this->sqeListSize = params.sq_entries * sizeof(struct io_uring_sqe);
+        this->sqeList = mmap(
+            NULL, this->sqeListSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->handle, IORING_OFF_SQES);
+
+        // Older kernels count the mappings against the locked memory limit so they can fail like registering the buffers below
+        if (this->ring == MAP_FAILED || this->sqeList == MAP_FAILED)  // {uncoverable - test kernels do not count the rings}
+            result = errno;                                         // {+uncoverable}
+    }
+
+    if (result == 0)
+    {
+        unsigned char *ring = this->ring;
+        this->sqTail = (unsigned int *)(ring + params.sq_off.tail);
+        this->sqMask = (unsigned int *)(ring + params.sq_off.ring_mask);
+        this->sqArray = (unsigned int *)(ring + params.sq_off.array);
+        this->cqHead = (unsigned int *)(ring + params.cq_off.head);
+        this->cqTail = (unsigned int *)(ring + params.cq_off.tail);
+        this->cqMask = (unsigned int *)(ring + params.cq_off.ring_mask);
+        this->cqeList = ring + params.cq_off.cqes;
+
+        // Register the slot buffers so the kernel does not need to map them for each request.  This can fail when the buffers
+        // exceed the locked memory limit.
+        struct iovec *bufferList = memNew(sizeof(struct iovec) * this->depth);
+
+        for (unsigned int slotIdx = 0; slotIdx < this->depth; slotIdx++)
+        {
+            bufferList[slotIdx] = (struct iovec)
+            {
+                .iov_base = storageDriverPosixUringBuffer(this, slotIdx),
+                .iov_len = this->bufferSize,
+            };
+        }
+
+        if (syscall(SYS_io_uring_register, this->handle, IORING_REGISTER_BUFFERS, bufferList, this->depth) == -1)
+            result = errno;
+
+        memFree(bufferList);
+    }
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+#endif
+
+/***********************************************************************************************************************************
+Create a new queue.  Returns NULL if io_uring is not available.
+***********************************************************************************************************************************/
+StorageDriverPosixUring *
+storageDriverPosixUringNew(unsigned int depth, size_t bufferSize)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(UINT, depth);
+        FUNCTION_LOG_PARAM(SIZE, bufferSize);
+    FUNCTION_LOG_END();
+
+    ASSERT(depth > 0);
+    ASSERT(bufferSize > 0);
+
+    StorageDriverPosixUring *this = NULL;
+
+#ifdef STORAGE_DRIVER_POSIX_URING_BUILD
+    int error = 0;
+
+    MEM_CONTEXT_NEW_BEGIN("StorageDriverPosixUring")
+    {
+        this = memNew(sizeof(StorageDriverPosixUring));
+        this->memContext = MEM_CONTEXT_NEW();
+        this->depth = depth;
+        this->bufferSize = bufferSize;
+        this->buffer = memNewRaw(depth * bufferSize);
+        this->slotList = memNew(sizeof(StorageDriverPosixUringSlot) * depth);
+        this->handle = -1;
+        this->ring = MAP_FAILED;
+        this->sqeList = MAP_FAILED;
+
+        // Set free callback to ensure the ring is released
+        memContextCallback(this->memContext, (MemContextCallback)storageDriverPosixUringFree, this);
+
+        error = storageDriverPosixUringInit(this);
+    }
+    MEM_CONTEXT_NEW_END();
+
+    if (error != 0)
+    {
+        LOG_DEBUG("io_uring is not available ([%d] %s), using regular system calls", error, strerror(error));
+
+        storageDriverPosixUringFree(this);
+        this = NULL;
+    }
+#endif
+
+    FUNCTION_LOG_RETURN(STORAGE_DRIVER_POSIX_URING, this);
+}
+
+#ifdef STORAGE_DRIVER_POSIX_URING_BUILD
+
+/***********************************************************************************************************************************
+Queue a request for a slot.  The request is submitted with the next wait.
+***********************************************************************************************************************************/
+static void
+storageDriverPosixUringQueue(
+    StorageDriverPosixUring *this, unsigned int slot, unsigned char opcode, int handle, uint64_t offset, size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX_URING, this);
+        FUNCTION_TEST_PARAM(UINT, slot);
+        FUNCTION_TEST_PARAM(UINT, opcode);
+        FUNCTION_TEST_PARAM(INT, handle);
+        FUNCTION_TEST_PARAM(UINT64, offset);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(slot < this->depth);
+    ASSERT(!this->slotList[slot].busy);
+    ASSERT(size <= this->bufferSize);
+
+    // There can't be more entries queued than slots so the submission queue never overflows.  Only this process writes the tail.
+    unsigned int tail = *this->sqTail;
+    unsigned int index = tail & *this->sqMask;
+
+    struct io_uring_sqe *sqe = (struct io_uring_sqe *)this->sqeList + index;
+    memset(sqe, 0, sizeof(struct io_uring_sqe));
+    sqe->opcode = opcode;
+    sqe->fd = handle;
+    sqe->off = offset;
+    sqe->addr = (uint64_t)(uintptr_t)storageDriverPosixUringBuffer(this, slot);
+    sqe->len = (uint32_t)size;
+    sqe->buf_index = (uint16_t)slot;
+    sqe->user_data = slot;
+
+    this->sqArray[index] = index;
+
+    // Make the entry visible to the kernel
+    __atomic_store_n(this->sqTail, tail + 1, __ATOMIC_RELEASE);
+
+    this->slotList[slot].busy = true;
+    this->submitTotal++;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+#endif
+
+/***********************************************************************************************************************************
+Queue a read into a slot buffer
+***********************************************************************************************************************************/
+void
+storageDriverPosixUringRead(StorageDriverPosixUring *this, unsigned int slot, int handle, uint64_t offset, size_t size)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_POSIX_URING, this);
+        FUNCTION_LOG_PARAM(UINT, slot);
+        FUNCTION_LOG_PARAM(INT, handle);
+        FUNCTION_LOG_PARAM(UINT64, offset);
+        FUNCTION_LOG_PARAM(SIZE, size);
+    FUNCTION_LOG_END();
+
+#ifdef STORAGE_DRIVER_POSIX_URING_BUILD
+    storageDriverPosixUringQueue(this, slot, IORING_OP_READ_FIXED, handle, offset, size);
+#endif
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Queue a write from a slot buffer
+***********************************************************************************************************************************/
+void
+storageDriverPosixUringWrite(StorageDriverPosixUring *this, unsigned int slot, int handle, uint64_t offset, size_t size)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_POSIX_URING, this);
+        FUNCTION_LOG_PARAM(UINT, slot);
+        FUNCTION_LOG_PARAM(INT, handle);
+        FUNCTION_LOG_PARAM(UINT64, offset);
+        FUNCTION_LOG_PARAM(SIZE, size);
+    FUNCTION_LOG_END();
+
+#ifdef STORAGE_DRIVER_POSIX_URING_BUILD
+    storageDriverPosixUringQueue(this, slot, IORING_OP_WRITE_FIXED, handle, offset, size);
+#endif
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Submit queued requests and wait for the request in a slot to complete.  Returns the result of the request, which is the number of
+bytes transferred or -errno on error.
+***********************************************************************************************************************************/
+int
+storageDriverPosixUringWait(StorageDriverPosixUring *this, unsigned int slot)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_POSIX_URING, this);
+        FUNCTION_LOG_PARAM(UINT, slot);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(slot < this->depth);
+
+#ifdef STORAGE_DRIVER_POSIX_URING_BUILD
+    // Submit queued requests even if the slot is already complete so requests queued ahead of consumption get started
+    bool wait = false;
+
+    do
+    {
+        // Reap completions.  Only this process writes the head.
+        unsigned int head = *this->cqHead;
+        unsigned int tail = __atomic_load_n(this->cqTail, __ATOMIC_ACQUIRE);
+
+        for (; head != tail; head++)
+        {
+            struct io_uring_cqe *cqe = (struct io_uring_cqe *)this->cqeList + (head & *this->cqMask);
+
+            this->slotList[cqe->user_data].busy = false;
+            this->slotList[cqe->user_data].result = cqe->res;
+        }
+
+        __atomic_store_n(this->cqHead, head, __ATOMIC_RELEASE);
+
+        // Submit queued requests and wait for a completion if the slot is still busy
+        wait = this->slotList[slot].busy;
+
+        if (this->submitTotal > 0 || wait)
+        {
+            int result = (int)syscall(
+                SYS_io_uring_enter, this->handle, this->submitTotal, wait ? 1 : 0, wait ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+
+            // Retry if interrupted by a signal
+            if (result == -1)                                       // {uncoverable - requests are always valid}
+            {
+                THROW_ON_SYS_ERROR(                                 // {+uncoverable}
+                    errno != EINTR, KernelError, "unable to submit io_uring requests");     // {+uncoverable}
+            }
+            else
+                this->submitTotal -= (unsigned int)result;
+        }
+    }
+    while (wait);
+#endif
+
+    FUNCTION_LOG_RETURN(INT, this->slotList[slot].result);
+}
+
+/***********************************************************************************************************************************
+Wait for all requests to complete.  Results are discarded so this is only useful before the buffers are released or reused.
+***********************************************************************************************************************************/
+void
+storageDriverPosixUringWaitAll(StorageDriverPosixUring *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_POSIX_URING, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    for (unsigned int slotIdx = 0; slotIdx < this->depth; slotIdx++)
+    {
+        if (this->slotList[slotIdx].busy)
+            storageDriverPosixUringWait(this, slotIdx);
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Get the buffer for a slot
+***********************************************************************************************************************************/
+unsigned char *
+storageDriverPosixUringBuffer(const StorageDriverPosixUring *this, unsigned int slot)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX_URING, this);
+        FUNCTION_TEST_PARAM(UINT, slot);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(slot < this->depth);
+
+    FUNCTION_TEST_RETURN(this->buffer + this->bufferSize * slot);
+}
+
+/***********************************************************************************************************************************
+Get the size of each slot buffer
+***********************************************************************************************************************************/
+size_t
+storageDriverPosixUringBufferSize(const StorageDriverPosixUring *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX_URING, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->bufferSize);
+}
+
+/***********************************************************************************************************************************
+Does the slot have a request in flight?
+***********************************************************************************************************************************/
+bool
+storageDriverPosixUringBusy(const StorageDriverPosixUring *this, unsigned int slot)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX_URING, this);
+        FUNCTION_TEST_PARAM(UINT, slot);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(slot < this->depth);
+
+    FUNCTION_TEST_RETURN(this->slotList[slot].busy);
+}
+
+/***********************************************************************************************************************************
+Get the number of slots
+***********************************************************************************************************************************/
+unsigned int
+storageDriverPosixUringDepth(const StorageDriverPosixUring *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_POSIX_URING, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->depth);
+}
+
+/***********************************************************************************************************************************
+Free the queue
+
+Requests in flight are waited for first since the kernel writes to the slot buffers until they complete.
+***********************************************************************************************************************************/
+void
+storageDriverPosixUringFree(StorageDriverPosixUring *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_POSIX_URING, this);
+    FUNCTION_LOG_END();
+
+    if (this != NULL)
+    {
+        if (this->handle != -1)
+        {
+            storageDriverPosixUringWaitAll(this);
+
+            // The mappings may not exist if initialization failed but munmap() does not mind
+            munmap(this->sqeList, this->sqeListSize);
+            munmap(this->ring, this->ringSize);
+            close(this->handle);
+        }
+
+        memContextCallbackClear(this->memContext);
+        memContextFree(this->memContext);
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
@@ -0,0 +1,58 @@
+/***********************************************************************************************************************************
+Posix io_uring Queue
+
+Queues reads and writes of fixed size blocks to the kernel with io_uring so they can proceed while the caller works on prior blocks.
+Each slot has a buffer registered with the kernel and at most one request in flight.  io_uring is accessed with system calls directly
+so liburing is not required.
+
+If the kernel does not support io_uring (or it has been disabled, or the buffers exceed the locked memory limit) then
+storageDriverPosixUringNew() returns NULL and the caller should use regular system calls instead.  Setup is expensive so callers
+should not try again after a failure.  A queue is only worth creating for files large enough to fill it.
+***********************************************************************************************************************************/
+#ifndef STORAGE_DRIVER_POSIX_URING_H
+#define STORAGE_DRIVER_POSIX_URING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef struct StorageDriverPosixUring StorageDriverPosixUring;
+
+/***********************************************************************************************************************************
+Constructor
+***********************************************************************************************************************************/
+StorageDriverPosixUring *storageDriverPosixUringNew(unsigned int depth, size_t bufferSize);
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+void storageDriverPosixUringRead(StorageDriverPosixUring *this, unsigned int slot, int handle, uint64_t offset, size_t size);
+void storageDriverPosixUringWrite(StorageDriverPosixUring *this, unsigned int slot, int handle, uint64_t offset, size_t size);
+int storageDriverPosixUringWait(StorageDriverPosixUring *this, unsigned int slot);
+void storageDriverPosixUringWaitAll(StorageDriverPosixUring *this);
+
+/***********************************************************************************************************************************
+Getters
+***********************************************************************************************************************************/
+unsigned char *storageDriverPosixUringBuffer(const StorageDriverPosixUring *this, unsigned int slot);
+size_t storageDriverPosixUringBufferSize(const StorageDriverPosixUring *this);
+bool storageDriverPosixUringBusy(const StorageDriverPosixUring *this, unsigned int slot);
+unsigned int storageDriverPosixUringDepth(const StorageDriverPosixUring *this);
+
+/***********************************************************************************************************************************
+Destructor
+***********************************************************************************************************************************/
+void storageDriverPosixUringFree(StorageDriverPosixUring *this);
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+#define FUNCTION_LOG_STORAGE_DRIVER_POSIX_URING_TYPE                                                                               \
+    StorageDriverPosixUring *
+#define FUNCTION_LOG_STORAGE_DRIVER_POSIX_URING_FORMAT(value, buffer, bufferSize)                                                  \
+    objToLog(value, "StorageDriverPosixUring", buffer, bufferSize)
+
+#endif
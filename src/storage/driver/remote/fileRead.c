@@ -5,20 +5,15 @@ Remote Storage File Read Driver
 #include <unistd.h>
 
 #include "common/debug.h"
+#include "common/io/filter/group.h"
 #include "common/io/read.intern.h"
 #include "common/log.h"
 #include "common/memContext.h"
-#include "common/regExp.h"
-#include "common/type/convert.h"
+#include "compress/gzipDecompress.h"
 #include "storage/driver/remote/fileRead.h"
 #include "storage/driver/remote/protocol.h"
 #include "storage/fileRead.intern.h"
 
-/***********************************************************************************************************************************
-Regular expressions
-***********************************************************************************************************************************/
-STRING_STATIC(BLOCK_REG_EXP_STR,                                    PROTOCOL_BLOCK_HEADER "[0-9]+");
-
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
@@ -30,32 +25,34 @@ struct StorageDriverRemoteFileRead
     IoRead *io;
     String *name;
     bool ignoreMissing;
+    bool noCache;
 
     ProtocolClient *client;                                         // Protocol client for requests
+    unsigned int compressLevel;                                     // Compression level for transfer (0 for no compression)
+    const StringList *filterList;                                   // Filters to run on the remote, e.g. hash:sha1
+    VariantList *filterResult;                                      // Results of filters run on the remote
+
+    IoRead *blockRead;                                              // Reads blocks from the protocol and decompresses them
     size_t remaining;                                               // Bytes remaining to be read
     bool eof;                                                       // Has the file reached eof?
 };
 
-/***********************************************************************************************************************************
-Local variables
-***********************************************************************************************************************************/
-static struct
-{
-    MemContext *memContext;                                         // Mem context for protocol helper
-    RegExp *blockRegExp;                                            // Regular expression to check block messages
-} storageDriverRemoteFileReadLocal;
-
 /***********************************************************************************************************************************
 Create a new file
 ***********************************************************************************************************************************/
 StorageDriverRemoteFileRead *
-storageDriverRemoteFileReadNew(StorageDriverRemote *storage, ProtocolClient *client, const String *name, bool ignoreMissing)
+storageDriverRemoteFileReadNew(
+    StorageDriverRemote *storage, ProtocolClient *client, const String *name, bool ignoreMissing, bool noCache,
+    unsigned int compressLevel, const StringList *filterList)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_DRIVER_REMOTE, storage);
         FUNCTION_LOG_PARAM(PROTOCOL_CLIENT, client);
         FUNCTION_LOG_PARAM(STRING, name);
         FUNCTION_LOG_PARAM(BOOL, ignoreMissing);
+        FUNCTION_LOG_PARAM(BOOL, noCache);
+        FUNCTION_LOG_PARAM(UINT, compressLevel);
+        FUNCTION_LOG_PARAM(STRING_LIST, filterList);
     FUNCTION_LOG_END();
 
     ASSERT(storage != NULL);
@@ -72,29 +69,18 @@ storageDriverRemoteFileReadNew(StorageDriverRemote *storage, ProtocolClient *cli
         this->storage = storage;
         this->name = strDup(name);
         this->ignoreMissing = ignoreMissing;
+        this->noCache = noCache;
 
         this->client = client;
-
-        // Create block regular expression if it has not been created yet
-        if (storageDriverRemoteFileReadLocal.memContext == NULL)
-        {
-            MEM_CONTEXT_BEGIN(memContextTop())
-            {
-                MEM_CONTEXT_NEW_BEGIN("StorageDriverRemoteFileReadLocal")
-                {
-                    storageDriverRemoteFileReadLocal.memContext = memContextCurrent();
-                    storageDriverRemoteFileReadLocal.blockRegExp = regExpNew(BLOCK_REG_EXP_STR);
-                }
-                MEM_CONTEXT_NEW_END();
-            }
-            MEM_CONTEXT_END();
-        }
+        this->compressLevel = compressLevel;
+        this->filterList = filterList == NULL ? NULL : strLstDup(filterList);
 
         this->interface = storageFileReadNewP(
             strNew(STORAGE_DRIVER_REMOTE_TYPE), this,
             .ignoreMissing = (StorageFileReadInterfaceIgnoreMissing)storageDriverRemoteFileReadIgnoreMissing,
             .io = (StorageFileReadInterfaceIo)storageDriverRemoteFileReadIo,
-            .name = (StorageFileReadInterfaceName)storageDriverRemoteFileReadName);
+            .name = (StorageFileReadInterfaceName)storageDriverRemoteFileReadName,
+            .filterResult = (StorageFileReadInterfaceFilterResult)storageDriverRemoteFileReadFilterResult);
 
         this->io = ioReadNewP(
             this, .eof = (IoReadInterfaceEof)storageDriverRemoteFileReadEof,
@@ -105,6 +91,89 @@ storageDriverRemoteFileReadNew(StorageDriverRemote *storage, ProtocolClient *cli
     FUNCTION_LOG_RETURN(STORAGE_DRIVER_REMOTE_FILE_READ, this);
 }
 
+/***********************************************************************************************************************************
+Read blocks from the protocol layer
+***********************************************************************************************************************************/
+static size_t
+storageDriverRemoteFileReadBlock(StorageDriverRemoteFileRead *this, Buffer *buffer, bool block)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_REMOTE_FILE_READ, this);
+        FUNCTION_LOG_PARAM(BUFFER, buffer);
+        FUNCTION_LOG_PARAM(BOOL, block);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(buffer != NULL && !bufFull(buffer));
+    ASSERT(!this->eof);
+
+    size_t result = 0;
+
+    do
+    {
+        // If no bytes remaining then read a new block
+        if (this->remaining == 0)
+        {
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                this->remaining = storageDriverRemoteProtocolBlockSize(ioReadLine(protocolClientIoRead(this->client)));
+
+                // On the zero block get the results of filters run on the remote
+                if (this->remaining == 0)
+                {
+                    const Variant *filterResult = protocolClientReadOutput(this->client, this->filterList != NULL);
+
+                    if (filterResult != NULL)
+                    {
+                        MEM_CONTEXT_BEGIN(this->memContext)
+                        {
+                            this->filterResult = varLstDup(varVarLst(filterResult));
+                        }
+                        MEM_CONTEXT_END();
+                    }
+
+                    this->eof = true;
+                }
+            }
+            MEM_CONTEXT_TEMP_END();
+        }
+
+        // Read if not eof
+        if (!this->eof)
+        {
+            // If the buffer can contain all remaining bytes
+            if (bufRemains(buffer) >= this->remaining)
+            {
+                bufLimitSet(buffer, bufUsed(buffer) + this->remaining);
+                ioRead(protocolClientIoRead(this->client), buffer);
+                bufLimitClear(buffer);
+                this->remaining = 0;
+            }
+            // Else read what we can
+            else
+                this->remaining -= ioRead(protocolClientIoRead(this->client), buffer);
+        }
+    }
+    while (!this->eof && !bufFull(buffer));
+
+    FUNCTION_LOG_RETURN(SIZE, result);
+}
+
+/***********************************************************************************************************************************
+Have all blocks been read?
+***********************************************************************************************************************************/
+static bool
+storageDriverRemoteFileReadBlockEof(const StorageDriverRemoteFileRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_REMOTE_FILE_READ, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->eof);
+}
+
 /***********************************************************************************************************************************
 Open the file
 ***********************************************************************************************************************************/
@@ -122,32 +191,38 @@ storageDriverRemoteFileReadOpen(StorageDriverRemoteFileRead *this)
     MEM_CONTEXT_TEMP_BEGIN()
     {
         ProtocolCommand *command = protocolCommandNew(PROTOCOL_COMMAND_STORAGE_OPEN_READ_STR);
-        protocolCommandParamAdd(command, varNewStr(this->name));
-        protocolCommandParamAdd(command, varNewBool(this->ignoreMissing));
+        protocolCommandParamAdd(command, VARSTR(this->name));
+        protocolCommandParamAdd(command, VARBOOL(this->ignoreMissing));
+        protocolCommandParamAdd(command, VARINT((int)this->compressLevel));
+        protocolCommandParamAdd(
+            command, this->filterList == NULL ? NULL : varNewVarLst(storageDriverRemoteProtocolFilterToVar(this->filterList)));
+        protocolCommandParamAdd(command, VARBOOL(this->noCache));
 
         result = varBool(protocolClientExecute(this->client, command, true));
     }
     MEM_CONTEXT_TEMP_END();
 
-    FUNCTION_LOG_RETURN(BOOL, result);
-}
-
-/***********************************************************************************************************************************
-Get size of the next transfer block
-***********************************************************************************************************************************/
-static size_t
-storageDriverRemoteFileReadBlockSize(const String *message)
-{
-    FUNCTION_LOG_BEGIN(logLevelTrace);
-        FUNCTION_LOG_PARAM(STRING, message);
-    FUNCTION_LOG_END();
+    // Blocks are read from the protocol and decompressed first when they were compressed for transfer
+    if (result)
+    {
+        MEM_CONTEXT_BEGIN(this->memContext)
+        {
+            this->blockRead = ioReadNewP(
+                this, .eof = (IoReadInterfaceEof)storageDriverRemoteFileReadBlockEof,
+                .read = (IoReadInterfaceRead)storageDriverRemoteFileReadBlock);
 
-    ASSERT(message != NULL);
+            if (this->compressLevel > 0)
+            {
+                ioReadFilterGroupSet(
+                    this->blockRead, ioFilterGroupAdd(ioFilterGroupNew(), gzipDecompressFilter(gzipDecompressNew(true))));
+            }
 
-    if (!regExpMatch(storageDriverRemoteFileReadLocal.blockRegExp, message))
-        THROW_FMT(ProtocolError, "'%s' is not a valid block size message", strPtr(message));
+            ioReadOpen(this->blockRead);
+        }
+        MEM_CONTEXT_END();
+    }
 
-    FUNCTION_LOG_RETURN(SIZE, (size_t)cvtZToUInt64(strPtr(message) + sizeof(PROTOCOL_BLOCK_HEADER) - 1));
+    FUNCTION_LOG_RETURN(BOOL, result);
 }
 
 /***********************************************************************************************************************************
@@ -164,47 +239,9 @@ storageDriverRemoteFileRead(StorageDriverRemoteFileRead *this, Buffer *buffer, b
 
     ASSERT(this != NULL);
     ASSERT(buffer != NULL && !bufFull(buffer));
+    ASSERT(this->blockRead != NULL);
 
-    size_t result = 0;
-
-    // Read if eof has not been reached
-    if (!this->eof)
-    {
-        do
-        {
-            // If no bytes remaining then read a new block
-            if (this->remaining == 0)
-            {
-                MEM_CONTEXT_TEMP_BEGIN()
-                {
-                    this->remaining = storageDriverRemoteFileReadBlockSize(ioReadLine(protocolClientIoRead(this->client)));
-
-                    if (this->remaining == 0)
-                        this->eof = true;
-                }
-                MEM_CONTEXT_TEMP_END();
-            }
-
-            // Read if not eof
-            if (!this->eof)
-            {
-                // If the buffer can contain all remaining bytes
-                if (bufRemains(buffer) >= this->remaining)
-                {
-                    bufLimitSet(buffer, bufUsed(buffer) + this->remaining);
-                    ioRead(protocolClientIoRead(this->client), buffer);
-                    bufLimitClear(buffer);
-                    this->remaining = 0;
-                }
-                // Else read what we can
-                else
-                    this->remaining -= ioRead(protocolClientIoRead(this->client), buffer);
-            }
-        }
-        while (!this->eof && !bufFull(buffer));
-    }
-
-    FUNCTION_LOG_RETURN(SIZE, result);
+    FUNCTION_LOG_RETURN(SIZE, ioRead(this->blockRead, buffer));
 }
 
 /***********************************************************************************************************************************
@@ -219,7 +256,22 @@ storageDriverRemoteFileReadEof(const StorageDriverRemoteFileRead *this)
 
     ASSERT(this != NULL);
 
-    FUNCTION_TEST_RETURN(this->eof);
+    FUNCTION_TEST_RETURN(this->blockRead != NULL && ioReadEof(this->blockRead));
+}
+
+/***********************************************************************************************************************************
+Results of filters run on the remote (NULL if no filters were requested)
+***********************************************************************************************************************************/
+const VariantList *
+storageDriverRemoteFileReadFilterResult(const StorageDriverRemoteFileRead *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_REMOTE_FILE_READ, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->filterResult);
 }
 
 /***********************************************************************************************************************************
@@ -11,6 +11,8 @@ typedef struct StorageDriverRemoteFileRead StorageDriverRemoteFileRead;
 
 #include "common/type/buffer.h"
 #include "common/type/string.h"
+#include "common/type/stringList.h"
+#include "common/type/variantList.h"
 #include "protocol/client.h"
 #include "storage/driver/remote/storage.h"
 #include "storage/fileRead.h"
@@ -19,7 +21,8 @@ typedef struct StorageDriverRemoteFileRead StorageDriverRemoteFileRead;
 Constructor
 ***********************************************************************************************************************************/
 StorageDriverRemoteFileRead *storageDriverRemoteFileReadNew(
-    StorageDriverRemote *storage, ProtocolClient *client, const String *name, bool ignoreMissing);
+    StorageDriverRemote *storage, ProtocolClient *client, const String *name, bool ignoreMissing, bool noCache,
+    unsigned int compressLevel, const StringList *filterList);
 
 /***********************************************************************************************************************************
 Functions
@@ -31,6 +34,7 @@ size_t storageDriverRemoteFileRead(StorageDriverRemoteFileRead *this, Buffer *bu
 Getters
 ***********************************************************************************************************************************/
 bool storageDriverRemoteFileReadEof(const StorageDriverRemoteFileRead *this);
+const VariantList *storageDriverRemoteFileReadFilterResult(const StorageDriverRemoteFileRead *this);
 bool storageDriverRemoteFileReadIgnoreMissing(const StorageDriverRemoteFileRead *this);
 StorageFileRead *storageDriverRemoteFileReadInterface(const StorageDriverRemoteFileRead *this);
 IoRead *storageDriverRemoteFileReadIo(const StorageDriverRemoteFileRead *this);
@@ -0,0 +1,412 @@
+/***********************************************************************************************************************************
+Remote Storage File Write Driver
+***********************************************************************************************************************************/
+#include "common/debug.h"
+#include "common/io/filter/group.h"
+#include "common/io/write.intern.h"
+#include "common/log.h"
+#include "common/memContext.h"
+#include "compress/gzipCompress.h"
+#include "storage/driver/remote/fileWrite.h"
+#include "storage/driver/remote/protocol.h"
+#include "storage/fileWrite.intern.h"
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+struct StorageDriverRemoteFileWrite
+{
+    MemContext *memContext;
+    StorageDriverRemote *storage;
+    StorageFileWrite *interface;
+    IoWrite *io;
+
+    String *name;
+    mode_t modeFile;
+    mode_t modePath;
+    bool createPath;
+    bool syncFile;
+    bool syncPath;
+    bool atomic;
+    bool noCache;
+
+    ProtocolClient *client;                                         // Protocol client for requests
+    unsigned int compressLevel;                                     // Compression level for transfer (0 for no compression)
+    IoWrite *blockWrite;                                            // Compresses data and writes it to the protocol in blocks
+};
+
+/***********************************************************************************************************************************
+Create a new file
+***********************************************************************************************************************************/
+StorageDriverRemoteFileWrite *
+storageDriverRemoteFileWriteNew(
+    StorageDriverRemote *storage, ProtocolClient *client, const String *name, mode_t modeFile, mode_t modePath, bool createPath,
+    bool syncFile, bool syncPath, bool atomic, bool noCache, unsigned int compressLevel)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_REMOTE, storage);
+        FUNCTION_LOG_PARAM(PROTOCOL_CLIENT, client);
+        FUNCTION_LOG_PARAM(STRING, name);
+        FUNCTION_LOG_PARAM(MODE, modeFile);
+        FUNCTION_LOG_PARAM(MODE, modePath);
+        FUNCTION_LOG_PARAM(BOOL, createPath);
+        FUNCTION_LOG_PARAM(BOOL, syncFile);
+        FUNCTION_LOG_PARAM(BOOL, syncPath);
+        FUNCTION_LOG_PARAM(BOOL, atomic);
+        FUNCTION_LOG_PARAM(BOOL, noCache);
+        FUNCTION_LOG_PARAM(UINT, compressLevel);
+    FUNCTION_LOG_END();
+
+    ASSERT(storage != NULL);
+    ASSERT(client != NULL);
+    ASSERT(name != NULL);
+    ASSERT(modeFile != 0);
+    ASSERT(modePath != 0);
+
+    StorageDriverRemoteFileWrite *this = NULL;
+
+    // Create the file
+    MEM_CONTEXT_NEW_BEGIN("StorageDriverRemoteFileWrite")
+    {
+        this = memNew(sizeof(StorageDriverRemoteFileWrite));
+        this->memContext = MEM_CONTEXT_NEW();
+        this->storage = storage;
+
+        this->interface = storageFileWriteNewP(
+            strNew(STORAGE_DRIVER_REMOTE_TYPE), this,
+            .atomic = (StorageFileWriteInterfaceAtomic)storageDriverRemoteFileWriteAtomic,
+            .createPath = (StorageFileWriteInterfaceCreatePath)storageDriverRemoteFileWriteCreatePath,
+            .io = (StorageFileWriteInterfaceIo)storageDriverRemoteFileWriteIo,
+            .modeFile = (StorageFileWriteInterfaceModeFile)storageDriverRemoteFileWriteModeFile,
+            .modePath = (StorageFileWriteInterfaceModePath)storageDriverRemoteFileWriteModePath,
+            .name = (StorageFileWriteInterfaceName)storageDriverRemoteFileWriteName,
+            .syncFile = (StorageFileWriteInterfaceSyncFile)storageDriverRemoteFileWriteSyncFile,
+            .syncPath = (StorageFileWriteInterfaceSyncPath)storageDriverRemoteFileWriteSyncPath);
+
+        this->io = ioWriteNewP(
+            this, .close = (IoWriteInterfaceClose)storageDriverRemoteFileWriteClose,
+            .open = (IoWriteInterfaceOpen)storageDriverRemoteFileWriteOpen,
+            .write = (IoWriteInterfaceWrite)storageDriverRemoteFileWrite);
+
+        this->name = strDup(name);
+        this->modeFile = modeFile;
+        this->modePath = modePath;
+        this->createPath = createPath;
+        this->syncFile = syncFile;
+        this->syncPath = syncPath;
+        this->atomic = atomic;
+        this->noCache = noCache;
+
+        this->client = client;
+        this->compressLevel = compressLevel;
+    }
+    MEM_CONTEXT_NEW_END();
+
+    FUNCTION_LOG_RETURN(STORAGE_DRIVER_REMOTE_FILE_WRITE, this);
+}
+
+/***********************************************************************************************************************************
+Write a block to the protocol layer
+***********************************************************************************************************************************/
+static void
+storageDriverRemoteFileWriteBlock(StorageDriverRemoteFileWrite *this, const Buffer *buffer)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_REMOTE_FILE_WRITE, this);
+        FUNCTION_LOG_PARAM(BUFFER, buffer);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(buffer != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        ioWriteLine(protocolClientIoWrite(this->client), strNewFmt(PROTOCOL_BLOCK_HEADER "%zu", bufUsed(buffer)));
+        ioWrite(protocolClientIoWrite(this->client), buffer);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Open the file
+***********************************************************************************************************************************/
+void
+storageDriverRemoteFileWriteOpen(StorageDriverRemoteFileWrite *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_REMOTE_FILE_WRITE, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        ProtocolCommand *command = protocolCommandNew(PROTOCOL_COMMAND_STORAGE_OPEN_WRITE_STR);
+        protocolCommandParamAdd(command, VARSTR(this->name));
+        protocolCommandParamAdd(command, VARUINT64(this->modeFile));
+        protocolCommandParamAdd(command, VARUINT64(this->modePath));
+        protocolCommandParamAdd(command, VARBOOL(this->createPath));
+        protocolCommandParamAdd(command, VARBOOL(this->syncFile));
+        protocolCommandParamAdd(command, VARBOOL(this->syncPath));
+        protocolCommandParamAdd(command, VARBOOL(this->atomic));
+        protocolCommandParamAdd(command, VARINT((int)this->compressLevel));
+        protocolCommandParamAdd(command, VARBOOL(this->noCache));
+
+        protocolClientExecute(this->client, command, false);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    // Set free callback to abort the write if the file is freed before it is closed
+    memContextCallback(this->memContext, (MemContextCallback)storageDriverRemoteFileWriteFree, this);
+
+    // Data is written to the protocol in blocks of buffer size and compressed first when requested.  Blocks are not flushed
+    // individually so the remote can write one block while the next is in transit, and writes block when the remote falls behind.
+    MEM_CONTEXT_BEGIN(this->memContext)
+    {
+        this->blockWrite = ioWriteNewP(this, .write = (IoWriteInterfaceWrite)storageDriverRemoteFileWriteBlock);
+
+        if (this->compressLevel > 0)
+        {
+            ioWriteFilterGroupSet(
+                this->blockWrite,
+                ioFilterGroupAdd(ioFilterGroupNew(), gzipCompressFilter(gzipCompressNew((int)this->compressLevel, true))));
+        }
+
+        ioWriteOpen(this->blockWrite);
+    }
+    MEM_CONTEXT_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Write to the file
+***********************************************************************************************************************************/
+void
+storageDriverRemoteFileWrite(StorageDriverRemoteFileWrite *this, const Buffer *buffer)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_REMOTE_FILE_WRITE, this);
+        FUNCTION_LOG_PARAM(BUFFER, buffer);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(buffer != NULL);
+    ASSERT(this->blockWrite != NULL);
+
+    ioWrite(this->blockWrite, buffer);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Close the file
+***********************************************************************************************************************************/
+void
+storageDriverRemoteFileWriteClose(StorageDriverRemoteFileWrite *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_REMOTE_FILE_WRITE, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    // Close if the file has not already been closed
+    if (this->blockWrite != NULL)
+    {
+        // Flush remaining data and write a zero block to show the file is complete
+        ioWriteClose(this->blockWrite);
+        ioWriteLine(protocolClientIoWrite(this->client), strNew(PROTOCOL_BLOCK_HEADER "0"));
+        ioWriteFlush(protocolClientIoWrite(this->client));
+
+        // This marks the file as closed.  Once the zero block has been sent the write can no longer be aborted.
+        memContextCallbackClear(this->memContext);
+        ioWriteFree(this->blockWrite);
+        this->blockWrite = NULL;
+
+        // Wait for the remote to close the file so any errors are reported
+        protocolClientReadOutput(this->client, false);
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Will the file be written atomically?
+***********************************************************************************************************************************/
+bool
+storageDriverRemoteFileWriteAtomic(const StorageDriverRemoteFileWrite *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_REMOTE_FILE_WRITE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->atomic);
+}
+
+/***********************************************************************************************************************************
+Will the path be created for the file if it does not exist?
+***********************************************************************************************************************************/
+bool
+storageDriverRemoteFileWriteCreatePath(const StorageDriverRemoteFileWrite *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_REMOTE_FILE_WRITE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->createPath);
+}
+
+/***********************************************************************************************************************************
+Get interface
+***********************************************************************************************************************************/
+StorageFileWrite *
+storageDriverRemoteFileWriteInterface(const StorageDriverRemoteFileWrite *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_REMOTE_FILE_WRITE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->interface);
+}
+
+/***********************************************************************************************************************************
+Get I/O interface
+***********************************************************************************************************************************/
+IoWrite *
+storageDriverRemoteFileWriteIo(const StorageDriverRemoteFileWrite *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_REMOTE_FILE_WRITE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->io);
+}
+
+/***********************************************************************************************************************************
+Mode for the file to be created
+***********************************************************************************************************************************/
+mode_t
+storageDriverRemoteFileWriteModeFile(const StorageDriverRemoteFileWrite *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_REMOTE_FILE_WRITE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->modeFile);
+}
+
+/***********************************************************************************************************************************
+Mode for any paths that are created while writing the file
+***********************************************************************************************************************************/
+mode_t
+storageDriverRemoteFileWriteModePath(const StorageDriverRemoteFileWrite *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_REMOTE_FILE_WRITE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->modePath);
+}
+
+/***********************************************************************************************************************************
+File name
+***********************************************************************************************************************************/
+const String *
+storageDriverRemoteFileWriteName(const StorageDriverRemoteFileWrite *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_REMOTE_FILE_WRITE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->name);
+}
+
+/***********************************************************************************************************************************
+Will the file be synced after it is closed?
+***********************************************************************************************************************************/
+bool
+storageDriverRemoteFileWriteSyncFile(const StorageDriverRemoteFileWrite *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_REMOTE_FILE_WRITE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->syncFile);
+}
+
+/***********************************************************************************************************************************
+Will the directory be synced to disk after the write is completed?
+***********************************************************************************************************************************/
+bool
+storageDriverRemoteFileWriteSyncPath(const StorageDriverRemoteFileWrite *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_REMOTE_FILE_WRITE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(this->syncPath);
+}
+
+/***********************************************************************************************************************************
+Free the file
+
+If the file is freed before it is closed (e.g. after an error while writing) then the remote is still waiting for a block, so the
+write is aborted to keep the protocol in sync and have the remote remove the partial file.  Errors are logged rather than thrown
+since this may be called from a mem context callback.
+***********************************************************************************************************************************/
+void
+storageDriverRemoteFileWriteFree(StorageDriverRemoteFileWrite *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_REMOTE_FILE_WRITE, this);
+    FUNCTION_LOG_END();
+
+    if (this != NULL)
+    {
+        memContextCallbackClear(this->memContext);
+
+        if (this->blockWrite != NULL)
+        {
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                TRY_BEGIN()
+                {
+                    ioWriteLine(protocolClientIoWrite(this->client), PROTOCOL_BLOCK_ABORT_STR);
+                    ioWriteFlush(protocolClientIoWrite(this->client));
+                    protocolClientReadOutput(this->client, false);
+                }
+                CATCH_ANY()
+                {
+                    LOG_WARN("unable to abort write of '%s': %s", strPtr(this->name), errorMessage());
+                }
+                TRY_END();
+            }
+            MEM_CONTEXT_TEMP_END();
+        }
+
+        memContextFree(this->memContext);
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
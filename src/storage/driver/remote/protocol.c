@@ -1,20 +1,328 @@
 /***********************************************************************************************************************************
 Remote Storage Protocol Handler
 ***********************************************************************************************************************************/
+#include <string.h>
+
 #include "common/debug.h"
+#include "common/io/filter/group.h"
 #include "common/io/io.h"
 #include "common/log.h"
 #include "common/memContext.h"
+#include "common/regExp.h"
+#include "common/type/convert.h"
+#include "common/type/keyValue.h"
+#include "compress/gzipCompress.h"
+#include "compress/gzipDecompress.h"
 #include "storage/driver/remote/protocol.h"
+#include "storage/fileRead.intern.h"
+#include "storage/fileWrite.intern.h"
 #include "storage/helper.h"
 #include "storage/storage.intern.h"
 
 /***********************************************************************************************************************************
 Constants
 ***********************************************************************************************************************************/
+STRING_EXTERN(PROTOCOL_BLOCK_ABORT_STR,                             PROTOCOL_BLOCK_ABORT);
+
 STRING_EXTERN(PROTOCOL_COMMAND_STORAGE_EXISTS_STR,                  PROTOCOL_COMMAND_STORAGE_EXISTS);
+STRING_EXTERN(PROTOCOL_COMMAND_STORAGE_EXISTS_LIST_STR,             PROTOCOL_COMMAND_STORAGE_EXISTS_LIST);
+STRING_EXTERN(PROTOCOL_COMMAND_STORAGE_INFO_LIST_STR,               PROTOCOL_COMMAND_STORAGE_INFO_LIST);
 STRING_EXTERN(PROTOCOL_COMMAND_STORAGE_LIST_STR,                    PROTOCOL_COMMAND_STORAGE_LIST);
+STRING_EXTERN(PROTOCOL_COMMAND_STORAGE_LIST_INFO_STR,               PROTOCOL_COMMAND_STORAGE_LIST_INFO);
 STRING_EXTERN(PROTOCOL_COMMAND_STORAGE_OPEN_READ_STR,               PROTOCOL_COMMAND_STORAGE_OPEN_READ);
+STRING_EXTERN(PROTOCOL_COMMAND_STORAGE_OPEN_WRITE_STR,              PROTOCOL_COMMAND_STORAGE_OPEN_WRITE);
+STRING_EXTERN(PROTOCOL_COMMAND_STORAGE_REMOVE_STR,                  PROTOCOL_COMMAND_STORAGE_REMOVE);
+
+STRING_EXTERN(PROTOCOL_STORAGE_FILTER_PARAM_STR,                    PROTOCOL_STORAGE_FILTER_PARAM);
+STRING_EXTERN(PROTOCOL_STORAGE_FILTER_TYPE_STR,                     PROTOCOL_STORAGE_FILTER_TYPE);
+
+STRING_EXTERN(PROTOCOL_STORAGE_INFO_MODE_STR,                       PROTOCOL_STORAGE_INFO_MODE);
+STRING_EXTERN(PROTOCOL_STORAGE_INFO_NAME_STR,                       PROTOCOL_STORAGE_INFO_NAME);
+STRING_EXTERN(PROTOCOL_STORAGE_INFO_SIZE_STR,                       PROTOCOL_STORAGE_INFO_SIZE);
+STRING_EXTERN(PROTOCOL_STORAGE_INFO_TIME_STR,                       PROTOCOL_STORAGE_INFO_TIME);
+STRING_EXTERN(PROTOCOL_STORAGE_INFO_TYPE_STR,                       PROTOCOL_STORAGE_INFO_TYPE);
+
+/***********************************************************************************************************************************
+Regular expressions
+***********************************************************************************************************************************/
+STRING_STATIC(BLOCK_REG_EXP_STR,                                    PROTOCOL_BLOCK_HEADER "[0-9]+");
+
+/***********************************************************************************************************************************
+Local variables
+***********************************************************************************************************************************/
+static struct
+{
+    MemContext *memContext;                                         // Mem context
+    RegExp *blockRegExp;                                            // Regular expression to check block messages
+} storageDriverRemoteProtocolLocal;
+
+/***********************************************************************************************************************************
+Get size of the next transfer block
+***********************************************************************************************************************************/
+size_t
+storageDriverRemoteProtocolBlockSize(const String *message)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STRING, message);
+    FUNCTION_LOG_END();
+
+    ASSERT(message != NULL);
+
+    // Create block regular expression if it has not been created yet
+    if (storageDriverRemoteProtocolLocal.memContext == NULL)
+    {
+        MEM_CONTEXT_BEGIN(memContextTop())
+        {
+            MEM_CONTEXT_NEW_BEGIN("StorageDriverRemoteProtocolLocal")
+            {
+                storageDriverRemoteProtocolLocal.memContext = memContextCurrent();
+                storageDriverRemoteProtocolLocal.blockRegExp = regExpNew(BLOCK_REG_EXP_STR);
+            }
+            MEM_CONTEXT_NEW_END();
+        }
+        MEM_CONTEXT_END();
+    }
+
+    // Validate the header block size message
+    if (!regExpMatch(storageDriverRemoteProtocolLocal.blockRegExp, message))
+        THROW_FMT(ProtocolError, "'%s' is not a valid block size message", strPtr(message));
+
+    FUNCTION_LOG_RETURN(SIZE, (size_t)cvtZToUInt64(strPtr(message) + sizeof(PROTOCOL_BLOCK_HEADER) - 1));
+}
+
+/***********************************************************************************************************************************
+Convert info to a variant for transfer.  The name is only included when set, i.e. when the info came from a list.
+***********************************************************************************************************************************/
+Variant *
+storageDriverRemoteProtocolInfoToVar(const StorageInfo *info)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, info);
+    FUNCTION_TEST_END();
+
+    ASSERT(info != NULL);
+    ASSERT(info->exists);
+
+    Variant *result = varNewKv();
+    KeyValue *infoKv = varKv(result);
+
+    if (info->name != NULL)
+        kvPut(infoKv, VARSTR(PROTOCOL_STORAGE_INFO_NAME_STR), VARSTR(info->name));
+
+    kvPut(infoKv, VARSTR(PROTOCOL_STORAGE_INFO_TYPE_STR), VARUINT64(info->type));
+    kvPut(infoKv, VARSTR(PROTOCOL_STORAGE_INFO_SIZE_STR), VARUINT64(info->size));
+    kvPut(infoKv, VARSTR(PROTOCOL_STORAGE_INFO_MODE_STR), VARUINT64(info->mode));
+    kvPut(infoKv, VARSTR(PROTOCOL_STORAGE_INFO_TIME_STR), VARINT64(info->timeModified));
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Convert a variant created by storageDriverRemoteProtocolInfoToVar() back to info.  Null variants are returned as missing.
+***********************************************************************************************************************************/
+StorageInfo
+storageDriverRemoteProtocolInfoFromVar(const Variant *infoVar)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(VARIANT, infoVar);
+    FUNCTION_TEST_END();
+
+    StorageInfo result = {.exists = false};
+
+    if (infoVar != NULL)
+    {
+        const KeyValue *infoKv = varKv(infoVar);
+        const Variant *name = kvGetStr(infoKv, PROTOCOL_STORAGE_INFO_NAME_STR);
+
+        result.exists = true;
+        result.name = name == NULL ? NULL : varStr(name);
+        result.type = (StorageType)varUInt64Force(kvGetStr(infoKv, PROTOCOL_STORAGE_INFO_TYPE_STR));
+        result.size = (size_t)varUInt64Force(kvGetStr(infoKv, PROTOCOL_STORAGE_INFO_SIZE_STR));
+        result.mode = (mode_t)varUInt64Force(kvGetStr(infoKv, PROTOCOL_STORAGE_INFO_MODE_STR));
+        result.timeModified = (time_t)varInt64Force(kvGetStr(infoKv, PROTOCOL_STORAGE_INFO_TIME_STR));
+    }
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Send info from storageListInfo() to the client in batches so the full list is never held in memory
+***********************************************************************************************************************************/
+typedef struct StorageDriverRemoteProtocolListInfoData
+{
+    ProtocolServer *server;                                         // Server to send batches to
+    MemContext *memContext;                                         // Mem context that batches are created in
+    MemContext *batchContext;                                       // Mem context for the current batch
+    VariantList *list;                                              // Current batch
+} StorageDriverRemoteProtocolListInfoData;
+
+static void
+storageDriverRemoteProtocolListInfoFlush(StorageDriverRemoteProtocolListInfoData *data)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+    FUNCTION_TEST_END();
+
+    ASSERT(data != NULL);
+
+    if (data->list != NULL)
+    {
+        protocolServerResponse(data->server, varNewVarLst(data->list));
+
+        memContextFree(data->batchContext);
+        data->batchContext = NULL;
+        data->list = NULL;
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+static void
+storageDriverRemoteProtocolListInfoCallback(void *callbackData, const StorageInfo *info)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, callbackData);
+        FUNCTION_TEST_PARAM_P(VOID, info);
+    FUNCTION_TEST_END();
+
+    ASSERT(callbackData != NULL);
+    ASSERT(info != NULL);
+
+    StorageDriverRemoteProtocolListInfoData *data = callbackData;
+
+    // Start a new batch if needed.  The callback may be running in a temp context owned by the driver so the batch must be created
+    // in a context that will outlive it.
+    if (data->list == NULL)
+    {
+        MEM_CONTEXT_BEGIN(data->memContext)
+        {
+            MEM_CONTEXT_NEW_BEGIN("StorageDriverRemoteProtocolListInfoBatch")
+            {
+                data->batchContext = MEM_CONTEXT_NEW();
+                data->list = varLstNew();
+            }
+            MEM_CONTEXT_NEW_END();
+        }
+        MEM_CONTEXT_END();
+    }
+
+    MEM_CONTEXT_BEGIN(data->batchContext)
+    {
+        varLstAdd(data->list, storageDriverRemoteProtocolInfoToVar(info));
+    }
+    MEM_CONTEXT_END();
+
+    // Send the batch when it is full
+    if (varLstSize(data->list) >= PROTOCOL_STORAGE_LIST_INFO_BATCH)
+        storageDriverRemoteProtocolListInfoFlush(data);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Convert a filter list to a variant list to send to the remote
+
+Each filter is specified as a filter type optionally followed by a colon and a parameter, e.g. hash:sha1 or size, and is sent as a
+KeyValue with the type and parameter in separate keys so the remote does not need to parse the filter.
+***********************************************************************************************************************************/
+VariantList *
+storageDriverRemoteProtocolFilterToVar(const StringList *filterList)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STRING_LIST, filterList);
+    FUNCTION_LOG_END();
+
+    ASSERT(filterList != NULL);
+
+    VariantList *result = varLstNew();
+
+    for (unsigned int filterIdx = 0; filterIdx < strLstSize(filterList); filterIdx++)
+    {
+        const String *filter = strLstGet(filterList, filterIdx);
+        const char *param = strchr(strPtr(filter), ':');
+
+        Variant *filterVar = varNewKv();
+        KeyValue *filterKv = varKv(filterVar);
+
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            if (param == NULL)
+                kvPut(filterKv, VARSTR(PROTOCOL_STORAGE_FILTER_TYPE_STR), VARSTR(filter));
+            else
+            {
+                kvPut(
+                    filterKv, VARSTR(PROTOCOL_STORAGE_FILTER_TYPE_STR),
+                    VARSTR(strNewN(strPtr(filter), (size_t)(param - strPtr(filter)))));
+                kvPut(filterKv, VARSTR(PROTOCOL_STORAGE_FILTER_PARAM_STR), VARSTR(strNew(param + 1)));
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        varLstAdd(result, filterVar);
+    }
+
+    FUNCTION_LOG_RETURN(VARIANT_LIST, result);
+}
+
+/***********************************************************************************************************************************
+Add filters requested by the client to a filter group
+***********************************************************************************************************************************/
+static void
+storageDriverRemoteProtocolFilterAdd(IoFilterGroup *filterGroup, const VariantList *filterList)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_FILTER_GROUP, filterGroup);
+        FUNCTION_LOG_PARAM(VARIANT_LIST, filterList);
+    FUNCTION_LOG_END();
+
+    ASSERT(filterGroup != NULL);
+    ASSERT(filterList != NULL);
+
+    for (unsigned int filterIdx = 0; filterIdx < varLstSize(filterList); filterIdx++)
+    {
+        const KeyValue *filter = varKv(varLstGet(filterList, filterIdx));
+        const String *filterType = varStr(kvGetStr(filter, PROTOCOL_STORAGE_FILTER_TYPE_STR));
+        const Variant *filterParam = kvGetStr(filter, PROTOCOL_STORAGE_FILTER_PARAM_STR);
+        IoFilter *filterNew = storageFileReadFilterNew(filterType, filterParam == NULL ? NULL : varStr(filterParam));
+
+        if (filterNew == NULL)
+        {
+            THROW_FMT(
+                ProtocolError, "invalid filter '%s%s%s'", strPtr(filterType), filterParam == NULL ? "" : ":",
+                filterParam == NULL ? "" : strPtr(varStr(filterParam)));
+        }
+
+        ioFilterGroupAdd(filterGroup, filterNew);
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Get filter results in the same order as the filter list
+***********************************************************************************************************************************/
+static VariantList *
+storageDriverRemoteProtocolFilterResult(const IoFilterGroup *filterGroup, const VariantList *filterList)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_FILTER_GROUP, filterGroup);
+        FUNCTION_LOG_PARAM(VARIANT_LIST, filterList);
+    FUNCTION_LOG_END();
+
+    ASSERT(filterGroup != NULL);
+    ASSERT(filterList != NULL);
+
+    VariantList *result = varLstNew();
+
+    for (unsigned int filterIdx = 0; filterIdx < varLstSize(filterList); filterIdx++)
+    {
+        const KeyValue *filter = varKv(varLstGet(filterList, filterIdx));
+        varLstAdd(
+            result, varDup(ioFilterGroupResult(filterGroup, varStr(kvGetStr(filter, PROTOCOL_STORAGE_FILTER_TYPE_STR)))));
+    }
+
+    FUNCTION_LOG_RETURN(VARIANT_LIST, result);
+}
 
 /***********************************************************************************************************************************
 Process storage protocol requests
@@ -43,7 +351,36 @@ storageDriverRemoteProtocol(const String *command, const VariantList *paramList,
         if (strEq(command, PROTOCOL_COMMAND_STORAGE_EXISTS_STR))
         {
             protocolServerResponse(
-                server, varNewBool(interface.exists(driver, storagePathNP(storage, varStr(varLstGet(paramList, 0))))));
+                server, VARBOOL(interface.exists(driver, storagePathNP(storage, varStr(varLstGet(paramList, 0))))));
+        }
+        else if (strEq(command, PROTOCOL_COMMAND_STORAGE_EXISTS_LIST_STR))
+        {
+            // Each param is a path to check
+            VariantList *result = varLstNew();
+
+            for (unsigned int paramIdx = 0; paramIdx < varLstSize(paramList); paramIdx++)
+            {
+                varLstAdd(
+                    result, varNewBool(interface.exists(driver, storagePathNP(storage, varStr(varLstGet(paramList, paramIdx))))));
+            }
+
+            protocolServerResponse(server, varNewVarLst(result));
+        }
+        else if (strEq(command, PROTOCOL_COMMAND_STORAGE_INFO_LIST_STR))
+        {
+            // The first param is ignore missing and the rest are files to get info for
+            bool ignoreMissing = varBool(varLstGet(paramList, 0));
+            VariantList *result = varLstNew();
+
+            for (unsigned int paramIdx = 1; paramIdx < varLstSize(paramList); paramIdx++)
+            {
+                StorageInfo info = interface.info(
+                    driver, storagePathNP(storage, varStr(varLstGet(paramList, paramIdx))), ignoreMissing);
+
+                varLstAdd(result, info.exists ? storageDriverRemoteProtocolInfoToVar(&info) : NULL);
+            }
+
+            protocolServerResponse(server, varNewVarLst(result));
         }
         else if (strEq(command, PROTOCOL_COMMAND_STORAGE_LIST_STR))
         {
@@ -55,23 +392,52 @@ storageDriverRemoteProtocol(const String *command, const VariantList *paramList,
                             driver, storagePathNP(storage, varStr(varLstGet(paramList, 0))), varBool(varLstGet(paramList, 1)),
                             varStr(varLstGet(paramList, 2))))));
         }
+        else if (strEq(command, PROTOCOL_COMMAND_STORAGE_LIST_INFO_STR))
+        {
+            // Send info in batches as it is read and then send whether the path exists to end the list
+            StorageDriverRemoteProtocolListInfoData data = {.server = server, .memContext = MEM_CONTEXT_TEMP()};
+
+            bool result = interface.listInfo(
+                driver, storagePathNP(storage, varStr(varLstGet(paramList, 0))), varBool(varLstGet(paramList, 1)),
+                varBool(varLstGet(paramList, 2)), storageDriverRemoteProtocolListInfoCallback, &data);
+
+            storageDriverRemoteProtocolListInfoFlush(&data);
+            protocolServerResponse(server, VARBOOL(result));
+        }
         else if (strEq(command, PROTOCOL_COMMAND_STORAGE_OPEN_READ_STR))
         {
             // Create the read object
             IoRead *fileRead = storageFileReadIo(
                 interface.newRead(
-                    driver, storagePathNP(storage, varStr(varLstGet(paramList, 0))), varBool(varLstGet(paramList, 1))));
+                    driver, storagePathNP(storage, varStr(varLstGet(paramList, 0))), varBool(varLstGet(paramList, 1)),
+                    varBool(varLstGet(paramList, 4)), false));
+
+            int compressLevel = varIntForce(varLstGet(paramList, 2));
+            const VariantList *filterList = varLstGet(paramList, 3) == NULL ? NULL : varVarLst(varLstGet(paramList, 3));
+
+            // Run filters requested by the client and then compress the data for transfer if requested
+            IoFilterGroup *filterGroup = ioFilterGroupNew();
+
+            if (filterList != NULL)
+                storageDriverRemoteProtocolFilterAdd(filterGroup, filterList);
+
+            if (compressLevel > 0)
+                ioFilterGroupAdd(filterGroup, gzipCompressFilter(gzipCompressNew(compressLevel, true)));
+
+            ioReadFilterGroupSet(fileRead, filterGroup);
 
             // Check if the file exists
             bool exists = ioReadOpen(fileRead);
-            protocolServerResponse(server, varNewBool(exists));
+            protocolServerResponse(server, VARBOOL(exists));
 
             // Transfer the file if it exists
             if (exists)
             {
                 Buffer *buffer = bufNew(ioBufferSize());
 
-                // Write file out to protocol layer
+                // Write file out to protocol layer.  Blocks are not flushed individually so the protocol layer writes full buffers
+                // and the next block can be read while the prior blocks are still in flight.  The client does not acknowledge
+                // blocks so nothing waits on the flush below.
                 do
                 {
                     ioRead(fileRead, buffer);
@@ -80,17 +446,122 @@ storageDriverRemoteProtocol(const String *command, const VariantList *paramList,
                     {
                         ioWriteLine(protocolServerIoWrite(server), strNewFmt(PROTOCOL_BLOCK_HEADER "%zu", bufUsed(buffer)));
                         ioWrite(protocolServerIoWrite(server), buffer);
-                        ioWriteFlush(protocolServerIoWrite(server));
-
-                        bufUsedZero(buffer);
                     }
+
+                    bufUsedZero(buffer);
                 }
                 while (!ioReadEof(fileRead));
 
+                ioReadClose(fileRead);
+
                 // Write a zero block to show file is complete
                 ioWriteLine(protocolServerIoWrite(server), strNew(PROTOCOL_BLOCK_HEADER "0"));
                 ioWriteFlush(protocolServerIoWrite(server));
+
+                // Return filter results in the same order as the filter list
+                protocolServerResponse(
+                    server, filterList == NULL ? NULL : varNewVarLst(storageDriverRemoteProtocolFilterResult(filterGroup, filterList)));
+            }
+        }
+        else if (strEq(command, PROTOCOL_COMMAND_STORAGE_OPEN_WRITE_STR))
+        {
+            // Create the write object
+            StorageFileWrite *file = interface.newWrite(
+                driver, storagePathNP(storage, varStr(varLstGet(paramList, 0))), (mode_t)varUInt64Force(varLstGet(paramList, 1)),
+                (mode_t)varUInt64Force(varLstGet(paramList, 2)), varBool(varLstGet(paramList, 3)), varBool(varLstGet(paramList, 4)),
+                varBool(varLstGet(paramList, 5)), varBool(varLstGet(paramList, 6)), varBool(varLstGet(paramList, 8)));
+            IoWrite *fileWrite = storageFileWriteIo(file);
+
+            // Decompress the data if it was compressed for transfer
+            if (varIntForce(varLstGet(paramList, 7)) > 0)
+            {
+                ioWriteFilterGroupSet(
+                    fileWrite, ioFilterGroupAdd(ioFilterGroupNew(), gzipDecompressFilter(gzipDecompressNew(true))));
             }
+
+            // Open file and let the client know it can start sending data
+            ioWriteOpen(fileWrite);
+            protocolServerResponse(server, NULL);
+
+            // Write data from the protocol layer to the file until a zero block is received.  If a write fails (e.g. out of space)
+            // then the remaining blocks are still read and discarded so the protocol stays in sync.  The error is returned once the
+            // zero block has been received.  If the client aborts the write then the partial file is removed instead.
+            Buffer *buffer = bufNew(ioBufferSize());
+            size_t blockSize = 0;
+            bool abort = false;
+            const ErrorType *writeErrorType = NULL;
+            String *writeErrorMessage = NULL;
+
+            do
+            {
+                MEM_CONTEXT_TEMP_BEGIN()
+                {
+                    const String *blockHeader = ioReadLine(protocolServerIoRead(server));
+
+                    if (strEq(blockHeader, PROTOCOL_BLOCK_ABORT_STR))
+                    {
+                        abort = true;
+                        blockSize = 0;
+                    }
+                    else
+                        blockSize = storageDriverRemoteProtocolBlockSize(blockHeader);
+                }
+                MEM_CONTEXT_TEMP_END();
+
+                size_t remaining = blockSize;
+
+                while (remaining > 0)
+                {
+                    bufLimitSet(buffer, remaining < bufSize(buffer) ? remaining : bufSize(buffer));
+                    ioRead(protocolServerIoRead(server), buffer);
+
+                    if (writeErrorType == NULL)
+                    {
+                        TRY_BEGIN()
+                        {
+                            ioWrite(fileWrite, buffer);
+                        }
+                        CATCH_ANY()
+                        {
+                            writeErrorType = errorType();
+                            writeErrorMessage = strNew(errorMessage());
+                        }
+                        TRY_END();
+                    }
+
+                    remaining -= bufUsed(buffer);
+                    bufUsedZero(buffer);
+                }
+            }
+            while (blockSize > 0);
+
+            // Free the file without closing it so it is not synced or renamed, then remove what was written
+            if (abort)
+            {
+                const String *nameAbort = storageFileWriteAtomic(file) ?
+                    strNewFmt("%s." STORAGE_FILE_TEMP_EXT, strPtr(storageFileWriteName(file))) : storageFileWriteName(file);
+
+                storageFileWriteFree(file);
+                interface.remove(driver, nameAbort, false);
+
+                protocolServerResponse(server, NULL);
+            }
+            else
+            {
+                if (writeErrorType != NULL)
+                    THROWP(writeErrorType, strPtr(writeErrorMessage));
+
+                // Close the file and let the client know it was successful
+                ioWriteClose(fileWrite);
+                protocolServerResponse(server, NULL);
+            }
+        }
+        else if (strEq(command, PROTOCOL_COMMAND_STORAGE_REMOVE_STR))
+        {
+            interface.remove(
+                driver, storagePathNP(storage, varStr(varLstGet(paramList, 0))), varBool(varLstGet(paramList, 1)));
+
+            protocolServerResponse(server, NULL);
         }
         else
             found = false;
@@ -5,24 +5,65 @@ Remote Storage Protocol Handler
 #define STORAGE_DRIVER_REMOTE_PROTOCOL_H
 
 #include "common/type/string.h"
+#include "common/type/stringList.h"
 #include "common/type/variantList.h"
 #include "protocol/server.h"
+#include "storage/info.h"
 
 /***********************************************************************************************************************************
 Constants
 ***********************************************************************************************************************************/
 #define PROTOCOL_BLOCK_HEADER                                       "BRBLOCK"
 
+// Sent by the client in place of a block header to abandon a write.  The remote removes the partial file.
+#define PROTOCOL_BLOCK_ABORT                                        PROTOCOL_BLOCK_HEADER "-1"
+    STRING_DECLARE(PROTOCOL_BLOCK_ABORT_STR);
+
 #define PROTOCOL_COMMAND_STORAGE_EXISTS                             "storageExists"
     STRING_DECLARE(PROTOCOL_COMMAND_STORAGE_EXISTS_STR);
+#define PROTOCOL_COMMAND_STORAGE_EXISTS_LIST                        "storageExistsList"
+    STRING_DECLARE(PROTOCOL_COMMAND_STORAGE_EXISTS_LIST_STR);
+#define PROTOCOL_COMMAND_STORAGE_INFO_LIST                          "storageInfoList"
+    STRING_DECLARE(PROTOCOL_COMMAND_STORAGE_INFO_LIST_STR);
 #define PROTOCOL_COMMAND_STORAGE_LIST                               "storageList"
     STRING_DECLARE(PROTOCOL_COMMAND_STORAGE_LIST_STR);
+#define PROTOCOL_COMMAND_STORAGE_LIST_INFO                          "storageListInfo"
+    STRING_DECLARE(PROTOCOL_COMMAND_STORAGE_LIST_INFO_STR);
 #define PROTOCOL_COMMAND_STORAGE_OPEN_READ                          "storageOpenRead"
     STRING_DECLARE(PROTOCOL_COMMAND_STORAGE_OPEN_READ_STR);
+#define PROTOCOL_COMMAND_STORAGE_OPEN_WRITE                         "storageOpenWrite"
+    STRING_DECLARE(PROTOCOL_COMMAND_STORAGE_OPEN_WRITE_STR);
+#define PROTOCOL_COMMAND_STORAGE_REMOVE                             "storageRemove"
+    STRING_DECLARE(PROTOCOL_COMMAND_STORAGE_REMOVE_STR);
+
+// Keys used to send filters to run on the remote.  The param key is omitted for filters that take no parameter.
+#define PROTOCOL_STORAGE_FILTER_PARAM                               "param"
+    STRING_DECLARE(PROTOCOL_STORAGE_FILTER_PARAM_STR);
+#define PROTOCOL_STORAGE_FILTER_TYPE                                "type"
+    STRING_DECLARE(PROTOCOL_STORAGE_FILTER_TYPE_STR);
+
+// Keys used to return StorageInfo.  Missing files are returned as null.
+#define PROTOCOL_STORAGE_INFO_MODE                                  "mode"
+    STRING_DECLARE(PROTOCOL_STORAGE_INFO_MODE_STR);
+#define PROTOCOL_STORAGE_INFO_NAME                                  "name"
+    STRING_DECLARE(PROTOCOL_STORAGE_INFO_NAME_STR);
+#define PROTOCOL_STORAGE_INFO_SIZE                                  "size"
+    STRING_DECLARE(PROTOCOL_STORAGE_INFO_SIZE_STR);
+#define PROTOCOL_STORAGE_INFO_TIME                                  "time"
+    STRING_DECLARE(PROTOCOL_STORAGE_INFO_TIME_STR);
+#define PROTOCOL_STORAGE_INFO_TYPE                                  "type"
+    STRING_DECLARE(PROTOCOL_STORAGE_INFO_TYPE_STR);
+
+// Number of entries returned in each response by storageListInfo so the client can start processing before the list is complete
+#define PROTOCOL_STORAGE_LIST_INFO_BATCH                            1000
 
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
+size_t storageDriverRemoteProtocolBlockSize(const String *message);
+VariantList *storageDriverRemoteProtocolFilterToVar(const StringList *filterList);
+Variant *storageDriverRemoteProtocolInfoToVar(const StorageInfo *info);
+StorageInfo storageDriverRemoteProtocolInfoFromVar(const Variant *infoVar);
 bool storageDriverRemoteProtocol(const String *command, const VariantList *paramList, ProtocolServer *server);
 
 #endif
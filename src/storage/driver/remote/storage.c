@@ -7,6 +7,7 @@ Remote Storage Driver
 #include "protocol/client.h"
 #include "protocol/helper.h"
 #include "storage/driver/remote/fileRead.h"
+#include "storage/driver/remote/fileWrite.h"
 #include "storage/driver/remote/protocol.h"
 #include "storage/driver/remote/storage.h"
 
@@ -23,6 +24,7 @@ struct StorageDriverRemote
     MemContext *memContext;
     Storage *interface;                                             // Driver interface
     ProtocolClient *client;                                         // Protocol client
+    unsigned int compressLevel;                                     // Level to use for compressing transfers (0 to disable)
 };
 
 /***********************************************************************************************************************************
@@ -30,7 +32,8 @@ New object
 ***********************************************************************************************************************************/
 StorageDriverRemote *
 storageDriverRemoteNew(
-    mode_t modeFile, mode_t modePath, bool write, StoragePathExpressionCallback pathExpressionFunction, ProtocolClient *client)
+    mode_t modeFile, mode_t modePath, bool write, StoragePathExpressionCallback pathExpressionFunction, ProtocolClient *client,
+    unsigned int compressLevel)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(MODE, modeFile);
@@ -38,6 +41,7 @@ storageDriverRemoteNew(
         FUNCTION_LOG_PARAM(BOOL, write);
         FUNCTION_LOG_PARAM(FUNCTIONP, pathExpressionFunction);
         FUNCTION_LOG_PARAM(PROTOCOL_CLIENT, client);
+        FUNCTION_LOG_PARAM(UINT, compressLevel);
     FUNCTION_LOG_END();
 
     ASSERT(modeFile != 0);
@@ -52,12 +56,17 @@ storageDriverRemoteNew(
         this->memContext = MEM_CONTEXT_NEW();
 
         this->client = client;
+        this->compressLevel = compressLevel;
 
         // Create the storage interface
         this->interface = storageNewP(
             STORAGE_DRIVER_REMOTE_TYPE_STR, NULL, modeFile, modePath, write, pathExpressionFunction, this,
-            .exists = (StorageInterfaceExists)storageDriverRemoteExists, .info = (StorageInterfaceInfo)storageDriverRemoteInfo,
-            .list = (StorageInterfaceList)storageDriverRemoteList, .newRead = (StorageInterfaceNewRead)storageDriverRemoteNewRead,
+            .exists = (StorageInterfaceExists)storageDriverRemoteExists,
+            .existsList = (StorageInterfaceExistsList)storageDriverRemoteExistsList,
+            .info = (StorageInterfaceInfo)storageDriverRemoteInfo, .infoList = (StorageInterfaceInfoList)storageDriverRemoteInfoList,
+            .list = (StorageInterfaceList)storageDriverRemoteList,
+            .listInfo = (StorageInterfaceListInfo)storageDriverRemoteListInfo, .newRead = (StorageInterfaceNewRead)storageDriverRemoteNewRead,
+            .newReadFilter = (StorageInterfaceNewReadFilter)storageDriverRemoteNewReadFilter,
             .newWrite = (StorageInterfaceNewWrite)storageDriverRemoteNewWrite,
             .pathCreate = (StorageInterfacePathCreate)storageDriverRemotePathCreate,
             .pathRemove = (StorageInterfacePathRemove)storageDriverRemotePathRemove,
@@ -88,7 +97,7 @@ storageDriverRemoteExists(StorageDriverRemote *this, const String *path)
     MEM_CONTEXT_TEMP_BEGIN()
     {
         ProtocolCommand *command = protocolCommandNew(PROTOCOL_COMMAND_STORAGE_EXISTS_STR);
-        protocolCommandParamAdd(command, varNewStr(path));
+        protocolCommandParamAdd(command, VARSTR(path));
 
         result = varBool(protocolClientExecute(this->client, command, true));
     }
@@ -97,6 +106,46 @@ storageDriverRemoteExists(StorageDriverRemote *this, const String *path)
     FUNCTION_LOG_RETURN(BOOL, result);
 }
 
+/***********************************************************************************************************************************
+Check if a list of paths exist in a single round trip
+***********************************************************************************************************************************/
+List *
+storageDriverRemoteExistsList(StorageDriverRemote *this, const StringList *pathList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_REMOTE, this);
+        FUNCTION_LOG_PARAM(STRING_LIST, pathList);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(pathList != NULL);
+
+    List *result = lstNew(sizeof(bool));
+
+    // No need for a round trip when the list is empty
+    if (strLstSize(pathList) > 0)
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            ProtocolCommand *command = protocolCommandNew(PROTOCOL_COMMAND_STORAGE_EXISTS_LIST_STR);
+
+            for (unsigned int pathIdx = 0; pathIdx < strLstSize(pathList); pathIdx++)
+                protocolCommandParamAdd(command, VARSTR(strLstGet(pathList, pathIdx)));
+
+            const VariantList *existsList = varVarLst(protocolClientExecute(this->client, command, true));
+
+            for (unsigned int pathIdx = 0; pathIdx < varLstSize(existsList); pathIdx++)
+            {
+                bool exists = varBool(varLstGet(existsList, pathIdx));
+                lstAdd(result, &exists);
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    FUNCTION_LOG_RETURN(LIST, result);
+}
+
 /***********************************************************************************************************************************
 File/path info
 ***********************************************************************************************************************************/
@@ -112,9 +161,61 @@ storageDriverRemoteInfo(StorageDriverRemote *this, const String *file, bool igno
     ASSERT(this != NULL);
     ASSERT(file != NULL);
 
-    THROW(AssertError, "NOT YET IMPLEMENTED");
+    StorageInfo result = {0};
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        StringList *fileList = strLstNew();
+        strLstAdd(fileList, file);
+
+        result = *(StorageInfo *)lstGet(storageDriverRemoteInfoList(this, fileList, ignoreMissing), 0);
+    }
+    MEM_CONTEXT_TEMP_END();
 
-    FUNCTION_LOG_RETURN(STORAGE_INFO, (StorageInfo){0});
+    FUNCTION_LOG_RETURN(STORAGE_INFO, result);
+}
+
+/***********************************************************************************************************************************
+Get info for a list of files in a single round trip
+***********************************************************************************************************************************/
+List *
+storageDriverRemoteInfoList(StorageDriverRemote *this, const StringList *fileList, bool ignoreMissing)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_REMOTE, this);
+        FUNCTION_LOG_PARAM(STRING_LIST, fileList);
+        FUNCTION_LOG_PARAM(BOOL, ignoreMissing);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(fileList != NULL);
+
+    List *result = lstNew(sizeof(StorageInfo));
+
+    // No need for a round trip when the list is empty
+    if (strLstSize(fileList) > 0)
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            ProtocolCommand *command = protocolCommandNew(PROTOCOL_COMMAND_STORAGE_INFO_LIST_STR);
+            protocolCommandParamAdd(command, VARBOOL(ignoreMissing));
+
+            for (unsigned int fileIdx = 0; fileIdx < strLstSize(fileList); fileIdx++)
+                protocolCommandParamAdd(command, VARSTR(strLstGet(fileList, fileIdx)));
+
+            const VariantList *infoList = varVarLst(protocolClientExecute(this->client, command, true));
+
+            for (unsigned int fileIdx = 0; fileIdx < varLstSize(infoList); fileIdx++)
+            {
+                // Missing files are returned as null
+                StorageInfo info = storageDriverRemoteProtocolInfoFromVar(varLstGet(infoList, fileIdx));
+                lstAdd(result, &info);
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    FUNCTION_LOG_RETURN(LIST, result);
 }
 
 /***********************************************************************************************************************************
@@ -138,9 +239,9 @@ storageDriverRemoteList(StorageDriverRemote *this, const String *path, bool erro
     MEM_CONTEXT_TEMP_BEGIN()
     {
         ProtocolCommand *command = protocolCommandNew(PROTOCOL_COMMAND_STORAGE_LIST_STR);
-        protocolCommandParamAdd(command, varNewStr(path));
-        protocolCommandParamAdd(command, varNewBool(errorOnMissing));
-        protocolCommandParamAdd(command, varNewStr(expression));
+        protocolCommandParamAdd(command, VARSTR(path));
+        protocolCommandParamAdd(command, VARBOOL(errorOnMissing));
+        protocolCommandParamAdd(command, VARSTR(expression));
 
         result = strLstMove(strLstNewVarLst(varVarLst(protocolClientExecute(this->client, command, true))), MEM_CONTEXT_OLD());
     }
@@ -150,22 +251,127 @@ storageDriverRemoteList(StorageDriverRemote *this, const String *path, bool erro
 }
 
 /***********************************************************************************************************************************
-New file read object
+Get info for the contents of a path.  The remote sends info in batches as it is read so the callback can process entries before the
+list is complete.  The final response is whether the path exists.
+***********************************************************************************************************************************/
+bool
+storageDriverRemoteListInfo(
+    StorageDriverRemote *this, const String *path, bool errorOnMissing, bool recurse, StorageListInfoCallback callback,
+    void *callbackData)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_REMOTE, this);
+        FUNCTION_LOG_PARAM(STRING, path);
+        FUNCTION_LOG_PARAM(BOOL, errorOnMissing);
+        FUNCTION_LOG_PARAM(BOOL, recurse);
+        FUNCTION_LOG_PARAM(FUNCTIONP, callback);
+        FUNCTION_LOG_PARAM_P(VOID, callbackData);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(callback != NULL);
+
+    bool result = false;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        ProtocolCommand *command = protocolCommandNew(PROTOCOL_COMMAND_STORAGE_LIST_INFO_STR);
+        protocolCommandParamAdd(command, VARSTR(path));
+        protocolCommandParamAdd(command, VARBOOL(errorOnMissing));
+        protocolCommandParamAdd(command, VARBOOL(recurse));
+
+        protocolClientWriteCommand(this->client, command);
+
+        // Process batches until the final response is received
+        while (true)
+        {
+            bool done = false;
+
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                const Variant *output = protocolClientReadOutput(this->client, true);
+
+                if (varType(output) == varTypeBool)
+                {
+                    result = varBool(output);
+                    done = true;
+                }
+                else
+                {
+                    const VariantList *infoList = varVarLst(output);
+
+                    for (unsigned int infoIdx = 0; infoIdx < varLstSize(infoList); infoIdx++)
+                    {
+                        StorageInfo info = storageDriverRemoteProtocolInfoFromVar(varLstGet(infoList, infoIdx));
+                        callback(callbackData, &info);
+                    }
+                }
+            }
+            MEM_CONTEXT_TEMP_END();
+
+            if (done)
+                break;
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
+
+/***********************************************************************************************************************************
+New file read object.  The transfer is only compressed when the caller indicates the file is compressible since compressing data
+that is already compressed or encrypted wastes CPU on both ends without reducing the transfer.
 ***********************************************************************************************************************************/
 StorageFileRead *
-storageDriverRemoteNewRead(StorageDriverRemote *this, const String *file, bool ignoreMissing)
+storageDriverRemoteNewRead(StorageDriverRemote *this, const String *file, bool ignoreMissing, bool noCache, bool compressible)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STORAGE_DRIVER_REMOTE, this);
         FUNCTION_LOG_PARAM(STRING, file);
         FUNCTION_LOG_PARAM(BOOL, ignoreMissing);
+        FUNCTION_LOG_PARAM(BOOL, noCache);
+        FUNCTION_LOG_PARAM(BOOL, compressible);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
 
     FUNCTION_LOG_RETURN(
         STORAGE_FILE_READ,
-        storageDriverRemoteFileReadInterface(storageDriverRemoteFileReadNew(this, this->client, file, ignoreMissing)));
+        storageDriverRemoteFileReadInterface(
+            storageDriverRemoteFileReadNew(
+                this, this->client, file, ignoreMissing, noCache, compressible ? this->compressLevel : 0, NULL)));
+}
+
+/***********************************************************************************************************************************
+New file read object with filters run on the remote
+
+Each filter is specified as a filter type optionally followed by a colon and a parameter, e.g. hash:sha1 or size.  Running the
+filters on the remote means the file is hashed, etc. on the host where it is stored rather than by the local process.  Results are
+available from storageFileReadFilterResult() once the file has been read.  See storageDriverRemoteNewRead() for a description of
+compressible.
+***********************************************************************************************************************************/
+StorageFileRead *
+storageDriverRemoteNewReadFilter(
+    StorageDriverRemote *this, const String *file, bool ignoreMissing, bool noCache, bool compressible,
+    const StringList *filterList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_REMOTE, this);
+        FUNCTION_LOG_PARAM(STRING, file);
+        FUNCTION_LOG_PARAM(BOOL, ignoreMissing);
+        FUNCTION_LOG_PARAM(BOOL, noCache);
+        FUNCTION_LOG_PARAM(BOOL, compressible);
+        FUNCTION_LOG_PARAM(STRING_LIST, filterList);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(filterList != NULL);
+
+    FUNCTION_LOG_RETURN(
+        STORAGE_FILE_READ,
+        storageDriverRemoteFileReadInterface(
+            storageDriverRemoteFileReadNew(
+                this, this->client, file, ignoreMissing, noCache, compressible ? this->compressLevel : 0, filterList)));
 }
 
 /***********************************************************************************************************************************
@@ -174,7 +380,7 @@ New file write object
 StorageFileWrite *
 storageDriverRemoteNewWrite(
     StorageDriverRemote *this, const String *file, mode_t modeFile, mode_t modePath, bool createPath, bool syncFile,
-    bool syncPath, bool atomic)
+    bool syncPath, bool atomic, bool noCache)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STORAGE_DRIVER_REMOTE, this);
@@ -185,14 +391,18 @@ storageDriverRemoteNewWrite(
         FUNCTION_LOG_PARAM(BOOL, syncFile);
         FUNCTION_LOG_PARAM(BOOL, syncPath);
         FUNCTION_LOG_PARAM(BOOL, atomic);
+        FUNCTION_LOG_PARAM(BOOL, noCache);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
     ASSERT(file != NULL);
 
-    THROW(AssertError, "NOT YET IMPLEMENTED");
-
-    FUNCTION_LOG_RETURN(STORAGE_FILE_WRITE, NULL);
+    FUNCTION_LOG_RETURN(
+        STORAGE_FILE_WRITE,
+        storageDriverRemoteFileWriteInterface(
+            storageDriverRemoteFileWriteNew(
+                this, this->client, file, modeFile, modePath, createPath, syncFile, syncPath, atomic, noCache,
+                this->compressLevel)));
 }
 
 /***********************************************************************************************************************************
@@ -273,7 +483,15 @@ storageDriverRemoteRemove(StorageDriverRemote *this, const String *file, bool er
     ASSERT(this != NULL);
     ASSERT(file != NULL);
 
-    THROW(AssertError, "NOT YET IMPLEMENTED");
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        ProtocolCommand *command = protocolCommandNew(PROTOCOL_COMMAND_STORAGE_REMOVE_STR);
+        protocolCommandParamAdd(command, VARSTR(file));
+        protocolCommandParamAdd(command, VARBOOL(errorOnMissing));
+
+        protocolClientExecute(this->client, command, false);
+    }
+    MEM_CONTEXT_TEMP_END();
 
     FUNCTION_LOG_RETURN_VOID();
 }
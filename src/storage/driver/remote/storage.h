@@ -23,18 +23,28 @@ Driver type constant
 Constructor
 ***********************************************************************************************************************************/
 StorageDriverRemote *storageDriverRemoteNew(
-    mode_t modeFile, mode_t modePath, bool write, StoragePathExpressionCallback pathExpressionFunction, ProtocolClient *client);
+    mode_t modeFile, mode_t modePath, bool write, StoragePathExpressionCallback pathExpressionFunction, ProtocolClient *client,
+    unsigned int compressLevel);
 
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
 bool storageDriverRemoteExists(StorageDriverRemote *this, const String *path);
+List *storageDriverRemoteExistsList(StorageDriverRemote *this, const StringList *pathList);
 StorageInfo storageDriverRemoteInfo(StorageDriverRemote *this, const String *file, bool ignoreMissing);
+List *storageDriverRemoteInfoList(StorageDriverRemote *this, const StringList *fileList, bool ignoreMissing);
 StringList *storageDriverRemoteList(StorageDriverRemote *this, const String *path, bool errorOnMissing, const String *expression);
-StorageFileRead *storageDriverRemoteNewRead(StorageDriverRemote *this, const String *file, bool ignoreMissing);
+bool storageDriverRemoteListInfo(
+    StorageDriverRemote *this, const String *path, bool errorOnMissing, bool recurse, StorageListInfoCallback callback,
+    void *callbackData);
+StorageFileRead *storageDriverRemoteNewRead(
+    StorageDriverRemote *this, const String *file, bool ignoreMissing, bool noCache, bool compressible);
+StorageFileRead *storageDriverRemoteNewReadFilter(
+    StorageDriverRemote *this, const String *file, bool ignoreMissing, bool noCache, bool compressible,
+    const StringList *filterList);
 StorageFileWrite *storageDriverRemoteNewWrite(
     StorageDriverRemote *this, const String *file, mode_t modeFile, mode_t modePath, bool createPath, bool syncFile, bool syncPath,
-    bool atomic);
+    bool atomic, bool noCache);
 void storageDriverRemotePathCreate(
     StorageDriverRemote *this, const String *path, bool errorOnExists, bool noParentCreate, mode_t mode);
 void storageDriverRemotePathRemove(StorageDriverRemote *this, const String *path, bool errorOnMissing, bool recurse);
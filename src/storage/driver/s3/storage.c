@@ -1,13 +1,20 @@
 /***********************************************************************************************************************************
 S3 Storage Driver
 ***********************************************************************************************************************************/
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/select.h>
 #include <time.h>
 
 #include "common/debug.h"
+#include "common/encode.h"
 #include "common/io/http/common.h"
 #include "common/log.h"
 #include "common/memContext.h"
 #include "common/regExp.h"
+#include "common/type/convert.h"
+#include "common/type/list.h"
 #include "common/type/xml.h"
 #include "crypto/hash.h"
 #include "storage/driver/s3/fileRead.h"
@@ -31,6 +38,7 @@ STRING_STATIC(S3_HEADER_TOKEN_STR,                                  "x-amz-secur
 S3 query tokens
 ***********************************************************************************************************************************/
 STRING_STATIC(S3_QUERY_CONTINUATION_TOKEN_STR,                      "continuation-token");
+STRING_STATIC(S3_QUERY_DELETE_STR,                                  "delete");
 STRING_STATIC(S3_QUERY_DELIMITER_STR,                               "delimiter");
 STRING_STATIC(S3_QUERY_LIST_TYPE_STR,                               "list-type");
 STRING_STATIC(S3_QUERY_PREFIX_STR,                                  "prefix");
@@ -40,11 +48,20 @@ STRING_STATIC(S3_QUERY_VALUE_LIST_TYPE_2_STR,                       "2");
 /***********************************************************************************************************************************
 XML tags
 ***********************************************************************************************************************************/
-STRING_STATIC(S3_XML_TAG_COMMON_PREFIXES_STR,                       "CommonPrefixes");
+STRING_STATIC(S3_XML_TAG_CODE_STR,                                  "Code");
 STRING_STATIC(S3_XML_TAG_CONTENTS_STR,                              "Contents");
+STRING_STATIC(S3_XML_TAG_DELETE_STR,                                "Delete");
+STRING_STATIC(S3_XML_TAG_ERROR_STR,                                 "Error");
 STRING_STATIC(S3_XML_TAG_KEY_STR,                                   "Key");
+STRING_STATIC(S3_XML_TAG_LAST_MODIFIED_STR,                         "LastModified");
+STRING_STATIC(S3_XML_TAG_MESSAGE_STR,                               "Message");
 STRING_STATIC(S3_XML_TAG_NEXT_CONTINUATION_TOKEN_STR,               "NextContinuationToken");
+STRING_STATIC(S3_XML_TAG_OBJECT_STR,                                "Object");
 STRING_STATIC(S3_XML_TAG_PREFIX_STR,                                "Prefix");
+STRING_STATIC(S3_XML_TAG_QUIET_STR,                                 "Quiet");
+STRING_STATIC(S3_XML_TAG_SIZE_STR,                                  "Size");
+
+STRING_STATIC(S3_XML_VALUE_TRUE_STR,                                "true");
 
 /***********************************************************************************************************************************
 AWS authentication v4 constants
@@ -54,11 +71,31 @@ AWS authentication v4 constants
 #define AWS4_REQUEST                                                "aws4_request"
 #define AWS4_HMAC_SHA256                                            "AWS4-HMAC-SHA256"
 
+/***********************************************************************************************************************************
+Maximum number of connections used to make concurrent requests
+***********************************************************************************************************************************/
+#define S3_CONNECTION_MAX                                           8
+
+/***********************************************************************************************************************************
+Maximum number of keys that can be deleted in a single request
+***********************************************************************************************************************************/
+#define S3_DELETE_MAX                                               1000
+
 /***********************************************************************************************************************************
 Starting data for signing string so it will be regenerated on the first request
 ***********************************************************************************************************************************/
 STRING_STATIC(YYYYMMDD_STR,                                         "YYYYMMDD");
 
+/***********************************************************************************************************************************
+Payload hash when there is no content (the sha256 of an empty string)
+***********************************************************************************************************************************/
+STRING_STATIC(S3_PAYLOAD_HASH_EMPTY_STR, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+
+/***********************************************************************************************************************************
+Payload hash used when content is not included in the signature.  This is allowed since requests are always sent over TLS.
+***********************************************************************************************************************************/
+STRING_STATIC(S3_PAYLOAD_UNSIGNED_STR,                              "UNSIGNED-PAYLOAD");
+
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
@@ -67,8 +104,17 @@ struct StorageDriverS3
     MemContext *memContext;
     Storage *interface;                                             // Driver interface
     HttpClient *httpClient;                                         // Http client to service requests
+    List *httpClientList;                                           // Http clients used to make concurrent requests
+    unsigned int connectionMax;                                     // Max connections to use for concurrent requests
+    unsigned int deleteMax;                                         // Max keys to delete in a single request
     const StringList *headerRedactList;                             // List of headers to redact from logging
 
+    unsigned int port;                                              // Port used to create additional http clients
+    TimeMSec timeout;                                               // Timeout used to create additional http clients
+    bool verifyPeer;                                                // Verify peer for additional http clients
+    const String *caFile;                                           // CA file for additional http clients
+    const String *caPath;                                           // CA path for additional http clients
+
     const String *bucket;                                           // Bucket to store data in
     const String *region;                                           // e.g. us-east-1
     const String *accessKey;                                        // Access key
@@ -79,6 +125,14 @@ struct StorageDriverS3
     // Current signing key and date it is valid for
     const String *signingKeyDate;                                   // Date of cached signing key (so we know when to regenerate)
     const Buffer *signingKey;                                       // Cached signing key
+    const String *signingScope;                                     // Credential scope for the date, e.g. {date}/{region}/s3/...
+    const String *authorizationPrefix;                              // Authorization header up to the signed header list
+
+    // Buffers reused for every signature so they are not allocated per request
+    Buffer *authCanonicalRequest;                                   // Canonical request
+    Buffer *authSignedHeaders;                                      // Signed header list
+    Buffer *authStringToSign;                                       // String to sign
+    Buffer *authorization;                                          // Authorization header
 };
 
 /***********************************************************************************************************************************
@@ -105,10 +159,58 @@ storageDriverS3DateTime(time_t authTime)
     FUNCTION_TEST_RETURN(strNew(buffer));
 }
 
+/***********************************************************************************************************************************
+Append a string to a reused signing buffer
+***********************************************************************************************************************************/
+static void
+storageDriverS3AuthCat(Buffer *buffer, const char *cat, size_t catSize)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, buffer);
+        FUNCTION_TEST_PARAM(STRINGZ, cat);
+        FUNCTION_TEST_PARAM(SIZE, catSize);
+    FUNCTION_TEST_END();
+
+    ASSERT(buffer != NULL);
+    ASSERT(cat != NULL);
+
+    bufCatC(buffer, (const unsigned char *)cat, 0, catSize);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Append lower case hex of a hash to a reused signing buffer
+***********************************************************************************************************************************/
+static void
+storageDriverS3AuthCatHex(Buffer *buffer, const Buffer *hash)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, buffer);
+        FUNCTION_TEST_PARAM(BUFFER, hash);
+    FUNCTION_TEST_END();
+
+    ASSERT(buffer != NULL);
+    ASSERT(hash != NULL);
+
+    static const char hexDigit[] = "0123456789abcdef";
+
+    for (size_t hashIdx = 0; hashIdx < bufSize(hash); hashIdx++)
+    {
+        const char hex[2] = {hexDigit[bufPtr(hash)[hashIdx] >> 4], hexDigit[bufPtr(hash)[hashIdx] & 0xF]};
+        storageDriverS3AuthCat(buffer, hex, sizeof(hex));
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Generate authorization header and add it to the supplied header list
 
 Based on the excellent documentation at http://docs.aws.amazon.com/AmazonS3/latest/API/sig-v4-header-based-auth.html.
+
+The canonical request, signed headers, string to sign, and authorization are built in buffers owned by the driver that are emptied
+rather than freed between requests, so they are only allocated when a request is larger than any before it.
 ***********************************************************************************************************************************/
 static void
 storageDriverS3Auth(
@@ -128,14 +230,12 @@ storageDriverS3Auth(
     ASSERT(verb != NULL);
     ASSERT(uri != NULL);
     ASSERT(dateTime != NULL);
+    ASSERT(strSize(dateTime) == ISO_8601_DATE_TIME_SIZE);
     ASSERT(httpHeader != NULL);
     ASSERT(payloadHash != NULL);
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        // Get date from datetime
-        const String *date = strSubN(dateTime, 0, 8);
-
         // Set required headers
         httpHeaderPut(httpHeader, S3_HEADER_CONTENT_SHA256_STR, payloadHash);
         httpHeaderPut(httpHeader, S3_HEADER_DATE_STR, dateTime);
@@ -144,42 +244,57 @@ storageDriverS3Auth(
         if (this->securityToken != NULL)
             httpHeaderPut(httpHeader, S3_HEADER_TOKEN_STR, this->securityToken);
 
-        // Generate canonical request and signed headers
-        const StringList *headerList = strLstSort(strLstDup(httpHeaderList(httpHeader)), sortOrderAsc);
-        String *signedHeaders = NULL;
+        // Generate canonical request and signed headers.  Header keys are always added in lower case and httpHeaderList() returns
+        // them sorted so they can be used as is.
+        const StringList *headerList = httpHeaderList(httpHeader);
+        const String *queryRender = query == NULL ? NULL : httpQueryRender(query);
 
-        String *canonicalRequest = strNewFmt(
-            "%s\n%s\n%s\n", strPtr(verb), strPtr(uri), query == NULL ? "" : strPtr(httpQueryRender(query)));
+        bufUsedZero(this->authCanonicalRequest);
+        bufUsedZero(this->authSignedHeaders);
+
+        storageDriverS3AuthCat(this->authCanonicalRequest, strPtr(verb), strSize(verb));
+        storageDriverS3AuthCat(this->authCanonicalRequest, "\n", 1);
+        storageDriverS3AuthCat(this->authCanonicalRequest, strPtr(uri), strSize(uri));
+        storageDriverS3AuthCat(this->authCanonicalRequest, "\n", 1);
+
+        if (queryRender != NULL)
+            storageDriverS3AuthCat(this->authCanonicalRequest, strPtr(queryRender), strSize(queryRender));
+
+        storageDriverS3AuthCat(this->authCanonicalRequest, "\n", 1);
 
         for (unsigned int headerIdx = 0; headerIdx < strLstSize(headerList); headerIdx++)
         {
             const String *headerKey = strLstGet(headerList, headerIdx);
-            const String *headerKeyLower = strLower(strDup(headerKey));
+            const String *headerValue = httpHeaderGet(httpHeader, headerKey);
 
             // Skip the authorization header -- if it exists this is a retry
-            if (strEq(headerKeyLower, S3_HEADER_AUTHORIZATION_STR))
+            if (strEq(headerKey, S3_HEADER_AUTHORIZATION_STR))
                 continue;
 
-            strCatFmt(canonicalRequest, "%s:%s\n", strPtr(headerKeyLower), strPtr(httpHeaderGet(httpHeader, headerKey)));
+            storageDriverS3AuthCat(this->authCanonicalRequest, strPtr(headerKey), strSize(headerKey));
+            storageDriverS3AuthCat(this->authCanonicalRequest, ":", 1);
+            storageDriverS3AuthCat(this->authCanonicalRequest, strPtr(headerValue), strSize(headerValue));
+            storageDriverS3AuthCat(this->authCanonicalRequest, "\n", 1);
 
-            if (signedHeaders == NULL)
-                signedHeaders = strDup(headerKeyLower);
-            else
-                strCatFmt(signedHeaders, ";%s", strPtr(headerKeyLower));
-        }
+            if (bufUsed(this->authSignedHeaders) > 0)
+                storageDriverS3AuthCat(this->authSignedHeaders, ";", 1);
 
-        strCatFmt(canonicalRequest, "\n%s\n%s", strPtr(signedHeaders), strPtr(payloadHash));
+            storageDriverS3AuthCat(this->authSignedHeaders, strPtr(headerKey), strSize(headerKey));
+        }
 
-        // Generate string to sign
-        const String *stringToSign = strNewFmt(
-            AWS4_HMAC_SHA256 "\n%s\n%s/%s/" S3 "/" AWS4_REQUEST "\n%s", strPtr(dateTime), strPtr(date), strPtr(this->region),
-            strPtr(bufHex(cryptoHashOneStr(HASH_TYPE_SHA256_STR, canonicalRequest))));
+        storageDriverS3AuthCat(this->authCanonicalRequest, "\n", 1);
+        bufCat(this->authCanonicalRequest, this->authSignedHeaders);
+        storageDriverS3AuthCat(this->authCanonicalRequest, "\n", 1);
+        storageDriverS3AuthCat(this->authCanonicalRequest, strPtr(payloadHash), strSize(payloadHash));
 
         // Generate signing key.  This key only needs to be regenerated every seven days but we'll do it once a day to keep the
         // logic simple.  It's a relatively expensive operation so we'd rather not do it for every request.
-        // If the cached signing key has expired (or has noe been generated) then regenerate it
-        if (!strEq(date, this->signingKeyDate))
+        // If the cached signing key has expired (or has not been generated) then regenerate it along with the credential scope
+        // and authorization prefix, which also only change when the date changes.
+        if (strncmp(strPtr(dateTime), strPtr(this->signingKeyDate), strSize(this->signingKeyDate)) != 0)
         {
+            const String *date = strSubN(dateTime, 0, strSize(this->signingKeyDate));
+
             const Buffer *dateKey = cryptoHmacOne(
                 HASH_TYPE_SHA256_STR, bufNewStr(strNewFmt(AWS4 "%s", strPtr(this->secretAccessKey))), bufNewStr(date));
             const Buffer *regionKey = cryptoHmacOne(HASH_TYPE_SHA256_STR, dateKey, bufNewStr(this->region));
@@ -190,17 +305,39 @@ storageDriverS3Auth(
             {
                 this->signingKey = cryptoHmacOne(HASH_TYPE_SHA256_STR, serviceKey, bufNewZ(AWS4_REQUEST));
                 this->signingKeyDate = strDup(date);
+                this->signingScope = strNewFmt("%s/%s/" S3 "/" AWS4_REQUEST, strPtr(date), strPtr(this->region));
+                this->authorizationPrefix = strNewFmt(
+                    AWS4_HMAC_SHA256 " Credential=%s/%s,SignedHeaders=", strPtr(this->accessKey), strPtr(this->signingScope));
             }
             MEM_CONTEXT_END();
         }
 
+        // Generate string to sign
+        bufUsedZero(this->authStringToSign);
+
+        storageDriverS3AuthCat(this->authStringToSign, AWS4_HMAC_SHA256 "\n", sizeof(AWS4_HMAC_SHA256 "\n") - 1);
+        storageDriverS3AuthCat(this->authStringToSign, strPtr(dateTime), strSize(dateTime));
+        storageDriverS3AuthCat(this->authStringToSign, "\n", 1);
+        storageDriverS3AuthCat(this->authStringToSign, strPtr(this->signingScope), strSize(this->signingScope));
+        storageDriverS3AuthCat(this->authStringToSign, "\n", 1);
+        storageDriverS3AuthCatHex(
+            this->authStringToSign,
+            cryptoHashOneC(HASH_TYPE_SHA256_STR, bufPtr(this->authCanonicalRequest), bufUsed(this->authCanonicalRequest)));
+
         // Generate authorization header
-        const String *authorization = strNewFmt(
-            AWS4_HMAC_SHA256 " Credential=%s/%s/%s/" S3 "/" AWS4_REQUEST ",SignedHeaders=%s,Signature=%s",
-            strPtr(this->accessKey), strPtr(date), strPtr(this->region), strPtr(signedHeaders),
-            strPtr(bufHex(cryptoHmacOne(HASH_TYPE_SHA256_STR, this->signingKey, bufNewStr(stringToSign)))));
+        bufUsedZero(this->authorization);
+
+        storageDriverS3AuthCat(this->authorization, strPtr(this->authorizationPrefix), strSize(this->authorizationPrefix));
+        bufCat(this->authorization, this->authSignedHeaders);
+        storageDriverS3AuthCat(this->authorization, ",Signature=", sizeof(",Signature=") - 1);
 
-        httpHeaderPut(httpHeader, S3_HEADER_AUTHORIZATION_STR, authorization);
+        // Limit the string to sign to the used portion since the hmac is calculated on the full size of the buffer
+        bufLimitSet(this->authStringToSign, bufUsed(this->authStringToSign));
+        storageDriverS3AuthCatHex(
+            this->authorization, cryptoHmacOne(HASH_TYPE_SHA256_STR, this->signingKey, this->authStringToSign));
+        bufLimitClear(this->authStringToSign);
+
+        httpHeaderPut(httpHeader, S3_HEADER_AUTHORIZATION_STR, strNewBuf(this->authorization));
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -260,11 +397,19 @@ storageDriverS3New(
         // Force the signing key to be generated on the first run
         this->signingKeyDate = YYYYMMDD_STR;
 
+        // Create buffers reused for signing
+        this->authCanonicalRequest = bufNew(0);
+        this->authSignedHeaders = bufNew(0);
+        this->authStringToSign = bufNew(0);
+        this->authorization = bufNew(0);
+
         // Create the storage interface
         this->interface = storageNewP(
             STORAGE_DRIVER_S3_TYPE_STR, path, 0, 0, write, pathExpressionFunction, this,
             .exists = (StorageInterfaceExists)storageDriverS3Exists, .info = (StorageInterfaceInfo)storageDriverS3Info,
-            .list = (StorageInterfaceList)storageDriverS3List, .newRead = (StorageInterfaceNewRead)storageDriverS3NewRead,
+            .list = (StorageInterfaceList)storageDriverS3List, .listPrefix = (StorageInterfaceListPrefix)storageDriverS3ListPrefix,
+            .listInfo = (StorageInterfaceListInfo)storageDriverS3ListInfo,
+            .newRead = (StorageInterfaceNewRead)storageDriverS3NewRead,
             .newWrite = (StorageInterfaceNewWrite)storageDriverS3NewWrite,
             .pathCreate = (StorageInterfacePathCreate)storageDriverS3PathCreate,
             .pathRemove = (StorageInterfacePathRemove)storageDriverS3PathRemove,
@@ -273,6 +418,16 @@ storageDriverS3New(
         // Create the http client used to service requests
         this->httpClient = httpClientNew(this->host, port, timeout, verifyPeer, caFile, caPath);
         this->headerRedactList = strLstAdd(strLstNew(), S3_HEADER_AUTHORIZATION_STR);
+
+        // Store settings needed to create additional http clients for concurrent requests
+        this->httpClientList = lstNew(sizeof(HttpClient *));
+        this->connectionMax = S3_CONNECTION_MAX;
+        this->deleteMax = S3_DELETE_MAX;
+        this->port = port;
+        this->timeout = timeout;
+        this->verifyPeer = verifyPeer;
+        this->caFile = strDup(caFile);
+        this->caPath = strDup(caPath);
     }
     MEM_CONTEXT_NEW_END();
 
@@ -280,51 +435,104 @@ storageDriverS3New(
 }
 
 /***********************************************************************************************************************************
-Process S3 request
+Send S3 request without waiting for the response
+
+The request header is returned so it can be included in the error message if the request fails.
 ***********************************************************************************************************************************/
-Buffer *
-storageDriverS3Request(
-    StorageDriverS3 *this, const String *verb, const String *uri, const HttpQuery *query, const Buffer *body, bool returnContent,
-    bool allowMissing)
+static HttpHeader *
+storageDriverS3RequestSend(
+    StorageDriverS3 *this, HttpClient *httpClient, const String *verb, const String *uri, const HttpQuery *query,
+    const Buffer *body)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STORAGE_DRIVER_S3, this);
+        FUNCTION_LOG_PARAM(HTTP_CLIENT, httpClient);
         FUNCTION_LOG_PARAM(STRING, verb);
         FUNCTION_LOG_PARAM(STRING, uri);
         FUNCTION_LOG_PARAM(HTTP_QUERY, query);
         FUNCTION_LOG_PARAM(BUFFER, body);
-        FUNCTION_LOG_PARAM(BOOL, returnContent);
-        FUNCTION_LOG_PARAM(BOOL, allowMissing);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
+    ASSERT(httpClient != NULL);
     ASSERT(verb != NULL);
     ASSERT(uri != NULL);
 
-    Buffer *result = NULL;
+    // Create header list and add content length
+    HttpHeader *result = httpHeaderNew(this->headerRedactList);
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        // Create header list and add content length
-        HttpHeader *requestHeader = httpHeaderNew(this->headerRedactList);
-        httpHeaderAdd(requestHeader, HTTP_HEADER_CONTENT_LENGTH_STR, ZERO_STR);
+        // Set content length and md5 when there is content
+        const String *payloadHash = S3_PAYLOAD_HASH_EMPTY_STR;
+
+        if (body == NULL)
+            httpHeaderAdd(result, HTTP_HEADER_CONTENT_LENGTH_STR, ZERO_STR);
+        else
+        {
+            httpHeaderAdd(result, HTTP_HEADER_CONTENT_LENGTH_STR, strNewFmt("%zu", bufUsed(body)));
+
+            // Content-MD5 is required by some requests (e.g. DeleteObjects) so always send it
+            const Buffer *md5 = cryptoHashOne(HASH_TYPE_MD5_STR, (Buffer *)body);
+            Buffer *md5Base64 = bufNew(encodeToStrSize(encodeBase64, bufUsed(md5)) + 1);
+
+            encodeToStr(encodeBase64, bufPtr(md5), bufUsed(md5), (char *)bufPtr(md5Base64));
+            httpHeaderAdd(result, HTTP_HEADER_CONTENT_MD5_STR, strNew((char *)bufPtr(md5Base64)));
+
+            // Don't include the content in the signature.  The content is already protected by TLS and Content-MD5 so there is no
+            // need for another pass over it to calculate a sha256 hash.
+            payloadHash = S3_PAYLOAD_UNSIGNED_STR;
+        }
 
         // Generate authorization header
-        storageDriverS3Auth(
-            this, verb, uri, query, storageDriverS3DateTime(time(NULL)), requestHeader,
-            strNew("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"));
+        storageDriverS3Auth(this, verb, uri, query, storageDriverS3DateTime(time(NULL)), result, payloadHash);
 
-        // Process request
-        result = httpClientRequest(this->httpClient, verb, uri, query, requestHeader, returnContent);
+        // Send request
+        httpClientRequestSend(httpClient, verb, uri, query, result, body);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(HTTP_HEADER, result);
+}
+
+/***********************************************************************************************************************************
+Get the response to an S3 request sent with storageDriverS3RequestSend() and error if the request was not successful
+***********************************************************************************************************************************/
+static Buffer *
+storageDriverS3Response(
+    StorageDriverS3 *this, HttpClient *httpClient, const String *uri, const HttpQuery *query, const HttpHeader *requestHeader,
+    bool returnContent, bool allowMissing)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_S3, this);
+        FUNCTION_LOG_PARAM(HTTP_CLIENT, httpClient);
+        FUNCTION_LOG_PARAM(STRING, uri);
+        FUNCTION_LOG_PARAM(HTTP_QUERY, query);
+        FUNCTION_LOG_PARAM(HTTP_HEADER, requestHeader);
+        FUNCTION_LOG_PARAM(BOOL, returnContent);
+        FUNCTION_LOG_PARAM(BOOL, allowMissing);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(httpClient != NULL);
+    ASSERT(uri != NULL);
+    ASSERT(requestHeader != NULL);
+
+    Buffer *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Get the response
+        result = httpClientResponse(httpClient, returnContent);
 
         // Error if the request was not successful
-        if (httpClientResponseCode(this->httpClient) != HTTP_RESPONSE_CODE_OK &&
-            (!allowMissing || httpClientResponseCode(this->httpClient) != HTTP_RESPONSE_CODE_NOT_FOUND))
+        if (httpClientResponseCode(httpClient) != HTTP_RESPONSE_CODE_OK &&
+            (!allowMissing || httpClientResponseCode(httpClient) != HTTP_RESPONSE_CODE_NOT_FOUND))
         {
             // General error message
             String *error = strNewFmt(
-                "S3 request failed with %u: %s", httpClientResponseCode(this->httpClient),
-                strPtr(httpClientResponseMessage(this->httpClient)));
+                "S3 request failed with %u: %s", httpClientResponseCode(httpClient),
+                strPtr(httpClientResponseMessage(httpClient)));
 
             // Output uri/query
             strCat(error, "\n*** URI/Query ***:");
@@ -350,7 +558,7 @@ storageDriverS3Request(
             }
 
             // Output response headers
-            const HttpHeader *responseHeader = httpClientReponseHeader(this->httpClient);
+            const HttpHeader *responseHeader = httpClientReponseHeader(httpClient);
             const StringList *responseHeaderList = httpHeaderList(responseHeader);
 
             if (strLstSize(responseHeaderList) > 0)
@@ -379,6 +587,42 @@ storageDriverS3Request(
     FUNCTION_LOG_RETURN(BUFFER, result);
 }
 
+/***********************************************************************************************************************************
+Process S3 request
+***********************************************************************************************************************************/
+Buffer *
+storageDriverS3Request(
+    StorageDriverS3 *this, const String *verb, const String *uri, const HttpQuery *query, const Buffer *body, bool returnContent,
+    bool allowMissing)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_S3, this);
+        FUNCTION_LOG_PARAM(STRING, verb);
+        FUNCTION_LOG_PARAM(STRING, uri);
+        FUNCTION_LOG_PARAM(HTTP_QUERY, query);
+        FUNCTION_LOG_PARAM(BUFFER, body);
+        FUNCTION_LOG_PARAM(BOOL, returnContent);
+        FUNCTION_LOG_PARAM(BOOL, allowMissing);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(verb != NULL);
+    ASSERT(uri != NULL);
+
+    Buffer *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const HttpHeader *requestHeader = storageDriverS3RequestSend(this, this->httpClient, verb, uri, query, body);
+        result = storageDriverS3Response(this, this->httpClient, uri, query, requestHeader, returnContent, allowMissing);
+
+        bufMove(result, MEM_CONTEXT_OLD());
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(BUFFER, result);
+}
+
 /***********************************************************************************************************************************
 Does a file/path exist?
 ***********************************************************************************************************************************/
@@ -448,6 +692,128 @@ storageDriverS3Info(StorageDriverS3 *this, const String *file, bool ignoreMissin
     FUNCTION_LOG_RETURN(STORAGE_INFO, (StorageInfo){0});
 }
 
+/***********************************************************************************************************************************
+Build the base prefix for a path by stripping off the initial /
+***********************************************************************************************************************************/
+static String *
+storageDriverS3ListBasePrefix(const String *path)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, path);
+    FUNCTION_TEST_END();
+
+    ASSERT(path != NULL);
+
+    FUNCTION_TEST_RETURN(strSize(path) == 1 ? strNew("") : strNewFmt("%s/", strPtr(strSub(path, 1))));
+}
+
+/***********************************************************************************************************************************
+Build the query for a page of list results
+***********************************************************************************************************************************/
+static HttpQuery *
+storageDriverS3ListQuery(const String *queryPrefix, const String *continuationToken, bool recurse)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, queryPrefix);
+        FUNCTION_TEST_PARAM(STRING, continuationToken);
+        FUNCTION_TEST_PARAM(BOOL, recurse);
+    FUNCTION_TEST_END();
+
+    ASSERT(queryPrefix != NULL);
+
+    HttpQuery *result = httpQueryNew();
+
+    // Add continuation token from the prior page if any
+    if (continuationToken != NULL)
+        httpQueryAdd(result, S3_QUERY_CONTINUATION_TOKEN_STR, continuationToken);
+
+    // Add the delimiter so we don't recurse
+    if (!recurse)
+        httpQueryAdd(result, S3_QUERY_DELIMITER_STR, FSLASH_STR);
+
+    // Use list type 2
+    httpQueryAdd(result, S3_QUERY_LIST_TYPE_STR, S3_QUERY_VALUE_LIST_TYPE_2_STR);
+
+    // Don't specified empty prefix because it is the default
+    if (!strEmpty(queryPrefix))
+        httpQueryAdd(result, S3_QUERY_PREFIX_STR, queryPrefix);
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Parse a page of list results as it streams in from the http client and add matching files/paths to the list.  The continuation
+token is returned (or NULL if this is the last page).
+***********************************************************************************************************************************/
+static String *
+storageDriverS3ListPage(HttpClient *httpClient, const String *basePrefix, RegExp *regExp, StringList *list)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(HTTP_CLIENT, httpClient);
+        FUNCTION_TEST_PARAM(STRING, basePrefix);
+        FUNCTION_TEST_PARAM(REGEXP, regExp);
+        FUNCTION_TEST_PARAM(STRING_LIST, list);
+    FUNCTION_TEST_END();
+
+    ASSERT(httpClient != NULL);
+    ASSERT(basePrefix != NULL);
+    ASSERT(list != NULL);
+
+    String *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Parse the response one element at a time so the full document is never held in memory.  Keys and prefixes are filtered
+        // and added to the list as soon as they are read.
+        XmlReader *xmlReader = xmlReaderNew(httpClientIoRead(httpClient));
+
+        while (xmlReaderNext(xmlReader))
+        {
+            // Get the continuation token and store it in the calling context
+            if (xmlReaderDepth(xmlReader) == 1)
+            {
+                if (xmlReaderNameEq(xmlReader, S3_XML_TAG_NEXT_CONTINUATION_TOKEN_STR))
+                {
+                    memContextSwitch(MEM_CONTEXT_OLD());
+                    result = xmlReaderContent(xmlReader);
+                    memContextSwitch(MEM_CONTEXT_TEMP());
+                }
+            }
+            // Prefix only appears at this depth in CommonPrefixes and Key only appears at this depth in Contents
+            else if (xmlReaderDepth(xmlReader) == 2)
+            {
+                // Get subpath name
+                if (xmlReaderNameEq(xmlReader, S3_XML_TAG_PREFIX_STR))
+                {
+                    const String *subPath = xmlReaderContent(xmlReader);
+
+                    // Strip off base prefix and final /
+                    subPath = strSubN(subPath, strSize(basePrefix), strSize(subPath) - strSize(basePrefix) - 1);
+
+                    // Add to list after checking expression if present
+                    if (regExp == NULL || regExpMatch(regExp, subPath))
+                        strLstAdd(list, subPath);
+                }
+                // Get file name
+                else if (xmlReaderNameEq(xmlReader, S3_XML_TAG_KEY_STR))
+                {
+                    const String *file = xmlReaderContent(xmlReader);
+
+                    // Strip off the base prefix when present
+                    file = strEmpty(basePrefix) ? file : strSub(file, strSize(basePrefix));
+
+                    // Add to list after checking expression if present
+                    if (regExp == NULL || regExpMatch(regExp, file))
+                        strLstAdd(list, file);
+                }
+            }
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(result);
+}
+
 /***********************************************************************************************************************************
 Get a list of files from a directory
 ***********************************************************************************************************************************/
@@ -476,12 +842,7 @@ storageDriverS3List(StorageDriverS3 *this, const String *path, bool errorOnMissi
         RegExp *regExp = (expression == NULL) ? NULL : regExpNew(expression);
 
         // Build the base prefix by stripping of the initial /
-        const String *basePrefix;
-
-        if (strSize(path) == 1)
-            basePrefix = EMPTY_STR;
-        else
-            basePrefix = strNewFmt("%s/", strPtr(strSub(path, 1)));
+        const String *basePrefix = storageDriverS3ListBasePrefix(path);
 
         // Get the expression prefix when possible to limit initial results
         const String *expressionPrefix = regExpPrefix(expression);
@@ -499,73 +860,524 @@ storageDriverS3List(StorageDriverS3 *this, const String *path, bool errorOnMissi
                 queryPrefix = strNewFmt("%s%s", strPtr(basePrefix), strPtr(expressionPrefix));
         }
 
-        // Loop as long as a continuation token returned
-        do
+        // Loop as long as a continuation token returned.  Use an inner mem context here because we could potentially be retrieving
+        // millions of files so it is a good idea to free memory after each page.
+        MEM_CONTEXT_TEMP_RESET_BEGIN()
         {
-            // Use an inner mem context here because we could potentially be retrieving millions of files so it is a good idea to
-            // free memory at regular intervals
-            MEM_CONTEXT_TEMP_BEGIN()
+            do
             {
-                HttpQuery *query = httpQueryNew();
+                MEM_CONTEXT_TEMP_RESET(1);
 
-                // Add continuation token from the prior loop if any
-                if (continuationToken != NULL)
-                    httpQueryAdd(query, S3_QUERY_CONTINUATION_TOKEN_STR, continuationToken);
+                // Don't return the content so it can be parsed as it streams in rather than being buffered
+                storageDriverS3Request(
+                    this, HTTP_VERB_GET_STR, FSLASH_STR, storageDriverS3ListQuery(queryPrefix, continuationToken, false), NULL,
+                    false, false);
 
-                // Add the delimiter so we don't recurse
-                httpQueryAdd(query, S3_QUERY_DELIMITER_STR, FSLASH_STR);
+                // Get the continuation token and store it in the outer temp context
+                memContextSwitch(MEM_CONTEXT_OLD());
+                continuationToken = storageDriverS3ListPage(this->httpClient, basePrefix, regExp, result);
+                memContextSwitch(MEM_CONTEXT_TEMP());
+            }
+            while (continuationToken != NULL);
+        }
+        MEM_CONTEXT_TEMP_END();
 
-                // Use list type 2
-                httpQueryAdd(query, S3_QUERY_LIST_TYPE_STR, S3_QUERY_VALUE_LIST_TYPE_2_STR);
+        strLstMove(result, MEM_CONTEXT_OLD());
+    }
+    MEM_CONTEXT_TEMP_END();
 
-                // Don't specified empty prefix because it is the default
-                if (!strEmpty(queryPrefix))
-                    httpQueryAdd(query, S3_QUERY_PREFIX_STR, queryPrefix);
+    FUNCTION_LOG_RETURN(STRING_LIST, result);
+}
 
-                XmlNode *xmlRoot = xmlDocumentRoot(
-                    xmlDocumentNewBuf(storageDriverS3Request(this, HTTP_VERB_GET_STR, FSLASH_STR, query, NULL, true, false)));
+/***********************************************************************************************************************************
+Convert an S3 timestamp (e.g. 2009-10-12T17:50:30.000Z) to time_t.  The time is always UTC so the epoch offset is calculated
+directly rather than with mktime(), which would apply the local timezone.
+***********************************************************************************************************************************/
+static time_t
+storageDriverS3CvtTime(const String *time)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, time);
+    FUNCTION_TEST_END();
 
-                // Get subpath list
-                XmlNodeList *subPathList = xmlNodeChildList(xmlRoot, S3_XML_TAG_COMMON_PREFIXES_STR);
+    ASSERT(time != NULL);
 
-                for (unsigned int subPathIdx = 0; subPathIdx < xmlNodeLstSize(subPathList); subPathIdx++)
+    int year, month, day, hour, minute, second;
+
+    if (sscanf(strPtr(time), "%4d-%2d-%2dT%2d:%2d:%2d", &year, &month, &day, &hour, &minute, &second) != 6)
+        THROW_FMT(FormatError, "invalid time '%s'", strPtr(time));
+
+    // Days since the epoch in the Gregorian calendar with years starting in March so leap days fall at the end of the year.  S3
+    // times are never before the epoch so the year is always positive.
+    year -= month <= 2;
+    int era = year / 400;
+    int yearOfEra = year - era * 400;
+    int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    int64_t days = (int64_t)era * 146097 + dayOfEra - 719468;
+
+    FUNCTION_TEST_RETURN((time_t)(days * 86400 + hour * 3600 + minute * 60 + second));
+}
+
+/***********************************************************************************************************************************
+Parse a page of list results as it streams in from the http client and pass info for each file/path to the callback.  The
+continuation token is returned (or NULL if this is the last page).
+
+The xml reader only reports the start of each element, so the info for a file is not complete until the next element at the same
+depth as Contents (or the end of the page) is reached.
+***********************************************************************************************************************************/
+static String *
+storageDriverS3ListInfoPage(
+    HttpClient *httpClient, const String *basePrefix, StorageListInfoCallback callback, void *callbackData, bool *found)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(HTTP_CLIENT, httpClient);
+        FUNCTION_TEST_PARAM(STRING, basePrefix);
+        FUNCTION_TEST_PARAM(FUNCTIONP, callback);
+        FUNCTION_TEST_PARAM_P(VOID, callbackData);
+        FUNCTION_TEST_PARAM_P(BOOL, found);
+    FUNCTION_TEST_END();
+
+    ASSERT(httpClient != NULL);
+    ASSERT(basePrefix != NULL);
+    ASSERT(callback != NULL);
+    ASSERT(found != NULL);
+
+    String *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        XmlReader *xmlReader = xmlReaderNew(httpClientIoRead(httpClient));
+        StorageInfo file = {0};
+
+        while (xmlReaderNext(xmlReader))
+        {
+            if (xmlReaderDepth(xmlReader) == 1)
+            {
+                // Any element at this depth ends the prior file
+                if (file.name != NULL)
                 {
-                    // Get subpath name
-                    const String *subPath = xmlNodeContent(
-                        xmlNodeChild(xmlNodeLstGet(subPathList, subPathIdx), S3_XML_TAG_PREFIX_STR, true));
+                    callback(callbackData, &file);
+                    file = (StorageInfo){0};
+                }
+
+                // Get the continuation token and store it in the calling context
+                if (xmlReaderNameEq(xmlReader, S3_XML_TAG_NEXT_CONTINUATION_TOKEN_STR))
+                {
+                    memContextSwitch(MEM_CONTEXT_OLD());
+                    result = xmlReaderContent(xmlReader);
+                    memContextSwitch(MEM_CONTEXT_TEMP());
+                }
+            }
+            else if (xmlReaderDepth(xmlReader) == 2)
+            {
+                // Report subpath
+                if (xmlReaderNameEq(xmlReader, S3_XML_TAG_PREFIX_STR))
+                {
+                    const String *subPath = xmlReaderContent(xmlReader);
 
                     // Strip off base prefix and final /
-                    subPath = strSubN(subPath, strSize(basePrefix), strSize(subPath) - strSize(basePrefix) - 1);
+                    StorageInfo path =
+                    {
+                        .name = strSubN(subPath, strSize(basePrefix), strSize(subPath) - strSize(basePrefix) - 1),
+                        .exists = true,
+                        .type = storageTypePath,
+                    };
+
+                    callback(callbackData, &path);
+                    *found = true;
+                }
+                // Start a new file
+                else if (xmlReaderNameEq(xmlReader, S3_XML_TAG_KEY_STR))
+                {
+                    const String *name = xmlReaderContent(xmlReader);
 
-                    // Add to list after checking expression if present
-                    if (regExp == NULL || regExpMatch(regExp, subPath))
-                        strLstAdd(result, subPath);
+                    file.name = strEmpty(basePrefix) ? name : strSub(name, strSize(basePrefix));
+                    file.exists = true;
+                    file.type = storageTypeFile;
+                    *found = true;
                 }
+                else if (xmlReaderNameEq(xmlReader, S3_XML_TAG_SIZE_STR))
+                    file.size = (size_t)cvtZToUInt64(strPtr(xmlReaderContent(xmlReader)));
+                else if (xmlReaderNameEq(xmlReader, S3_XML_TAG_LAST_MODIFIED_STR))
+                    file.timeModified = storageDriverS3CvtTime(xmlReaderContent(xmlReader));
+            }
+        }
 
-                // Get file list
-                XmlNodeList *fileList = xmlNodeChildList(xmlRoot, S3_XML_TAG_CONTENTS_STR);
+        // Report the final file
+        if (file.name != NULL)
+            callback(callbackData, &file);
+    }
+    MEM_CONTEXT_TEMP_END();
 
-                for (unsigned int fileIdx = 0; fileIdx < xmlNodeLstSize(fileList); fileIdx++)
-                {
-                    // Get file name
-                    const String *file = xmlNodeContent(xmlNodeChild(xmlNodeLstGet(fileList, fileIdx), S3_XML_TAG_KEY_STR, true));
+    FUNCTION_TEST_RETURN(result);
+}
 
-                    // Strip off the base prefix when present
-                    file = strEmpty(basePrefix) ? file : strSub(file, strSize(basePrefix));
+/***********************************************************************************************************************************
+Get info for the contents of a path.  When recursing there is no delimiter so S3 returns every key under the prefix, which means
+only files are reported since paths do not exist as objects.
+***********************************************************************************************************************************/
+bool
+storageDriverS3ListInfo(
+    StorageDriverS3 *this, const String *path, bool errorOnMissing, bool recurse, StorageListInfoCallback callback,
+    void *callbackData)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_S3, this);
+        FUNCTION_LOG_PARAM(STRING, path);
+        FUNCTION_LOG_PARAM(BOOL, errorOnMissing);
+        FUNCTION_LOG_PARAM(BOOL, recurse);
+        FUNCTION_LOG_PARAM(FUNCTIONP, callback);
+        FUNCTION_LOG_PARAM_P(VOID, callbackData);
+    FUNCTION_LOG_END();
 
-                    // Add to list after checking expression if present
-                    if (regExp == NULL || regExpMatch(regExp, file))
-                        strLstAdd(result, file);
-                }
+    ASSERT(this != NULL);
+    ASSERT(path != NULL);
+    ASSERT(!errorOnMissing);
+    ASSERT(callback != NULL);
+
+    bool result = false;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const String *continuationToken = NULL;
+        const String *basePrefix = storageDriverS3ListBasePrefix(path);
+
+        // Loop as long as a continuation token returned
+        MEM_CONTEXT_TEMP_RESET_BEGIN()
+        {
+            do
+            {
+                MEM_CONTEXT_TEMP_RESET(1);
+
+                // Don't return the content so it can be parsed as it streams in rather than being buffered
+                storageDriverS3Request(
+                    this, HTTP_VERB_GET_STR, FSLASH_STR, storageDriverS3ListQuery(basePrefix, continuationToken, recurse), NULL,
+                    false, false);
 
                 // Get the continuation token and store it in the outer temp context
                 memContextSwitch(MEM_CONTEXT_OLD());
-                continuationToken = xmlNodeContent(xmlNodeChild(xmlRoot, S3_XML_TAG_NEXT_CONTINUATION_TOKEN_STR, false));
+                continuationToken = storageDriverS3ListInfoPage(this->httpClient, basePrefix, callback, callbackData, &result);
                 memContextSwitch(MEM_CONTEXT_TEMP());
             }
-            MEM_CONTEXT_TEMP_END();
+            while (continuationToken != NULL);
         }
-        while (continuationToken != NULL);
+        MEM_CONTEXT_TEMP_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
+
+/***********************************************************************************************************************************
+Get an http client from the pool used for concurrent requests, creating it if needed
+***********************************************************************************************************************************/
+static HttpClient *
+storageDriverS3HttpClientPool(StorageDriverS3 *this, unsigned int clientIdx)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_S3, this);
+        FUNCTION_TEST_PARAM(UINT, clientIdx);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(clientIdx <= lstSize(this->httpClientList));
+
+    if (clientIdx == lstSize(this->httpClientList))
+    {
+        MEM_CONTEXT_BEGIN(this->memContext)
+        {
+            HttpClient *httpClient = httpClientNew(
+                this->host, this->port, this->timeout, this->verifyPeer, this->caFile, this->caPath);
+            lstAdd(this->httpClientList, &httpClient);
+        }
+        MEM_CONTEXT_END();
+    }
+
+    FUNCTION_TEST_RETURN(*(HttpClient **)lstGet(this->httpClientList, clientIdx));
+}
+
+/***********************************************************************************************************************************
+Free all http clients in the pool.  This is required after an error because the state of outstanding requests is unknown.
+***********************************************************************************************************************************/
+static void
+storageDriverS3HttpClientPoolFree(StorageDriverS3 *this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_S3, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    for (unsigned int clientIdx = 0; clientIdx < lstSize(this->httpClientList); clientIdx++)
+        httpClientFree(*(HttpClient **)lstGet(this->httpClientList, clientIdx));
+
+    lstFree(this->httpClientList);
+
+    MEM_CONTEXT_BEGIN(this->memContext)
+    {
+        this->httpClientList = lstNew(sizeof(HttpClient *));
+    }
+    MEM_CONTEXT_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Get a list of files from a directory that begin with any of the prefixes
+
+Each prefix is listed as a separate shard and pages for the shards are requested concurrently on pooled connections, so a large
+directory can be listed much faster than with storageDriverS3List() when the distribution of names is known in advance (e.g. WAL
+directories sharded on the first hex character).  Responses are processed in the order they arrive so a slow shard does not stall
+the others.  The storage layer sorts the combined results.
+***********************************************************************************************************************************/
+typedef struct StorageDriverS3ListShard
+{
+    bool active;                                                    // Is a shard assigned to this connection?
+    bool sent;                                                      // Was the outstanding request sent?
+    unsigned int shardIdx;                                          // Shard being listed on this connection
+    HttpClient *httpClient;                                         // Connection the shard is being listed on
+    MemContext *memContext;                                         // Context for the outstanding request (freed by the next one)
+    HttpQuery *query;                                               // Query for the outstanding request
+    HttpHeader *requestHeader;                                      // Header for the outstanding request
+} StorageDriverS3ListShard;
+
+/***********************************************************************************************************************************
+Send the request for the next page of a shard.  The prior request (including its continuation token) is freed once the new request
+has been sent so memory does not accumulate across pages.
+
+Returns false if the request could not be sent.  The connection is closed in that case so it can't be waited on, but the request
+will be sent again when the response is read.
+***********************************************************************************************************************************/
+static bool
+storageDriverS3ListPrefixSend(
+    StorageDriverS3 *this, StorageDriverS3ListShard *connection, const String *basePrefix, const StringList *shardList,
+    const String *continuationToken)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_S3, this);
+        FUNCTION_TEST_PARAM_P(VOID, connection);
+        FUNCTION_TEST_PARAM(STRING, basePrefix);
+        FUNCTION_TEST_PARAM(STRING_LIST, shardList);
+        FUNCTION_TEST_PARAM(STRING, continuationToken);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(connection != NULL);
+    ASSERT(basePrefix != NULL);
+    ASSERT(shardList != NULL);
+
+    MemContext *memContextPrior = connection->memContext;
+
+    connection->memContext = memContextNew("StorageDriverS3ListShard");
+
+    MEM_CONTEXT_BEGIN(connection->memContext)
+    {
+        connection->query = storageDriverS3ListQuery(
+            strNewFmt("%s%s", strPtr(basePrefix), strPtr(strLstGet(shardList, connection->shardIdx))), continuationToken, false);
+        connection->requestHeader = storageDriverS3RequestSend(
+            this, connection->httpClient, HTTP_VERB_GET_STR, FSLASH_STR, connection->query, NULL);
+    }
+    MEM_CONTEXT_END();
+
+    if (memContextPrior != NULL)
+        memContextFree(memContextPrior);
+
+    FUNCTION_TEST_RETURN(httpClientRequestSent(connection->httpClient));
+}
+
+StringList *
+storageDriverS3ListPrefix(
+    StorageDriverS3 *this, const String *path, bool errorOnMissing, const StringList *prefixList, const String *expression)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_DRIVER_S3, this);
+        FUNCTION_LOG_PARAM(STRING, path);
+        FUNCTION_LOG_PARAM(BOOL, errorOnMissing);
+        FUNCTION_LOG_PARAM(STRING_LIST, prefixList);
+        FUNCTION_LOG_PARAM(STRING, expression);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(path != NULL);
+    ASSERT(!errorOnMissing);
+    ASSERT(prefixList != NULL);
+
+    StringList *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        result = strLstNew();
+
+        // Prepare regexp if an expression was passed
+        RegExp *regExp = (expression == NULL) ? NULL : regExpNew(expression);
+
+        // Build the base prefix by stripping of the initial /
+        const String *basePrefix = storageDriverS3ListBasePrefix(path);
+
+        // Get the expression prefix when possible to limit results
+        const String *expressionPrefix = regExpPrefix(expression);
+
+        // Build the list of shards to query
+        StringList *shardList = strLstNew();
+
+        for (unsigned int prefixIdx = 0; prefixIdx < strLstSize(prefixList); prefixIdx++)
+        {
+            const String *prefix = strLstGet(prefixList, prefixIdx);
+
+            // Skip prefixes that are covered by another prefix so no name is listed twice
+            bool covered = false;
+
+            for (unsigned int coverIdx = 0; coverIdx < strLstSize(prefixList); coverIdx++)
+            {
+                const String *cover = strLstGet(prefixList, coverIdx);
+
+                if (coverIdx != prefixIdx && strBeginsWith(prefix, cover) && (!strEq(prefix, cover) || coverIdx < prefixIdx))
+                {
+                    covered = true;
+                    break;
+                }
+            }
+
+            if (covered)
+                continue;
+
+            // Narrow the prefix with the expression prefix, or skip it if they can't both match
+            if (expressionPrefix != NULL)
+            {
+                if (strBeginsWith(expressionPrefix, prefix))
+                    prefix = expressionPrefix;
+                else if (!strBeginsWith(prefix, expressionPrefix))
+                    continue;
+            }
+
+            strLstAdd(shardList, prefix);
+        }
+
+        // Assign shards to connections and request pages until all shards are complete
+        unsigned int shardTotal = strLstSize(shardList);
+        unsigned int shardNext = 0;
+        unsigned int connectionTotal = shardTotal < this->connectionMax ? shardTotal : this->connectionMax;
+        List *connectionList = lstNew(sizeof(StorageDriverS3ListShard));
+
+        TRY_BEGIN()
+        {
+            // Send a request for the first page of a shard on each connection
+            for (unsigned int connectionIdx = 0; connectionIdx < connectionTotal; connectionIdx++)
+            {
+                lstAdd(
+                    connectionList,
+                    &(StorageDriverS3ListShard)
+                    {
+                        .active = true, .shardIdx = shardNext++,
+                        .httpClient = storageDriverS3HttpClientPool(this, connectionIdx),
+                    });
+
+                StorageDriverS3ListShard *connection = lstGet(connectionList, connectionIdx);
+                connection->sent = storageDriverS3ListPrefixSend(this, connection, basePrefix, shardList, NULL);
+            }
+
+            unsigned int activeTotal = connectionTotal;
+
+            while (activeTotal > 0)
+            {
+                // Wait for a response on any of the active connections.  Connections where the request could not be sent are closed
+                // so they are left out of the select and retried without waiting.
+                fd_set selectSet;
+                FD_ZERO(&selectSet);
+                int handleMax = -1;
+                bool retry = false;
+
+                for (unsigned int connectionIdx = 0; connectionIdx < connectionTotal; connectionIdx++)
+                {
+                    StorageDriverS3ListShard *connection = lstGet(connectionList, connectionIdx);
+
+                    if (connection->active)
+                    {
+                        if (!connection->sent)
+                        {
+                            retry = true;
+                            continue;
+                        }
+
+                        int handle = httpClientHandle(connection->httpClient);
+                        FD_SET((unsigned int)handle, &selectSet);
+
+                        if (handle > handleMax)                             // {+uncovered - handles are often in ascending order}
+                            handleMax = handle;
+                    }
+                }
+
+                // Initialize timeout struct used for select.  Recreate this structure each time since Linux will modify it.  Only
+                // poll when there are requests to retry.
+                struct timeval timeoutSelect;
+                timeoutSelect.tv_sec = retry ? 0 : (time_t)(this->timeout / MSEC_PER_SEC);
+                timeoutSelect.tv_usec = retry ? 0 : (time_t)(this->timeout % MSEC_PER_SEC * 1000);
+
+                int ready = select(handleMax + 1, &selectSet, NULL, NULL, &timeoutSelect);
+                THROW_ON_SYS_ERROR(ready == -1, AssertError, "unable to select from S3 list connection(s)");
+
+                if (ready == 0 && !retry)
+                {
+                    THROW_FMT(
+                        FileReadError, "unable to read list response(s) from '%s' after %" PRIu64 "ms", strPtr(this->host),
+                        this->timeout);
+                }
+
+                // Process the connections with a response ready
+                for (unsigned int connectionIdx = 0; connectionIdx < connectionTotal; connectionIdx++)
+                {
+                    StorageDriverS3ListShard *connection = lstGet(connectionList, connectionIdx);
+
+                    if (connection->active &&
+                        (!connection->sent ||
+                         (FD_ISSET((unsigned int)httpClientHandle(connection->httpClient), &selectSet) &&
+                          httpClientReady(connection->httpClient))))
+                    {
+                        String *continuationToken = NULL;
+
+                        // Read the response into the request context so it is freed along with the request
+                        MEM_CONTEXT_BEGIN(connection->memContext)
+                        {
+                            storageDriverS3Response(
+                                this, connection->httpClient, FSLASH_STR, connection->query, connection->requestHeader, false,
+                                false);
+                            continuationToken = storageDriverS3ListPage(connection->httpClient, basePrefix, regExp, result);
+                        }
+                        MEM_CONTEXT_END();
+
+                        // Move to the next shard when there are no more pages for this one
+                        if (continuationToken == NULL)
+                        {
+                            if (shardNext < shardTotal)
+                                connection->shardIdx = shardNext++;
+                            else
+                            {
+                                connection->active = false;
+                                activeTotal--;
+
+                                memContextFree(connection->memContext);
+                                connection->memContext = NULL;
+                            }
+                        }
+
+                        // Send the request for the next page on this connection
+                        if (connection->active)
+                        {
+                            connection->sent = storageDriverS3ListPrefixSend(
+                                this, connection, basePrefix, shardList, continuationToken);
+                        }
+                    }
+                }
+            }
+        }
+        CATCH_ANY()
+        {
+            // Other connections may still have outstanding responses so free them all
+            storageDriverS3HttpClientPoolFree(this);
+            RETHROW();
+        }
+        TRY_END();
 
         strLstMove(result, MEM_CONTEXT_OLD());
     }
@@ -575,15 +1387,18 @@ storageDriverS3List(StorageDriverS3 *this, const String *path, bool errorOnMissi
 }
 
 /***********************************************************************************************************************************
-New file read object
+New file read object.  There is no local cache for S3 so noCache is ignored.  S3 does not compress transfers so compressible is also
+ignored.
 ***********************************************************************************************************************************/
 StorageFileRead *
-storageDriverS3NewRead(StorageDriverS3 *this, const String *file, bool ignoreMissing)
+storageDriverS3NewRead(StorageDriverS3 *this, const String *file, bool ignoreMissing, bool noCache, bool compressible)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STORAGE_DRIVER_S3, this);
         FUNCTION_LOG_PARAM(STRING, file);
         FUNCTION_LOG_PARAM(BOOL, ignoreMissing);
+        FUNCTION_LOG_PARAM(BOOL, noCache);
+        FUNCTION_LOG_PARAM(BOOL, compressible);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -599,7 +1414,7 @@ New file write object
 StorageFileWrite *
 storageDriverS3NewWrite(
     StorageDriverS3 *this, const String *file, mode_t modeFile, mode_t modePath, bool createPath, bool syncFile,
-    bool syncPath, bool atomic)
+    bool syncPath, bool atomic, bool noCache)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STORAGE_DRIVER_S3, this);
@@ -610,6 +1425,7 @@ storageDriverS3NewWrite(
         FUNCTION_LOG_PARAM(BOOL, syncFile);
         FUNCTION_LOG_PARAM(BOOL, syncPath);
         FUNCTION_LOG_PARAM(BOOL, atomic);
+        FUNCTION_LOG_PARAM(BOOL, noCache);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -643,9 +1459,104 @@ storageDriverS3PathCreate(StorageDriverS3 *this, const String *path, bool errorO
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Send a request to delete a batch of keys (DeleteObjects) without waiting for the response
+
+Quiet mode is requested so only keys that could not be deleted are included in the response.
+***********************************************************************************************************************************/
+static HttpHeader *
+storageDriverS3DeleteSend(StorageDriverS3 *this, HttpClient *httpClient, const HttpQuery *query, const StringList *keyList)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_S3, this);
+        FUNCTION_TEST_PARAM(HTTP_CLIENT, httpClient);
+        FUNCTION_TEST_PARAM(HTTP_QUERY, query);
+        FUNCTION_TEST_PARAM(STRING_LIST, keyList);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(httpClient != NULL);
+    ASSERT(query != NULL);
+    ASSERT(keyList != NULL);
+    ASSERT(strLstSize(keyList) > 0 && strLstSize(keyList) <= S3_DELETE_MAX);
+
+    HttpHeader *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        XmlDocument *request = xmlDocumentNew(S3_XML_TAG_DELETE_STR);
+        XmlNode *root = xmlDocumentRoot(request);
+
+        xmlNodeContentSet(xmlNodeAdd(root, S3_XML_TAG_QUIET_STR), S3_XML_VALUE_TRUE_STR);
+
+        for (unsigned int keyIdx = 0; keyIdx < strLstSize(keyList); keyIdx++)
+            xmlNodeContentSet(xmlNodeAdd(xmlNodeAdd(root, S3_XML_TAG_OBJECT_STR), S3_XML_TAG_KEY_STR), strLstGet(keyList, keyIdx));
+
+        memContextSwitch(MEM_CONTEXT_OLD());
+        result = storageDriverS3RequestSend(this, httpClient, HTTP_VERB_POST_STR, FSLASH_STR, query, xmlDocumentBuf(request));
+        memContextSwitch(MEM_CONTEXT_TEMP());
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(result);
+}
+
+/***********************************************************************************************************************************
+Get the response to a request sent with storageDriverS3DeleteSend() and error if any keys could not be deleted
+***********************************************************************************************************************************/
+static void
+storageDriverS3DeleteResponse(
+    StorageDriverS3 *this, HttpClient *httpClient, const HttpQuery *query, const HttpHeader *requestHeader)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_DRIVER_S3, this);
+        FUNCTION_TEST_PARAM(HTTP_CLIENT, httpClient);
+        FUNCTION_TEST_PARAM(HTTP_QUERY, query);
+        FUNCTION_TEST_PARAM(HTTP_HEADER, requestHeader);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(httpClient != NULL);
+    ASSERT(query != NULL);
+    ASSERT(requestHeader != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        XmlNodeList *errorList = xmlNodeChildList(
+            xmlDocumentRoot(
+                xmlDocumentNewBuf(storageDriverS3Response(this, httpClient, FSLASH_STR, query, requestHeader, true, false))),
+            S3_XML_TAG_ERROR_STR);
+
+        // Report the first key that could not be deleted
+        if (xmlNodeLstSize(errorList) > 0)
+        {
+            XmlNode *error = xmlNodeLstGet(errorList, 0);
+
+            THROW_FMT(
+                FileRemoveError, "unable to remove file '/%s': [%s] %s",
+                strPtr(xmlNodeContent(xmlNodeChild(error, S3_XML_TAG_KEY_STR, true))),
+                strPtr(xmlNodeContent(xmlNodeChild(error, S3_XML_TAG_CODE_STR, true))),
+                strPtr(xmlNodeContent(xmlNodeChild(error, S3_XML_TAG_MESSAGE_STR, true))));
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Remove a path
+
+All keys that begin with the path are listed and deleted in batches.  Batches are sent on pooled connections without waiting for the
+response so deletes run concurrently with each other and with retrieving the next page of keys.  Paths do not exist independently
+of the files they contain so only recursive removes are supported.
 ***********************************************************************************************************************************/
+typedef struct StorageDriverS3DeleteBatch
+{
+    MemContext *memContext;                                         // Context for the outstanding request (NULL if none)
+    HttpHeader *requestHeader;                                      // Header for the outstanding request
+} StorageDriverS3DeleteBatch;
+
 void
 storageDriverS3PathRemove(StorageDriverS3 *this, const String *path, bool errorOnMissing, bool recurse)
 {
@@ -658,8 +1569,107 @@ storageDriverS3PathRemove(StorageDriverS3 *this, const String *path, bool errorO
 
     ASSERT(this != NULL);
     ASSERT(path != NULL);
+    ASSERT(!errorOnMissing);
+    ASSERT(recurse);
 
-    THROW(AssertError, "NOT YET IMPLEMENTED");
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Build the prefix by stripping off the initial / and adding a final / (unless this is the root path)
+        const String *queryPrefix = storageDriverS3ListBasePrefix(path);
+        String *continuationToken = NULL;
+
+        // Query used for all delete requests
+        HttpQuery *query = httpQueryAdd(httpQueryNew(), S3_QUERY_DELETE_STR, EMPTY_STR);
+
+        // Outstanding delete request for each connection.  Each request is in its own context which is freed once the response has
+        // been read so memory does not accumulate across batches.
+        List *batchList = lstNew(sizeof(StorageDriverS3DeleteBatch));
+        unsigned int batchIdx = 0;
+
+        for (unsigned int connectionIdx = 0; connectionIdx < this->connectionMax; connectionIdx++)
+            lstAdd(batchList, &(StorageDriverS3DeleteBatch){0});
+
+        TRY_BEGIN()
+        {
+            MEM_CONTEXT_TEMP_RESET_BEGIN()
+            {
+                do
+                {
+                    MEM_CONTEXT_TEMP_RESET(1);
+
+                    // Get the next page of keys.  Don't return the content so it can be parsed as it streams in.
+                    StringList *keyList = strLstNew();
+
+                    storageDriverS3Request(
+                        this, HTTP_VERB_GET_STR, FSLASH_STR, storageDriverS3ListQuery(queryPrefix, continuationToken, true), NULL,
+                        false, false);
+
+                    // Get the continuation token and store it in the outer temp context, replacing the prior token
+                    memContextSwitch(MEM_CONTEXT_OLD());
+                    strFree(continuationToken);
+                    continuationToken = storageDriverS3ListPage(this->httpClient, EMPTY_STR, NULL, keyList);
+                    memContextSwitch(MEM_CONTEXT_TEMP());
+
+                    // Send the keys in batches, cycling through the connections
+                    for (unsigned int keyIdx = 0; keyIdx < strLstSize(keyList); keyIdx += this->deleteMax)
+                    {
+                        StorageDriverS3DeleteBatch *batch = lstGet(batchList, batchIdx);
+                        HttpClient *httpClient = storageDriverS3HttpClientPool(this, batchIdx);
+
+                        // Wait for the prior batch on this connection to complete and free it
+                        if (batch->memContext != NULL)
+                        {
+                            storageDriverS3DeleteResponse(this, httpClient, query, batch->requestHeader);
+                            memContextFree(batch->memContext);
+                        }
+
+                        StringList *batchKeyList = strLstNew();
+
+                        for (unsigned int batchKeyIdx = keyIdx;
+                             batchKeyIdx < strLstSize(keyList) && batchKeyIdx < keyIdx + this->deleteMax; batchKeyIdx++)
+                        {
+                            strLstAdd(batchKeyList, strLstGet(keyList, batchKeyIdx));
+                        }
+
+                        // Send the batch in a context that is a child of the outer temp context so it outlives the page of keys
+                        memContextSwitch(MEM_CONTEXT_OLD());
+                        batch->memContext = memContextNew("StorageDriverS3DeleteBatch");
+                        memContextSwitch(MEM_CONTEXT_TEMP());
+
+                        MEM_CONTEXT_BEGIN(batch->memContext)
+                        {
+                            batch->requestHeader = storageDriverS3DeleteSend(this, httpClient, query, batchKeyList);
+                        }
+                        MEM_CONTEXT_END();
+
+                        batchIdx = (batchIdx + 1) % this->connectionMax;
+                    }
+                }
+                while (continuationToken != NULL);
+            }
+            MEM_CONTEXT_TEMP_END();
+
+            // Wait for all outstanding batches to complete
+            for (unsigned int connectionIdx = 0; connectionIdx < this->connectionMax; connectionIdx++)
+            {
+                StorageDriverS3DeleteBatch *batch = lstGet(batchList, connectionIdx);
+
+                if (batch->memContext != NULL)
+                {
+                    storageDriverS3DeleteResponse(
+                        this, storageDriverS3HttpClientPool(this, connectionIdx), query, batch->requestHeader);
+                }
+            }
+        }
+        CATCH_ANY()
+        {
+            // Other connections may still have outstanding responses so free them all
+            storageDriverS3HttpClientPoolFree(this);
+            RETHROW();
+        }
+        TRY_END();
+    }
+    MEM_CONTEXT_TEMP_END();
 
     FUNCTION_LOG_RETURN_VOID();
 }
@@ -696,8 +1706,18 @@ storageDriverS3Remove(StorageDriverS3 *this, const String *file, bool errorOnMis
 
     ASSERT(this != NULL);
     ASSERT(file != NULL);
+    ASSERT(!errorOnMissing);
 
-    THROW(AssertError, "NOT YET IMPLEMENTED");
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Use the same request as batch removes so missing files are not reported as errors
+        HttpQuery *query = httpQueryAdd(httpQueryNew(), S3_QUERY_DELETE_STR, EMPTY_STR);
+
+        storageDriverS3DeleteResponse(
+            this, this->httpClient, query,
+            storageDriverS3DeleteSend(this, this->httpClient, query, strLstAdd(strLstNew(), strSub(file, 1))));
+    }
+    MEM_CONTEXT_TEMP_END();
 
     FUNCTION_LOG_RETURN_VOID();
 }
@@ -40,10 +40,16 @@ Functions
 bool storageDriverS3Exists(StorageDriverS3 *this, const String *path);
 StorageInfo storageDriverS3Info(StorageDriverS3 *this, const String *file, bool ignoreMissing);
 StringList *storageDriverS3List(StorageDriverS3 *this, const String *path, bool errorOnMissing, const String *expression);
-StorageFileRead *storageDriverS3NewRead(StorageDriverS3 *this, const String *file, bool ignoreMissing);
+bool storageDriverS3ListInfo(
+    StorageDriverS3 *this, const String *path, bool errorOnMissing, bool recurse, StorageListInfoCallback callback,
+    void *callbackData);
+StringList *storageDriverS3ListPrefix(
+    StorageDriverS3 *this, const String *path, bool errorOnMissing, const StringList *prefixList, const String *expression);
+StorageFileRead *storageDriverS3NewRead(
+    StorageDriverS3 *this, const String *file, bool ignoreMissing, bool noCache, bool compressible);
 StorageFileWrite *storageDriverS3NewWrite(
     StorageDriverS3 *this, const String *file, mode_t modeFile, mode_t modePath, bool createPath, bool syncFile, bool syncPath,
-    bool atomic);
+    bool atomic, bool noCache);
 void storageDriverS3PathCreate(StorageDriverS3 *this, const String *path, bool errorOnExists, bool noParentCreate, mode_t mode);
 void storageDriverS3PathRemove(StorageDriverS3 *this, const String *path, bool errorOnMissing, bool recurse);
 void storageDriverS3PathSync(StorageDriverS3 *this, const String *path, bool ignoreMissing);
@@ -2,8 +2,11 @@
 Storage File Read Interface
 ***********************************************************************************************************************************/
 #include "common/debug.h"
+#include "common/io/filter/group.h"
+#include "common/io/filter/size.h"
 #include "common/log.h"
 #include "common/memContext.h"
+#include "crypto/hash.h"
 #include "storage/fileRead.intern.h"
 
 /***********************************************************************************************************************************
@@ -15,6 +18,9 @@ struct StorageFileRead
     const String *type;
     void *driver;
     StorageFileReadInterface interface;
+
+    StringList *filterList;                                         // Filters run as the file is read (when not run by the driver)
+    VariantList *filterResult;                                      // Results of filters run as the file is read
 };
 
 /***********************************************************************************************************************************
@@ -46,6 +52,77 @@ storageFileReadNew(const String *type, void *driver, StorageFileReadInterface in
     FUNCTION_LOG_RETURN(STORAGE_FILE_READ, this);
 }
 
+/***********************************************************************************************************************************
+Create a filter from a filter type and parameter, e.g. hash and sha1
+
+Only filters that produce results without transforming the data are allowed since the caller must still be able to use the data as
+it was stored.  NULL is returned if the filter is not allowed so the caller can decide how to report the error.
+***********************************************************************************************************************************/
+IoFilter *
+storageFileReadFilterNew(const String *type, const String *param)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STRING, type);
+        FUNCTION_LOG_PARAM(STRING, param);
+    FUNCTION_LOG_END();
+
+    ASSERT(type != NULL);
+
+    IoFilter *result = NULL;
+
+    if (strEq(type, CRYPTO_HASH_FILTER_TYPE_STR) && param != NULL)
+        result = cryptoHashFilter(cryptoHashNew(param));
+    else if (strEq(type, SIZE_FILTER_TYPE_STR) && param == NULL)
+        result = ioSizeFilter(ioSizeNew());
+
+    FUNCTION_LOG_RETURN(IO_FILTER, result);
+}
+
+/***********************************************************************************************************************************
+Run filters as the file is read for drivers that cannot run them where the file is stored
+
+Each filter is specified as a filter type optionally followed by a colon and a parameter, e.g. hash:sha1 or size.  The filters are
+set as the read filter group so the caller cannot set another filter group.
+***********************************************************************************************************************************/
+void
+storageFileReadFilterListSet(StorageFileRead *this, const StringList *filterList)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_FILE_READ, this);
+        FUNCTION_LOG_PARAM(STRING_LIST, filterList);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->filterList == NULL);
+    ASSERT(filterList != NULL);
+
+    MEM_CONTEXT_BEGIN(this->memContext)
+    {
+        IoFilterGroup *filterGroup = ioFilterGroupNew();
+
+        for (unsigned int filterIdx = 0; filterIdx < strLstSize(filterList); filterIdx++)
+        {
+            const String *filter = strLstGet(filterList, filterIdx);
+            int paramIdx = strChr(filter, ':');
+
+            IoFilter *filterNew = paramIdx == -1 ?
+                storageFileReadFilterNew(filter, NULL) :
+                storageFileReadFilterNew(strSubN(filter, 0, (size_t)paramIdx), strSub(filter, (size_t)paramIdx + 1));
+
+            if (filterNew == NULL)
+                THROW_FMT(AssertError, "invalid filter '%s'", strPtr(filter));
+
+            ioFilterGroupAdd(filterGroup, filterNew);
+        }
+
+        ioReadFilterGroupSet(storageFileReadIo(this), filterGroup);
+        this->filterList = strLstDup(filterList);
+    }
+    MEM_CONTEXT_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Move the file object to a new context
 ***********************************************************************************************************************************/
@@ -95,6 +172,62 @@ storageFileReadIgnoreMissing(const StorageFileRead *this)
     FUNCTION_TEST_RETURN(this->interface.ignoreMissing(this->driver));
 }
 
+/***********************************************************************************************************************************
+Get results of filters requested with storageNewRead() in the same order as the filter list
+
+The results are available once the file has been closed.  NULL is returned if no filters were requested.
+***********************************************************************************************************************************/
+const VariantList *
+storageFileReadFilterResult(StorageFileRead *this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_FILE_READ, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    const VariantList *result = NULL;
+
+    // Gather results of filters run as the file was read
+    if (this->filterList != NULL)
+    {
+        if (this->filterResult == NULL)
+        {
+            const IoFilterGroup *filterGroup = ioReadFilterGroup(storageFileReadIo(this));
+
+            MEM_CONTEXT_BEGIN(this->memContext)
+            {
+                this->filterResult = varLstNew();
+
+                for (unsigned int filterIdx = 0; filterIdx < strLstSize(this->filterList); filterIdx++)
+                {
+                    const String *filter = strLstGet(this->filterList, filterIdx);
+                    int paramIdx = strChr(filter, ':');
+
+                    MEM_CONTEXT_TEMP_BEGIN()
+                    {
+                        const Variant *filterResult = ioFilterGroupResult(
+                            filterGroup, paramIdx == -1 ? filter : strSubN(filter, 0, (size_t)paramIdx));
+
+                        memContextSwitch(MEM_CONTEXT_OLD());
+                        varLstAdd(this->filterResult, varDup(filterResult));
+                        memContextSwitch(MEM_CONTEXT_TEMP());
+                    }
+                    MEM_CONTEXT_TEMP_END();
+                }
+            }
+            MEM_CONTEXT_END();
+        }
+
+        result = this->filterResult;
+    }
+    // Else get results from the driver when it ran the filters where the file is stored
+    else if (this->interface.filterResult != NULL)
+        result = this->interface.filterResult(this->driver);
+
+    FUNCTION_LOG_RETURN_CONST(VARIANT_LIST, result);
+}
+
 /***********************************************************************************************************************************
 Get io interface
 ***********************************************************************************************************************************/
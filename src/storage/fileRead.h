@@ -10,6 +10,7 @@ Object type
 typedef struct StorageFileRead StorageFileRead;
 
 #include "common/io/read.h"
+#include "common/type/variantList.h"
 
 /***********************************************************************************************************************************
 Functions
@@ -20,6 +21,7 @@ StorageFileRead *storageFileReadMove(StorageFileRead *this, MemContext *parentNe
 Getters
 ***********************************************************************************************************************************/
 void *storageFileReadDriver(const StorageFileRead *this);
+const VariantList *storageFileReadFilterResult(StorageFileRead *this);
 IoRead *storageFileReadIo(const StorageFileRead *this);
 bool storageFileReadIgnoreMissing(const StorageFileRead *this);
 const String *storageFileReadName(const StorageFileRead *this);
@@ -4,6 +4,9 @@ Storage File Read Interface Internal
 #ifndef STORAGE_FILEREAD_INTERN_H
 #define STORAGE_FILEREAD_INTERN_H
 
+#include "common/io/filter/filter.h"
+#include "common/type/stringList.h"
+#include "common/type/variantList.h"
 #include "storage/fileRead.h"
 
 /***********************************************************************************************************************************
@@ -12,12 +15,14 @@ Constructor
 typedef bool (*StorageFileReadInterfaceIgnoreMissing)(const void *driver);
 typedef IoRead *(*StorageFileReadInterfaceIo)(const void *driver);
 typedef const String *(*StorageFileReadInterfaceName)(const void *driver);
+typedef const VariantList *(*StorageFileReadInterfaceFilterResult)(const void *driver);
 
 typedef struct StorageFileReadInterface
 {
     StorageFileReadInterfaceIgnoreMissing ignoreMissing;
     StorageFileReadInterfaceIo io;
     StorageFileReadInterfaceName name;
+    StorageFileReadInterfaceFilterResult filterResult;              // Optional, results of filters run where the file is stored
 } StorageFileReadInterface;
 
 #define storageFileReadNewP(type, driver, ...)                                                                                     \
@@ -25,6 +30,12 @@ typedef struct StorageFileReadInterface
 
 StorageFileRead *storageFileReadNew(const String *type, void *driver, StorageFileReadInterface interface);
 
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+IoFilter *storageFileReadFilterNew(const String *type, const String *param);
+void storageFileReadFilterListSet(StorageFileRead *this, const StringList *filterList);
+
 /***********************************************************************************************************************************
 Macros for function logging
 ***********************************************************************************************************************************/
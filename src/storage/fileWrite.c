@@ -2,6 +2,7 @@
 Storage File Write Interface
 ***********************************************************************************************************************************/
 #include "common/debug.h"
+#include "common/io/filter/group.h"
 #include "common/log.h"
 #include "common/memContext.h"
 #include "storage/fileWrite.intern.h"
@@ -53,6 +54,36 @@ storageFileWriteNew(const String *type, void *driver, StorageFileWriteInterface
     FUNCTION_LOG_RETURN(STORAGE_FILE_WRITE, this);
 }
 
+/***********************************************************************************************************************************
+Copy directly from a source file when the driver supports it
+
+Both files must be open.  The copy is only attempted when the source is the same type as the destination and neither has filters,
+since the data is never seen by the IO layer.  Returns false when the driver did not finish the copy so the caller can complete it
+through the IO layer.
+***********************************************************************************************************************************/
+bool
+storageFileWriteCopy(StorageFileWrite *this, StorageFileRead *source)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_FILE_WRITE, this);
+        FUNCTION_LOG_PARAM(STORAGE_FILE_READ, source);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(source != NULL);
+
+    bool result = false;
+
+    if (this->interface.copy != NULL && strEq(this->type, storageFileReadType(source)) &&
+        ioFilterGroupPassThru(ioReadFilterGroup(storageFileReadIo(source))) &&
+        ioFilterGroupPassThru(ioWriteFilterGroup(storageFileWriteIo(this))))
+    {
+        result = this->interface.copy(this->driver, storageFileReadDriver(source));
+    }
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
+
 /***********************************************************************************************************************************
 Move the file object to a new context
 ***********************************************************************************************************************************/
@@ -14,10 +14,12 @@ typedef struct StorageFileWrite StorageFileWrite;
 #include "common/io/write.h"
 #include "common/type/buffer.h"
 #include "common/type/string.h"
+#include "storage/fileRead.h"
 
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
+bool storageFileWriteCopy(StorageFileWrite *this, StorageFileRead *source);
 StorageFileWrite *storageFileWriteMove(StorageFileWrite *this, MemContext *parentNew);
 
 /***********************************************************************************************************************************
@@ -16,6 +16,7 @@ Temporary file extension
 Constructor
 ***********************************************************************************************************************************/
 typedef bool (*StorageFileWriteInterfaceAtomic)(const void *data);
+typedef bool (*StorageFileWriteInterfaceCopy)(void *data, void *source);
 typedef bool (*StorageFileWriteInterfaceCreatePath)(const void *data);
 typedef IoWrite *(*StorageFileWriteInterfaceIo)(const void *data);
 typedef mode_t (*StorageFileWriteInterfaceModeFile)(const void *data);
@@ -27,6 +28,7 @@ typedef bool (*StorageFileWriteInterfaceSyncPath)(const void *data);
 typedef struct StorageFileWriteInterface
 {
     StorageFileWriteInterfaceAtomic atomic;
+    StorageFileWriteInterfaceCopy copy;                             // Copy from a source file of the same type (optional)
     StorageFileWriteInterfaceCreatePath createPath;
     StorageFileWriteInterfaceIo io;
     StorageFileWriteInterfaceModeFile modeFile;
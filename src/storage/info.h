@@ -6,6 +6,8 @@ Storage Info
 
 #include <sys/types.h>
 
+#include "common/type/string.h"
+
 /***********************************************************************************************************************************
 Storage type
 ***********************************************************************************************************************************/
@@ -21,10 +23,12 @@ Object type
 ***********************************************************************************************************************************/
 typedef struct StorageInfo
 {
+    const String *name;                                             // Name relative to the listed path (only set when listing)
     bool exists;                                                    // Does the path/file/link exist?
     StorageType type;                                               // Type file/path/link)
     size_t size;                                                    // Size (path/link is 0)
     mode_t mode;                                                    // Mode of path/file/link
+    time_t timeModified;                                            // Time file was last modified
 } StorageInfo;
 
 /***********************************************************************************************************************************
@@ -9,6 +9,7 @@ Storage Interface
 #include "common/log.h"
 #include "common/memContext.h"
 #include "common/wait.h"
+#include "storage/fileRead.intern.h"
 #include "storage/storage.intern.h"
 
 /***********************************************************************************************************************************
@@ -54,6 +55,7 @@ storageNew(
     ASSERT(interface.exists != NULL);
     ASSERT(interface.info != NULL);
     ASSERT(interface.list != NULL);
+    ASSERT(interface.listInfo != NULL);
     ASSERT(interface.newRead != NULL);
     ASSERT(interface.newWrite != NULL);
     ASSERT(interface.pathCreate != NULL);
@@ -101,16 +103,20 @@ storageCopy(StorageFileRead *source, StorageFileWrite *destination)
             // Open the destination file now that we know the source file exists and is readable
             ioWriteOpen(storageFileWriteIo(destination));
 
-            // Copy data from source to destination
-            Buffer *read = bufNew(ioBufferSize());
-
-            do
+            // Let the driver copy directly if it can, e.g. posix can copy in the kernel without passing data through user space.
+            // Otherwise copy data from source to destination.
+            if (!storageFileWriteCopy(destination, source))
             {
-                ioRead(storageFileReadIo(source), read);
-                ioWrite(storageFileWriteIo(destination), read);
-                bufUsedZero(read);
+                Buffer *read = bufNew(ioBufferSize());
+
+                do
+                {
+                    ioRead(storageFileReadIo(source), read);
+                    ioWrite(storageFileWriteIo(destination), read);
+                    bufUsedZero(read);
+                }
+                while (!ioReadEof(storageFileReadIo(source)));
             }
-            while (!ioReadEof(storageFileReadIo(source)));
 
             // Close the source and destination files
             ioReadClose(storageFileReadIo(source));
@@ -162,6 +168,58 @@ storageExists(const Storage *this, const String *pathExp, StorageExistsParam par
     FUNCTION_LOG_RETURN(BOOL, result);
 }
 
+/***********************************************************************************************************************************
+Check if a list of paths/files exist
+
+This is more efficient than calling storageExists() for each path when the driver can check the list at once, e.g. in a single round
+trip to a remote.
+***********************************************************************************************************************************/
+List *
+storageExistsList(const Storage *this, const StringList *pathExpList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE, this);
+        FUNCTION_LOG_PARAM(STRING_LIST, pathExpList);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(pathExpList != NULL);
+
+    List *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Build the paths
+        StringList *pathList = strLstNew();
+
+        for (unsigned int pathIdx = 0; pathIdx < strLstSize(pathExpList); pathIdx++)
+            strLstAdd(pathList, storagePathNP(this, strLstGet(pathExpList, pathIdx)));
+
+        // If the driver can check the list directly then let it
+        if (this->interface.existsList != NULL)
+        {
+            result = this->interface.existsList(this->driver, pathList);
+        }
+        // Else check each path
+        else
+        {
+            result = lstNew(sizeof(bool));
+
+            for (unsigned int pathIdx = 0; pathIdx < strLstSize(pathList); pathIdx++)
+            {
+                bool exists = this->interface.exists(this->driver, strLstGet(pathList, pathIdx));
+                lstAdd(result, &exists);
+            }
+        }
+
+        // Move list up to the old context
+        result = lstMove(result, MEM_CONTEXT_OLD());
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(LIST, result);
+}
+
 /***********************************************************************************************************************************
 Read from storage into a buffer
 ***********************************************************************************************************************************/
@@ -253,6 +311,58 @@ storageInfo(const Storage *this, const String *fileExp, StorageInfoParam param)
     FUNCTION_LOG_RETURN(STORAGE_INFO, result);
 }
 
+/***********************************************************************************************************************************
+Get info for a list of files
+
+As with storageExistsList() this is more efficient than calling storageInfo() for each file when the driver can handle the list at once.
+***********************************************************************************************************************************/
+List *
+storageInfoList(const Storage *this, const StringList *fileExpList, StorageInfoListParam param)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE, this);
+        FUNCTION_LOG_PARAM(STRING_LIST, fileExpList);
+        FUNCTION_LOG_PARAM(BOOL, param.ignoreMissing);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(fileExpList != NULL);
+
+    List *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Build the paths
+        StringList *fileList = strLstNew();
+
+        for (unsigned int fileIdx = 0; fileIdx < strLstSize(fileExpList); fileIdx++)
+            strLstAdd(fileList, storagePathNP(this, strLstGet(fileExpList, fileIdx)));
+
+        // If the driver can get info for the list directly then let it
+        if (this->interface.infoList != NULL)
+        {
+            result = this->interface.infoList(this->driver, fileList, param.ignoreMissing);
+        }
+        // Else get info for each file
+        else
+        {
+            result = lstNew(sizeof(StorageInfo));
+
+            for (unsigned int fileIdx = 0; fileIdx < strLstSize(fileList); fileIdx++)
+            {
+                StorageInfo info = this->interface.info(this->driver, strLstGet(fileList, fileIdx), param.ignoreMissing);
+                lstAdd(result, &info);
+            }
+        }
+
+        // Move list up to the old context
+        result = lstMove(result, MEM_CONTEXT_OLD());
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(LIST, result);
+}
+
 /***********************************************************************************************************************************
 Get a list of files from a directory
 ***********************************************************************************************************************************/
@@ -264,6 +374,7 @@ storageList(const Storage *this, const String *pathExp, StorageListParam param)
         FUNCTION_LOG_PARAM(STRING, pathExp);
         FUNCTION_LOG_PARAM(BOOL, param.errorOnMissing);
         FUNCTION_LOG_PARAM(STRING, param.expression);
+        FUNCTION_LOG_PARAM(STRING_LIST, param.prefixList);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -275,14 +386,87 @@ storageList(const Storage *this, const String *pathExp, StorageListParam param)
         // Build the path
         String *path = storagePathNP(this, pathExp);
 
+        // If the driver can list prefixes directly (e.g. concurrently) then let it
+        if (param.prefixList != NULL && this->interface.listPrefix != NULL)
+        {
+            result = this->interface.listPrefix(this->driver, path, param.errorOnMissing, param.prefixList, param.expression);
+        }
+        else
+        {
+            result = this->interface.list(this->driver, path, param.errorOnMissing, param.expression);
+
+            // Else filter the list on the prefixes
+            if (param.prefixList != NULL && result != NULL)
+            {
+                StringList *resultPrefix = strLstNew();
+
+                for (unsigned int resultIdx = 0; resultIdx < strLstSize(result); resultIdx++)
+                {
+                    const String *name = strLstGet(result, resultIdx);
+
+                    for (unsigned int prefixIdx = 0; prefixIdx < strLstSize(param.prefixList); prefixIdx++)
+                    {
+                        if (strBeginsWith(name, strLstGet(param.prefixList, prefixIdx)))
+                        {
+                            strLstAdd(resultPrefix, name);
+                            break;
+                        }
+                    }
+                }
+
+                result = resultPrefix;
+            }
+        }
+
+        // Merge results from multiple prefixes by sorting
+        if (param.prefixList != NULL && result != NULL)
+            strLstSort(result, sortOrderAsc);
+
         // Move list up to the old context
-        result = strLstMove(this->interface.list(this->driver, path, param.errorOnMissing, param.expression), MEM_CONTEXT_OLD());
+        result = strLstMove(result, MEM_CONTEXT_OLD());
     }
     MEM_CONTEXT_TEMP_END();
 
     FUNCTION_LOG_RETURN(STRING_LIST, result);
 }
 
+/***********************************************************************************************************************************
+Get info for all files/paths/links in a path, optionally recursing into subpaths
+
+This is much more efficient than calling storageList() and then storageInfo() for each name since drivers can get the info while
+listing, e.g. S3 returns size and time in list results and the remote driver streams results back without a round trip per file.
+***********************************************************************************************************************************/
+bool
+storageListInfo(
+    const Storage *this, const String *pathExp, StorageListInfoCallback callback, void *callbackData, StorageListInfoParam param)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE, this);
+        FUNCTION_LOG_PARAM(STRING, pathExp);
+        FUNCTION_LOG_PARAM(FUNCTIONP, callback);
+        FUNCTION_LOG_PARAM_P(VOID, callbackData);
+        FUNCTION_LOG_PARAM(BOOL, param.errorOnMissing);
+        FUNCTION_LOG_PARAM(BOOL, param.recurse);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(callback != NULL);
+
+    bool result = false;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Build the path
+        String *path = storagePathNP(this, pathExp);
+
+        // Call driver function
+        result = this->interface.listInfo(this->driver, path, param.errorOnMissing, param.recurse, callback, callbackData);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(BOOL, result);
+}
+
 /***********************************************************************************************************************************
 Move a file
 ***********************************************************************************************************************************/
@@ -326,6 +510,17 @@ storageMove(const Storage *this, StorageFileRead *source, StorageFileWrite *dest
 
 /***********************************************************************************************************************************
 Open a file for reading
+
+Set noCache for files that will not be read again soon so they do not evict more useful data from the cache, e.g. the PostgreSQL
+buffers on a database host.  Drivers without a cache ignore it.
+
+Set compressible for files that are not already compressed or encrypted so drivers that transfer data over the network, i.e. remote,
+can compress the transfer.  Other drivers ignore it.
+
+Set filterList to get results such as a hash or size of the file as it is stored, e.g. hash:sha1 or size.  Drivers that can run the
+filters where the file is stored, i.e. remote, do so to spare the local host the work.  Otherwise the filters are run as the file is
+read.  Either way the results are available from storageFileReadFilterResult() once the file is closed.  A filter group cannot also
+be set since the filters must see the data before any other filters.
 ***********************************************************************************************************************************/
 StorageFileRead *
 storageNewRead(const Storage *this, const String *fileExp, StorageNewReadParam param)
@@ -334,16 +529,35 @@ storageNewRead(const Storage *this, const String *fileExp, StorageNewReadParam p
         FUNCTION_LOG_PARAM(STORAGE, this);
         FUNCTION_LOG_PARAM(STRING, fileExp);
         FUNCTION_LOG_PARAM(BOOL, param.ignoreMissing);
+        FUNCTION_LOG_PARAM(BOOL, param.noCache);
+        FUNCTION_LOG_PARAM(BOOL, param.compressible);
         FUNCTION_LOG_PARAM(IO_FILTER_GROUP, param.filterGroup);
+        FUNCTION_LOG_PARAM(STRING_LIST, param.filterList);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
+    ASSERT(param.filterGroup == NULL || param.filterList == NULL);
 
     StorageFileRead *result = NULL;
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        result = this->interface.newRead(this->driver, storagePathNP(this, fileExp), param.ignoreMissing);
+        // Run filters where the file is stored when the driver can
+        if (param.filterList != NULL && this->interface.newReadFilter != NULL)
+        {
+            result = this->interface.newReadFilter(
+                this->driver, storagePathNP(this, fileExp), param.ignoreMissing, param.noCache, param.compressible,
+                param.filterList);
+        }
+        else
+        {
+            result = this->interface.newRead(
+                this->driver, storagePathNP(this, fileExp), param.ignoreMissing, param.noCache, param.compressible);
+
+            // Else run them as the file is read
+            if (param.filterList != NULL)
+                storageFileReadFilterListSet(result, param.filterList);
+        }
 
         if (param.filterGroup != NULL)
             ioReadFilterGroupSet(storageFileReadIo(result), param.filterGroup);
@@ -357,6 +571,8 @@ storageNewRead(const Storage *this, const String *fileExp, StorageNewReadParam p
 
 /***********************************************************************************************************************************
 Open a file for writing
+
+See storageNewRead() for a description of noCache.
 ***********************************************************************************************************************************/
 StorageFileWrite *
 storageNewWrite(const Storage *this, const String *fileExp, StorageNewWriteParam param)
@@ -370,6 +586,7 @@ storageNewWrite(const Storage *this, const String *fileExp, StorageNewWriteParam
         FUNCTION_LOG_PARAM(BOOL, param.noSyncFile);
         FUNCTION_LOG_PARAM(BOOL, param.noSyncPath);
         FUNCTION_LOG_PARAM(BOOL, param.noAtomic);
+        FUNCTION_LOG_PARAM(BOOL, param.noCache);
         FUNCTION_LOG_PARAM(IO_FILTER_GROUP, param.filterGroup);
     FUNCTION_LOG_END();
 
@@ -383,7 +600,7 @@ storageNewWrite(const Storage *this, const String *fileExp, StorageNewWriteParam
         result = this->interface.newWrite(
             this->driver, storagePathNP(this, fileExp), param.modeFile != 0 ? param.modeFile : this->modeFile,
             param.modePath != 0 ? param.modePath : this->modePath, !param.noCreatePath, !param.noSyncFile, !param.noSyncPath,
-            !param.noAtomic);
+            !param.noAtomic, param.noCache);
 
         if (param.filterGroup != NULL)
             ioWriteFilterGroupSet(storageFileWriteIo(result), param.filterGroup);
@@ -12,6 +12,7 @@ Object type
 typedef struct Storage Storage;
 
 #include "common/type/buffer.h"
+#include "common/type/list.h"
 #include "common/type/stringList.h"
 #include "common/io/filter/group.h"
 #include "common/time.h"
@@ -42,6 +43,14 @@ typedef struct StorageExistsParam
 
 bool storageExists(const Storage *this, const String *pathExp, StorageExistsParam param);
 
+/***********************************************************************************************************************************
+storageExistsList - returns a List of bool in the same order as the path list
+***********************************************************************************************************************************/
+#define storageExistsListNP(this, pathExpList)                                                                                     \
+    storageExistsList(this, pathExpList)
+
+List *storageExistsList(const Storage *this, const StringList *pathExpList);
+
 /***********************************************************************************************************************************
 storageGet
 ***********************************************************************************************************************************/
@@ -72,6 +81,21 @@ typedef struct StorageInfoParam
 
 StorageInfo storageInfo(const Storage *this, const String *fileExp, StorageInfoParam param);
 
+/***********************************************************************************************************************************
+storageInfoList - returns a List of StorageInfo in the same order as the file list
+***********************************************************************************************************************************/
+typedef struct StorageInfoListParam
+{
+    bool ignoreMissing;
+} StorageInfoListParam;
+
+#define storageInfoListP(this, fileExpList, ...)                                                                                   \
+    storageInfoList(this, fileExpList, (StorageInfoListParam){__VA_ARGS__})
+#define storageInfoListNP(this, fileExpList)                                                                                       \
+    storageInfoList(this, fileExpList, (StorageInfoListParam){0})
+
+List *storageInfoList(const Storage *this, const StringList *fileExpList, StorageInfoListParam param);
+
 /***********************************************************************************************************************************
 storageList
 ***********************************************************************************************************************************/
@@ -79,6 +103,7 @@ typedef struct StorageListParam
 {
     bool errorOnMissing;
     const String *expression;
+    const StringList *prefixList;                                   // Only list names that begin with one of these prefixes
 } StorageListParam;
 
 #define storageListP(this, pathExp, ...)                                                                                           \
@@ -88,6 +113,26 @@ typedef struct StorageListParam
 
 StringList *storageList(const Storage *this, const String *pathExp, StorageListParam param);
 
+/***********************************************************************************************************************************
+storageListInfo - call the callback with info for each file/path/link in a path (or the entire tree when recurse is set).  Returns
+false when the path is missing.  Paths are always reported before their contents but ordering is otherwise up to the driver.
+***********************************************************************************************************************************/
+typedef void (*StorageListInfoCallback)(void *callbackData, const StorageInfo *info);
+
+typedef struct StorageListInfoParam
+{
+    bool errorOnMissing;
+    bool recurse;
+} StorageListInfoParam;
+
+#define storageListInfoP(this, pathExp, callback, callbackData, ...)                                                               \
+    storageListInfo(this, pathExp, callback, callbackData, (StorageListInfoParam){__VA_ARGS__})
+#define storageListInfoNP(this, pathExp, callback, callbackData)                                                                   \
+    storageListInfo(this, pathExp, callback, callbackData, (StorageListInfoParam){0})
+
+bool storageListInfo(
+    const Storage *this, const String *pathExp, StorageListInfoCallback callback, void *callbackData, StorageListInfoParam param);
+
 /***********************************************************************************************************************************
 storageMove
 ***********************************************************************************************************************************/
@@ -102,7 +147,10 @@ storageNewRead
 typedef struct StorageNewReadParam
 {
     bool ignoreMissing;
+    bool noCache;
+    bool compressible;
     IoFilterGroup *filterGroup;
+    const StringList *filterList;
 } StorageNewReadParam;
 
 #define storageNewReadP(this, pathExp, ...)                                                                                        \
@@ -123,6 +171,7 @@ typedef struct StorageNewWriteParam
     bool noSyncFile;
     bool noSyncPath;
     bool noAtomic;
+    bool noCache;
     IoFilterGroup *filterGroup;
 } StorageNewWriteParam;
 
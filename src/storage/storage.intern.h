@@ -21,12 +21,22 @@ typedef String *(*StoragePathExpressionCallback)(const String *expression, const
 Constructor
 ***********************************************************************************************************************************/
 typedef bool (*StorageInterfaceExists)(void *driver, const String *path);
+typedef List *(*StorageInterfaceExistsList)(void *driver, const StringList *pathList);
 typedef StorageInfo (*StorageInterfaceInfo)(void *driver, const String *file, bool ignoreMissing);
+typedef List *(*StorageInterfaceInfoList)(void *driver, const StringList *fileList, bool ignoreMissing);
 typedef StringList *(*StorageInterfaceList)(void *driver, const String *path, bool errorOnMissing, const String *expression);
+typedef bool (*StorageInterfaceListInfo)(
+    void *driver, const String *path, bool errorOnMissing, bool recurse, StorageListInfoCallback callback, void *callbackData);
+typedef StringList *(*StorageInterfaceListPrefix)(
+    void *driver, const String *path, bool errorOnMissing, const StringList *prefixList, const String *expression);
 typedef bool (*StorageInterfaceMove)(void *driver, void *source, void *destination);
-typedef StorageFileRead *(*StorageInterfaceNewRead)(void *driver, const String *file, bool ignoreMissing);
+typedef StorageFileRead *(*StorageInterfaceNewRead)(
+    void *driver, const String *file, bool ignoreMissing, bool noCache, bool compressible);
+typedef StorageFileRead *(*StorageInterfaceNewReadFilter)(
+    void *driver, const String *file, bool ignoreMissing, bool noCache, bool compressible, const StringList *filterList);
 typedef StorageFileWrite *(*StorageInterfaceNewWrite)(
-    void *driver, const String *file, mode_t modeFile, mode_t modePath, bool createPath, bool syncFile, bool syncPath, bool atomic);
+    void *driver, const String *file, mode_t modeFile, mode_t modePath, bool createPath, bool syncFile, bool syncPath, bool atomic,
+    bool noCache);
 typedef void (*StorageInterfacePathCreate)(
     void *driver, const String *path, bool errorOnExists, bool noParentCreate, mode_t mode);
 typedef void (*StorageInterfacePathRemove)(void *driver, const String *path, bool errorOnMissing, bool recurse);
@@ -36,10 +46,15 @@ typedef void (*StorageInterfaceRemove)(void *driver, const String *file, bool er
 typedef struct StorageInterface
 {
     StorageInterfaceExists exists;
+    StorageInterfaceExistsList existsList;                          // Optional, check a list of paths at once
     StorageInterfaceInfo info;
+    StorageInterfaceInfoList infoList;                              // Optional, get info for a list of files at once
     StorageInterfaceList list;
+    StorageInterfaceListInfo listInfo;
+    StorageInterfaceListPrefix listPrefix;                          // Optional, list prefixes concurrently
     StorageInterfaceMove move;
     StorageInterfaceNewRead newRead;
+    StorageInterfaceNewReadFilter newReadFilter;                    // Optional, run filters where the file is stored
     StorageInterfaceNewWrite newWrite;
     StorageInterfacePathCreate pathCreate;
     StorageInterfacePathRemove pathRemove;
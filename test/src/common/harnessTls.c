@@ -22,6 +22,16 @@ static SSL_CTX *testServerContext = NULL;
 static int testClientSocket = 0;
 static SSL *testClientSSL = NULL;
 
+// Accepted connections so the server can switch between them to test clients that use multiple connections
+#define TLS_TEST_CONNECTION_MAX                                     8
+
+static struct
+{
+    int socket;
+    SSL *ssl;
+} testConnectionList[TLS_TEST_CONNECTION_MAX];
+static unsigned int testConnectionIdx = 0;
+
 /***********************************************************************************************************************************
 Initialize TLS and listen on the specified port for TLS connections
 ***********************************************************************************************************************************/
@@ -124,8 +134,10 @@ harnessTlsServerReply(const char *reply)
 
 /***********************************************************************************************************************************
 Accept a TLS connection from the client
+
+The index of the new connection is returned so harnessTlsServerSwitch() can be used to switch back to it later.
 ***********************************************************************************************************************************/
-void
+unsigned int
 harnessTlsServerAccept(void)
 {
     struct sockaddr_in addr;
@@ -140,6 +152,35 @@ harnessTlsServerAccept(void)
     SSL_set_fd(testClientSSL, testClientSocket);
 
     cryptoError(SSL_accept(testClientSSL) <= 0, "unable to accept TLS connection");
+
+    // Find a free slot to store the connection
+    for (testConnectionIdx = 0; testConnectionIdx < TLS_TEST_CONNECTION_MAX; testConnectionIdx++)
+    {
+        if (testConnectionList[testConnectionIdx].ssl == NULL)
+            break;
+    }
+
+    if (testConnectionIdx == TLS_TEST_CONNECTION_MAX)
+        THROW(AssertError, "too many open connections");
+
+    testConnectionList[testConnectionIdx].socket = testClientSocket;
+    testConnectionList[testConnectionIdx].ssl = testClientSSL;
+
+    return testConnectionIdx;
+}
+
+/***********************************************************************************************************************************
+Switch to a connection that was previously accepted
+***********************************************************************************************************************************/
+void
+harnessTlsServerSwitch(unsigned int connectionIdx)
+{
+    if (connectionIdx >= TLS_TEST_CONNECTION_MAX || testConnectionList[connectionIdx].ssl == NULL)
+        THROW_FMT(AssertError, "connection %u is not open", connectionIdx);
+
+    testConnectionIdx = connectionIdx;
+    testClientSocket = testConnectionList[connectionIdx].socket;
+    testClientSSL = testConnectionList[connectionIdx].ssl;
 }
 
 /***********************************************************************************************************************************
@@ -150,4 +191,6 @@ harnessTlsServerClose(void)
 {
     SSL_free(testClientSSL);
     close(testClientSocket);
+
+    testConnectionList[testConnectionIdx].ssl = NULL;
 }
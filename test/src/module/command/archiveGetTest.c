@@ -176,6 +176,24 @@ testRun(void)
                     "repo/archive/test1/10-1/01ABCDEF01ABCDEF/01ABCDEF01ABCDEF01ABCDEF-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa")),
             buffer);
 
+        TEST_ERROR(
+            archiveGetFile(storageTest, archiveFile, walDestination, false, cipherTypeNone, NULL), ChecksumError,
+            "WAL segment '10-1/01ABCDEF01ABCDEF/01ABCDEF01ABCDEF01ABCDEF-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa'"
+                " in the archive has checksum '3b4417fc421cee30a9ad0fd9319220a8dae32da2' but expected"
+                " 'aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa' from the file name");
+        TEST_RESULT_BOOL(storageExistsNP(storageTest, walDestination), false, "  check corrupt WAL segment removed");
+
+        storageMoveNP(
+            storageTest,
+            storageNewReadNP(
+                storageTest,
+                strNew(
+                    "repo/archive/test1/10-1/01ABCDEF01ABCDEF/01ABCDEF01ABCDEF01ABCDEF-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa")),
+            storageNewWriteNP(
+                storageTest,
+                strNew(
+                    "repo/archive/test1/10-1/01ABCDEF01ABCDEF/01ABCDEF01ABCDEF01ABCDEF-3b4417fc421cee30a9ad0fd9319220a8dae32da2")));
+
         TEST_RESULT_INT(
             archiveGetFile(storageTest, archiveFile, walDestination, false, cipherTypeNone, NULL), 0, "WAL segment copied");
         TEST_RESULT_BOOL(storageExistsNP(storageTest, walDestination), true, "  check exists");
@@ -183,10 +201,44 @@ testRun(void)
 
         storageRemoveP(
             storageTest,
-            strNew("repo/archive/test1/10-1/01ABCDEF01ABCDEF/01ABCDEF01ABCDEF01ABCDEF-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"),
+            strNew("repo/archive/test1/10-1/01ABCDEF01ABCDEF/01ABCDEF01ABCDEF01ABCDEF-3b4417fc421cee30a9ad0fd9319220a8dae32da2"),
             .errorOnMissing = true);
         storageRemoveP(storageTest, walDestination, .errorOnMissing = true);
 
+        // Compressed WAL segments and history files are not verified against a checksum in the file name
+        // -------------------------------------------------------------------------------------------------------------------------
+        StorageFileWrite *destination = storageNewWriteNP(
+            storageTest,
+            strNew(
+                "repo/archive/test1/10-1/01ABCDEF01ABCDEF/01ABCDEF01ABCDEF01ABCDEF-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.gz"));
+
+        ioWriteFilterGroupSet(
+            storageFileWriteIo(destination), ioFilterGroupAdd(ioFilterGroupNew(), gzipCompressFilter(gzipCompressNew(3, false))));
+        storagePutNP(destination, buffer);
+
+        TEST_RESULT_INT(
+            archiveGetFile(storageTest, archiveFile, walDestination, false, cipherTypeNone, NULL), 0,
+            "compressed WAL segment copied");
+        TEST_RESULT_INT(storageInfoNP(storageTest, walDestination).size, 16 * 1024 * 1024, "  check size");
+
+        storageRemoveP(
+            storageTest,
+            strNew(
+                "repo/archive/test1/10-1/01ABCDEF01ABCDEF/01ABCDEF01ABCDEF01ABCDEF-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.gz"),
+            .errorOnMissing = true);
+        storageRemoveP(storageTest, walDestination, .errorOnMissing = true);
+
+        storagePutNP(storageNewWriteNP(storageTest, strNew("repo/archive/test1/10-1/00000002.history")), bufNewZ("HISTORY"));
+
+        TEST_RESULT_INT(
+            archiveGetFile(storageTest, strNew("00000002.history"), walDestination, false, cipherTypeNone, NULL), 0,
+            "history file copied");
+        TEST_RESULT_STR(
+            strPtr(strNewBuf(storageGetNP(storageNewReadNP(storageTest, walDestination)))), "HISTORY", "  check content");
+
+        storageRemoveP(storageTest, strNew("repo/archive/test1/10-1/00000002.history"), .errorOnMissing = true);
+        storageRemoveP(storageTest, walDestination, .errorOnMissing = true);
+
         // Create a compressed WAL segment to copy
         // -------------------------------------------------------------------------------------------------------------------------
         StorageFileWrite *infoWrite = storageNewWriteNP(storageTest, strNew("repo/archive/test1/archive.info"));
@@ -211,7 +263,7 @@ testRun(void)
                 "[db:history]\n"
                 "1={\"db-id\":18072658121562454734,\"db-version\":\"10\"}"));
 
-        StorageFileWrite *destination = storageNewWriteNP(
+        destination = storageNewWriteNP(
             storageTest,
             strNew(
                 "repo/archive/test1/10-1/01ABCDEF01ABCDEF/01ABCDEF01ABCDEF01ABCDEF-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa.gz"));
@@ -383,7 +435,7 @@ testRun(void)
                     storageTest,
                     strNew(
                         "repo/archive/test2/10-1/0000000100000001/"
-                            "000000010000000100000001-abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd")),
+                            "000000010000000100000001-da39a3ee5e6b4b0d3255bfef95601890afd80709")),
                 NULL),
             "normal WAL segment");
 
@@ -2,6 +2,19 @@
 Test Ini
 ***********************************************************************************************************************************/
 
+#include "common/io/bufferRead.h"
+
+/***********************************************************************************************************************************
+Test callback that records each key/value loaded and consumes pg1-port so it is not stored
+***********************************************************************************************************************************/
+static bool
+testIniLoadCallback(void *data, const String *section, const String *key, const String *value)
+{
+    strCatFmt((String *)data, "%s:%s=%s\n", strPtr(section), strPtr(key), strPtr(value));
+
+    return !strEqZ(key, "pg1-port");
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -17,7 +30,9 @@ testRun(void)
 
         TEST_ASSIGN(ini, iniNew(), "new ini");
         TEST_RESULT_PTR_NE(ini->memContext, NULL, "mem context is set");
-        TEST_RESULT_PTR_NE(ini->store, NULL, "store is set");
+        TEST_RESULT_PTR_NE(ini->sectionIndex, NULL, "section index is set");
+        TEST_RESULT_PTR_NE(ini->sectionList, NULL, "section list is set");
+        TEST_RESULT_PTR_NE(ini->sectionNameList, NULL, "section name list is set");
         TEST_RESULT_VOID(iniFree(ini), "free ini");
         TEST_RESULT_VOID(iniFree(NULL), "free null ini");
     }
@@ -48,6 +63,12 @@ testRun(void)
         TEST_RESULT_INT(strLstSize(iniSectionList(ini)), 2, "number of sections");
         TEST_RESULT_STR(strPtr(strLstJoin(iniSectionList(ini), "|")), "section1|section2", "get sections");
 
+        TEST_RESULT_VOID(iniSet(ini, strNew("section1"), strNew("key1"), varNewInt(12)), "set section1, existing key, int");
+        TEST_RESULT_STR(strPtr(strLstJoin(iniSectionKeyList(ini, strNew("section1")), "|")), "key1|key2", "key list unchanged");
+        TEST_RESULT_INT(varLstSize(varVarLst(iniGet(ini, strNew("section1"), strNew("key1")))), 2, "values added to list");
+        TEST_RESULT_PTR(
+            iniSectionKeyList(ini, strNew("section1")), iniSectionKeyList(ini, strNew("section1")), "key list is not copied");
+
         TEST_RESULT_VOID(iniFree(ini), "free ini");
     }
 
@@ -82,6 +103,64 @@ testRun(void)
 
         TEST_RESULT_STR(strPtr(varStr(iniGet(ini, strNew("global"), strNew("compress")))), "y", "get compress");
         TEST_RESULT_STR(strPtr(varStr(iniGet(ini, strNew("db"), strNew("pg1-path")))), "/path/to/pg", "get pg1-path");
+
+        // Parse again with CRLF line endings and enough keys that the temp context is reset
+        // -------------------------------------------------------------------------------------------------------------------------
+        content = strNew("[section1]\r\n");
+
+        for (unsigned int keyIdx = 0; keyIdx < 2500; keyIdx++)
+            strCatFmt(content, "key%u = value%u\r\n", keyIdx, keyIdx);
+
+        strCat(content, "\t[section2]\t\r\n\r key=\r\n");
+
+        TEST_RESULT_VOID(iniParse(ini, content), "load ini");
+        TEST_RESULT_STR(strPtr(strLstJoin(iniSectionList(ini), "|")), "section1|section2", "get sections");
+        TEST_RESULT_INT(strLstSize(iniSectionKeyList(ini, strNew("section1"))), 2500, "get key total");
+        TEST_RESULT_STR(strPtr(strLstGet(iniSectionKeyList(ini, strNew("section1")), 1999)), "key1999", "get key in order");
+        TEST_RESULT_STR(strPtr(varStr(iniGet(ini, strNew("section1"), strNew("key2499")))), "value2499", "get value");
+        TEST_RESULT_STR(strPtr(varStr(iniGet(ini, strNew("section2"), strNew("key")))), "", "get empty value");
+        TEST_RESULT_PTR(iniGetDefault(ini, strNew("global"), strNew("compress"), NULL), NULL, "prior content is gone");
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("iniLoad()"))
+    {
+        Ini *ini = iniNew();
+        String *callbackResult = strNew("");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        IoRead *read = ioBufferReadIo(ioBufferReadNew(bufNew(0)));
+        ioReadOpen(read);
+
+        TEST_RESULT_VOID(iniLoad(ini, read, NULL, NULL), "load empty ini");
+        TEST_RESULT_INT(strLstSize(iniSectionList(ini)), 0, "no sections");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        read = ioBufferReadIo(
+            ioBufferReadNew(
+                bufNewZ(
+                    "# Comment\n"
+                    "[global]\n"
+                    "compress=y\n"
+                    "\n"
+                    "[db]\n"
+                    "pg1-path = /path/to/pg\n"
+                    "pg1-port=5432")));
+        ioReadOpen(read);
+
+        TEST_RESULT_VOID(iniLoad(ini, read, testIniLoadCallback, callbackResult), "load ini");
+        TEST_RESULT_STR(strPtr(varStr(iniGet(ini, strNew("global"), strNew("compress")))), "y", "get compress");
+        TEST_RESULT_STR(strPtr(varStr(iniGet(ini, strNew("db"), strNew("pg1-path")))), "/path/to/pg", "get pg1-path");
+        TEST_RESULT_PTR(
+            iniGetDefault(ini, strNew("db"), strNew("pg1-port"), NULL), NULL, "unterminated last line consumed by callback");
+        TEST_RESULT_STR(
+            strPtr(callbackResult), "global:compress=y\ndb:pg1-path=/path/to/pg\ndb:pg1-port=5432\n", "callback for each key");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        read = ioBufferReadIo(ioBufferReadNew(bufNewZ("[global]\ncompress\n")));
+        ioReadOpen(read);
+
+        TEST_ERROR(iniLoad(ini, read, NULL, NULL), FormatError, "missing '=' in key/value at line 2: compress");
     }
 
     FUNCTION_HARNESS_RESULT_VOID();
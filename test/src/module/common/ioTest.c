@@ -1,6 +1,7 @@
 /***********************************************************************************************************************************
 Test IO
 ***********************************************************************************************************************************/
+#include <ctype.h>
 #include <fcntl.h>
 
 #include "common/harnessFork.h"
@@ -34,6 +35,48 @@ testIoReadClose(void *driver)
     testIoReadCloseCalled = true;
 }
 
+/***********************************************************************************************************************************
+Test driver for IoRead that returns views of upper case data and copies everything else with read()
+***********************************************************************************************************************************/
+typedef struct TestIoReadView
+{
+    const char *data;                                               // Data to read
+    size_t offset;                                                  // Offset of next read
+    Buffer *view;                                                   // View of data
+} TestIoReadView;
+
+static bool
+testIoReadViewEof(TestIoReadView *driver)
+{
+    return driver->data[driver->offset] == 0;
+}
+
+static size_t
+testIoReadViewRead(TestIoReadView *driver, Buffer *buffer)
+{
+    bufCatC(buffer, (const unsigned char *)driver->data, driver->offset, 1);
+    driver->offset++;
+
+    return 1;
+}
+
+static const Buffer *
+testIoReadView(TestIoReadView *driver, size_t size)
+{
+    size_t viewSize = 0;
+
+    while (viewSize < size && isupper(driver->data[driver->offset + viewSize]))
+        viewSize++;
+
+    if (viewSize == 0)
+        return NULL;
+
+    bufViewSet(driver->view, driver->data + driver->offset, viewSize);
+    driver->offset += viewSize;
+
+    return driver->view;
+}
+
 /***********************************************************************************************************************************
 Test functions for IoWrite that are not covered by testing the IoBufferWrite object
 ***********************************************************************************************************************************/
@@ -247,6 +290,7 @@ testRun(void)
             "create io read object");
 
         TEST_RESULT_BOOL(ioReadOpen(read), true, "    open io object");
+        TEST_RESULT_BOOL(ioFilterGroupPassThru(ioReadFilterGroup(read)), true, "    no filters so pass thru");
         TEST_RESULT_SIZE(ioRead(read, buffer), 2, "    read 2 bytes");
         TEST_RESULT_BOOL(ioReadEof(read), false, "    no eof");
         TEST_RESULT_VOID(ioReadClose(read), "    close io object");
@@ -282,6 +326,7 @@ testRun(void)
         TEST_RESULT_PTR(ioFilterMove(NULL, memContextTop()), NULL, "    move NULL filter to top context");
 
         TEST_RESULT_BOOL(ioReadOpen(ioBufferReadIo(bufferRead)), true, "    open");
+        TEST_RESULT_BOOL(ioFilterGroupPassThru(filterGroup), false, "    filters so not pass thru");
         TEST_RESULT_BOOL(ioReadEof(ioBufferReadIo(bufferRead)), false, "    not eof");
         TEST_RESULT_SIZE(ioRead(ioBufferReadIo(bufferRead), buffer), 2, "    read 2 bytes");
         TEST_RESULT_SIZE(ioRead(ioBufferReadIo(bufferRead), buffer), 0, "    read 0 bytes (full buffer)");
@@ -324,6 +369,24 @@ testRun(void)
         TEST_RESULT_VOID(ioFilterGroupFree(filterGroup), "    free filter group object");
         TEST_RESULT_VOID(ioFilterGroupFree(NULL), "    free NULL filter group object");
 
+        // Read views from the driver when available
+        // -------------------------------------------------------------------------------------------------------------------------
+        TestIoReadView testView = {.data = "ABcDEfgH", .view = bufNewView(NULL, 0)};
+
+        TEST_ASSIGN(
+            read,
+            ioReadNewP(
+                &testView, .eof = (IoReadInterfaceEof)testIoReadViewEof, .read = (IoReadInterfaceRead)testIoReadViewRead,
+                .view = (IoReadInterfaceView)testIoReadView),
+            "create io read object with views");
+
+        filterGroup = ioFilterGroupNew();
+        ioFilterGroupAdd(filterGroup, ioTestFilterMultiplyNew("double", 2, 1, 'X')->filter);
+        ioReadFilterGroupSet(read, filterGroup);
+
+        TEST_RESULT_BOOL(ioReadOpen(read), true, "    open");
+        TEST_RESULT_STR(strPtr(strNewBuf(ioReadBuf(read))), "AABBccDDEEffggHHX", "    check read");
+
         // Mixed line and buffer read
         // -------------------------------------------------------------------------------------------------------------------------
         ioBufferSizeSet(5);
@@ -368,6 +431,27 @@ testRun(void)
         TEST_ERROR(ioReadLine(read), FileReadError, "unexpected eof while reading line");
         TEST_RESULT_INT(ioRead(read, buffer), 0, "read buffer");
 
+        // Read lines allowing eof
+        read = ioBufferReadIo(ioBufferReadNew(bufNewZ("12\n1234")));
+        ioReadOpen(read);
+
+        TEST_RESULT_STR(strPtr(ioReadLineParam(read, true)), "12", "read line");
+        TEST_RESULT_STR(strPtr(ioReadLineParam(read, true)), "1234", "read unterminated line at eof");
+        TEST_RESULT_PTR(ioReadLineParam(read, true), NULL, "no more lines");
+
+        // Read lines into a reused buffer
+        read = ioBufferReadIo(ioBufferReadNew(bufNewZ("1234\n1\n")));
+        ioReadOpen(read);
+        buffer = bufNew(2);
+
+        TEST_RESULT_VOID(ioReadLineBuf(read, buffer), "read line into buffer");
+        TEST_RESULT_STR(strPtr(strNewBuf(buffer)), "1234", "    check buffer");
+        TEST_RESULT_SIZE(bufSize(buffer), 4, "    buffer grew to fit line");
+        TEST_RESULT_VOID(ioReadLineBuf(read, buffer), "read line into buffer");
+        TEST_RESULT_STR(strPtr(strNewBuf(buffer)), "1", "    check buffer");
+        TEST_RESULT_SIZE(bufSize(buffer), 4, "    buffer was not resized");
+        TEST_ERROR(ioReadLineBuf(read, buffer), FileReadError, "unexpected eof while reading line");
+
         // Error if buffer is full and there is no linefeed
         ioBufferSizeSet(10);
         read = ioBufferReadIo(ioBufferReadNew(bufNewZ("0123456789")));
@@ -460,7 +544,7 @@ testRun(void)
     }
 
     // *****************************************************************************************************************************
-    if (testBegin("IoHandleRead, IoHandleWrite, and ioHandleWriteOneStr()"))
+    if (testBegin("IoHandleRead, IoHandleWrite, ioHandleWriteOneStr(), and ioHandlePipeSizeSet()"))
     {
         ioBufferSizeSet(16);
 
@@ -560,6 +644,17 @@ testRun(void)
         int fileHandle = open(strPtr(fileName), O_CREAT | O_TRUNC | O_WRONLY, 0700);
 
         TEST_RESULT_VOID(ioHandleWriteOneStr(fileHandle, strNew("test1\ntest2")), "write string to file");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_UINT(ioHandlePipeSizeSet(fileHandle, 262144), 0, "pipe size cannot be set on a file");
+
+        int pipeHandle[2];
+        THROW_ON_SYS_ERROR(pipe(pipeHandle) == -1, KernelError, "unable to create pipe");
+
+        TEST_RESULT_BOOL(ioHandlePipeSizeSet(pipeHandle[1], 262144) >= 262144, true, "set pipe size");
+
+        close(pipeHandle[0]);
+        close(pipeHandle[1]);
     }
 
     FUNCTION_HARNESS_RESULT_VOID();
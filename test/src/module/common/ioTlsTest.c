@@ -199,6 +199,8 @@ testRun(void)
         TEST_RESULT_INT(ioRead(tlsClientIoRead(client), output), 8, "read output");
         TEST_RESULT_STR(strPtr(strNewBuf(output)), "AND MORE", "    check output");
         TEST_RESULT_BOOL(ioReadEof(tlsClientIoRead(client)), false, "    check eof = false");
+        TEST_RESULT_BOOL(tlsClientHandle(client) != -1, true, "    check handle");
+        TEST_RESULT_BOOL(tlsClientReady(client), false, "    check no data ready");
 
         output = bufNew(12);
         TEST_ERROR(
@@ -211,6 +213,9 @@ testRun(void)
         TEST_RESULT_VOID(ioWrite(tlsClientIoWrite(client), input), "write input");
         ioWriteFlush(tlsClientIoWrite(client));
 
+        sleepMSec(100);
+        TEST_RESULT_BOOL(tlsClientReady(client), true, "check data ready");
+
         output = bufNew(12);
         TEST_RESULT_INT(ioRead(tlsClientIoRead(client), output), 12, "read output");
         TEST_RESULT_STR(strPtr(strNewBuf(output)), "0123456789AB", "    check output");
@@ -219,6 +224,7 @@ testRun(void)
         output = bufNew(12);
         TEST_RESULT_INT(ioRead(tlsClientIoRead(client), output), 0, "read no output after eof");
         TEST_RESULT_BOOL(ioReadEof(tlsClientIoRead(client)), true, "    check eof = true");
+        TEST_RESULT_BOOL(tlsClientReady(client), true, "    check ready when closed");
 
         TEST_RESULT_VOID(tlsClientFree(client), "free client");
         TEST_RESULT_VOID(tlsClientFree(NULL), "free null client");
@@ -171,7 +171,7 @@ testRun(void)
     if (testBegin("memContextAlloc(), memNew*(), memGrow(), and memFree()"))
     {
         memContextSwitch(memContextTop());
-        memNew(sizeof(size_t));
+        void *bufferTop = memNew(sizeof(size_t));
 
         MemContext *memContext = memContextNew("test-alloc");
         memContextSwitch(memContext);
@@ -211,11 +211,12 @@ testRun(void)
 
         // Free memory
         TEST_RESULT_UINT(memContextCurrent()->allocFreeIdx, MEM_CONTEXT_ALLOC_INITIAL_SIZE + 2, "check alloc free idx");
-        TEST_RESULT_VOID(memFree(memContextCurrent()->allocList[0].buffer), "free allocation");
-        TEST_ERROR(memFree(memContextCurrent()->allocList[0].buffer), AssertError, "unable to find allocation");
+        TEST_RESULT_VOID(memFree(MEM_CONTEXT_ALLOC_BUFFER(memContextCurrent()->allocList[0])), "free allocation");
+        TEST_RESULT_PTR(memContextCurrent()->allocList[0], NULL, "    allocation removed from list");
+        TEST_ERROR(memFree(bufferTop), AssertError, "unable to find allocation");
         TEST_RESULT_UINT(memContextCurrent()->allocFreeIdx, 0, "check alloc free idx");
 
-        TEST_RESULT_VOID(memFree(memContextCurrent()->allocList[1].buffer), "free allocation");
+        TEST_RESULT_VOID(memFree(MEM_CONTEXT_ALLOC_BUFFER(memContextCurrent()->allocList[1])), "free allocation");
         TEST_RESULT_UINT(memContextCurrent()->allocFreeIdx, 0, "check alloc free idx");
 
         TEST_RESULT_VOID(memNew(3), "new allocation");
@@ -228,13 +229,274 @@ testRun(void)
         TEST_RESULT_UINT(memContextCurrent()->allocFreeIdx, MEM_CONTEXT_ALLOC_INITIAL_SIZE + 3, "check alloc free idx");
 
         TEST_ERROR(memFree(NULL), AssertError, "assertion 'buffer != NULL' failed");
-        TEST_ERROR(memFree((void *)0x01), AssertError, "unable to find allocation");
+        MemContextAlloc bufferInvalid[MEM_CONTEXT_ALLOC_HEADER_SIZE / sizeof(MemContextAlloc) + 1] = {{.allocIdx = 999999}};
+        TEST_ERROR(memFree(MEM_CONTEXT_ALLOC_BUFFER(bufferInvalid)), AssertError, "unable to find allocation");
         memFree(buffer);
 
         memContextSwitch(memContextTop());
         memContextFree(memContext);
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("memGrowRaw() and memFree() with 1M allocations"))
+    {
+        // Allocations are found using the header before the buffer so growing and freeing take constant time no matter how many
+        // allocations are in the context.  Searching the alloc list instead would make this test take hours.
+        #define TEST_ALLOC_TOTAL                                    1000000
+
+        MemContext *memContext = memContextNew("test-many");
+        memContextSwitch(memContext);
+
+        void **bufferList = memNewRaw(sizeof(void *) * TEST_ALLOC_TOTAL);
+
+        for (unsigned int allocIdx = 0; allocIdx < TEST_ALLOC_TOTAL; allocIdx++)
+            bufferList[allocIdx] = memNewRaw(sizeof(size_t));
+
+        TEST_RESULT_UINT(memContext->allocListSize, 1048576, "alloc list size");
+
+        // Grow and free newest first since those are the slowest to find by searching
+        for (unsigned int allocIdx = TEST_ALLOC_TOTAL; allocIdx > 0; allocIdx--)
+            bufferList[allocIdx - 1] = memGrowRaw(bufferList[allocIdx - 1], sizeof(size_t) * 2);
+
+        for (unsigned int allocIdx = TEST_ALLOC_TOTAL; allocIdx > 0; allocIdx--)
+            memFree(bufferList[allocIdx - 1]);
+
+        TEST_RESULT_UINT(memContext->allocFreeIdx, 1, "all allocations freed");
+
+        memContextSwitch(memContextTop());
+        memContextFree(memContext);
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("memContextNewArena() and arena allocations"))
+    {
+        MemContext *memContext = memContextNewArena("test-arena");
+        TEST_RESULT_BOOL(memContext->arena, true, "context is an arena");
+        TEST_RESULT_PTR(memContext->allocList, NULL, "no alloc list");
+        TEST_RESULT_PTR(memContext->arenaBlock, NULL, "no blocks yet");
+
+        memContextSwitch(memContext);
+
+        // Allocations from another context are caught before there are any blocks
+        // -------------------------------------------------------------------------------------------------------------------------
+        memContextSwitch(memContextTop());
+        void *bufferTop = memNew(1);
+        memContextSwitch(memContext);
+
+        TEST_ERROR(memFree(bufferTop), AssertError, "unable to find allocation");
+        TEST_ERROR(memGrowRaw(bufferTop, 2), AssertError, "unable to find allocation");
+
+        // Large allocation is the first block
+        // -------------------------------------------------------------------------------------------------------------------------
+        unsigned char *large = memNewRaw(MEM_CONTEXT_ARENA_BLOCK_SIZE);
+        MemContextArenaBlock *largeBlock = memContext->arenaBlock;
+
+        TEST_RESULT_SIZE(largeBlock->size, MEM_CONTEXT_ARENA_BLOCK_SIZE + MEM_CONTEXT_ARENA_ALLOC_HEADER_SIZE, "large block size");
+        TEST_RESULT_SIZE(largeBlock->used, largeBlock->size, "large block is full");
+        TEST_RESULT_SIZE(MEM_CONTEXT_ARENA_ALLOC_SIZE(large), MEM_CONTEXT_ARENA_BLOCK_SIZE, "allocation size");
+
+        // Small allocations bump through a new block
+        // -------------------------------------------------------------------------------------------------------------------------
+        unsigned char *buffer1 = memNew(3);
+        MemContextArenaBlock *block = memContext->arenaBlock;
+
+        TEST_RESULT_BOOL(block != largeBlock, true, "new current block");
+        TEST_RESULT_PTR(block->next, largeBlock, "large block is next");
+        TEST_RESULT_SIZE(block->size, MEM_CONTEXT_ARENA_BLOCK_SIZE, "block size");
+        TEST_RESULT_INT(buffer1[0] + buffer1[1] + buffer1[2], 0, "allocation is zeroed");
+        TEST_RESULT_UINT((uintptr_t)buffer1 % MEM_CONTEXT_ALIGN, 0, "allocation is aligned");
+
+        unsigned char *buffer2 = memNewRaw(17);
+
+        TEST_RESULT_PTR(
+            buffer2, buffer1 + MEM_CONTEXT_ALIGN + MEM_CONTEXT_ARENA_ALLOC_HEADER_SIZE, "allocation follows previous");
+        TEST_RESULT_SIZE(block->used, MEM_CONTEXT_ARENA_ALLOC_HEADER_SIZE * 2 + MEM_CONTEXT_ALIGN * 3, "block used");
+
+        // Resize the most recent allocation in place
+        // -------------------------------------------------------------------------------------------------------------------------
+        memset(buffer2, 0xFE, 17);
+
+        TEST_RESULT_PTR(memGrowRaw(buffer2, 64), buffer2, "grow in place");
+        TEST_RESULT_SIZE(MEM_CONTEXT_ARENA_ALLOC_SIZE(buffer2), 64, "    check size");
+        TEST_RESULT_SIZE(block->used, MEM_CONTEXT_ARENA_ALLOC_HEADER_SIZE * 2 + MEM_CONTEXT_ALIGN + 64, "    check used");
+        TEST_RESULT_PTR(memGrowRaw(buffer2, 8), buffer2, "shrink in place");
+        TEST_RESULT_SIZE(block->used, MEM_CONTEXT_ARENA_ALLOC_HEADER_SIZE * 2 + MEM_CONTEXT_ALIGN * 2, "    check used");
+
+        // Resize an allocation that is not the most recent
+        // -------------------------------------------------------------------------------------------------------------------------
+        unsigned char *buffer3 = NULL;
+
+        buffer1[0] = 0xFD;
+
+        TEST_ASSIGN(buffer3, memGrowRaw(buffer1, 32), "grow by copying");
+        TEST_RESULT_BOOL(buffer3 != buffer1, true, "    new allocation");
+        TEST_RESULT_UINT(buffer3[0], 0xFD, "    contents are copied");
+
+        // Resize the most recent allocation when there is not enough space in the block
+        // -------------------------------------------------------------------------------------------------------------------------
+        buffer3[1] = 0xFC;
+
+        unsigned char *buffer4 = NULL;
+
+        TEST_ASSIGN(buffer4, memGrowRaw(buffer3, MEM_CONTEXT_ARENA_BLOCK_SIZE), "grow past end of block");
+        TEST_RESULT_BOOL(buffer4 != buffer3, true, "    new allocation");
+        TEST_RESULT_UINT(buffer4[0], 0xFD, "    contents are copied");
+        TEST_RESULT_UINT(buffer4[1], 0xFC, "    contents are copied");
+        TEST_RESULT_PTR(memContext->arenaBlock, block, "    current block is unchanged");
+        TEST_RESULT_PTR(block->next->next, largeBlock, "    large block added after current block");
+
+        // Free reclaims only the most recent allocation
+        // -------------------------------------------------------------------------------------------------------------------------
+        size_t used = block->used;
+
+        TEST_RESULT_VOID(memFree(buffer2), "free allocation that is not most recent");
+        TEST_RESULT_SIZE(block->used, used, "    space is not reclaimed");
+
+        buffer2 = memNew(1);
+
+        TEST_RESULT_VOID(memFree(buffer2), "free most recent allocation");
+        TEST_RESULT_SIZE(block->used, used, "    space is reclaimed");
+
+        // Allocations must be in the current context
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ERROR(memFree(bufferTop), AssertError, "unable to find allocation");
+        TEST_ERROR(memGrowRaw(bufferTop, 2), AssertError, "unable to find allocation");
+        TEST_ERROR(memFree(buffer2), AssertError, "unable to find allocation");
+
+        memContextSwitch(memContextTop());
+        memFree(bufferTop);
+        memContextSwitch(memContext);
+
+        // Fill the block so a new block is added
+        // -------------------------------------------------------------------------------------------------------------------------
+        while (memContext->arenaBlock == block)
+            memNewRaw(MEM_CONTEXT_ARENA_BLOCK_SIZE / 8);
+
+        TEST_RESULT_PTR(memContext->arenaBlock->next, block, "new block added when full");
+
+        memContextSwitch(memContextTop());
+        TEST_RESULT_VOID(memContextFree(memContext), "free arena context");
+        TEST_RESULT_PTR(memContext->arenaBlock, NULL, "    blocks are freed");
+        TEST_RESULT_BOOL(memContext->arena, false, "    context is reset");
+
+        // Temp arena context
+        // -------------------------------------------------------------------------------------------------------------------------
+        MEM_CONTEXT_TEMP_ARENA_BEGIN()
+        {
+            TEST_RESULT_BOOL(memContextCurrent()->arena, true, "temp context is an arena");
+            TEST_RESULT_STR(memContextName(MEM_CONTEXT_TEMP()), "temporary", "    context name");
+            memNew(1);
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        TEST_RESULT_PTR(memContextCurrent(), memContextTop(), "context is now top");
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("memContextReset() and MEM_CONTEXT_TEMP_RESET*()"))
+    {
+        MemContext *memContext = memContextNew("test-reset");
+        memContextSwitch(memContext);
+
+        for (int allocIdx = 0; allocIdx <= MEM_CONTEXT_ALLOC_INITIAL_SIZE; allocIdx++)
+            memNew(sizeof(size_t));
+
+        MemContext *memContextChild = memContextNew("test-reset-child");
+        memContextFree(memContextNew("test-reset-child-freed"));
+
+        TEST_RESULT_VOID(memContextReset(memContext), "reset context");
+        TEST_RESULT_PTR(memContextCurrent(), memContext, "    context is still current");
+        TEST_RESULT_STR(memContextName(memContext), "test-reset", "    context is still active");
+        TEST_RESULT_UINT(memContext->allocListSize, MEM_CONTEXT_ALLOC_INITIAL_SIZE * 2, "    alloc list is kept");
+        TEST_RESULT_UINT(memContext->allocFreeIdx, 0, "    alloc list is empty");
+        TEST_RESULT_PTR(memContext->allocList[MEM_CONTEXT_ALLOC_INITIAL_SIZE], NULL, "    allocation is freed");
+        TEST_RESULT_UINT(memContext->contextChildListSize, MEM_CONTEXT_INITIAL_SIZE, "    child list is kept");
+        TEST_RESULT_BOOL(memContextChild->state == memContextStateFree, true, "    child context is freed");
+
+        TEST_RESULT_PTR(memContextNew("test-reset-child2"), memContextChild, "child context is reused");
+        void *buffer = memNew(1);
+        TEST_RESULT_PTR(memContext->allocList[0], MEM_CONTEXT_ALLOC_HEADER(buffer), "allocation is at start of list");
+
+        memContextSwitch(memContextTop());
+        memContextFree(memContext);
+
+        TEST_ERROR(memContextReset(memContext), AssertError, "cannot reset inactive context");
+
+        // Reset arena
+        // -------------------------------------------------------------------------------------------------------------------------
+        memContext = memContextNewArena("test-reset-arena");
+        memContextSwitch(memContext);
+
+        memNew(MEM_CONTEXT_ARENA_BLOCK_SIZE);
+        TEST_RESULT_VOID(memContextReset(memContext), "reset arena with only a large block");
+        TEST_RESULT_PTR(memContext->arenaBlock, NULL, "    no blocks");
+
+        memNew(1);
+        MemContextArenaBlock *block = memContext->arenaBlock;
+
+        while (memContext->arenaBlock == block)
+            memNew(MEM_CONTEXT_ARENA_BLOCK_SIZE / 8);
+
+        block = memContext->arenaBlock;
+        memNew(MEM_CONTEXT_ARENA_BLOCK_SIZE);
+
+        TEST_RESULT_VOID(memContextReset(memContext), "reset arena with several blocks");
+        TEST_RESULT_PTR(memContext->arenaBlock, block, "    current block is kept");
+        TEST_RESULT_PTR(block->next, NULL, "    other blocks are freed");
+        TEST_RESULT_SIZE(block->used, 0, "    block is empty");
+
+        memContextSwitch(memContextTop());
+        memContextFree(memContext);
+
+        // Temp context reset in a loop
+        // -------------------------------------------------------------------------------------------------------------------------
+        MemContext *memContextTemp = NULL;
+        unsigned int loopIdx = 0;
+
+        MEM_CONTEXT_TEMP_RESET_BEGIN()
+        {
+            memContextTemp = MEM_CONTEXT_TEMP();
+
+            do
+            {
+                MEM_CONTEXT_TEMP_RESET(2);
+
+                memNew(1);
+
+                TEST_RESULT_UINT(memContextCurrent()->allocFreeIdx, loopIdx % 2 + 1, "allocations since reset");
+                TEST_RESULT_PTR(memContextCurrent(), memContextTemp, "    same temp context");
+            }
+            while (++loopIdx < 5);
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        TEST_RESULT_PTR(memContextCurrent(), memContextTop(), "context is now top");
+        TEST_RESULT_BOOL(memContextTemp->state == memContextStateFree, true, "temp context is freed");
+
+        // Iterations that continue are still counted
+        // -------------------------------------------------------------------------------------------------------------------------
+        loopIdx = 0;
+
+        MEM_CONTEXT_TEMP_RESET_BEGIN()
+        {
+            do
+            {
+                MEM_CONTEXT_TEMP_RESET(2);
+
+                memNew(1);
+
+                TEST_RESULT_UINT(memContextCurrent()->allocFreeIdx, loopIdx % 2 + 1, "allocations since reset with continue");
+
+                if (loopIdx % 2 == 0)
+                    continue;
+
+                memNew(1);
+            }
+            while (++loopIdx < 5);
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("memContextCallback()"))
     {
@@ -354,7 +616,7 @@ testRun(void)
                 }
                 MEM_CONTEXT_NEW_END();
 
-                TEST_RESULT_PTR(memContext->allocList[0].buffer, mem, "check memory allocation");
+                TEST_RESULT_PTR(MEM_CONTEXT_ALLOC_BUFFER(memContext->allocList[0]), mem, "check memory allocation");
                 TEST_RESULT_PTR(memContextCurrent()->contextChildList[1], memContext, "check memory context");
 
                 // Null out the mem context in the parent so the move will fail
@@ -378,10 +640,10 @@ testRun(void)
             }
             MEM_CONTEXT_TEMP_END();
 
-            TEST_RESULT_PTR(memContext->allocList[0].buffer, mem, "check memory allocation");
+            TEST_RESULT_PTR(MEM_CONTEXT_ALLOC_BUFFER(memContext->allocList[0]), mem, "check memory allocation");
             TEST_RESULT_PTR(memContextCurrent()->contextChildList[1], memContext, "check memory context");
 
-            TEST_RESULT_PTR(memContext2->allocList[0].buffer, mem2, "check memory allocation 2");
+            TEST_RESULT_PTR(MEM_CONTEXT_ALLOC_BUFFER(memContext2->allocList[0]), mem2, "check memory allocation 2");
             TEST_RESULT_PTR(memContextCurrent()->contextChildList[2], memContext2, "check memory context 2");
         }
         MEM_CONTEXT_NEW_END();
@@ -19,6 +19,8 @@ testRun(void)
         TEST_ASSIGN(regExp, regExpNew(strNew("^abc")), "new regexp");
         TEST_RESULT_BOOL(regExpMatch(regExp, strNew("abcdef")), true, "match regexp");
         TEST_RESULT_BOOL(regExpMatch(regExp, strNew("bcdef")), false, "no match regexp");
+        TEST_RESULT_BOOL(regExpMatchZ(regExp, "abcdef"), true, "match regexp on zero-terminated string");
+        TEST_RESULT_BOOL(regExpMatchZ(regExp, "bcdef"), false, "no match regexp on zero-terminated string");
 
         TEST_RESULT_VOID(regExpFree(regExp), "free regexp");
         TEST_RESULT_VOID(regExpFree(NULL), "free NULL regexp");
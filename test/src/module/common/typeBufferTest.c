@@ -11,7 +11,7 @@ testRun(void)
     FUNCTION_HARNESS_VOID();
 
     // *****************************************************************************************************************************
-    if (testBegin("bufNew(), bugNewC, bufNewStr(), bufNewZ(), bufMove(), bufSize(), bufPtr(), and bufFree()"))
+    if (testBegin("bufNew(), bugNewC, bufNewStr(), bufNewZ(), bufNewView(), bufMove(), bufSize(), bufPtr(), and bufFree()"))
     {
         Buffer *buffer = NULL;
 
@@ -42,6 +42,21 @@ testRun(void)
 
         TEST_ASSIGN(buffer, bufNewC(sizeof(cBuffer), cBuffer), "create from c buffer");
         TEST_RESULT_BOOL(memcmp(bufPtr(buffer), cBuffer, sizeof(cBuffer)) == 0, true, "check buffer");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ASSIGN(buffer, bufNewView(cBuffer, 2), "create view of c buffer");
+        TEST_RESULT_PTR(bufPtr(buffer), cBuffer, "    check pointer");
+        TEST_RESULT_SIZE(bufUsed(buffer), 2, "    check used");
+        TEST_RESULT_BOOL(bufFull(buffer), true, "    check full");
+        TEST_ERROR(bufResize(buffer, 4), AssertError, "assertion '!this->view' failed");
+
+        TEST_RESULT_VOID(bufViewSet(buffer, cBuffer + 2, 3), "move view");
+        TEST_RESULT_STR(strPtr(strNewBuf(buffer)), "CD", "    check view");
+        TEST_RESULT_VOID(bufViewSet(buffer, NULL, 0), "empty view");
+        TEST_RESULT_SIZE(bufSize(buffer), 0, "    check size");
+        TEST_ERROR(bufViewSet(bufNew(0), cBuffer, 1), AssertError, "assertion 'this->view' failed");
+        TEST_RESULT_VOID(bufFree(bufNewView(cBuffer, 4)), "free view without freeing memory");
+        TEST_RESULT_STR(cBuffer, "ABCD", "    check memory");
     }
 
     // *****************************************************************************************************************************
@@ -30,14 +30,19 @@ testRun(void)
         TEST_ERROR(jsonToVar(strNew("-")), JsonFormatError, "found '-' with no integer at '-'");
         TEST_RESULT_INT(varUInt64(jsonToVar(strNew(" 5555555555"))), 5555555555, "simple integer");
         TEST_RESULT_INT(varInt64(jsonToVar(strNew("-5555555555 "))), -5555555555, "negative integer");
+        TEST_ERROR(
+            jsonToVar(strNew("1234567890123456789012345678901234567890123456789012345678901234")), JsonFormatError,
+            "number is too long at '1234567890123456789012345678901234567890123456789012345678901234'");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_ERROR(jsonToVar(strNew("ton")), JsonFormatError, "expected boolean at 'ton'");
+        TEST_ERROR(jsonToVar(strNew("t")), JsonFormatError, "expected boolean at 't'");
         TEST_RESULT_BOOL(varBool(jsonToVar(strNew(" true"))), true, "boolean true");
         TEST_RESULT_BOOL(varBool(jsonToVar(strNew("false "))), false, "boolean false");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_ERROR(jsonToVar(strNew("not")), JsonFormatError, "expected null at 'not'");
+        TEST_ERROR(jsonToVar(strNew("n")), JsonFormatError, "expected null at 'n'");
         TEST_RESULT_PTR(jsonToVar(strNew("null")), NULL, "null value");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -67,6 +72,10 @@ testRun(void)
 
         TEST_ASSIGN(kv, varKv(jsonToVar(strNew("\t{\n} "))), "empty object");
         TEST_RESULT_UINT(varLstSize(kvKeyList(kv)), 0, "check key total");
+
+        TEST_ASSIGN(kv, varKv(jsonToVar(strNew("{\"key\\\"1\":1,\"key\":2}"))), "object with escaped key");
+        TEST_RESULT_UINT(varUInt64(kvGet(kv, varNewStrZ("key\"1"))), 1, "check escaped key");
+        TEST_RESULT_STR(strPtr(varStr(varLstGet(kvKeyList(kv), 1))), "key", "check unescaped key");
     }
 
     // *****************************************************************************************************************************
@@ -143,6 +152,10 @@ testRun(void)
             "\"backup-reference\":[\"20161219-212741F\",\"20161219-212741F_20161219-212803I\"],"
             "\"backup-timestamp-start\":1482182951,\"checksum-page-error\":[1]}",
             "  check string no pretty print");
+
+        TEST_ASSIGN(keyValue, varKv(jsonToVar(strNew("{\"list\":[[1,\"a\",[{\"b\":true}]],[]]}"))), "nested arrays");
+        TEST_ASSIGN(json, kvToJson(keyValue, 0), "  kvToJson - nested arrays, no indent");
+        TEST_RESULT_STR(strPtr(json), "{\"list\":[[1,\"a\",[{\"b\":true}]],[]]}", "  check nested arrays");
     }
 
     // *****************************************************************************************************************************
@@ -286,5 +299,151 @@ testRun(void)
             "  sorted json string result, pretty print");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("JsonRead"))
+    {
+        Buffer *json = bufNewZ(
+            " {\"array\" : [true, false, null, -1, 2, 3, \"str\\n\", []],\"var\":{\"key\":[1]}, \"empty\":{}}  ");
+        JsonRead *read = NULL;
+
+        TEST_ASSIGN(read, jsonReadNew(json), "new read");
+
+        TEST_RESULT_UINT(jsonReadTypeNext(read), jsonTypeObjectBegin, "next is object begin");
+        TEST_RESULT_VOID(jsonReadObjectBegin(read), "object begin");
+        TEST_RESULT_UINT(jsonReadTypeNext(read), jsonTypeString, "next is key");
+        TEST_RESULT_PTR(jsonReadKey(read), strInternZ("array"), "key is interned");
+        TEST_RESULT_UINT(jsonReadTypeNext(read), jsonTypeArrayBegin, "next is array begin");
+        TEST_RESULT_VOID(jsonReadArrayBegin(read), "array begin");
+        TEST_RESULT_UINT(jsonReadTypeNext(read), jsonTypeBool, "next is bool");
+        TEST_RESULT_BOOL(jsonReadBool(read), true, "bool true");
+        TEST_RESULT_BOOL(jsonReadBool(read), false, "bool false");
+        TEST_RESULT_UINT(jsonReadTypeNext(read), jsonTypeNull, "next is null");
+        TEST_RESULT_VOID(jsonReadNull(read), "null");
+        TEST_RESULT_UINT(jsonReadTypeNext(read), jsonTypeNumber, "next is number");
+        TEST_RESULT_INT(jsonReadInt(read), -1, "int");
+        TEST_RESULT_INT(jsonReadInt64(read), 2, "int64");
+        TEST_RESULT_UINT(jsonReadUInt64(read), 3, "uint64");
+        TEST_RESULT_STR(strPtr(jsonReadStr(read)), "str\n", "str");
+        TEST_RESULT_VOID(jsonReadArrayBegin(read), "empty array begin");
+        TEST_RESULT_UINT(jsonReadTypeNext(read), jsonTypeArrayEnd, "next is array end");
+        TEST_RESULT_VOID(jsonReadArrayEnd(read), "empty array end");
+        TEST_RESULT_VOID(jsonReadArrayEnd(read), "array end");
+        TEST_RESULT_PTR(jsonReadKey(read), strInternZ("var"), "key");
+        TEST_RESULT_UINT(
+            varLstSize(varVarLst(kvGet(varKv(jsonReadVar(read)), varNewStrZ("key")))), 1, "variant");
+        TEST_RESULT_PTR(jsonReadKey(read), strInternZ("empty"), "key");
+        TEST_RESULT_UINT(jsonReadTypeNext(read), jsonTypeObjectBegin, "next is object begin");
+        TEST_RESULT_VOID(jsonReadObjectBegin(read), "empty object begin");
+        TEST_RESULT_UINT(jsonReadTypeNext(read), jsonTypeObjectEnd, "next is object end");
+        TEST_RESULT_VOID(jsonReadObjectEnd(read), "empty object end");
+        TEST_RESULT_VOID(jsonReadObjectEnd(read), "object end");
+
+        // Reset and read again from the beginning after new JSON is loaded into the buffer
+        // -------------------------------------------------------------------------------------------------------------------------
+        bufUsedZero(json);
+        bufCat(json, bufNewZ("[1 2]"));
+        TEST_RESULT_VOID(jsonReadReset(read), "reset");
+        TEST_RESULT_VOID(jsonReadArrayBegin(read), "array begin");
+        TEST_RESULT_INT(jsonReadInt(read), 1, "int");
+        TEST_ERROR(jsonReadInt(read), JsonFormatError, "expected ',' at '2]'");
+
+        // Errors
+        // -------------------------------------------------------------------------------------------------------------------------
+        bufUsedZero(json);
+        bufCat(json, bufNewZ("[\"a\",{\"b\" 1}"));
+        jsonReadReset(read);
+
+        TEST_ERROR(jsonReadObjectBegin(read), JsonFormatError, "expected '{' at '[\"a\",{\"b\" 1}'");
+        TEST_RESULT_VOID(jsonReadArrayBegin(read), "array begin");
+        TEST_ERROR(jsonReadInt(read), JsonFormatError, "expected number at '\"a\",{\"b\" 1}'");
+        TEST_ERROR(jsonReadArrayEnd(read), JsonFormatError, "expected ']' at '\"a\",{\"b\" 1}'");
+        TEST_RESULT_STR(strPtr(jsonReadStr(read)), "a", "str");
+        TEST_RESULT_VOID(jsonReadObjectBegin(read), "object begin");
+        TEST_ERROR(jsonReadKey(read), JsonFormatError, "expected ':' at '1}'");
+
+        bufUsedZero(json);
+        bufCat(json, bufNewZ("  x"));
+        jsonReadReset(read);
+
+        TEST_ERROR(jsonReadTypeNext(read), JsonFormatError, "invalid type at 'x'");
+
+        bufUsedZero(json);
+        jsonReadReset(read);
+
+        TEST_ERROR(jsonReadTypeNext(read), JsonFormatError, "expected data");
+
+        TEST_RESULT_VOID(jsonReadFree(read), "free read");
+        TEST_RESULT_VOID(jsonReadFree(NULL), "free null read");
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("JsonWrite"))
+    {
+        Buffer *json = bufNew(0);
+        JsonWrite *write = NULL;
+
+        TEST_ASSIGN(write, jsonWriteNew(json), "new write");
+
+        jsonWriteObjectBegin(write);
+        jsonWriteArrayBegin(jsonWriteKey(write, strNew("array")));
+        jsonWriteBool(write, true);
+        jsonWriteInt(write, -1);
+        jsonWriteInt64(write, -5555555555);
+        jsonWriteUInt64(write, 5555555555);
+        jsonWriteNull(write);
+        jsonWriteStr(write, strNew("\"\\/\b\n\r\t\fx"));
+        jsonWriteStr(write, NULL);
+        jsonWriteArrayEnd(jsonWriteArrayBegin(write));
+        jsonWriteArrayEnd(write);
+        jsonWriteObjectEnd(jsonWriteObjectBegin(jsonWriteKey(write, strNew("empty"))));
+        jsonWriteStr(jsonWriteKey(write, strNew("key")), strNew("value"));
+        jsonWriteObjectEnd(write);
+
+        TEST_RESULT_STR(
+            strPtr(strNewBuf(json)),
+            "{\"array\":[true,-1,-5555555555,5555555555,null,\"\\\"\\\\\\/\\b\\n\\r\\t\\fx\",null,[]],\"empty\":{},"
+                "\"key\":\"value\"}",
+            "check json");
+
+        // Reset and write variants
+        // -------------------------------------------------------------------------------------------------------------------------
+        size_t bufferSize = bufSize(json);
+
+        TEST_RESULT_VOID(jsonWriteReset(write), "reset");
+        TEST_RESULT_VOID(jsonWriteVar(write, varNewKv()), "write empty kv");
+        TEST_RESULT_VOID(jsonWriteVar(write, NULL), "write null");
+        TEST_RESULT_VOID(jsonWriteVar(write, varNewStr(NULL)), "write null string");
+        TEST_RESULT_STR(strPtr(strNewBuf(json)), "{},null,null", "check json");
+
+        VariantList *list = varLstNew();
+        varLstAdd(list, varNewBool(false));
+        varLstAdd(list, varNewInt(7));
+        varLstAdd(list, varNewInt64(-8));
+        varLstAdd(list, varNewUInt64(9));
+        varLstAdd(list, varNewStrZ("str"));
+        varLstAdd(list, varNewKv());
+        varLstAdd(list, NULL);
+
+        jsonWriteReset(write);
+        TEST_RESULT_VOID(jsonWriteVar(write, varNewVarLst(list)), "write list");
+        TEST_RESULT_STR(strPtr(strNewBuf(json)), "[false,7,-8,9,\"str\",{},null]", "check json");
+        TEST_RESULT_SIZE(bufSize(json), bufferSize, "buffer was not resized");
+
+        // Output matches kvToJson()
+        Variant *kv = varNewKv();
+        kvPut(varKv(kv), varNewStrZ("z"), varNewDbl(1.5));
+        kvPut(varKv(kv), varNewStrZ("a"), varNewVarLst(NULL));
+        kvPut(varKv(kv), varNewStrZ("m"), NULL);
+        kvPut(varKv(kv), varNewStrZ("list"), varNewVarLst(list));
+        kvPutKv(varKv(kv), varNewStrZ("kv"));
+
+        jsonWriteReset(write);
+        TEST_RESULT_VOID(jsonWriteVar(write, kv), "write kv");
+        TEST_RESULT_STR(strPtr(strNewBuf(json)), strPtr(kvToJson(varKv(kv), 0)), "check json matches kvToJson()");
+
+        TEST_RESULT_VOID(jsonWriteFree(write), "free write");
+        TEST_RESULT_VOID(jsonWriteFree(NULL), "free null write");
+    }
+
     FUNCTION_HARNESS_RESULT_VOID();
 }
@@ -109,5 +109,95 @@ testRun(void)
         TEST_RESULT_VOID(kvFree(store), "free store");
     }
 
+    // -----------------------------------------------------------------------------------------------------------------------------
+    if (testBegin("kvGetStr(), kvGetZ(), and hash index"))
+    {
+        KeyValue *store = kvNew();
+
+        // Keys are searched linearly until the index is built
+        // -------------------------------------------------------------------------------------------------------------------------
+        kvPut(store, varNewStrZ("a"), varNewInt(1));
+        kvPut(store, varNewStrZ("ab"), varNewInt(2));
+        kvPut(store, varNewStrZ("bb"), varNewInt(3));
+        kvPut(store, varNewInt(0), varNewInt(4));
+
+        TEST_RESULT_PTR(store->index, NULL, "no index");
+        TEST_RESULT_INT(varInt(kvGetZ(store, "ab")), 2, "get zero-terminated key");
+        TEST_RESULT_INT(varInt(kvGetStr(store, strNew("bb"))), 3, "get String key");
+        TEST_RESULT_PTR(kvGetZ(store, "b"), NULL, "get missing key");
+
+        // Force string keys to collide so the size and contents are compared
+        for (unsigned int listIdx = 0; listIdx < 3; listIdx++)
+            ((KeyValuePair *)lstGet(store->list, listIdx))->hash = kvHashZ("bb", 2);
+
+        TEST_RESULT_INT(varInt(kvGetZ(store, "bb")), 3, "get key after hash collisions");
+
+        // A string key with the same bytes that are hashed for int 0 collides but is not equal
+        const char intZeroZ[sizeof(uint64_t) + 1] = {(char)varTypeInt};
+
+        TEST_RESULT_UINT(kvHashZ(intZeroZ, sizeof(intZeroZ)), kvHashVar(varNewInt(0)), "string and int hash match");
+        TEST_RESULT_PTR(kvGetStr(store, strNewN(intZeroZ, sizeof(intZeroZ))), NULL, "string does not match int");
+        TEST_RESULT_INT(varInt(kvGet(store, varNewInt(0))), 4, "get int key");
+
+        // Keys of different types are never equal and -0.0 is the same key as 0.0
+        // -------------------------------------------------------------------------------------------------------------------------
+        kvPut(store, varNewUInt64(0), varNewInt(5));
+        kvPut(store, varNewInt64(0), varNewInt(6));
+        kvPut(store, varNewBool(false), varNewInt(7));
+        kvPut(store, varNewDbl(-0.0), varNewInt(8));
+
+        TEST_RESULT_PTR_NE(store->index, NULL, "index built");
+        TEST_RESULT_UINT(store->indexSize, 16, "index size");
+        TEST_RESULT_INT(varInt(kvGet(store, varNewInt(0))), 4, "get int key");
+        TEST_RESULT_INT(varInt(kvGet(store, varNewUInt64(0))), 5, "get uint64 key");
+        TEST_RESULT_INT(varInt(kvGet(store, varNewInt64(0))), 6, "get int64 key");
+        TEST_RESULT_INT(varInt(kvGet(store, varNewBool(false))), 7, "get bool key");
+        TEST_RESULT_INT(varInt(kvGet(store, varNewDbl(0.0))), 8, "get double key");
+        TEST_RESULT_PTR(kvGet(store, varNewBool(true)), NULL, "get missing key");
+
+        // Key/value and list keys can be added but not compared
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_PTR(kvPut(store, varNewKv(), NULL), store, "put kv key");
+        TEST_RESULT_PTR(kvPut(store, varNewVarLst(varLstNew()), NULL), store, "put list key");
+        TEST_ERROR(kvPut(store, varNewKv(), NULL), AssertError, "unable to test equality for KeyValue");
+
+        // Add enough keys to grow the index several times
+        // -------------------------------------------------------------------------------------------------------------------------
+        for (unsigned int keyIdx = 0; keyIdx < 1000; keyIdx++)
+            kvPut(store, varNewStr(strNewFmt("key%u", keyIdx)), varNewUInt64(keyIdx));
+
+        TEST_RESULT_UINT(lstSize(store->list), 1010, "list size");
+        TEST_RESULT_UINT(store->indexSize, 2048, "index size");
+        TEST_RESULT_STR(strPtr(varStr(varLstGet(kvKeyList(store), 10))), "key0", "key list in insertion order");
+        TEST_RESULT_STR(strPtr(varStr(varLstGet(kvKeyList(store), 1009))), "key999", "key list in insertion order");
+
+        bool found = true;
+
+        for (unsigned int keyIdx = 0; keyIdx < 1000; keyIdx++)
+        {
+            String *key = strNewFmt("key%u", keyIdx);
+
+            if (varUInt64(kvGet(store, varNewStr(key))) != keyIdx || varUInt64(kvGetStr(store, key)) != keyIdx ||
+                varUInt64(kvGetZ(store, strPtr(key))) != keyIdx)
+            {
+                found = false;
+            }
+        }
+
+        TEST_RESULT_BOOL(found, true, "get all keys");
+        TEST_RESULT_PTR(kvGetZ(store, "key1000"), NULL, "get missing key");
+
+        // Duplicate rebuilds the index
+        // -------------------------------------------------------------------------------------------------------------------------
+        KeyValue *storeDup = kvDup(store);
+
+        TEST_RESULT_UINT(storeDup->indexSize, 2048, "dup index size");
+        TEST_RESULT_UINT(varUInt64(kvGetZ(storeDup, "key777")), 777, "get dup key");
+        TEST_RESULT_INT(varInt(kvGet(storeDup, varNewDbl(0.0))), 8, "get dup double key");
+
+        TEST_RESULT_VOID(kvFree(storeDup), "free dup store");
+        TEST_RESULT_VOID(kvFree(store), "free store");
+    }
+
     FUNCTION_HARNESS_RESULT_VOID();
 }
@@ -31,6 +31,7 @@ testRun(void)
         TEST_RESULT_BOOL(strEmpty(string), false, "is not empty");
         TEST_RESULT_INT(strlen(strPtr(string)), 13, "check size with strlen()");
         TEST_RESULT_CHAR(strPtr(string)[2], 'a', "check character");
+        TEST_RESULT_BOOL(STRING_BUFFER_INLINE(string), true, "buffer is inline");
 
         TEST_RESULT_VOID(strFree(string), "free string");
 
@@ -80,7 +81,9 @@ testRun(void)
         String *string = strNew("XXXX");
         String *string2 = strNew("ZZZZ");
 
+        TEST_RESULT_BOOL(STRING_BUFFER_INLINE(string), true, "buffer is inline");
         TEST_RESULT_STR(strPtr(strCat(string, "YYYY")), "XXXXYYYY", "cat string");
+        TEST_RESULT_BOOL(STRING_BUFFER_INLINE(string), false, "    buffer moved out to grow");
         TEST_RESULT_SIZE(string->common.extra, 4, "check extra");
         TEST_RESULT_STR(strPtr(strCatFmt(string, "%05d", 777)), "XXXXYYYY00777", "cat formatted string");
         TEST_RESULT_SIZE(string->common.extra, 6, "check extra");
@@ -88,6 +91,7 @@ testRun(void)
         TEST_RESULT_SIZE(string->common.extra, 5, "check extra");
 
         TEST_RESULT_STR(strPtr(string2), "ZZZZ", "check unaltered string");
+        TEST_RESULT_VOID(strFree(string), "free string with separate buffer");
     }
 
     // *****************************************************************************************************************************
@@ -138,6 +142,53 @@ testRun(void)
         TEST_RESULT_INT(strCmpZ(strNew("b"), "a"), 1, "b > a");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("strIntern(), strInternN(), and strInternZ()"))
+    {
+        const String *interned = NULL;
+
+        TEST_ASSIGN(interned, strIntern(strNew("key")), "intern string");
+        TEST_RESULT_STR(strPtr(interned), "key", "    check string");
+        TEST_RESULT_BOOL(STRING_INTERNED(interned), true, "    string is interned");
+        TEST_RESULT_PTR(strInternZ("key"), interned, "    intern zero-terminated string returns same string");
+        TEST_RESULT_PTR(strInternN("keys", 3), interned, "    intern sized string returns same string");
+        TEST_RESULT_PTR(strIntern(interned), interned, "    intern interned string returns same string");
+
+        String *internedDup = NULL;
+        TEST_ASSIGN(internedDup, strDup(interned), "    duplicate interned string");
+        TEST_RESULT_BOOL(internedDup != interned, true, "    duplicate is a copy");
+        TEST_RESULT_BOOL(STRING_INTERNED(internedDup), false, "    duplicate is not interned");
+        TEST_RESULT_STR(strPtr(strCat(internedDup, "x")), "keyx", "    duplicate can be modified");
+
+        TEST_RESULT_VOID(strFree((String *)interned), "    free does nothing");
+        TEST_RESULT_STR(strPtr(interned), "key", "    string still valid");
+
+        TEST_ERROR(strCat((String *)interned, "x"), AssertError, "assertion '!STRING_INTERNED(this)' failed");
+
+        TEST_RESULT_BOOL(strEq(interned, strInternZ("kez")), false, "interned strings not equal");
+        TEST_RESULT_BOOL(strEq(interned, strNew("key")), true, "interned string equals string");
+        TEST_RESULT_BOOL(strEq(strNew("key"), interned), true, "string equals interned string");
+        TEST_RESULT_BOOL(strEq(interned, interned), true, "same string equal");
+
+        // Intern enough strings to grow the table and cause collisions
+        for (unsigned int stringIdx = 0; stringIdx < STRING_INTERN_TABLE_SIZE_MIN; stringIdx++)
+            strIntern(strNewFmt("key%u", stringIdx));
+
+        TEST_RESULT_UINT(strInternLocal.size, STRING_INTERN_TABLE_SIZE_MIN * 4, "table grown");
+        TEST_RESULT_UINT(strInternLocal.total, STRING_INTERN_TABLE_SIZE_MIN + 2, "check total");
+        TEST_RESULT_PTR(strInternZ("key"), interned, "    interned string is the same after grow");
+        TEST_RESULT_STR(strPtr(strInternZ("key33")), "key33", "    interned string found after grow");
+
+        // Freeing the intern context resets the table so it is recreated on next use
+        TEST_RESULT_VOID(memContextFree(strInternLocal.memContext), "free intern context");
+        TEST_RESULT_PTR(strInternLocal.memContext, NULL, "    context reset");
+        TEST_RESULT_PTR(strInternLocal.table, NULL, "    table reset");
+        TEST_RESULT_UINT(strInternLocal.total, 0, "    total reset");
+        TEST_RESULT_STR(strPtr(strInternZ("key")), "key", "intern after reset");
+        TEST_RESULT_UINT(strInternLocal.size, STRING_INTERN_TABLE_SIZE_MIN, "    table recreated");
+        TEST_RESULT_UINT(strInternLocal.total, 1, "    check total");
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("strFirstUpper(), strFirstLower(), strUpper(), strLower()"))
     {
@@ -190,6 +241,7 @@ testRun(void)
         TEST_RESULT_STR(strPtr(strTrim(strNew("end-only\t "))), "end-only", "trim end");
         TEST_RESULT_STR(strPtr(strTrim(strNew("\n\rboth\r\n"))), "both", "trim both");
         TEST_RESULT_STR(strPtr(strTrim(strNew("begin \r\n\tend"))), "begin \r\n\tend", "ignore whitespace in middle");
+        TEST_RESULT_STR(strPtr(strTrim(strCat(strNew(" "), "separate buffer "))), "separate buffer", "trim separate buffer");
     }
 
     // *****************************************************************************************************************************
@@ -200,6 +252,8 @@ testRun(void)
         TEST_RESULT_INT(strChr(strNew("abcd"), 'i'), -1, "i not found");
         TEST_RESULT_INT(strChr(strNew(""), 'x'), -1, "empty string - x not found");
 
+        TEST_RESULT_STR(strPtr(strTrunc(strNew("abcdef"), 3)), "abc", "inline string truncated");
+
         String *val = strNew("abcdef");
         TEST_ERROR(
             strTrunc(val, (int)(strSize(val) + 1)), AssertError,
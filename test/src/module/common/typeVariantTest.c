@@ -19,7 +19,7 @@ testRun(void)
         varFree(boolean);
 
         // -------------------------------------------------------------------------------------------------------------------------
-        TEST_ERROR(varBool(varNewStrZ("string")), AssertError, "assertion 'this->type == varTypeBool' failed");
+        TEST_ERROR(varBool(varNewStrZ("string")), AssertError, "assertion 'this->common.type == varTypeBool' failed");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_RESULT_BOOL(varBool(varNewBool(true)), true, "true bool variant");
@@ -44,6 +44,12 @@ testRun(void)
 
         TEST_RESULT_BOOL(varEq(varNewBool(true), varNewBool(true)), true, "bool, bool eq");
         TEST_RESULT_BOOL(varEq(varNewBool(false), varNewBool(true)), false, "bool, bool not eq");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_BOOL(varBool(BOOL_TRUE_VAR), true, "true bool constant");
+        TEST_RESULT_BOOL(varBool(BOOL_FALSE_VAR), false, "false bool constant");
+        TEST_RESULT_BOOL(varEq(VARBOOL(true), varNewBool(true)), true, "constant bool, bool eq");
+        TEST_RESULT_BOOL(varBool(varDup(VARBOOL(false))), false, "dup constant bool");
     }
 
     // *****************************************************************************************************************************
@@ -54,7 +60,7 @@ testRun(void)
         varFree(var);
 
         // -------------------------------------------------------------------------------------------------------------------------
-        TEST_ERROR(varDbl(varNewStrZ("string")), AssertError, "assertion 'this->type == varTypeDouble' failed");
+        TEST_ERROR(varDbl(varNewStrZ("string")), AssertError, "assertion 'this->common.type == varTypeDouble' failed");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_RESULT_DOUBLE(varDblForce(varNewDbl(4.567)), 4.567, "force double to double");
@@ -76,6 +82,10 @@ testRun(void)
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_RESULT_BOOL(varEq(varNewDbl(1.234), varNewDbl(1.234)), true, "double, double eq");
         TEST_RESULT_BOOL(varEq(varNewDbl(4.321), varNewDbl(1.234)), false, "double, double not eq");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_DOUBLE(varDbl(VARDBL(5.55)), 5.55, "constant double");
+        TEST_RESULT_DOUBLE(varDblForce(VARINT(7)), 7, "force constant int to double");
     }
 
     // *****************************************************************************************************************************
@@ -96,7 +106,7 @@ testRun(void)
         TEST_ERROR(varIntForce(varNewUInt64(2147483648)), FormatError, "unable to convert uint64 2147483648 to int");
 
         // -------------------------------------------------------------------------------------------------------------------------
-        TEST_ERROR(varInt(varNewStrZ("string")), AssertError, "assertion 'this->type == varTypeInt' failed");
+        TEST_ERROR(varInt(varNewStrZ("string")), AssertError, "assertion 'this->common.type == varTypeInt' failed");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_RESULT_INT(varInt(varDup(varNewInt(88976))), 88976, "dup int");
@@ -108,6 +118,10 @@ testRun(void)
 
         TEST_RESULT_BOOL(varEq(varNewInt(123), varNewInt(123)), true, "int, int eq");
         TEST_RESULT_BOOL(varEq(varNewInt(444), varNewInt(123)), false, "int, int not eq");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_INT(varInt(VARINT(-99)), -99, "constant int");
+        TEST_RESULT_BOOL(varEq(VARINT(123), varNewInt(123)), true, "constant int, int eq");
     }
 
     // *****************************************************************************************************************************
@@ -132,7 +146,7 @@ testRun(void)
             "unable to convert uint64 9223372036854775808 to int64");
 
         // -------------------------------------------------------------------------------------------------------------------------
-        TEST_ERROR(varInt64(varNewStrZ("string")), AssertError, "assertion 'this->type == varTypeInt64' failed");
+        TEST_ERROR(varInt64(varNewStrZ("string")), AssertError, "assertion 'this->common.type == varTypeInt64' failed");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_RESULT_INT(varInt64(varDup(varNewInt64(88976))), 88976, "dup int64");
@@ -143,6 +157,9 @@ testRun(void)
 
         TEST_RESULT_BOOL(varEq(varNewInt64(9223372036854775807L), varNewInt64(9223372036854775807L)), true, "int64, int64 eq");
         TEST_RESULT_BOOL(varEq(varNewInt64(444), varNewInt64(123)), false, "int64, int64 not eq");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_INT(varInt64(VARINT64(-9223372036854775807L)), -9223372036854775807L, "constant int64");
     }
 
     // *****************************************************************************************************************************
@@ -169,7 +186,7 @@ testRun(void)
         TEST_ERROR(varUInt64Force(varNewInt(-1)), FormatError, "unable to convert int -1 to uint64");
 
         // -------------------------------------------------------------------------------------------------------------------------
-        TEST_ERROR(varUInt64(varNewStrZ("string")), AssertError, "assertion 'this->type == varTypeUInt64' failed");
+        TEST_ERROR(varUInt64(varNewStrZ("string")), AssertError, "assertion 'this->common.type == varTypeUInt64' failed");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_RESULT_DOUBLE(varUInt64(varDup(varNewUInt64(88976))), 88976, "dup uint64");
@@ -180,12 +197,16 @@ testRun(void)
 
         TEST_RESULT_BOOL(varEq(varNewUInt64(9223372036854775807L), varNewUInt64(9223372036854775807L)), true, "uint64, uint64 eq");
         TEST_RESULT_BOOL(varEq(varNewUInt64(444), varNewUInt64(123)), false, "uint64, uint64 not eq");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_DOUBLE(varUInt64(VARUINT64(18446744073709551615U)), 18446744073709551615U, "constant uint64");
+        TEST_RESULT_DOUBLE(varUInt64(varDup(VARUINT64(77))), 77, "dup constant uint64");
     }
 
     // *****************************************************************************************************************************
     if (testBegin("keyValue"))
     {
-        TEST_ERROR(varKv(varNewInt(66)), AssertError, "assertion 'this->type == varTypeKeyValue' failed");
+        TEST_ERROR(varKv(varNewInt(66)), AssertError, "assertion 'this->common.type == varTypeKeyValue' failed");
 
         // -------------------------------------------------------------------------------------------------------------------------
         Variant *keyValue = NULL;
@@ -221,7 +242,7 @@ testRun(void)
         TEST_RESULT_PTR(varStr(NULL), NULL, "get null string variant");
 
         // -------------------------------------------------------------------------------------------------------------------------
-        TEST_ERROR(varStr(varNewBool(true)), AssertError, "assertion 'this->type == varTypeString' failed");
+        TEST_ERROR(varStr(varNewBool(true)), AssertError, "assertion 'this->common.type == varTypeString' failed");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_RESULT_INT(varIntForce(varNewStrZ("777")), 777, "int from string");
@@ -264,12 +285,23 @@ testRun(void)
         TEST_RESULT_PTR(varDup(NULL), NULL, "dup NULL");
         TEST_RESULT_BOOL(varEq(varNewStr(strNew("expect-equal")), varNewStr(strNew("expect-equal"))), true, "string, string eq");
         TEST_RESULT_BOOL(varEq(varNewStr(strNew("Y")), varNewStr(strNew("X"))), false, "string, string not eq");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_STR(strPtr(varStr(VARSTRDEF("const-str"))), "const-str", "constant string");
+        TEST_RESULT_STR(strPtr(varStr(VARSTR(strNew("str")))), "str", "constant variant from string");
+        TEST_RESULT_PTR(varStr(VARSTR(NULL)), NULL, "constant null string");
+        TEST_RESULT_BOOL(varEq(VARSTRDEF("expect-equal"), varNewStrZ("expect-equal")), true, "constant string, string eq");
+
+        Variant *stringDup = NULL;
+        TEST_ASSIGN(stringDup, varDup(VARSTRDEF("dup-const")), "dup constant string");
+        TEST_RESULT_STR(strPtr(varStr(stringDup)), "dup-const", "    check dup");
+        TEST_RESULT_VOID(varFree(stringDup), "    free dup");
     }
 
     // *****************************************************************************************************************************
     if (testBegin("VariantList"))
     {
-        TEST_ERROR(varVarLst(varNewInt(66)), AssertError, "assertion 'this->type == varTypeVariantList' failed");
+        TEST_ERROR(varVarLst(varNewInt(66)), AssertError, "assertion 'this->common.type == varTypeVariantList' failed");
 
         // -------------------------------------------------------------------------------------------------------------------------
         Variant *listVar = NULL;
@@ -1,6 +1,21 @@
 /***********************************************************************************************************************************
 Test Xml Types
 ***********************************************************************************************************************************/
+#include "common/io/bufferRead.h"
+#include "common/io/read.intern.h"
+
+/***********************************************************************************************************************************
+Test read function that always errors
+***********************************************************************************************************************************/
+static size_t
+testIoReadError(void *driver, Buffer *buffer, bool block)
+{
+    (void)driver;
+    (void)buffer;
+    (void)block;
+
+    THROW(FileReadError, "unable to read source");
+}
 
 /***********************************************************************************************************************************
 Test Run
@@ -85,6 +100,89 @@ testRun(void)
 
         TEST_RESULT_VOID(xmlDocumentFree(xmlDocument), "free xmldoc");
         TEST_RESULT_VOID(xmlDocumentFree(NULL), "free null xmldoc");
+
+        // Create a document
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ASSIGN(xmlDocument, xmlDocumentNew(strNew("Delete")), "new xmldoc");
+        TEST_RESULT_VOID(xmlNodeContentSet(xmlNodeAdd(xmlDocumentRoot(xmlDocument), strNew("Quiet")), strNew("true")), "add node");
+
+        XmlNode *nodeObject = NULL;
+        TEST_ASSIGN(nodeObject, xmlNodeAdd(xmlDocumentRoot(xmlDocument), strNew("Object")), "add node");
+        TEST_RESULT_VOID(xmlNodeContentSet(xmlNodeAdd(nodeObject, strNew("Key")), strNew("a<b>&c")), "add node with escapes");
+
+        TEST_RESULT_STR(
+            strPtr(strNewBuf(xmlDocumentBuf(xmlDocument))),
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            "<Delete><Quiet>true</Quiet><Object><Key>a&lt;b&gt;&amp;c</Key></Object></Delete>\n",
+            "render xmldoc");
+        TEST_RESULT_VOID(xmlDocumentFree(xmlDocument), "free xmldoc");
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("xmlReader*()"))
+    {
+        IoRead *read = ioBufferReadIo(ioBufferReadNew(bufNewZ(BOGUS_STR)));
+        ioReadOpen(read);
+
+        XmlReader *xmlReader = NULL;
+        TEST_ASSIGN(xmlReader, xmlReaderNew(read), "new reader on invalid xml");
+        TEST_ERROR(xmlReaderNext(xmlReader), FormatError, "invalid xml");
+        TEST_RESULT_VOID(xmlReaderFree(xmlReader), "free reader");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        read = ioReadNewP((void *)999, .read = testIoReadError);
+        ioReadOpen(read);
+
+        TEST_ASSIGN(xmlReader, xmlReaderNew(read), "new reader on source that errors");
+        TEST_ERROR(xmlReaderNext(xmlReader), FileReadError, "unable to read source");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        // Use a small buffer so the xml is read in multiple chunks
+        ioBufferSizeSet(16);
+
+        read = ioBufferReadIo(ioBufferReadNew(
+            bufNewZ(
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">\n"
+                "    <Prefix/>\n"
+                "    <!-- comment -->\n"
+                "    <Contents>\n"
+                "        <Key>test1.txt</Key>\n"
+                "        <ETag>&quot;fba9dede5f27731c9771645a39863328&quot;</ETag>\n"
+                "    </Contents>\n"
+                "</ListBucketResult>\n"
+                "\n")));
+        ioReadOpen(read);
+
+        TEST_ASSIGN(xmlReader, xmlReaderNew(read), "new reader");
+
+        TEST_RESULT_BOOL(xmlReaderNext(xmlReader), true, "next element");
+        TEST_RESULT_UINT(xmlReaderDepth(xmlReader), 0, "    check depth");
+        TEST_RESULT_BOOL(xmlReaderNameEq(xmlReader, strNew("ListBucketResult")), true, "    check name");
+
+        TEST_RESULT_BOOL(xmlReaderNext(xmlReader), true, "next element");
+        TEST_RESULT_UINT(xmlReaderDepth(xmlReader), 1, "    check depth");
+        TEST_RESULT_BOOL(xmlReaderNameEq(xmlReader, strNew("Prefix")), true, "    check name");
+        TEST_RESULT_STR(strPtr(xmlReaderContent(xmlReader)), "", "    check empty content");
+
+        TEST_RESULT_BOOL(xmlReaderNext(xmlReader), true, "next element");
+        TEST_RESULT_BOOL(xmlReaderNameEq(xmlReader, strNew("Prefix")), false, "    check name does not match");
+        TEST_RESULT_BOOL(xmlReaderNameEq(xmlReader, strNew("Contents")), true, "    check name");
+
+        TEST_RESULT_BOOL(xmlReaderNext(xmlReader), true, "next element");
+        TEST_RESULT_UINT(xmlReaderDepth(xmlReader), 2, "    check depth");
+        TEST_RESULT_BOOL(xmlReaderNameEq(xmlReader, strNew("Key")), true, "    check name");
+        TEST_RESULT_STR(strPtr(xmlReaderContent(xmlReader)), "test1.txt", "    check content");
+
+        TEST_RESULT_BOOL(xmlReaderNext(xmlReader), true, "next element");
+        TEST_RESULT_BOOL(xmlReaderNameEq(xmlReader, strNew("ETag")), true, "    check name");
+        TEST_RESULT_STR(strPtr(xmlReaderContent(xmlReader)), "\"fba9dede5f27731c9771645a39863328\"", "    check content");
+
+        TEST_RESULT_BOOL(xmlReaderNext(xmlReader), false, "no more elements");
+        TEST_RESULT_BOOL(ioReadEof(read), true, "    check source is at eof");
+
+        TEST_RESULT_VOID(xmlReaderFree(xmlReader), "free reader");
+        TEST_RESULT_VOID(xmlReaderFree(NULL), "free null reader");
     }
 
     FUNCTION_HARNESS_RESULT_VOID();
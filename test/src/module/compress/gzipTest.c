@@ -5,6 +5,34 @@ Test Gzip
 #include "common/io/bufferRead.h"
 #include "common/io/bufferWrite.h"
 #include "common/io/io.h"
+#include "common/io/read.intern.h"
+
+/***********************************************************************************************************************************
+Test read driver that returns an empty buffer before eof like file drivers do
+***********************************************************************************************************************************/
+static unsigned int testReadTotal = 0;
+
+static size_t
+testRead(void *driver, Buffer *buffer, bool block)
+{
+    (void)driver;
+    (void)block;
+
+    if (testReadTotal == 0)
+        bufCatC(buffer, (const unsigned char *)"A simple string", 0, 15);
+
+    testReadTotal++;
+
+    return testReadTotal == 1 ? 15 : 0;
+}
+
+static bool
+testReadEof(void *driver)
+{
+    (void)driver;
+
+    return testReadTotal > 1;
+}
 
 /***********************************************************************************************************************************
 Compress data
@@ -156,6 +184,19 @@ testRun(void)
             bufEq(decompressed, testDecompress(gzipDecompressNew(true), compressed, bufSize(compressed), 1024 * 256)), true,
             "zero data - decompress large in/small out buffer");
 
+        // Compress through a read filter where the driver returns an empty buffer at eof
+        // -------------------------------------------------------------------------------------------------------------------------
+        IoRead *read = ioReadNewP((void *)999, .eof = testReadEof, .read = testRead);
+        ioReadFilterGroupSet(read, ioFilterGroupAdd(ioFilterGroupNew(), gzipCompressFilter(gzipCompressNew(3, false))));
+        ioReadOpen(read);
+
+        Buffer *readBuffer = bufNew(1024);
+        TEST_RESULT_VOID(ioRead(read, readBuffer), "compress via read");
+        TEST_RESULT_BOOL(ioReadEof(read), true, "    check eof");
+        TEST_RESULT_BOOL(
+            bufEq(bufNewC(strlen(simpleData), simpleData), testDecompress(gzipDecompressNew(false), readBuffer, 1024, 1024)), true,
+            "    check decompressed data");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_RESULT_VOID(gzipCompressFree(NULL), "free null decompress object");
         TEST_RESULT_VOID(gzipDecompressFree(NULL), "free null decompress object");
@@ -0,0 +1,246 @@
+/***********************************************************************************************************************************
+Test Manifest Info Handler
+***********************************************************************************************************************************/
+#include "storage/helper.h"
+
+/***********************************************************************************************************************************
+Test Run
+***********************************************************************************************************************************/
+void
+testRun(void)
+{
+    // Initialize test variables
+    //--------------------------------------------------------------------------------------------------------------------------
+    String *content = NULL;
+    String *fileName = strNewFmt("%s/backup.manifest", testPath());
+    InfoManifest *manifest = NULL;
+    InfoManifestFile file = {0};
+
+    // *****************************************************************************************************************************
+    if (testBegin("infoManifestChecksumDecode()"))
+    {
+        unsigned char checksum[INFO_MANIFEST_CHECKSUM_SIZE];
+
+        TEST_RESULT_VOID(
+            infoManifestChecksumDecode(strNew("0123456789abcdef0123456789abcdef01234567"), strNew("file"), checksum), "decode");
+        TEST_RESULT_STR(
+            strPtr(bufHex(bufNewC(INFO_MANIFEST_CHECKSUM_SIZE, checksum))), "0123456789abcdef0123456789abcdef01234567",
+            "    check checksum");
+
+        TEST_ERROR(
+            infoManifestChecksumDecode(strNew("0123"), strNew("file"), checksum), FormatError,
+            "invalid checksum '0123' for file 'file'");
+        TEST_ERROR(
+            infoManifestChecksumDecode(strNew("!123456789abcdef0123456789abcdef01234567"), strNew("file"), checksum), FormatError,
+            "invalid checksum '!123456789abcdef0123456789abcdef01234567' for file 'file'");
+        TEST_ERROR(
+            infoManifestChecksumDecode(strNew("0A23456789abcdef0123456789abcdef01234567"), strNew("file"), checksum), FormatError,
+            "invalid checksum '0A23456789abcdef0123456789abcdef01234567' for file 'file'");
+        TEST_ERROR(
+            infoManifestChecksumDecode(strNew("0123456789abcdeg0123456789abcdef01234567"), strNew("file"), checksum), FormatError,
+            "invalid checksum '0123456789abcdeg0123456789abcdef01234567' for file 'file'");
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("infoManifestNew(), infoManifestFile*(), infoManifestFree()"))
+    {
+        content = strNew
+        (
+            "[backrest]\n"
+            "backrest-checksum=\"071cac0b84d335601ead4308c10f4606f83c943d\"\n"
+            "backrest-format=5\n"
+            "backrest-version=\"2.14\"\n"
+            "\n"
+            "[backup]\n"
+            "backup-label=\"20190818-084502F_20190820-084502I\"\n"
+            "\n"
+            "[target:file]\n"
+            "pg_data/PG_VERSION={\"checksum\":\"184473f470864e067ee3a22e64b47b0a1c356f29\",\"master\":true,\"size\":4,"
+                "\"timestamp\":1565282114}\n"
+            "pg_data/base/1/12000={\"checksum\":\"c2cfd41b2fcbd3e1a0ae5dd2c0ad3e6e94b29b44\",\"checksum-page\":false,"
+                "\"checksum-page-error\":[1,[3,5]],\"group\":\"group2\",\"mode\":\"0640\","
+                "\"reference\":\"20190818-084502F\",\"repo-size\":4096,\"size\":8192,\"timestamp\":1565282115,\"user\":false}\n"
+            "pg_data/base/1/12001={\"checksum-page\":true,\"group\":false,\"size\":0,\"timestamp\":1565282116,"
+                "\"user\":\"postgres\"}\n"
+            "pg_data/base/1/12002={\"checksum\":\"da39a3ee5e6b4b0d3255bfef95601890afd80709\",\"checksum-page\":false,"
+                "\"master\":false,\"reference\":\"20190818-084502F\",\"size\":0,\"timestamp\":1565282117}\n"
+            "pg_data/postgresql.conf={\"size\":21,\"timestamp\":1565282118}\n"
+            "pg_datafile={\"size\":1,\"timestamp\":1565282119}\n"
+            "\n"
+            "[target:file:default]\n"
+            "group=\"postgres\"\n"
+            "master=false\n"
+            "mode=\"0600\"\n"
+            "user=\"postgres\"\n"
+            "\n"
+            "[target:path]\n"
+            "pg_data={}\n"
+        );
+
+        TEST_RESULT_VOID(
+            storagePutNP(storageNewWriteNP(storageLocalWrite(), fileName), bufNewStr(content)), "put manifest");
+        TEST_ASSIGN(manifest, infoManifestNew(storageLocal(), fileName, cipherTypeNone, NULL), "load manifest");
+
+        TEST_RESULT_UINT(infoManifestFileTotal(manifest), 6, "    file total");
+        TEST_RESULT_BOOL(manifest->fileSorted, true, "    files are sorted");
+        TEST_RESULT_PTR(manifest->fileSort, NULL, "    no sort index");
+        TEST_RESULT_UINT(strLstSize(manifest->path.list), 3, "    paths are interned");
+        TEST_RESULT_UINT(strLstSize(manifest->user.list), 1, "    users are deduplicated");
+        TEST_RESULT_PTR(
+            iniGetDefault(infoManifestIni(manifest), strNew("target:file"), strNew("pg_data/PG_VERSION"), NULL), NULL,
+            "    files are not stored in the ini");
+        TEST_RESULT_STR(
+            strPtr(varStr(iniGet(infoManifestIni(manifest), strNew("backup"), strNew("backup-label")))),
+            "\"20190818-084502F_20190820-084502I\"", "    other sections are stored in the ini");
+
+        TEST_ASSIGN(file, infoManifestFile(manifest, 0), "get first file");
+        TEST_RESULT_STR(strPtr(file.name), "pg_data/PG_VERSION", "    name");
+        TEST_RESULT_STR(file.checksumSha1, "184473f470864e067ee3a22e64b47b0a1c356f29", "    checksum");
+        TEST_RESULT_BOOL(file.master, true, "    master");
+        TEST_RESULT_UINT(file.size, 4, "    size");
+        TEST_RESULT_UINT(file.sizeRepo, 4, "    repo size defaults to size");
+        TEST_RESULT_INT(file.timestamp, 1565282114, "    timestamp");
+        TEST_RESULT_INT(file.mode, 0600, "    mode from default");
+        TEST_RESULT_STR(strPtr(file.user), "postgres", "    user from default");
+        TEST_RESULT_STR(strPtr(file.group), "postgres", "    group from default");
+        TEST_RESULT_PTR(file.reference, NULL, "    no reference");
+        TEST_RESULT_BOOL(file.checksumPage, false, "    page checksums not verified");
+        TEST_RESULT_STR(strPtr(infoManifestFileToLog(&file)), "{name: pg_data/PG_VERSION, size: 4}", "    log format");
+
+        TEST_ASSIGN(file, infoManifestFileFind(manifest, strNew("pg_data/base/1/12000")), "find file");
+        TEST_RESULT_STR(strPtr(file.name), "pg_data/base/1/12000", "    name");
+        TEST_RESULT_STR(file.checksumSha1, "c2cfd41b2fcbd3e1a0ae5dd2c0ad3e6e94b29b44", "    checksum");
+        TEST_RESULT_BOOL(file.master, false, "    master from default");
+        TEST_RESULT_UINT(file.size, 8192, "    size");
+        TEST_RESULT_UINT(file.sizeRepo, 4096, "    repo size");
+        TEST_RESULT_INT(file.mode, 0640, "    mode");
+        TEST_RESULT_PTR(file.user, NULL, "    user not mapped");
+        TEST_RESULT_STR(strPtr(file.group), "group2", "    group");
+        TEST_RESULT_STR(strPtr(file.reference), "20190818-084502F", "    reference");
+        TEST_RESULT_BOOL(file.checksumPage, true, "    page checksums verified");
+        TEST_RESULT_BOOL(file.checksumPageError, true, "    page checksum errors");
+        TEST_RESULT_UINT(varLstSize(file.checksumPageErrorList), 2, "    page checksum error list");
+        TEST_RESULT_UINT(varUInt64(varLstGet(file.checksumPageErrorList, 0)), 1, "    page checksum error");
+        TEST_RESULT_UINT(
+            varLstSize(varVarLst(varLstGet(file.checksumPageErrorList, 1))), 2, "    page checksum error range");
+
+        TEST_ASSIGN(file, infoManifestFileFind(manifest, strNew("pg_data/base/1/12001")), "find file");
+        TEST_RESULT_STR(file.checksumSha1, "", "    no checksum");
+        TEST_RESULT_STR(strPtr(file.user), "postgres", "    user");
+        TEST_RESULT_PTR(file.group, NULL, "    group not mapped");
+        TEST_RESULT_BOOL(file.checksumPage, true, "    page checksums verified");
+        TEST_RESULT_BOOL(file.checksumPageError, false, "    no page checksum errors");
+
+        TEST_ASSIGN(file, infoManifestFileFind(manifest, strNew("pg_data/base/1/12002")), "find file");
+        TEST_RESULT_BOOL(file.checksumPageError, true, "    page checksum errors");
+        TEST_RESULT_PTR(file.checksumPageErrorList, NULL, "    no page checksum error list");
+        TEST_RESULT_STR(strPtr(file.reference), "20190818-084502F", "    reference");
+
+        TEST_ASSIGN(file, infoManifestFileFind(manifest, strNew("pg_datafile")), "find file");
+        TEST_RESULT_STR(strPtr(file.name), "pg_datafile", "    name without path");
+
+        TEST_RESULT_BOOL(infoManifestFileExists(manifest, strNew("pg_data/postgresql.conf")), true, "file exists");
+        TEST_RESULT_BOOL(infoManifestFileExists(manifest, strNew("pg_data/base/1")), false, "name is a path");
+        TEST_RESULT_BOOL(infoManifestFileExists(manifest, strNew("pg_data")), false, "name is shorter than path");
+        TEST_RESULT_BOOL(infoManifestFileExists(manifest, strNew("pg_data/zzz")), false, "name is after last file");
+        TEST_ERROR(
+            infoManifestFileFind(manifest, strNew("pg_data/bogus")), AssertError,
+            "unable to find 'pg_data/bogus' in manifest file list");
+
+        // Invalid files are not added
+        TEST_ERROR(
+            infoManifestFileAdd(manifest, strNew("pg_data/bogus"), strNew("1")), FormatError,
+            "invalid attributes for file 'pg_data/bogus'");
+        TEST_ERROR(
+            infoManifestFileAdd(manifest, strNew("pg_data/bogus"), strNew("{\"timestamp\":1}")), FormatError,
+            "missing 'size' for file 'pg_data/bogus'");
+        TEST_ERROR(
+            infoManifestFileAdd(manifest, strNew("pg_data/bogus"), strNew("{\"size\":\"1\",\"timestamp\":1}")), FormatError,
+            "invalid 'size' for file 'pg_data/bogus'");
+        TEST_ERROR(
+            infoManifestFileAdd(manifest, strNew("pg_data/bogus"), strNew("{\"size\":-1,\"timestamp\":1}")), FormatError,
+            "unable to convert int64 -1 to uint64");
+        TEST_ERROR(
+            infoManifestFileAdd(manifest, strNew("pg_data/bogus"), strNew("{\"size\":1}")), FormatError,
+            "missing 'timestamp' for file 'pg_data/bogus'");
+        TEST_ERROR(
+            infoManifestFileAdd(manifest, strNew("pg_data/bogus"), strNew("{\"repo-size\":true,\"size\":1,\"timestamp\":1}")),
+            FormatError, "invalid 'repo-size' for file 'pg_data/bogus'");
+        TEST_RESULT_UINT(infoManifestFileTotal(manifest), 6, "    file total unchanged");
+
+        TEST_RESULT_VOID(infoManifestFree(manifest), "free manifest");
+        TEST_RESULT_VOID(infoManifestFree(NULL), "    free NULL");
+
+        // Unsorted files with no default section and a primary that fails after files were loaded
+        //--------------------------------------------------------------------------------------------------------------------------
+        content = strNew
+        (
+            "[backrest]\n"
+            "backrest-checksum=\"a0904ffe29aae897a243c8c4fe08b734f7625cbf\"\n"
+            "backrest-format=5\n"
+            "backrest-version=\"2.14\"\n"
+            "\n"
+            "[target:file]\n"
+            "pg_data/b={\"size\":2,\"timestamp\":2}\n"
+            "pg_data/a={\"size\":1,\"timestamp\":1}\n"
+            "pg_data/c={\"size\":3,\"timestamp\":3}\n"
+        );
+
+        TEST_RESULT_VOID(
+            storagePutNP(storageNewWriteNP(storageLocalWrite(), strNewFmt("%s.copy", strPtr(fileName))), bufNewStr(content)),
+            "put manifest copy");
+        TEST_RESULT_VOID(
+            storagePutNP(
+                storageNewWriteNP(storageLocalWrite(), fileName),
+                bufNewStr(strNewFmt("%s%s", strPtr(content), "pg_data/d={\"size\":4,\"timestamp\":4}\n"))),
+            "put manifest with bad checksum");
+        TEST_ASSIGN(manifest, infoManifestNew(storageLocal(), fileName, cipherTypeNone, NULL), "load manifest");
+
+        TEST_RESULT_UINT(infoManifestFileTotal(manifest), 3, "    files from primary discarded");
+        TEST_RESULT_BOOL(manifest->fileSorted, false, "    files are not sorted");
+        TEST_RESULT_STR(strPtr(infoManifestFile(manifest, 0).name), "pg_data/a", "    first file in name order");
+        TEST_RESULT_STR(strPtr(infoManifestFile(manifest, 2).name), "pg_data/c", "    last file in name order");
+        TEST_RESULT_UINT(infoManifestFileFind(manifest, strNew("pg_data/b")).size, 2, "    find file");
+
+        file = infoManifestFileFind(manifest, strNew("pg_data/a"));
+        TEST_RESULT_INT(file.mode, 0, "    no default mode");
+        TEST_RESULT_PTR(file.user, NULL, "    no default user");
+        TEST_RESULT_PTR(file.group, NULL, "    no default group");
+        TEST_RESULT_BOOL(file.master, false, "    no default master");
+
+        storageRemoveNP(storageLocalWrite(), strNewFmt("%s.copy", strPtr(fileName)));
+
+        // Enough files to grow the columns and leaf pool
+        //--------------------------------------------------------------------------------------------------------------------------
+        content = strNew
+        (
+            "[backrest]\n"
+            "backrest-checksum=\"d07fc9585222fe4d926f3a10203cd56d277226eb\"\n"
+            "backrest-format=5\n"
+            "backrest-version=\"2.14\"\n"
+            "\n"
+            "[target:file]\n"
+        );
+
+        for (unsigned int fileIdx = 0; fileIdx < 100; fileIdx++)
+            strCatFmt(content, "pg_data/base/1/%05u_with_a_long_name={\"size\":%u,\"timestamp\":1}\n", fileIdx, fileIdx);
+
+        strCat(content, "\n[target:file:default]\ngroup=false\nmaster=true\nuser=false\n");
+
+        TEST_RESULT_VOID(
+            storagePutNP(storageNewWriteNP(storageLocalWrite(), fileName), bufNewStr(content)), "put manifest");
+        TEST_ASSIGN(manifest, infoManifestNew(storageLocal(), fileName, cipherTypeNone, NULL), "load manifest");
+
+        TEST_RESULT_UINT(infoManifestFileTotal(manifest), 100, "    file total");
+        TEST_RESULT_UINT(manifest->fileMax, 128, "    columns grown");
+        TEST_RESULT_UINT(manifest->leafPoolMax, 4096, "    leaf pool grown");
+        TEST_RESULT_UINT(
+            infoManifestFileFind(manifest, strNew("pg_data/base/1/00077_with_a_long_name")).size, 77, "    find file");
+
+        file = infoManifestFile(manifest, 99);
+        TEST_RESULT_STR(strPtr(file.name), "pg_data/base/1/00099_with_a_long_name", "    last file");
+        TEST_RESULT_PTR(file.user, NULL, "    default user not mapped");
+        TEST_RESULT_PTR(file.group, NULL, "    default group not mapped");
+        TEST_RESULT_BOOL(file.master, true, "    default master");
+    }
+}
@@ -2,6 +2,21 @@
 Test Info Handler
 ***********************************************************************************************************************************/
 
+/***********************************************************************************************************************************
+Test callback that counts load attempts and consumes the [db] section
+***********************************************************************************************************************************/
+static bool
+testInfoLoadCallback(void *data, const String *section, const String *key, const String *value)
+{
+    (void)key;
+    (void)value;
+
+    if (section == NULL)
+        (*(unsigned int *)data)++;
+
+    return section == NULL || !strEqZ(section, "db");
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -9,7 +24,7 @@ void
 testRun(void)
 {
     // *****************************************************************************************************************************
-    if (testBegin("infoNew(), infoExists(), infoFileName(), infoIni()"))
+    if (testBegin("infoNew(), infoNewLoad(), infoExists(), infoFileName(), infoIni()"))
     {
         // Initialize test variables
         //--------------------------------------------------------------------------------------------------------------------------
@@ -236,6 +251,47 @@ testRun(void)
 
         storageRemoveNP(storageLocalWrite(), fileNameCopy);
 
+        // Empty file
+        //--------------------------------------------------------------------------------------------------------------------------
+        storagePutNP(storageNewWriteNP(storageLocalWrite(), fileName), NULL);
+
+        TEST_ERROR(
+            infoNew(storageLocal(), fileName, cipherTypeNone, NULL), FormatError,
+            strPtr(
+                strNewFmt(
+                    "unable to load info file '%s/test.ini' or '%s/test.ini.copy':\n"
+                    "FormatError: section 'backrest', key 'backrest-checksum' does not exist\n"
+                    "FileMissingError: unable to open '%s/test.ini.copy' for read: [2] No such file or directory",
+                testPath(), testPath(), testPath())));
+
+        storageRemoveNP(storageLocalWrite(), fileName);
+
+        // Load with a callback
+        //--------------------------------------------------------------------------------------------------------------------------
+        content = strNew
+        (
+            "[backrest]\n"
+            "backrest-checksum=\"cfd036c90679e5a1504b61f09f0aa967facdfa39\"\n"
+            "backrest-format=5\n"
+            "backrest-version=\"2.04\"\n"
+            "\n"
+            "[db]\n"
+            "db-id=1\n"
+        );
+
+        storagePutNP(storageNewWriteNP(storageLocalWrite(), fileNameCopy), bufNewStr(content));
+        unsigned int loadTotal = 0;
+
+        TEST_ASSIGN(
+            info, infoNewLoad(storageLocal(), fileName, cipherTypeNone, NULL, testInfoLoadCallback, &loadTotal),
+            "infoNewLoad() - load copy file with callback");
+        TEST_RESULT_UINT(loadTotal, 2, "    callback notified before each attempt");
+        TEST_RESULT_PTR(iniGetDefault(infoIni(info), strNew("db"), strNew("db-id"), NULL), NULL, "    db section consumed");
+        TEST_RESULT_STR(
+            strPtr(varStr(iniGet(infoIni(info), strNew("backrest"), strNew("backrest-format")))), "5", "    backrest section stored");
+
+        storageRemoveNP(storageLocalWrite(), fileNameCopy);
+
         // infoFree()
         //--------------------------------------------------------------------------------------------------------------------------
         TEST_RESULT_VOID(infoFree(info), "infoFree() - free info memory context");
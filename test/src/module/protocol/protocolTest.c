@@ -39,6 +39,10 @@ testServerProtocol(const String *command, const VariantList *paramList, Protocol
         {
             protocolServerResponse(server, varNewBool(true));
         }
+        else if (strEq(command, strNew("request-param")))
+        {
+            protocolServerResponse(server, varNewVarLst(paramList));
+        }
         else if (strEq(command, strNew("request-complex")))
         {
             protocolServerResponse(server, varNewBool(false));
@@ -226,6 +230,11 @@ testRun(void)
                 ioWriteLine(write, strNew("{\"out\":[\"bogus\"]}"));
                 ioWriteFlush(write);
 
+                // Invalid response key
+                TEST_RESULT_STR(strPtr(ioReadLine(read)), "{\"cmd\":\"noop\"}", "noop with invalid response key");
+                ioWriteLine(write, strNew("{\"bogus\":1}"));
+                ioWriteFlush(write);
+
                 // Send output
                 TEST_RESULT_STR(strPtr(ioReadLine(read)), "{\"cmd\":\"test\"}", "test command");
                 ioWriteLine(write, strNew("{\"out\":[\"value1\",\"value2\"]}"));
@@ -284,6 +293,7 @@ testRun(void)
                 TEST_ERROR(protocolClientNoOp(client), AssertError, "raised from test client: sample error message");
                 TEST_ERROR(protocolClientNoOp(client), UnknownError, "raised from test client: no details available");
                 TEST_ERROR(protocolClientNoOp(client), AssertError, "no output required by command");
+                TEST_ERROR(protocolClientNoOp(client), ProtocolError, "invalid response key 'bogus'");
 
                 // Get command output
                 const VariantList *output = NULL;
@@ -332,11 +342,30 @@ testRun(void)
                 TEST_RESULT_VOID(ioWriteFlush(write), "flush bogus");
                 TEST_RESULT_STR(strPtr(ioReadLine(read)), "{\"err\":39,\"out\":\"invalid command 'bogus'\"}", "bogus error");
 
+                // Invalid command key
+                TEST_RESULT_VOID(ioWriteLine(write, strNew("{\"bogus\":1}")), "write bogus key");
+                TEST_RESULT_VOID(ioWriteFlush(write), "flush bogus key");
+                TEST_RESULT_STR(
+                    strPtr(ioReadLine(read)), "{\"err\":39,\"out\":\"invalid command key 'bogus'\"}", "bogus key error");
+
+                // Missing command
+                TEST_RESULT_VOID(ioWriteLine(write, strNew("{}")), "write missing command");
+                TEST_RESULT_VOID(ioWriteFlush(write), "flush missing command");
+                TEST_RESULT_STR(strPtr(ioReadLine(read)), "{\"err\":39,\"out\":\"command is missing\"}", "missing command error");
+
                 // Simple request
                 TEST_RESULT_VOID(ioWriteLine(write, strNew("{\"cmd\":\"request-simple\"}")), "write simple request");
                 TEST_RESULT_VOID(ioWriteFlush(write), "flush simple request");
                 TEST_RESULT_STR(strPtr(ioReadLine(read)), "{\"out\":true}", "simple request result");
 
+                // Request with parameters echoed back
+                TEST_RESULT_VOID(
+                    ioWriteLine(write, strNew("{\"cmd\":\"request-param\",\"param\":[\"a\\\"b\",1,{\"z\":true,\"k\":null}]}")),
+                    "write param request");
+                TEST_RESULT_VOID(ioWriteFlush(write), "flush param request");
+                TEST_RESULT_STR(
+                    strPtr(ioReadLine(read)), "{\"out\":[\"a\\\"b\",1,{\"k\":null,\"z\":true}]}", "param request result");
+
                 // Assert -- no response will come backup because the process loop will terminate
                 TEST_RESULT_VOID(ioWriteLine(write, strNew("{\"cmd\":\"assert\"}")), "write assert");
                 TEST_RESULT_VOID(ioWriteFlush(write), "flush simple request");
@@ -1,6 +1,7 @@
 /***********************************************************************************************************************************
 Test Posix Storage Driver
 ***********************************************************************************************************************************/
+#include "common/io/filter/size.h"
 #include "common/io/io.h"
 #include "common/time.h"
 #include "storage/fileRead.h"
@@ -25,6 +26,92 @@ storageTestPathExpression(const String *expression, const String *path)
     return result;
 }
 
+/***********************************************************************************************************************************
+Test function for drivers that list prefixes directly.  The prefixes are returned unsorted so the storage layer must sort them.
+***********************************************************************************************************************************/
+StringList *
+storageTestListPrefix(
+    void *driver, const String *path, bool errorOnMissing, const StringList *prefixList, const String *expression)
+{
+    (void)driver; (void)path; (void)errorOnMissing; (void)expression;
+
+    return strLstDup(prefixList);
+}
+
+/***********************************************************************************************************************************
+Test functions for drivers that run read filters where the file is stored.  The file is read by posix and the filter list is
+returned as the results so the storage layer must get the results from the driver.
+***********************************************************************************************************************************/
+static StringList *storageTestFilterList = NULL;
+
+const VariantList *
+storageTestFilterResult(const void *driver)
+{
+    (void)driver;
+
+    return varLstNewStrLst(storageTestFilterList);
+}
+
+StorageFileRead *
+storageTestNewReadFilter(
+    void *driver, const String *file, bool ignoreMissing, bool noCache, bool compressible, const StringList *filterList)
+{
+    StorageDriverPosixFileRead *fileRead = storageFileReadDriver(
+        storageDriverPosixNewRead(driver, file, ignoreMissing, noCache, compressible));
+    StorageFileRead *result = NULL;
+
+    MEM_CONTEXT_BEGIN(fileRead->memContext)
+    {
+        storageTestFilterList = strLstDup(filterList);
+
+        result = storageFileReadNewP(
+            strNew("test"), fileRead,
+            .ignoreMissing = (StorageFileReadInterfaceIgnoreMissing)storageDriverPosixFileReadIgnoreMissing,
+            .io = (StorageFileReadInterfaceIo)storageDriverPosixFileReadIo,
+            .name = (StorageFileReadInterfaceName)storageDriverPosixFileReadName,
+            .filterResult = storageTestFilterResult);
+    }
+    MEM_CONTEXT_END();
+
+    return result;
+}
+
+/***********************************************************************************************************************************
+Test callback for storageListInfo() that collects a description of each entry.  When remove is set entries are removed while the
+path is being read: sub is removed as soon as it is reported and the first vanish file reported removes both vanish files.
+***********************************************************************************************************************************/
+typedef struct TestListInfoData
+{
+    StringList *list;
+    const Storage *storage;
+    bool remove;
+} TestListInfoData;
+
+void
+storageTestListInfo(void *callbackData, const StorageInfo *info)
+{
+    TestListInfoData *data = callbackData;
+
+    if (data->remove)
+    {
+        if (strEqZ(info->name, "sub"))
+            storagePathRemoveP(data->storage, strNew("listinfo/sub"), .recurse = true);
+        else if (strBeginsWithZ(info->name, "vanish"))
+        {
+            storageRemoveNP(data->storage, strNew("listinfo/vanish1"));
+            storageRemoveNP(data->storage, strNew("listinfo/vanish2"));
+        }
+    }
+
+    if (info->type == storageTypeFile)
+    {
+        strLstAdd(
+            data->list, strNewFmt("%s:file:%zu:%" PRId64, strPtr(info->name), info->size, (int64_t)info->timeModified));
+    }
+    else
+        strLstAdd(data->list, strNewFmt("%s:%s", strPtr(info->name), info->type == storageTypePath ? "path" : "link"));
+}
+
 /***********************************************************************************************************************************
 Macro to create a path and file that cannot be accessed
 ***********************************************************************************************************************************/
@@ -151,6 +238,17 @@ testRun(void)
         TEST_RESULT_INT(system(strPtr(strNewFmt("touch %s", strPtr(fileExists)))), 0, "create exists file");
 
         TEST_RESULT_BOOL(storageExistsNP(storageTest, fileExists), true, "file exists");
+
+        StringList *pathList = strLstNew();
+        strLstAdd(pathList, fileExists);
+        strLstAddZ(pathList, "missing");
+
+        List *existsList = NULL;
+        TEST_ASSIGN(existsList, storageExistsListNP(storageTest, pathList), "exists list");
+        TEST_RESULT_UINT(lstSize(existsList), 2, "    check size");
+        TEST_RESULT_BOOL(*(bool *)lstGet(existsList, 0), true, "    check file exists");
+        TEST_RESULT_BOOL(*(bool *)lstGet(existsList, 1), false, "    check file does not exist");
+
         TEST_RESULT_INT(system(strPtr(strNewFmt("sudo rm %s", strPtr(fileExists)))), 0, "remove exists file");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -212,6 +310,20 @@ testRun(void)
         TEST_RESULT_INT(info.size, 8, "    check size");
         TEST_RESULT_INT(info.mode, 0640, "    check mode");
 
+        StringList *fileList = strLstNew();
+        strLstAdd(fileList, fileName);
+        strLstAddZ(fileList, "missing");
+
+        List *infoList = NULL;
+        TEST_ASSIGN(infoList, storageInfoListP(storageTest, fileList, .ignoreMissing = true), "info list");
+        TEST_RESULT_UINT(lstSize(infoList), 2, "    check size");
+        TEST_RESULT_INT(((StorageInfo *)lstGet(infoList, 0))->size, 8, "    check file size");
+        TEST_RESULT_BOOL(((StorageInfo *)lstGet(infoList, 1))->exists, false, "    check missing file");
+
+        TEST_ERROR_FMT(
+            storageInfoListNP(storageTest, fileList), FileOpenError,
+            "unable to get info for '%s/missing': [2] No such file or directory", testPath());
+
         storageRemoveP(storageTest, fileName, .errorOnMissing = true);
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -268,6 +380,150 @@ testRun(void)
             storagePutNP(storageNewWriteNP(storageTest, strNew("bbb.txt")), bufNewZ("bbb")), "write bbb.text");
         TEST_RESULT_STR(
             strPtr(strLstJoin(storageListP(storageTest, NULL, .expression = strNew("^bbb")), ", ")), "bbb.txt", "dir list");
+        TEST_RESULT_PTR(((StorageDriverPosix *)storageDriver(storageTest))->listRegExp, NULL, "    prefix only is not compiled");
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(storageListP(storageTest, NULL, .expression = strNew("^bbb")), ", ")), "bbb.txt",
+            "dir list with cached filter");
+
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(storageListP(storageTest, NULL, .expression = strNew("^aaa\\.txt$")), ", ")), "aaa.txt",
+            "dir list with prefix and expression");
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(storageListP(storageTest, NULL, .expression = strNew("b\\.txt$")), ", ")), "bbb.txt",
+            "dir list with expression and no prefix");
+
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_INT(
+            system(
+                strPtr(strNewFmt("mkdir %s/big && cd %s/big && seq -f 'file%%05g' 1 10000 | xargs touch .a ..a", testPath(), testPath()))),
+            0, "create path with more entries than fit in the read buffer");
+        TEST_RESULT_UINT(strLstSize(storageListNP(storageTest, strNew("big"))), 10002, "dir list");
+        TEST_RESULT_UINT(
+            strLstSize(storageListP(storageTest, strNew("big"), .expression = strNew("^file0999"))), 10, "dir list with prefix");
+        TEST_RESULT_INT(system(strPtr(strNewFmt("rm -rf %s/big", testPath()))), 0, "remove path");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        StringList *prefixList = strLstNew();
+        strLstAddZ(prefixList, "bbb");
+        strLstAddZ(prefixList, "ccc");
+        strLstAddZ(prefixList, "aaa");
+
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(storageListP(storageTest, NULL, .prefixList = prefixList), ", ")), "aaa.txt, bbb.txt",
+            "dir list with prefixes");
+        TEST_RESULT_PTR(
+            storageListP(storageTest, strNew(BOGUS_STR), .prefixList = prefixList), NULL, "ignore missing dir with prefixes");
+
+        storageTest->interface.listPrefix = storageTestListPrefix;
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(storageListP(storageTest, NULL, .prefixList = prefixList), ", ")), "aaa, bbb, ccc",
+            "driver list with prefixes");
+        storageTest->interface.listPrefix = NULL;
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TestListInfoData data = {.list = strLstNew()};
+
+        TEST_ERROR_FMT(
+            storageListInfoP(storageTest, strNew(BOGUS_STR), storageTestListInfo, &data, .errorOnMissing = true), PathOpenError,
+            "unable to open path '%s/BOGUS' for read: [2] No such file or directory", testPath());
+        TEST_RESULT_BOOL(
+            storageListInfoNP(storageTest, strNew(BOGUS_STR), storageTestListInfo, &data), false, "info for missing path");
+
+        TEST_ERROR_FMT(
+            storageListInfoNP(storageTest, pathNoPerm, storageTestListInfo, &data), PathOpenError,
+            "unable to open path '%s' for read: [13] Permission denied", strPtr(pathNoPerm));
+        TEST_ERROR_FMT(
+            storageListInfoP(storageTest, NULL, storageTestListInfo, &data, .recurse = true), PathOpenError,
+            "unable to open path '%s' for read: [13] Permission denied", strPtr(pathNoPerm));
+
+        TEST_RESULT_VOID(
+            storagePutNP(storageNewWriteNP(storageTest, strNew("listinfo/file")), bufNewZ("FILE")), "write file");
+        TEST_RESULT_VOID(
+            storagePutNP(storageNewWriteNP(storageTest, strNew("listinfo/sub/subfile")), bufNewZ("SUBFILE")), "write subfile");
+        TEST_RESULT_INT(
+            system(
+                strPtr(
+                    strNewFmt(
+                        "touch -d @1555160000 %s/listinfo/file %s/listinfo/sub/subfile && ln -s /tmp %s/listinfo/link &&"
+                            " mkfifo %s/listinfo/pipe",
+                        testPath(), testPath(), testPath(), testPath()))),
+            0, "set times, create link and pipe");
+
+        data.list = strLstNew();
+        TEST_RESULT_BOOL(
+            storageListInfoNP(storageTest, strNew("listinfo"), storageTestListInfo, &data), true, "info for path");
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(strLstSort(data.list, sortOrderAsc), ", ")), "file:file:4:1555160000, link:link, sub:path",
+            "    check info");
+
+        data.list = strLstNew();
+        TEST_RESULT_BOOL(
+            storageListInfoP(storageTest, strNew("listinfo"), storageTestListInfo, &data, .recurse = true), true,
+            "recursive info for path");
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(strLstSort(data.list, sortOrderAsc), ", ")),
+            "file:file:4:1555160000, link:link, sub/subfile:file:7:1555160000, sub:path", "    check info");
+
+        // Subpaths share the buffer with their parent so the parent must read its remaining entries again after each subpath
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_INT(
+            system(
+                strPtr(
+                    strNewFmt(
+                        "mkdir -p %s/listdeep/p1/p2 %s/listdeep/q1 %s/listdeep/r1/r2 && cd %s/listdeep &&"
+                            " touch f1 f2 f3 p1/f1 p1/f2 p1/p2/f1 q1/f1 && find . -type f -exec touch -d @1555160000 {} +",
+                        testPath(), testPath(), testPath(), testPath()))),
+            0, "create nested paths");
+
+        data.list = strLstNew();
+        TEST_RESULT_BOOL(
+            storageListInfoP(storageTest, strNew("listdeep"), storageTestListInfo, &data, .recurse = true), true,
+            "recursive info for nested paths");
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(strLstSort(data.list, sortOrderAsc), ", ")),
+            "f1:file:0:1555160000, f2:file:0:1555160000, f3:file:0:1555160000, p1/f1:file:0:1555160000, p1/f2:file:0:1555160000,"
+                " p1/p2/f1:file:0:1555160000, p1/p2:path, p1:path, q1/f1:file:0:1555160000, q1:path, r1/r2:path, r1:path",
+            "    check info");
+
+        storagePathRemoveP(storageTest, strNew("listdeep"), .recurse = true);
+
+        // Entries in a path that can be read but not searched cannot be stat'd
+        TEST_RESULT_INT(
+            system(
+                strPtr(
+                    strNewFmt(
+                        "sudo mkdir -m 700 %s/listinfo/noexec && sudo touch %s/listinfo/noexec/file &&"
+                            " sudo chmod 744 %s/listinfo/noexec",
+                        testPath(), testPath(), testPath()))),
+            0, "create path with no search permission");
+
+        TEST_ERROR_FMT(
+            storageListInfoNP(storageTest, strNew("listinfo/noexec"), storageTestListInfo, &data), FileOpenError,
+            "unable to get info for '%s/listinfo/noexec/file': [13] Permission denied", testPath());
+
+        TEST_RESULT_INT(
+            system(strPtr(strNewFmt("sudo rm -rf %s/listinfo/noexec", testPath()))), 0, "remove path with no search permission");
+
+        // Remove entries while the path is being read.  Entries already read from the directory are skipped when they no longer
+        // exist and removed paths are not recursed into.
+        TEST_RESULT_VOID(
+            storagePutNP(storageNewWriteNP(storageTest, strNew("listinfo/vanish1")), NULL), "write vanish1");
+        TEST_RESULT_VOID(
+            storagePutNP(storageNewWriteNP(storageTest, strNew("listinfo/vanish2")), NULL), "write vanish2");
+
+        data.list = strLstNew();
+        data.storage = storageTest;
+        data.remove = true;
+
+        TEST_RESULT_BOOL(
+            storageListInfoP(storageTest, strNew("listinfo"), storageTestListInfo, &data, .recurse = true), true,
+            "recursive info for path with removed entries");
+        TEST_RESULT_UINT(strLstSize(data.list), 4, "    check one vanish file skipped");
+        TEST_RESULT_BOOL(strLstExistsZ(data.list, "sub:path"), true, "    check sub reported");
+        TEST_RESULT_BOOL(strLstExistsZ(data.list, "sub/subfile:file:7:1555160000"), false, "    check sub not recursed");
+
+        storagePathRemoveP(storageTest, strNew("listinfo"), .recurse = true);
     }
 
     // *****************************************************************************************************************************
@@ -297,6 +553,133 @@ testRun(void)
         TEST_RESULT_BOOL(storageCopyNP(source, destination), true, "copy file");
         TEST_RESULT_BOOL(bufEq(expectedBuffer, storageGetNP(storageNewReadNP(storageTest, destinationFile))), true, "check file");
 
+        // Nothing is copied in the kernel from an empty file so the IO layer confirms it is empty
+        // -------------------------------------------------------------------------------------------------------------------------
+        String *emptyFile = strNewFmt("%s/empty.txt", testPath());
+        TEST_RESULT_VOID(storagePutNP(storageNewWriteNP(storageTest, emptyFile), NULL), "write empty file");
+
+        source = storageNewReadNP(storageTest, emptyFile);
+        destination = storageNewWriteNP(storageTest, destinationFile);
+
+        ioReadOpen(storageFileReadIo(source));
+        ioWriteOpen(storageFileWriteIo(destination));
+
+        TEST_RESULT_BOOL(storageFileWriteCopy(destination, source), false, "no kernel copy for empty file");
+
+        ioReadClose(storageFileReadIo(source));
+        ioWriteClose(storageFileWriteIo(destination));
+
+        source = storageNewReadNP(storageTest, emptyFile);
+        destination = storageNewWriteNP(storageTest, destinationFile);
+
+        TEST_RESULT_BOOL(storageCopyNP(source, destination), true, "copy empty file");
+        TEST_RESULT_UINT(bufUsed(storageGetNP(storageNewReadNP(storageTest, destinationFile))), 0, "check file");
+
+        storageRemoveP(storageTest, emptyFile, .errorOnMissing = true);
+
+        // Copy with a filter so the data must pass through the IO layer
+        // -------------------------------------------------------------------------------------------------------------------------
+        source = storageNewReadNP(storageTest, sourceFile);
+        destination = storageNewWriteNP(storageTest, destinationFile);
+        ioWriteFilterGroupSet(storageFileWriteIo(destination), ioFilterGroupAdd(ioFilterGroupNew(), ioSizeFilter(ioSizeNew())));
+
+        TEST_RESULT_BOOL(storageCopyNP(source, destination), true, "copy file with filter");
+        TEST_RESULT_UINT(
+            varUInt64(ioFilterGroupResult(ioWriteFilterGroup(storageFileWriteIo(destination)), SIZE_FILTER_TYPE_STR)), 9,
+            "    check size");
+        TEST_RESULT_BOOL(bufEq(expectedBuffer, storageGetNP(storageNewReadNP(storageTest, destinationFile))), true, "check file");
+
+        // Copy with sendfile() when copy_file_range() is not available
+        // -------------------------------------------------------------------------------------------------------------------------
+        storageDriverPosixFileWriteLocal.copyRangeUnsupported = true;
+
+        source = storageNewReadNP(storageTest, sourceFile);
+        destination = storageNewWriteNP(storageTest, destinationFile);
+
+        TEST_RESULT_BOOL(storageCopyNP(source, destination), true, "copy file with sendfile()");
+        TEST_RESULT_BOOL(bufEq(expectedBuffer, storageGetNP(storageNewReadNP(storageTest, destinationFile))), true, "check file");
+
+        storageDriverPosixFileWriteLocal.copyRangeUnsupported = false;
+
+        // Files that the kernel cannot copy are copied through the IO layer
+        // -------------------------------------------------------------------------------------------------------------------------
+        source = storageNewReadNP(
+            storageDriverPosixInterface(
+                storageDriverPosixNew(strNew("/"), STORAGE_MODE_FILE_DEFAULT, STORAGE_MODE_PATH_DEFAULT, false, NULL)),
+            strNew("/proc/self/status"));
+        destination = storageNewWriteNP(storageTest, destinationFile);
+
+        TEST_RESULT_BOOL(storageCopyNP(source, destination), true, "copy proc file");
+        TEST_RESULT_BOOL(
+            strBeginsWithZ(strNewBuf(storageGetNP(storageNewReadNP(storageTest, destinationFile))), "Name:"), true, "check file");
+
+        // Files that neither copy_file_range() nor sendfile() support are left for the IO layer to copy
+        // -------------------------------------------------------------------------------------------------------------------------
+        source = storageNewReadNP(storageTest, sourceFile);
+        destination = storageNewWriteNP(storageTest, destinationFile);
+
+        ioReadOpen(storageFileReadIo(source));
+        ioWriteOpen(storageFileWriteIo(destination));
+
+        // Replace the source handle with a pipe, which neither call can copy from
+        int pipeHandle[2];
+        THROW_ON_SYS_ERROR(pipe(pipeHandle) == -1, KernelError, "unable to create pipe");
+        THROW_ON_SYS_ERROR(
+            dup2(pipeHandle[0], storageDriverPosixFileReadHandle((StorageDriverPosixFileRead *)source->driver)) == -1,
+            FileOpenError, "unable to dup handle");
+
+        TEST_RESULT_BOOL(storageFileWriteCopy(destination, source), false, "copy_file_range() and sendfile() cannot copy");
+        TEST_RESULT_BOOL(storageDriverPosixFileWriteLocal.copyRangeUnsupported, false, "    copy_file_range() is supported");
+
+        close(pipeHandle[0]);
+        close(pipeHandle[1]);
+        ioReadClose(storageFileReadIo(source));
+
+        // Other kernel copy errors are reported
+        // -------------------------------------------------------------------------------------------------------------------------
+        source = storageNewReadNP(storageTest, sourceFile);
+        destination = storageNewWriteNP(storageTest, destinationFile);
+
+        ioReadOpen(storageFileReadIo(source));
+        ioWriteOpen(storageFileWriteIo(destination));
+
+        // Replace the destination handle with a handle that cannot be written
+        THROW_ON_SYS_ERROR(
+            dup2(open(strPtr(sourceFile), O_RDONLY), ((StorageDriverPosixFileWrite *)destination->driver)->handle) == -1,
+            FileOpenError, "unable to dup handle");
+
+        TEST_ERROR_FMT(
+            storageFileWriteCopy(destination, source), FileWriteError, "unable to copy to '%s': [9] Bad file descriptor",
+            strPtr(destinationFile));
+
+        storageDriverPosixFileWriteLocal.copyRangeUnsupported = true;
+        TEST_ERROR_FMT(
+            storageFileWriteCopy(destination, source), FileWriteError, "unable to copy to '%s': [9] Bad file descriptor",
+            strPtr(destinationFile));
+        storageDriverPosixFileWriteLocal.copyRangeUnsupported = false;
+
+        ioReadClose(storageFileReadIo(source));
+
+        // Kernel copy is not used for drivers that do not support it
+        // -------------------------------------------------------------------------------------------------------------------------
+        StorageFileWrite *destinationNoCopy = storageNewWriteNP(storageTest, destinationFile);
+        destinationNoCopy->interface.copy = NULL;
+
+        TEST_RESULT_BOOL(storageFileWriteCopy(destinationNoCopy, source), false, "no kernel copy without interface");
+
+        destinationNoCopy = storageNewWriteNP(storageTest, destinationFile);
+        destinationNoCopy->type = strNew("bogus");
+
+        TEST_RESULT_BOOL(storageFileWriteCopy(destinationNoCopy, source), false, "no kernel copy between types");
+
+        source = storageNewReadNP(storageTest, sourceFile);
+        ioReadFilterGroupSet(storageFileReadIo(source), ioFilterGroupAdd(ioFilterGroupNew(), ioSizeFilter(ioSizeNew())));
+        ioReadOpen(storageFileReadIo(source));
+
+        TEST_RESULT_BOOL(storageFileWriteCopy(destination, source), false, "no kernel copy with read filter");
+
+        ioReadClose(storageFileReadIo(source));
+
         storageRemoveP(storageTest, sourceFile, .errorOnMissing = true);
         storageRemoveP(storageTest, destinationFile, .errorOnMissing = true);
     }
@@ -554,6 +937,42 @@ testRun(void)
         IoFilterGroup *filterGroup = ioFilterGroupNew();
         TEST_ASSIGN(file, storageNewReadP(storageTest, fileName, .filterGroup = filterGroup), "new read file with filters");
         TEST_RESULT_PTR(ioReadFilterGroup(storageFileReadIo(file)), filterGroup, "    check filter group is set");
+
+        // Filters are run as the file is read since posix cannot run them anywhere else
+        // -------------------------------------------------------------------------------------------------------------------------
+        storagePutNP(storageNewWriteNP(storageTest, fileName), bufNewZ("TESTDATA"));
+
+        StringList *filterList = strLstNew();
+        strLstAddZ(filterList, "hash:sha1");
+        strLstAddZ(filterList, "size");
+
+        TEST_ASSIGN(file, storageNewReadP(storageTest, fileName, .filterList = filterList), "new read file with filter list");
+        TEST_RESULT_STR(strPtr(strNewBuf(storageGetNP(file))), "TESTDATA", "    get file");
+
+        const VariantList *filterResult = storageFileReadFilterResult(file);
+        TEST_RESULT_STR(strPtr(varStr(varLstGet(filterResult, 0))), "bbbcf2c59433f68f22376cd2439d6cd309378df6", "    check hash");
+        TEST_RESULT_UINT(varUInt64Force(varLstGet(filterResult, 1)), 8, "    check size");
+        TEST_RESULT_PTR(storageFileReadFilterResult(file), filterResult, "    results are cached");
+
+        TEST_ASSIGN(file, storageNewReadNP(storageTest, fileName), "new read file without filter list");
+        TEST_RESULT_PTR(storageFileReadFilterResult(file), NULL, "    no filter results");
+
+        TEST_ERROR(
+            storageNewReadP(storageTest, fileName, .filterList = strLstAddZ(strLstNew(), "hash")), AssertError,
+            "invalid filter 'hash'");
+        TEST_ERROR(
+            storageNewReadP(storageTest, fileName, .filterList = strLstAddZ(strLstNew(), "size:bogus")), AssertError,
+            "invalid filter 'size:bogus'");
+
+        // Drivers that can run filters where the file is stored return the results
+        storageTest->interface.newReadFilter = storageTestNewReadFilter;
+
+        TEST_ASSIGN(file, storageNewReadP(storageTest, fileName, .filterList = filterList), "new read file with driver filters");
+        TEST_RESULT_STR(strPtr(strNewBuf(storageGetNP(file))), "TESTDATA", "    get file");
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(strLstNewVarLst(storageFileReadFilterResult(file)), ", ")), "hash:sha1, size", "    check results");
+
+        storageTest->interface.newReadFilter = NULL;
     }
 
     // *****************************************************************************************************************************
@@ -610,6 +1029,60 @@ testRun(void)
         TEST_RESULT_VOID(ioWriteOpen(storageFileWriteIo(file)), "    open file");
         TEST_RESULT_VOID(ioWriteClose(storageFileWriteIo(file)), "   close file");
         TEST_RESULT_PTR(ioWriteFilterGroup(storageFileWriteIo(file)), filterGroup, "    check filter group is set");
+
+        // Write and read a file without caching.  Use a large buffer so the file is written back and dropped in multiple ranges.
+        // -------------------------------------------------------------------------------------------------------------------------
+        ioBufferSizeSet((size_t)STORAGE_DRIVER_POSIX_CACHE_DROP_SIZE);
+
+        Buffer *buffer = bufNew((size_t)STORAGE_DRIVER_POSIX_CACHE_DROP_SIZE);
+        memset(bufPtr(buffer), 'X', bufSize(buffer));
+        bufUsedSet(buffer, bufSize(buffer));
+
+        fileName = strNewFmt("%s/sub2/nocache", testPath());
+
+        TEST_ASSIGN(file, storageNewWriteP(storageTest, fileName, .noCache = true, .noSyncFile = true), "new write file (no cache)");
+        TEST_RESULT_VOID(ioWriteOpen(storageFileWriteIo(file)), "    open file");
+        TEST_RESULT_VOID(ioWrite(storageFileWriteIo(file), buffer), "    write data");
+        TEST_RESULT_VOID(ioWrite(storageFileWriteIo(file), buffer), "    write data");
+        TEST_RESULT_VOID(ioWrite(storageFileWriteIo(file), buffer), "    write data");
+        TEST_RESULT_VOID(ioWriteClose(storageFileWriteIo(file)), "    close file");
+
+        StorageDriverPosixFileWrite *fileDriver = (StorageDriverPosixFileWrite *)storageFileWriteFileDriver(file);
+        TEST_RESULT_UINT(fileDriver->writebackBegin, STORAGE_DRIVER_POSIX_CACHE_DROP_SIZE * 2, "    check writeback begin");
+        TEST_RESULT_UINT(fileDriver->writebackEnd, STORAGE_DRIVER_POSIX_CACHE_DROP_SIZE * 3, "    check writeback end");
+
+        TEST_ASSIGN(file, storageNewWriteP(storageTest, fileName, .noSyncFile = true), "new write file (no cache or sync)");
+        TEST_RESULT_VOID(ioWriteOpen(storageFileWriteIo(file)), "    open file");
+        TEST_RESULT_VOID(ioWrite(storageFileWriteIo(file), buffer), "    write data");
+        TEST_RESULT_VOID(ioWriteClose(storageFileWriteIo(file)), "    close file");
+        TEST_RESULT_UINT(
+            ((StorageDriverPosixFileWrite *)storageFileWriteFileDriver(file))->writebackEnd, 0, "    check no writeback");
+
+        TEST_ASSIGN(file, storageNewWriteNP(storageTest, fileName), "new write file (sync)");
+        TEST_RESULT_VOID(ioWriteOpen(storageFileWriteIo(file)), "    open file");
+        TEST_RESULT_VOID(ioWrite(storageFileWriteIo(file), buffer), "    write data");
+        TEST_RESULT_VOID(ioWrite(storageFileWriteIo(file), buffer), "    write data");
+        TEST_RESULT_VOID(ioWriteClose(storageFileWriteIo(file)), "    close file");
+        TEST_RESULT_UINT(
+            ((StorageDriverPosixFileWrite *)storageFileWriteFileDriver(file))->writebackEnd, STORAGE_DRIVER_POSIX_CACHE_DROP_SIZE * 2,
+            "    check writeback");
+
+        StorageFileRead *fileRead = storageNewReadP(storageTest, fileName, .noCache = true);
+        TEST_RESULT_BOOL(ioReadOpen(storageFileReadIo(fileRead)), true, "    open file (no cache)");
+
+        do
+        {
+            bufUsedZero(buffer);
+            ioRead(storageFileReadIo(fileRead), buffer);
+        }
+        while (!ioReadEof(storageFileReadIo(fileRead)));
+
+        TEST_RESULT_UINT(
+            ((StorageDriverPosixFileRead *)storageFileReadDriver(fileRead))->cacheDropSize, STORAGE_DRIVER_POSIX_CACHE_DROP_SIZE * 2,
+            "    check cache drop");
+        TEST_RESULT_VOID(ioReadClose(storageFileReadIo(fileRead)), "    close file");
+
+        ioBufferSizeSet(2);
     }
 
     // *****************************************************************************************************************************
@@ -917,6 +1390,469 @@ testRun(void)
         storageRemoveP(storageTest, fileName, .errorOnMissing = true);
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("storageDriverPosixUring*()"))
+    {
+        ioBufferSizeSet(4);
+
+        StorageDriverPosix *driver = storageDriverPosixNew(
+            strNew(testPath()), STORAGE_MODE_FILE_DEFAULT, STORAGE_MODE_PATH_DEFAULT, true, NULL);
+        Storage *storage = storageDriverPosixInterface(driver);
+
+        TEST_RESULT_UINT(storageDriverPosixUring(driver), 0, "io_uring disabled by default");
+        TEST_RESULT_VOID(storageDriverPosixUringSet(driver, 2), "enable io_uring");
+        TEST_RESULT_UINT(storageDriverPosixUring(driver), 2, "    check depth");
+
+        // Files that end in the middle of a slot, at the end of a slot, are too small to fill the queue, and are empty.  The first
+        // file starts out too small so io_uring is used only after the first write.
+        // -------------------------------------------------------------------------------------------------------------------------
+        String *fileName = strNewFmt("%s/uring.txt", testPath());
+        StorageFileWrite *fileWrite = NULL;
+        StorageFileRead *fileRead = NULL;
+        const char *contentList[][2] = {{"0123456", "789ABCDEFGHIJK"}, {"0123456789ABCDEF", ""}, {"0123", "456"}, {"", ""}};
+
+        for (unsigned int contentIdx = 0; contentIdx < sizeof(contentList) / sizeof(contentList[0]); contentIdx++)
+        {
+            Buffer *content = bufNewZ(contentList[contentIdx][0]);
+            bufCat(content, bufNewZ(contentList[contentIdx][1]));
+
+            TEST_ASSIGN(fileWrite, storageNewWriteNP(storage, fileName), "new write file");
+            TEST_RESULT_VOID(ioWriteOpen(storageFileWriteIo(fileWrite)), "    open file");
+            TEST_RESULT_VOID(
+                storageDriverPosixFileWrite(storageFileWriteFileDriver(fileWrite), bufNewZ(contentList[contentIdx][0])),
+                "    write file");
+            TEST_RESULT_VOID(
+                storageDriverPosixFileWrite(storageFileWriteFileDriver(fileWrite), bufNewZ(contentList[contentIdx][1])),
+                "    write more");
+            TEST_RESULT_BOOL(
+                ((StorageDriverPosixFileWrite *)storageFileWriteFileDriver(fileWrite))->uring != NULL, bufUsed(content) >= 8,
+                "    io_uring used when the file fills the queue");
+            TEST_RESULT_VOID(ioWriteClose(storageFileWriteIo(fileWrite)), "    close file");
+
+            Buffer *buffer = bufNew(64);
+
+            TEST_ASSIGN(fileRead, storageNewReadNP(storage, fileName), "new read file");
+            TEST_RESULT_BOOL(ioReadOpen(storageFileReadIo(fileRead)), true, "    open file");
+            TEST_RESULT_SIZE(
+                storageDriverPosixFileRead(storageFileReadDriver(fileRead), buffer, true), bufUsed(content), "    read file");
+            TEST_RESULT_BOOL(bufEq(buffer, content), true, "    check contents");
+            TEST_RESULT_BOOL(
+                ((StorageDriverPosixFileRead *)storageFileReadDriver(fileRead))->uring != NULL, bufUsed(content) >= 8,
+                "    io_uring used when the file fills the queue");
+            TEST_RESULT_VOID(ioReadClose(storageFileReadIo(fileRead)), "    close file");
+        }
+
+        // Read with a buffer smaller than a slot
+        // -------------------------------------------------------------------------------------------------------------------------
+        Buffer *buffer = bufNew(3);
+
+        storagePutNP(storageNewWriteNP(storage, fileName), bufNewZ("0123456789ABCDEFGHIJK"));
+
+        TEST_ASSIGN(fileRead, storageNewReadNP(storage, fileName), "new read file");
+        TEST_RESULT_BOOL(ioReadOpen(storageFileReadIo(fileRead)), true, "    open file");
+        TEST_RESULT_SIZE(storageDriverPosixFileRead(storageFileReadDriver(fileRead), buffer, true), 3, "    read 3 bytes");
+        TEST_RESULT_STR(strPtr(strNewBuf(buffer)), "012", "    check buffer");
+        TEST_RESULT_BOOL(((StorageDriverPosixFileRead *)storageFileReadDriver(fileRead))->uring != NULL, true, "    io_uring used");
+
+        bufUsedZero(buffer);
+
+        TEST_RESULT_SIZE(storageDriverPosixFileRead(storageFileReadDriver(fileRead), buffer, true), 3, "    read 3 bytes");
+        TEST_RESULT_STR(strPtr(strNewBuf(buffer)), "345", "    check buffer across slots");
+        TEST_RESULT_VOID(ioReadClose(storageFileReadIo(fileRead)), "    close before eof");
+
+        // Short reads before EOF are continued rather than ending the file.  Wait for the queued reads to complete before appending
+        // so the slot being consumed holds a short read and the next slot holds an empty read.
+        // -------------------------------------------------------------------------------------------------------------------------
+        buffer = bufNew(8);
+
+        storagePutNP(storageNewWriteNP(storage, fileName), bufNewZ("0123456789"));
+
+        TEST_ASSIGN(fileRead, storageNewReadNP(storage, fileName), "new read file");
+        TEST_RESULT_BOOL(ioReadOpen(storageFileReadIo(fileRead)), true, "    open file");
+        TEST_RESULT_SIZE(storageDriverPosixFileRead(storageFileReadDriver(fileRead), buffer, true), 8, "    read 8 bytes");
+        TEST_RESULT_STR(strPtr(strNewBuf(buffer)), "01234567", "    check buffer");
+
+        StorageDriverPosixUring *uring = ((StorageDriverPosixFileRead *)storageFileReadDriver(fileRead))->uring;
+
+        TEST_RESULT_INT(storageDriverPosixUringWait(uring, 0), 2, "    short read queued");
+        TEST_RESULT_INT(storageDriverPosixUringWait(uring, 1), 0, "    empty read queued");
+
+        int handleAppend = open(strPtr(fileName), O_WRONLY | O_APPEND);
+        TEST_RESULT_INT(write(handleAppend, "ABCDEF", 6), 6, "    append to file");
+        close(handleAppend);
+
+        bufUsedZero(buffer);
+
+        TEST_RESULT_SIZE(storageDriverPosixFileRead(storageFileReadDriver(fileRead), buffer, true), 4, "    read 4 bytes");
+        TEST_RESULT_STR(strPtr(strNewBuf(buffer)), "89AB", "    check buffer continues short read");
+        TEST_RESULT_BOOL(((StorageDriverPosixFileRead *)storageFileReadDriver(fileRead))->eof, true, "    eof on empty read");
+        TEST_RESULT_VOID(ioReadClose(storageFileReadIo(fileRead)), "    close file");
+
+        // Read error
+        // -------------------------------------------------------------------------------------------------------------------------
+        storagePathCreateNP(storage, strNew("uring.path"));
+
+        TEST_ASSIGN(fileRead, storageNewReadNP(storage, strNew("uring.path")), "new read path");
+        TEST_ERROR_FMT(
+            storageGetNP(fileRead), FileReadError, "unable to read '%s/uring.path': [21] Is a directory", testPath());
+
+        // Write errors
+        // -------------------------------------------------------------------------------------------------------------------------
+        int handleReadOnly = open(strPtr(fileName), O_RDONLY);
+
+        TEST_ASSIGN(fileWrite, storageNewWriteP(storage, fileName, .noAtomic = true), "new write file");
+        TEST_RESULT_VOID(ioWriteOpen(storageFileWriteIo(fileWrite)), "    open file");
+        dup2(handleReadOnly, ((StorageDriverPosixFileWrite *)storageFileWriteFileDriver(fileWrite))->handle);
+
+        TEST_RESULT_VOID(
+            storageDriverPosixFileWrite(storageFileWriteFileDriver(fileWrite), bufNewZ("01234567")), "    write file");
+        TEST_ERROR_FMT(
+            ioWriteClose(storageFileWriteIo(fileWrite)), FileWriteError, "unable to write '%s': [9] Bad file descriptor",
+            strPtr(fileName));
+        TEST_RESULT_VOID(storageFileWriteFree(fileWrite), "    free file");
+
+        // Short writes are reported as out of space.  A short read stands in for a short write since it is hard to cause one.
+        TEST_ASSIGN(fileWrite, storageNewWriteP(storage, strNew("uring.short"), .noAtomic = true), "new write file");
+        TEST_RESULT_VOID(ioWriteOpen(storageFileWriteIo(fileWrite)), "    open file");
+        TEST_RESULT_VOID(
+            storageDriverPosixFileWrite(storageFileWriteFileDriver(fileWrite), bufNewZ("01234567")), "    write file");
+
+        uring = ((StorageDriverPosixFileWrite *)storageFileWriteFileDriver(fileWrite))->uring;
+
+        TEST_RESULT_INT(storageDriverPosixUringWait(uring, 0), 4, "    wait for first slot");
+        TEST_RESULT_INT(storageDriverPosixUringWait(uring, 1), 4, "    wait for second slot");
+
+        storageDriverPosixUringRead(uring, 1, handleReadOnly, 0, 4);
+
+        TEST_ERROR_FMT(
+            storageDriverPosixFileWriteUringWait(storageFileWriteFileDriver(fileWrite), 1, 4), FileWriteError,
+            "unable to write '%s/uring.short': [28] No space left on device", testPath());
+        TEST_RESULT_INT(storageDriverPosixUringWait(uring, 1), 0, "    result is kept after completion");
+
+        storageDriverPosixUringRead(uring, 1, handleReadOnly, 0, 4);
+
+        TEST_RESULT_INT(storageDriverPosixUringWait(uring, 0), 4, "    submit without waiting on completed slot");
+        TEST_RESULT_INT(storageDriverPosixUringWait(uring, 1), 0, "    wait for submitted request");
+        TEST_RESULT_VOID(ioWriteClose(storageFileWriteIo(fileWrite)), "    close file");
+        TEST_RESULT_STR(
+            strPtr(strNewBuf(storageGetNP(storageNewReadNP(storage, strNew("uring.short"))))), "01234567", "    check contents");
+
+        close(handleReadOnly);
+
+        // Fall back to regular system calls when io_uring cannot be initialized (too many entries)
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_RESULT_PTR(storageDriverPosixUringNew(65536, 4), NULL, "io_uring setup fails");
+
+        // Buffers larger than the kernel allows cannot be registered
+        TEST_RESULT_PTR(storageDriverPosixUringNew(1, (size_t)1024 * 1024 * 1024 + 1), NULL, "io_uring register fails");
+
+        // A failure disables io_uring for the driver so setup is not attempted again for each file
+        // -------------------------------------------------------------------------------------------------------------------------
+        ioBufferSizeSet(2);
+        storageDriverPosixUringSet(driver, 65536);
+
+        buffer = bufNew(65536 * 2);
+        memset(bufPtr(buffer), 'X', bufSize(buffer));
+        bufUsedSet(buffer, bufSize(buffer));
+
+        TEST_ASSIGN(fileWrite, storageNewWriteNP(storage, strNew("uring.fail")), "new write file");
+        TEST_RESULT_VOID(ioWriteOpen(storageFileWriteIo(fileWrite)), "    open file");
+        TEST_RESULT_VOID(storageDriverPosixFileWrite(storageFileWriteFileDriver(fileWrite), buffer), "    write file");
+        TEST_RESULT_PTR(
+            ((StorageDriverPosixFileWrite *)storageFileWriteFileDriver(fileWrite))->uring, NULL, "    io_uring not used");
+        TEST_RESULT_UINT(storageDriverPosixUring(driver), 0, "    io_uring disabled");
+        TEST_RESULT_VOID(ioWriteClose(storageFileWriteIo(fileWrite)), "    close file");
+
+        storageDriverPosixUringSet(driver, 65536);
+
+        TEST_ASSIGN(fileRead, storageNewReadNP(storage, strNew("uring.fail")), "new read file");
+        TEST_RESULT_BOOL(ioReadOpen(storageFileReadIo(fileRead)), true, "    open file");
+        TEST_RESULT_UINT(storageDriverPosixFileRead(storageFileReadDriver(fileRead), bufNew(2), false), 2, "    read file");
+        TEST_RESULT_PTR(((StorageDriverPosixFileRead *)storageFileReadDriver(fileRead))->uring, NULL, "    io_uring not used");
+        TEST_RESULT_UINT(storageDriverPosixUring(driver), 0, "    io_uring disabled");
+        TEST_RESULT_VOID(ioReadClose(storageFileReadIo(fileRead)), "    close file");
+
+        storageDriverPosixUringSet(driver, 2);
+
+        // Storage with io_uring disabled
+        // -------------------------------------------------------------------------------------------------------------------------
+        storagePutNP(storageNewWriteNP(storage, fileName), bufNewZ("012345678"));
+
+        TEST_RESULT_STR(
+            strPtr(strNewBuf(storageGetNP(storageNewReadNP(storageTest, fileName)))), "012345678", "read without io_uring");
+        TEST_RESULT_VOID(storageDriverPosixUringFree(NULL), "free null io_uring");
+
+        // Write back only data that queued writes have completed.  The partial slot is not in the file yet so it is not included.
+        // -------------------------------------------------------------------------------------------------------------------------
+        ioBufferSizeSet(1024 * 1024);
+
+        buffer = bufNew(ioBufferSize() * 7 / 2);
+        memset(bufPtr(buffer), 'X', bufSize(buffer));
+        bufUsedSet(buffer, bufSize(buffer));
+
+        TEST_ASSIGN(fileWrite, storageNewWriteP(storage, fileName, .noCache = true), "new write file (no cache)");
+        TEST_RESULT_VOID(ioWriteOpen(storageFileWriteIo(fileWrite)), "    open file");
+        TEST_RESULT_VOID(storageDriverPosixFileWrite(storageFileWriteFileDriver(fileWrite), buffer), "    write data");
+        TEST_RESULT_VOID(storageDriverPosixFileWrite(storageFileWriteFileDriver(fileWrite), buffer), "    write data");
+        TEST_RESULT_VOID(storageDriverPosixFileWrite(storageFileWriteFileDriver(fileWrite), buffer), "    write data");
+
+        StorageDriverPosixFileWrite *fileDriver = (StorageDriverPosixFileWrite *)storageFileWriteFileDriver(fileWrite);
+
+        TEST_RESULT_BOOL(fileDriver->uring != NULL, true, "    io_uring used");
+        TEST_RESULT_UINT(fileDriver->writebackEnd, ioBufferSize() * 10, "    check writeback end is a full slot");
+        TEST_RESULT_BOOL(storageDriverPosixUringBusy(fileDriver->uring, 0), false, "    check first slot is complete");
+        TEST_RESULT_BOOL(storageDriverPosixUringBusy(fileDriver->uring, 1), false, "    check second slot is complete");
+        TEST_RESULT_VOID(ioWriteClose(storageFileWriteIo(fileWrite)), "    close file");
+        TEST_RESULT_UINT(storageInfoNP(storage, fileName).size, bufUsed(buffer) * 3, "    check size");
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("storageDriverPosixFileReadView() and storageDriverPosixMap*()"))
+    {
+        ioBufferSizeSet(2);
+
+        StorageDriverPosix *driver = storageDriverPosixNew(
+            strNew(testPath()), STORAGE_MODE_FILE_DEFAULT, STORAGE_MODE_PATH_DEFAULT, true, NULL);
+        Storage *storage = storageDriverPosixInterface(driver);
+
+        TEST_RESULT_UINT(storageDriverPosixMmap(driver), 0, "mmap disabled by default");
+        TEST_RESULT_VOID(storageDriverPosixMmapSet(driver, 16), "enable mmap");
+        TEST_RESULT_UINT(storageDriverPosixMmap(driver), 16, "    check max size");
+
+        // Read a mapped file
+        // -------------------------------------------------------------------------------------------------------------------------
+        String *fileName = strNewFmt("%s/map.txt", testPath());
+        StorageFileRead *fileRead = NULL;
+        StorageDriverPosixFileRead *driverRead = NULL;
+
+        storagePutNP(storageNewWriteNP(storage, fileName), bufNewZ("0123456789"));
+
+        TEST_RESULT_STR(strPtr(strNewBuf(storageGetNP(storageNewReadNP(storage, fileName)))), "0123456789", "read mapped file");
+
+        // Views start at the current offset of the file
+        TEST_ASSIGN(fileRead, storageNewReadNP(storage, fileName), "new read file");
+        TEST_RESULT_BOOL(ioReadOpen(storageFileReadIo(fileRead)), true, "    open file");
+        driverRead = storageFileReadDriver(fileRead);
+        lseek(driverRead->handle, 5, SEEK_SET);
+
+        TEST_RESULT_STR(strPtr(strNewBuf(storageDriverPosixFileReadView(driverRead, 2))), "56", "    view from offset");
+        TEST_RESULT_BOOL(driverRead->map != NULL, true, "    file is mapped");
+        TEST_RESULT_STR(strPtr(strNewBuf(storageDriverPosixFileReadView(driverRead, 2))), "78", "    view");
+        TEST_RESULT_BOOL(driverRead->eof, false, "    not eof");
+        TEST_RESULT_STR(strPtr(strNewBuf(storageDriverPosixFileReadView(driverRead, 2))), "9", "    short view");
+        TEST_RESULT_BOOL(driverRead->eof, false, "    not eof at end of mapping");
+
+        // Data appended after the file was mapped is read after the mapping
+        int handleAppend = open(strPtr(fileName), O_WRONLY | O_APPEND);
+        TEST_RESULT_INT(write(handleAppend, "AB", 2), 2, "    append to file");
+        close(handleAppend);
+
+        Buffer *buffer = bufNew(4);
+
+        TEST_RESULT_PTR(storageDriverPosixFileReadView(driverRead, 2), NULL, "    no view at end of mapping");
+        TEST_RESULT_PTR(driverRead->map, NULL, "    file is unmapped");
+        TEST_RESULT_SIZE(storageDriverPosixFileRead(driverRead, buffer, true), 2, "    read appended data");
+        TEST_RESULT_STR(strPtr(strNewBuf(buffer)), "AB", "    check buffer");
+        TEST_RESULT_SIZE(storageDriverPosixFileRead(driverRead, buffer, true), 0, "    read eof");
+        TEST_RESULT_BOOL(driverRead->eof, true, "    eof");
+        TEST_RESULT_VOID(ioReadClose(storageFileReadIo(fileRead)), "    close file");
+
+        // Error getting file info
+        TEST_ASSIGN(fileRead, storageNewReadNP(storage, fileName), "new read file");
+        TEST_RESULT_BOOL(ioReadOpen(storageFileReadIo(fileRead)), true, "    open file");
+        driverRead = storageFileReadDriver(fileRead);
+
+        int handleSave = dup(driverRead->handle);
+        close(driverRead->handle);
+
+        TEST_ERROR_FMT(
+            storageDriverPosixFileReadView(driverRead, 2), FileOpenError,
+            "unable to get info for '%s': [9] Bad file descriptor", strPtr(fileName));
+
+        dup2(handleSave, driverRead->handle);
+        close(handleSave);
+
+        TEST_RESULT_VOID(ioReadClose(storageFileReadIo(fileRead)), "    close file");
+
+        // Files that are not mapped
+        // -------------------------------------------------------------------------------------------------------------------------
+        storagePutNP(storageNewWriteNP(storage, fileName), bufNewZ("0123456789ABCDEFG"));
+
+        TEST_ASSIGN(fileRead, storageNewReadNP(storage, fileName), "new read file too large to map");
+        TEST_RESULT_BOOL(ioReadOpen(storageFileReadIo(fileRead)), true, "    open file");
+        TEST_RESULT_PTR(storageDriverPosixFileReadView(storageFileReadDriver(fileRead), 2), NULL, "    no view");
+        TEST_RESULT_PTR(storageDriverPosixFileReadView(storageFileReadDriver(fileRead), 2), NULL, "    still no view");
+        TEST_RESULT_VOID(ioReadClose(storageFileReadIo(fileRead)), "    close file");
+        TEST_RESULT_STR(
+            strPtr(strNewBuf(storageGetNP(storageNewReadNP(storage, fileName)))), "0123456789ABCDEFG", "read file too large to map");
+
+        storagePutNP(storageNewWriteNP(storage, fileName), NULL);
+
+        TEST_ASSIGN(fileRead, storageNewReadNP(storage, fileName), "new read empty file");
+        TEST_RESULT_BOOL(ioReadOpen(storageFileReadIo(fileRead)), true, "    open file");
+        TEST_RESULT_PTR(storageDriverPosixFileReadView(storageFileReadDriver(fileRead), 2), NULL, "    no view");
+        TEST_RESULT_VOID(ioReadClose(storageFileReadIo(fileRead)), "    close file");
+
+        storagePathCreateNP(storage, strNew("map.path"));
+
+        TEST_ERROR_FMT(
+            storageGetNP(storageNewReadNP(storage, strNew("map.path"))), FileReadError,
+            "unable to read '%s/map.path': [21] Is a directory", testPath());
+
+        // Files in sysfs report a size but cannot be mapped
+        StorageDriverPosix *driverRoot = storageDriverPosixNew(
+            strNew("/"), STORAGE_MODE_FILE_DEFAULT, STORAGE_MODE_PATH_DEFAULT, false, NULL);
+        storageDriverPosixMmapSet(driverRoot, 4096);
+
+        TEST_ASSIGN(
+            fileRead, storageNewReadNP(storageDriverPosixInterface(driverRoot), strNew("/sys/devices/system/cpu/online")),
+            "new read sysfs file");
+        TEST_RESULT_BOOL(ioReadOpen(storageFileReadIo(fileRead)), true, "    open file");
+        TEST_RESULT_PTR(storageDriverPosixFileReadView(storageFileReadDriver(fileRead), 2), NULL, "    no view");
+        TEST_RESULT_VOID(ioReadClose(storageFileReadIo(fileRead)), "    close file");
+
+        // Files truncated while mapped
+        // -------------------------------------------------------------------------------------------------------------------------
+        String *fileNameA = strNewFmt("%s/map-a.txt", testPath());
+        String *fileNameB = strNewFmt("%s/map-b.txt", testPath());
+        StorageFileRead *fileReadA = NULL;
+        StorageFileRead *fileReadB = NULL;
+
+        storagePutNP(storageNewWriteNP(storage, fileNameA), bufNewZ("0123456789"));
+        storagePutNP(storageNewWriteNP(storage, fileNameB), bufNewZ("abcdefghij"));
+
+        TEST_ASSIGN(fileReadA, storageNewReadNP(storage, fileNameA), "new read file a");
+        TEST_RESULT_BOOL(ioReadOpen(storageFileReadIo(fileReadA)), true, "    open file");
+        TEST_RESULT_STR(strPtr(strNewBuf(storageDriverPosixFileReadView(storageFileReadDriver(fileReadA), 2))), "01", "    view");
+
+        TEST_ASSIGN(fileReadB, storageNewReadNP(storage, fileNameB), "new read file b");
+        TEST_RESULT_BOOL(ioReadOpen(storageFileReadIo(fileReadB)), true, "    open file");
+        TEST_RESULT_STR(strPtr(strNewBuf(storageDriverPosixFileReadView(storageFileReadDriver(fileReadB), 2))), "ab", "    view");
+
+        // The truncation is detected before the view is returned
+        StorageDriverPosixMap *map = ((StorageDriverPosixFileRead *)storageFileReadDriver(fileReadA))->map;
+
+        TEST_RESULT_INT(truncate(strPtr(fileNameA), 0), 0, "truncate file a");
+        TEST_ERROR_FMT(
+            storageDriverPosixFileReadView(storageFileReadDriver(fileReadA), 2), FileReadError,
+            "unable to read '%s': file was truncated while being read", strPtr(fileNameA));
+        TEST_RESULT_BOOL(storageDriverPosixMapTruncated(map), true, "    mapping is truncated");
+        TEST_RESULT_UINT(storageDriverPosixMapPtr(map)[2], 0, "    truncated data is zeroed");
+        TEST_ERROR_FMT(
+            storageDriverPosixFileReadView(storageFileReadDriver(fileReadA), 2), FileReadError,
+            "unable to read '%s': file was truncated while being read", strPtr(fileNameA));
+        TEST_ERROR_FMT(
+            ioReadClose(storageFileReadIo(fileReadA)), FileReadError,
+            "unable to read '%s': file was truncated while being read", strPtr(fileNameA));
+        TEST_RESULT_VOID(storageFileReadFree(fileReadA), "    free file a");
+        TEST_RESULT_BOOL(storageDriverPosixMapLocal.handlerInstalled, true, "    SIGBUS handler installed while b is mapped");
+
+        TEST_RESULT_STR(
+            strPtr(strNewBuf(storageDriverPosixFileReadView(storageFileReadDriver(fileReadB), 2))), "cd", "view file b");
+        TEST_RESULT_VOID(ioReadClose(storageFileReadIo(fileReadB)), "    close file b");
+        TEST_RESULT_PTR(storageDriverPosixMapLocal.mapList, NULL, "    no active mappings");
+        TEST_RESULT_BOOL(storageDriverPosixMapLocal.handlerInstalled, false, "    SIGBUS handler removed");
+
+        // Truncation within the last page does not raise SIGBUS so the size is checked when the views end or the file is closed
+        storagePutNP(storageNewWriteNP(storage, fileNameA), bufNewZ("0123456789"));
+
+        TEST_ASSIGN(fileReadA, storageNewReadNP(storage, fileNameA), "new read file a");
+        TEST_RESULT_BOOL(ioReadOpen(storageFileReadIo(fileReadA)), true, "    open file");
+        driverRead = storageFileReadDriver(fileReadA);
+        TEST_RESULT_STR(strPtr(strNewBuf(storageDriverPosixFileReadView(driverRead, 4))), "0123", "    view");
+        TEST_RESULT_INT(truncate(strPtr(fileNameA), 6), 0, "truncate file a in the last page");
+        TEST_RESULT_UINT(bufUsed(storageDriverPosixFileReadView(driverRead, 6)), 6, "    view");
+        TEST_RESULT_BOOL(storageDriverPosixMapTruncated(driverRead->map), false, "    mapping is not truncated");
+        TEST_ERROR_FMT(
+            storageDriverPosixFileReadView(driverRead, 2), FileReadError,
+            "unable to read '%s': file was truncated while being read", strPtr(fileNameA));
+        TEST_RESULT_VOID(storageFileReadFree(fileReadA), "    free file a");
+
+        storagePutNP(storageNewWriteNP(storage, fileNameA), bufNewZ("0123456789"));
+
+        TEST_ASSIGN(fileReadA, storageNewReadNP(storage, fileNameA), "new read file a");
+        TEST_RESULT_BOOL(ioReadOpen(storageFileReadIo(fileReadA)), true, "    open file");
+        TEST_RESULT_STR(strPtr(strNewBuf(storageDriverPosixFileReadView(storageFileReadDriver(fileReadA), 4))), "0123", "    view");
+        TEST_RESULT_INT(truncate(strPtr(fileNameA), 2), 0, "truncate file a before the end of the view");
+        TEST_ERROR_FMT(
+            ioReadClose(storageFileReadIo(fileReadA)), FileReadError,
+            "unable to read '%s': file was truncated while being read", strPtr(fileNameA));
+        TEST_RESULT_VOID(storageFileReadFree(fileReadA), "    free file a");
+
+        // Truncation after the data that has been returned is not an error
+        storagePutNP(storageNewWriteNP(storage, fileNameA), bufNewZ("0123456789"));
+
+        TEST_ASSIGN(fileReadA, storageNewReadNP(storage, fileNameA), "new read file a");
+        TEST_RESULT_BOOL(ioReadOpen(storageFileReadIo(fileReadA)), true, "    open file");
+        TEST_RESULT_STR(strPtr(strNewBuf(storageDriverPosixFileReadView(storageFileReadDriver(fileReadA), 4))), "0123", "    view");
+        TEST_RESULT_INT(truncate(strPtr(fileNameA), 4), 0, "truncate file a after the end of the view");
+        TEST_RESULT_VOID(ioReadClose(storageFileReadIo(fileReadA)), "    close file");
+
+        // Error getting file info when checking the size
+        TEST_ASSIGN(fileReadA, storageNewReadNP(storage, fileNameB), "new read file b");
+        TEST_RESULT_BOOL(ioReadOpen(storageFileReadIo(fileReadA)), true, "    open file");
+        driverRead = storageFileReadDriver(fileReadA);
+        TEST_RESULT_STR(strPtr(strNewBuf(storageDriverPosixFileReadView(driverRead, 2))), "ab", "    view");
+
+        handleSave = dup(driverRead->handle);
+        close(driverRead->handle);
+
+        TEST_ERROR_FMT(
+            ioReadClose(storageFileReadIo(fileReadA)), FileReadError,
+            "unable to get info for '%s': [9] Bad file descriptor", strPtr(fileNameB));
+
+        dup2(handleSave, driverRead->handle);
+        close(handleSave);
+
+        TEST_RESULT_VOID(storageFileReadFree(fileReadA), "    free file b");
+        TEST_RESULT_PTR(storageDriverPosixMapLocal.mapList, NULL, "    no active mappings");
+
+        // The SIGBUS handler is only installed while files are mapped and the prior action is restored after
+        // -------------------------------------------------------------------------------------------------------------------------
+        struct sigaction action = {.sa_handler = SIG_IGN};
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGBUS, &action, NULL);
+
+        TEST_ASSIGN(fileRead, storageNewReadNP(storage, fileNameB), "new read file");
+        TEST_RESULT_BOOL(ioReadOpen(storageFileReadIo(fileRead)), true, "    open file");
+        TEST_RESULT_STR(strPtr(strNewBuf(storageDriverPosixFileReadView(storageFileReadDriver(fileRead), 2))), "ab", "    view");
+
+        sigaction(SIGBUS, NULL, &action);
+        TEST_RESULT_BOOL(action.sa_sigaction == storageDriverPosixMapSigBus, true, "    SIGBUS handler installed");
+
+        TEST_RESULT_VOID(ioReadClose(storageFileReadIo(fileRead)), "    close file");
+
+        sigaction(SIGBUS, NULL, &action);
+        TEST_RESULT_BOOL(action.sa_handler == SIG_IGN, true, "    prior SIGBUS action restored");
+
+        action.sa_handler = SIG_DFL;
+        sigaction(SIGBUS, &action, NULL);
+
+        // Views are dropped from the cache after they have been consumed
+        // -------------------------------------------------------------------------------------------------------------------------
+        storageDriverPosixMmapSet(driver, STORAGE_DRIVER_POSIX_CACHE_DROP_SIZE * 2);
+
+        buffer = bufNew((size_t)STORAGE_DRIVER_POSIX_CACHE_DROP_SIZE + 1);
+        memset(bufPtr(buffer), 'X', bufSize(buffer));
+        bufUsedSet(buffer, bufSize(buffer));
+
+        storagePutNP(storageNewWriteNP(storage, fileName), buffer);
+
+        TEST_ASSIGN(fileRead, storageNewReadP(storage, fileName, .noCache = true), "new read file (no cache)");
+        TEST_RESULT_BOOL(ioReadOpen(storageFileReadIo(fileRead)), true, "    open file");
+        driverRead = storageFileReadDriver(fileRead);
+
+        TEST_RESULT_UINT(
+            bufUsed(storageDriverPosixFileReadView(driverRead, (size_t)STORAGE_DRIVER_POSIX_CACHE_DROP_SIZE)),
+            STORAGE_DRIVER_POSIX_CACHE_DROP_SIZE, "    view");
+        TEST_RESULT_UINT(driverRead->mapDropOffset, 0, "    nothing dropped before view is consumed");
+        TEST_RESULT_UINT(bufUsed(storageDriverPosixFileReadView(driverRead, 2)), 1, "    view");
+        TEST_RESULT_UINT(driverRead->mapDropOffset, STORAGE_DRIVER_POSIX_CACHE_DROP_SIZE, "    consumed view dropped");
+        TEST_RESULT_VOID(ioReadClose(storageFileReadIo(fileRead)), "    close file");
+
+        TEST_RESULT_VOID(storageDriverPosixMapFree(NULL), "free null mapping");
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("storageLocal() and storageLocalWrite()"))
     {
@@ -926,6 +1862,7 @@ testRun(void)
         TEST_ASSIGN(storage, storageLocal(), "new storage");
         TEST_RESULT_PTR(storageHelper.storageLocal, storage, "local storage cached");
         TEST_RESULT_PTR(storageLocal(), storage, "get cached storage");
+        TEST_RESULT_UINT(storageDriverPosixMmap(storage->driver), 0, "    mmap disabled");
 
         TEST_RESULT_STR(strPtr(storagePathNP(storage, NULL)), "/", "check base path");
 
@@ -953,7 +1890,9 @@ testRun(void)
         strLstAddZ(argList, "archive-get");
         harnessCfgLoad(strLstSize(argList), strLstPtr(argList));
 
-        TEST_RESULT_VOID(storageRepoGet(strNew(STORAGE_TYPE_CIFS), false), "get cifs repo storage");
+        TEST_RESULT_UINT(
+            storageDriverPosixUring(storageRepoGet(strNew(STORAGE_TYPE_CIFS), false)->driver), 0,
+            "get cifs repo storage without io_uring");
         TEST_ERROR(storageRepoGet(strNew(BOGUS_STR), false), AssertError, "invalid storage type 'BOGUS'");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -1,11 +1,25 @@
 /***********************************************************************************************************************************
 Test Remote Storage Driver
 ***********************************************************************************************************************************/
+#include <utime.h>
+
 #include "common/io/bufferRead.h"
 #include "common/io/bufferWrite.h"
+#include "compress/gzipCompress.h"
 
 #include "common/harnessConfig.h"
 
+/***********************************************************************************************************************************
+Test callback for storageListInfo()
+***********************************************************************************************************************************/
+static void
+testRemoteListInfo(void *callbackData, const StorageInfo *info)
+{
+    strLstAdd(
+        (StringList *)callbackData,
+        strNewFmt("%s:%s:%zu", strPtr(info->name), info->type == storageTypePath ? "path" : "file", info->size));
+}
+
 /***********************************************************************************************************************************
 Test Run
 ***********************************************************************************************************************************/
@@ -61,6 +75,92 @@ testRun(void)
         TEST_RESULT_STR(strPtr(strNewBuf(serverWrite)), "{\"out\":true}\n", "check result");
 
         bufUsedSet(serverWrite, 0);
+
+        // Check a list of files in one round trip
+        // -------------------------------------------------------------------------------------------------------------------------
+        StringList *pathList = strLstNew();
+        strLstAddZ(pathList, "test.txt");
+        strLstAddZ(pathList, BOGUS_STR);
+
+        List *existsList = NULL;
+        TEST_ASSIGN(existsList, storageExistsListNP(storageRemote, pathList), "exists list");
+        TEST_RESULT_UINT(lstSize(existsList), 2, "    check size");
+        TEST_RESULT_BOOL(*(bool *)lstGet(existsList, 0), true, "    check file exists");
+        TEST_RESULT_BOOL(*(bool *)lstGet(existsList, 1), false, "    check file does not exist");
+
+        TEST_RESULT_UINT(lstSize(storageExistsListNP(storageRemote, strLstNew())), 0, "empty exists list");
+
+        // Check protocol function directly
+        // -------------------------------------------------------------------------------------------------------------------------
+        paramList = varLstNew();
+        varLstAdd(paramList, varNewStr(strNew("test.txt")));
+        varLstAdd(paramList, varNewStr(strNew(BOGUS_STR)));
+
+        TEST_RESULT_BOOL(
+            storageDriverRemoteProtocol(PROTOCOL_COMMAND_STORAGE_EXISTS_LIST_STR, paramList, server), true, "protocol exists list");
+        TEST_RESULT_STR(strPtr(strNewBuf(serverWrite)), "{\"out\":[true,false]}\n", "check result");
+
+        bufUsedSet(serverWrite, 0);
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("storageInfo()"))
+    {
+        Storage *storageRemote = NULL;
+        TEST_ASSIGN(storageRemote, storageRepoGet(strNew(STORAGE_TYPE_POSIX), false), "get remote repo storage");
+        storagePathCreateP(storageTest, strNew("repo"), .mode = 0750);
+        storagePutNP(storageNewWriteP(storageTest, strNew("repo/test.txt"), .modeFile = 0640), bufNewStr(strNew("TEST")));
+        THROW_ON_SYS_ERROR(
+            utime(strPtr(strNewFmt("%s/repo/test.txt", testPath())), &((struct utimbuf){.modtime = 1555160000})) != 0,
+            FileWriteError, "unable to set time");
+
+        TEST_ERROR(
+            storageInfoNP(storageRemote, strNew(BOGUS_STR)), FileOpenError,
+            strPtr(
+                strNewFmt(
+                    "raised from remote-0 protocol on 'localhost': unable to get info for '%s/repo/BOGUS': [2] No such file or"
+                        " directory",
+                    testPath())));
+        TEST_RESULT_BOOL(storageInfoP(storageRemote, strNew(BOGUS_STR), .ignoreMissing = true).exists, false, "missing file");
+
+        StorageInfo info = {0};
+        TEST_ASSIGN(info, storageInfoNP(storageRemote, strNew("test.txt")), "file info");
+        TEST_RESULT_BOOL(info.exists, true, "    check exists");
+        TEST_RESULT_INT(info.type, storageTypeFile, "    check type");
+        TEST_RESULT_SIZE(info.size, 4, "    check size");
+        TEST_RESULT_INT(info.mode, 0640, "    check mode");
+        TEST_RESULT_INT(info.timeModified, 1555160000, "    check time");
+
+        // Get info for a list of files in one round trip
+        // -------------------------------------------------------------------------------------------------------------------------
+        StringList *fileList = strLstNew();
+        strLstAddZ(fileList, "test.txt");
+        strLstAddZ(fileList, BOGUS_STR);
+        strLstAdd(fileList, strNewFmt("%s/repo", testPath()));
+
+        List *infoList = NULL;
+        TEST_ASSIGN(infoList, storageInfoListP(storageRemote, fileList, .ignoreMissing = true), "info list");
+        TEST_RESULT_UINT(lstSize(infoList), 3, "    check size");
+        TEST_RESULT_SIZE(((StorageInfo *)lstGet(infoList, 0))->size, 4, "    check file size");
+        TEST_RESULT_BOOL(((StorageInfo *)lstGet(infoList, 1))->exists, false, "    check missing file");
+        TEST_RESULT_INT(((StorageInfo *)lstGet(infoList, 2))->type, storageTypePath, "    check path type");
+        TEST_RESULT_INT(((StorageInfo *)lstGet(infoList, 2))->mode, 0750, "    check path mode");
+
+        TEST_RESULT_UINT(lstSize(storageInfoListNP(storageRemote, strLstNew())), 0, "empty info list");
+
+        // Check protocol function directly
+        // -------------------------------------------------------------------------------------------------------------------------
+        VariantList *paramList = varLstNew();
+        varLstAdd(paramList, varNewBool(true));
+        varLstAdd(paramList, varNewStr(strNew("test.txt")));
+        varLstAdd(paramList, varNewStr(strNew(BOGUS_STR)));
+
+        TEST_RESULT_BOOL(
+            storageDriverRemoteProtocol(PROTOCOL_COMMAND_STORAGE_INFO_LIST_STR, paramList, server), true, "protocol info list");
+        TEST_RESULT_STR(
+            strPtr(strNewBuf(serverWrite)), "{\"out\":[{\"mode\":416,\"size\":4,\"time\":1555160000,\"type\":0},null]}\n", "check result");
+
+        bufUsedSet(serverWrite, 0);
     }
 
     // *****************************************************************************************************************************
@@ -94,6 +194,89 @@ testRun(void)
 
         bufUsedSet(serverWrite, 0);
 
+        // Get info for the contents of a path
+        // -------------------------------------------------------------------------------------------------------------------------
+        StringList *infoList = strLstNew();
+
+        TEST_ERROR(
+            storageListInfoP(storageRemote, strNew(BOGUS_STR), testRemoteListInfo, infoList, .errorOnMissing = true), PathOpenError,
+            strPtr(
+                strNewFmt(
+                    "raised from remote-0 protocol on 'localhost': unable to open path '%s/repo/BOGUS' for read: [2] No such file or"
+                        " directory",
+                    testPath())));
+        TEST_RESULT_BOOL(
+            storageListInfoNP(storageRemote, strNew(BOGUS_STR), testRemoteListInfo, infoList), false, "missing path ignored");
+
+        storagePutNP(storageNewWriteNP(storageTest, strNew("repo/testy/file.txt")), bufNewStr(strNew("FILE")));
+        THROW_ON_SYS_ERROR(
+            utime(strPtr(strNewFmt("%s/repo/testy/file.txt", testPath())), &((struct utimbuf){.modtime = 1555160000})) != 0,
+            FileWriteError, "unable to set time");
+
+        TEST_RESULT_BOOL(
+            storageListInfoP(storageRemote, NULL, testRemoteListInfo, infoList, .recurse = true), true, "list info recursively");
+        TEST_RESULT_STR(
+            strPtr(strLstJoin(strLstSort(infoList, sortOrderAsc), ", ")), "testy/file.txt:file:4, testy2\":path:0, testy:path:0",
+            "    check info");
+
+        // Create enough files that info is returned in more than one batch
+        TEST_RESULT_INT(
+            system(
+                strPtr(
+                    strNewFmt(
+                        "mkdir %s/repo/batch && cd %s/repo/batch && touch $(seq -f 'f%%04g' 1 %d)", testPath(), testPath(),
+                        PROTOCOL_STORAGE_LIST_INFO_BATCH + 1))),
+            0, "create files");
+
+        infoList = strLstNew();
+        TEST_RESULT_BOOL(
+            storageListInfoNP(storageRemote, strNew("batch"), testRemoteListInfo, infoList), true, "list info in batches");
+        TEST_RESULT_UINT(strLstSize(infoList), PROTOCOL_STORAGE_LIST_INFO_BATCH + 1, "    check size");
+
+        // Check protocol function directly
+        // -------------------------------------------------------------------------------------------------------------------------
+        paramList = varLstNew();
+        varLstAdd(paramList, varNewStr(strNew("testy")));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewBool(false));
+
+        TEST_RESULT_BOOL(
+            storageDriverRemoteProtocol(PROTOCOL_COMMAND_STORAGE_LIST_INFO_STR, paramList, server), true, "protocol list info");
+        TEST_RESULT_STR(
+            strPtr(strNewBuf(serverWrite)),
+            "{\"out\":[{\"mode\":416,\"name\":\"file.txt\",\"size\":4,\"time\":1555160000,\"type\":0}]}\n"
+            "{\"out\":true}\n",
+            "check result");
+
+        bufUsedSet(serverWrite, 0);
+
+        varLstFree(paramList);
+        paramList = varLstNew();
+        varLstAdd(paramList, varNewStr(strNew(BOGUS_STR)));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewBool(false));
+
+        TEST_RESULT_BOOL(
+            storageDriverRemoteProtocol(PROTOCOL_COMMAND_STORAGE_LIST_INFO_STR, paramList, server), true,
+            "protocol list info missing");
+        TEST_RESULT_STR(strPtr(strNewBuf(serverWrite)), "{\"out\":false}\n", "check result");
+
+        bufUsedSet(serverWrite, 0);
+
+        varLstFree(paramList);
+        paramList = varLstNew();
+        varLstAdd(paramList, varNewStr(strNew("batch")));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewBool(false));
+
+        TEST_RESULT_BOOL(
+            storageDriverRemoteProtocol(PROTOCOL_COMMAND_STORAGE_LIST_INFO_STR, paramList, server), true,
+            "protocol list info in batches");
+        TEST_RESULT_UINT(strLstSize(strLstNewSplitZ(strNewBuf(serverWrite), "\n")), 4, "    check batches");
+        TEST_RESULT_BOOL(strEndsWithZ(strNewBuf(serverWrite), "}]}\n{\"out\":true}\n"), true, "    check result");
+
+        bufUsedSet(serverWrite, 0);
+
         // Check invalid protocol function
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_RESULT_BOOL(storageDriverRemoteProtocol(strNew(BOGUS_STR), paramList, server), false, "invalid function");
@@ -135,16 +318,60 @@ testRun(void)
             "nothing more to read");
 
         TEST_RESULT_BOOL(
-            bufEq(storageGetNP(storageNewReadNP(storageRemote, strNew("test.txt"))), contentBuf), true, "get file again");
+            bufEq(storageGetNP(storageNewReadP(storageRemote, strNew("test.txt"), .compressible = true)), contentBuf), true,
+            "get compressible file");
 
         TEST_ERROR(
-            storageDriverRemoteFileReadBlockSize(strNew("bogus")), ProtocolError, "'bogus' is not a valid block size message");
+            storageDriverRemoteProtocolBlockSize(strNew("bogus")), ProtocolError, "'bogus' is not a valid block size message");
+
+        // Run filters on the remote
+        // -------------------------------------------------------------------------------------------------------------------------
+        StringList *filterList = strLstNew();
+        strLstAddZ(filterList, "hash:sha1");
+        strLstAddZ(filterList, "size");
+
+        TEST_ASSIGN(fileRead, storageNewReadP(storageRemote, strNew("test.txt"), .filterList = filterList), "new filter read");
+        TEST_RESULT_BOOL(bufEq(storageGetNP(fileRead), contentBuf), true, "    get file");
+
+        const VariantList *filterResult = storageFileReadFilterResult(fileRead);
+        TEST_RESULT_STR(strPtr(varStr(varLstGet(filterResult, 0))), "eda188f3f6ceae07b0f02813049a8c8acbe53b51", "    check hash");
+        TEST_RESULT_UINT(varUInt64Force(varLstGet(filterResult, 1)), 32768, "    check size");
+
+        // Run filters on the remote and return compressed data
+        TEST_ASSIGN(
+            fileRead, storageNewReadP(storageRemote, strNew("test.txt"), .compressible = true, .filterList = filterList),
+            "new compressible filter read");
+        TEST_RESULT_BOOL(bufEq(storageGetNP(fileRead), contentBuf), true, "    get file");
+
+        filterResult = storageFileReadFilterResult(fileRead);
+        TEST_RESULT_STR(strPtr(varStr(varLstGet(filterResult, 0))), "eda188f3f6ceae07b0f02813049a8c8acbe53b51", "    check hash");
+        TEST_RESULT_UINT(varUInt64Force(varLstGet(filterResult, 1)), 32768, "    check size");
+
+        // No filter results without a filter list
+        TEST_ASSIGN(fileRead, storageNewReadNP(storageRemote, strNew("test.txt")), "new read");
+        TEST_RESULT_BOOL(bufEq(storageGetNP(fileRead), contentBuf), true, "    get file");
+        TEST_RESULT_PTR(storageFileReadFilterResult(fileRead), NULL, "    no filter results");
+
+        // Missing file with filters
+        TEST_RESULT_PTR(
+            storageGetNP(storageNewReadP(storageRemote, strNew("missing.txt"), .ignoreMissing = true, .filterList = filterList)),
+            NULL, "missing file");
+
+        // Invalid filter
+        strLstAddZ(filterList, "cipher:aes-256-cbc");
+
+        TEST_ERROR(
+            storageGetNP(storageNewReadP(storageRemote, strNew("test.txt"), .filterList = filterList)), ProtocolError,
+            "raised from remote-0 protocol on 'localhost': invalid filter 'cipher:aes-256-cbc'");
 
         // Check protocol function directly (file missing)
         // -------------------------------------------------------------------------------------------------------------------------
         VariantList *paramList = varLstNew();
         varLstAdd(paramList, varNewStr(strNew("missing.txt")));
         varLstAdd(paramList, varNewBool(true));
+        varLstAdd(paramList, varNewInt(0));
+        varLstAdd(paramList, NULL);
+        varLstAdd(paramList, varNewBool(false));
 
         TEST_RESULT_BOOL(
             storageDriverRemoteProtocol(PROTOCOL_COMMAND_STORAGE_OPEN_READ_STR, paramList, server), true,
@@ -161,6 +388,9 @@ testRun(void)
         paramList = varLstNew();
         varLstAdd(paramList, varNewStr(strNew("test.txt")));
         varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewInt(0));
+        varLstAdd(paramList, NULL);
+        varLstAdd(paramList, varNewBool(true));
 
         TEST_RESULT_BOOL(
             storageDriverRemoteProtocol(PROTOCOL_COMMAND_STORAGE_OPEN_READ_STR, paramList, server), true, "protocol open read");
@@ -169,11 +399,393 @@ testRun(void)
             "{\"out\":true}\n"
                 "BRBLOCK4\n"
                 "TESTBRBLOCK4\n"
-                "DATABRBLOCK0\n",
+                "DATABRBLOCK0\n"
+                "{}\n",
+            "check result");
+
+        bufUsedSet(serverWrite, 0);
+
+        // Check protocol function directly (filters)
+        // -------------------------------------------------------------------------------------------------------------------------
+        paramList = varLstNew();
+        varLstAdd(paramList, varNewStr(strNew("test.txt")));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewInt(0));
+        varLstAdd(paramList, varNewVarLst(storageDriverRemoteProtocolFilterToVar(filterList)));
+        varLstAdd(paramList, varNewBool(false));
+
+        TEST_ERROR(
+            storageDriverRemoteProtocol(PROTOCOL_COMMAND_STORAGE_OPEN_READ_STR, paramList, server), ProtocolError,
+            "invalid filter 'cipher:aes-256-cbc'");
+
+        paramList = varLstNew();
+        varLstAdd(paramList, varNewStrZ("test.txt"));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewInt(0));
+        varLstAdd(paramList, varNewVarLst(storageDriverRemoteProtocolFilterToVar(strLstAddZ(strLstNew(), "hash"))));
+        varLstAdd(paramList, varNewBool(true));
+
+        TEST_ERROR(
+            storageDriverRemoteProtocol(PROTOCOL_COMMAND_STORAGE_OPEN_READ_STR, paramList, server), ProtocolError,
+            "invalid filter 'hash'");
+
+        paramList = varLstNew();
+        varLstAdd(paramList, varNewStrZ("test.txt"));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewInt(0));
+        varLstAdd(paramList, varNewVarLst(storageDriverRemoteProtocolFilterToVar(strLstAddZ(strLstNew(), "size:bogus"))));
+        varLstAdd(paramList, varNewBool(false));
+
+        TEST_ERROR(
+            storageDriverRemoteProtocol(PROTOCOL_COMMAND_STORAGE_OPEN_READ_STR, paramList, server), ProtocolError,
+            "invalid filter 'size:bogus'");
+
+        strLstFree(filterList);
+        filterList = strLstNew();
+        strLstAddZ(filterList, "hash:sha1");
+        strLstAddZ(filterList, "size");
+
+        paramList = varLstNew();
+        varLstAdd(paramList, varNewStr(strNew("test.txt")));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewInt(0));
+        varLstAdd(paramList, varNewVarLst(storageDriverRemoteProtocolFilterToVar(filterList)));
+        varLstAdd(paramList, varNewBool(true));
+
+        TEST_RESULT_BOOL(
+            storageDriverRemoteProtocol(PROTOCOL_COMMAND_STORAGE_OPEN_READ_STR, paramList, server), true,
+            "protocol open read (filters)");
+        TEST_RESULT_STR(
+            strPtr(strNewBuf(serverWrite)),
+            "{\"out\":true}\n"
+                "BRBLOCK4\n"
+                "TESTBRBLOCK4\n"
+                "DATABRBLOCK0\n"
+                "{\"out\":[\"bbbcf2c59433f68f22376cd2439d6cd309378df6\",8]}\n",
             "check result");
 
         bufUsedSet(serverWrite, 0);
         ioBufferSizeSet(8192);
+
+        // Check protocol function directly (compressed)
+        // -------------------------------------------------------------------------------------------------------------------------
+        paramList = varLstNew();
+        varLstAdd(paramList, varNewStr(strNew("test.txt")));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewInt(3));
+        varLstAdd(paramList, NULL);
+        varLstAdd(paramList, varNewBool(false));
+
+        TEST_RESULT_BOOL(
+            storageDriverRemoteProtocol(PROTOCOL_COMMAND_STORAGE_OPEN_READ_STR, paramList, server), true,
+            "protocol open read (compressed)");
+        TEST_RESULT_BOOL(
+            strBeginsWithZ(strNewBuf(serverWrite), "{\"out\":true}\nBRBLOCK"), true, "check result begins with block");
+        TEST_RESULT_BOOL(strEndsWithZ(strNewBuf(serverWrite), "BRBLOCK0\n{}\n"), true, "check result ends with zero block");
+
+        bufUsedSet(serverWrite, 0);
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("storageNewWrite()"))
+    {
+        Storage *storageRemote = NULL;
+        TEST_ASSIGN(storageRemote, storageRepoGet(strNew(STORAGE_TYPE_POSIX), false), "get remote repo storage");
+        storageRemote->write = true;
+        storagePathCreateNP(storageTest, strNew("repo"));
+
+        Buffer *contentBuf = bufNew(32768);
+
+        for (unsigned int contentIdx = 0; contentIdx < bufSize(contentBuf); contentIdx++)
+            bufPtr(contentBuf)[contentIdx] = contentIdx % 2 ? 'A' : 'B';
+
+        bufUsedSet(contentBuf, bufSize(contentBuf));
+
+        // Write the file with compression
+        // -------------------------------------------------------------------------------------------------------------------------
+        ioBufferSizeSet(9999);
+
+        StorageFileWrite *write = NULL;
+        TEST_ASSIGN(write, storageNewWriteNP(storageRemote, strNew("test.txt")), "new write file");
+
+        TEST_RESULT_BOOL(storageFileWriteAtomic(write), true, "    check atomic");
+        TEST_RESULT_BOOL(storageFileWriteCreatePath(write), true, "    check create path");
+        TEST_RESULT_INT(storageFileWriteModeFile(write), STORAGE_MODE_FILE_DEFAULT, "    check mode file");
+        TEST_RESULT_INT(storageFileWriteModePath(write), STORAGE_MODE_PATH_DEFAULT, "    check mode path");
+        TEST_RESULT_STR(strPtr(storageFileWriteName(write)), "test.txt", "    check name");
+        TEST_RESULT_BOOL(storageFileWriteSyncFile(write), true, "    check sync file");
+        TEST_RESULT_BOOL(storageFileWriteSyncPath(write), true, "    check sync path");
+
+        TEST_RESULT_VOID(storagePutNP(write, contentBuf), "write file");
+        TEST_RESULT_VOID(
+            storageDriverRemoteFileWriteClose((StorageDriverRemoteFileWrite *)storageFileWriteFileDriver(write)),
+            "    close file again");
+        TEST_RESULT_BOOL(
+            bufEq(storageGetNP(storageNewReadNP(storageTest, strNew("repo/test.txt"))), contentBuf), true, "    check file");
+
+        // Write the file without compression into a path that does not exist
+        // -------------------------------------------------------------------------------------------------------------------------
+        Storage *storageRemoteRaw = storageDriverRemoteInterface(
+            storageDriverRemoteNew(
+                STORAGE_MODE_FILE_DEFAULT, STORAGE_MODE_PATH_DEFAULT, true, NULL, protocolRemoteGet(protocolStorageTypeRepo), 0));
+
+        TEST_RESULT_VOID(
+            storagePutNP(storageNewWriteNP(storageRemoteRaw, strNewFmt("%s/repo/path/test.txt", testPath())), contentBuf),
+            "write file without compression");
+        TEST_RESULT_BOOL(
+            bufEq(storageGetNP(storageNewReadNP(storageTest, strNew("repo/path/test.txt"))), contentBuf), true, "    check file");
+
+        TEST_RESULT_VOID(
+            storagePutNP(storageNewWriteNP(storageRemote, strNew("empty.txt")), NULL), "write empty file");
+        TEST_RESULT_UINT(
+            bufUsed(storageGetNP(storageNewReadNP(storageTest, strNew("repo/empty.txt")))), 0, "    check file");
+
+        // Error when the file cannot be opened on the remote
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ERROR(
+            storagePutNP(storageNewWriteP(storageRemote, strNew("missing/test.txt"), .noCreatePath = true), contentBuf),
+            FileMissingError,
+            strPtr(
+                strNewFmt(
+                    "raised from remote-0 protocol on 'localhost': unable to open '%s/repo/missing/test.txt.pgbackrest.tmp' for"
+                        " write: [2] No such file or directory",
+                    testPath())));
+
+        TEST_RESULT_BOOL(storageExistsNP(storageRemote, strNew("test.txt")), true, "protocol still in sync after error");
+
+        // Free a write before it is closed so the remote aborts it and removes the partial file
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ASSIGN(write, storageNewWriteNP(storageRemote, strNew("abort.txt")), "new write file");
+        TEST_RESULT_VOID(ioWriteOpen(storageFileWriteIo(write)), "    open file");
+        TEST_RESULT_VOID(ioWrite(storageFileWriteIo(write), contentBuf), "    write file");
+        TEST_RESULT_VOID(storageFileWriteFree(write), "    free file");
+        TEST_RESULT_BOOL(storageExistsNP(storageTest, strNew("repo/abort.txt.pgbackrest.tmp")), false, "    check temp file");
+        TEST_RESULT_BOOL(storageExistsNP(storageRemote, strNew("test.txt")), true, "    protocol still in sync after abort");
+
+        // Abort fails on the remote when the partial file cannot be removed, so a warning is logged
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ASSIGN(write, storageNewWriteNP(storageRemote, strNew("abort.txt")), "new write file");
+        TEST_RESULT_VOID(ioWriteOpen(storageFileWriteIo(write)), "    open file");
+        storageRemoveNP(storageTest, strNew("repo/abort.txt.pgbackrest.tmp"));
+        storagePathCreateNP(storageTest, strNew("repo/abort.txt.pgbackrest.tmp"));
+
+        harnessLogLevelSet(logLevelWarn);
+        TEST_RESULT_VOID(storageFileWriteFree(write), "    free file");
+        harnessLogResult(
+            strPtr(
+                strNewFmt(
+                    "P00   WARN: unable to abort write of 'abort.txt': raised from remote-0 protocol on 'localhost': unable to"
+                        " remove '%s/repo/abort.txt.pgbackrest.tmp': [21] Is a directory",
+                    testPath())));
+        harnessLogLevelReset();
+
+        storagePathRemoveNP(storageTest, strNew("repo/abort.txt.pgbackrest.tmp"));
+        TEST_RESULT_BOOL(storageExistsNP(storageRemote, strNew("test.txt")), true, "    protocol still in sync after abort");
+
+        // Free after close and free NULL have nothing to abort
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_ASSIGN(write, storageNewWriteNP(storageRemote, strNew("test.txt")), "new write file");
+        TEST_RESULT_VOID(storagePutNP(write, contentBuf), "    write file");
+        TEST_RESULT_VOID(
+            storageDriverRemoteFileWriteFree((StorageDriverRemoteFileWrite *)storageFileWriteFileDriver(write)), "    free file");
+        TEST_RESULT_VOID(storageDriverRemoteFileWriteFree(NULL), "free null file");
+
+        // Check protocol function directly
+        // -------------------------------------------------------------------------------------------------------------------------
+        VariantList *paramList = varLstNew();
+        varLstAdd(paramList, varNewStr(strNew("test2.txt")));
+        varLstAdd(paramList, varNewUInt64(0640));
+        varLstAdd(paramList, varNewUInt64(0750));
+        varLstAdd(paramList, varNewBool(true));
+        varLstAdd(paramList, varNewBool(true));
+        varLstAdd(paramList, varNewBool(true));
+        varLstAdd(paramList, varNewBool(true));
+        varLstAdd(paramList, varNewInt(0));
+        varLstAdd(paramList, varNewBool(false));
+
+        IoRead *serverReadIo = ioBufferReadIo(ioBufferReadNew(bufNewZ("BRBLOCK20\n0123456789ABCDEFGHIJBRBLOCK2\nXYBRBLOCK0\n")));
+        ioReadOpen(serverReadIo);
+
+        ProtocolServer *serverWriteFile = protocolServerNew(strNew("test"), strNew("test"), serverReadIo, serverWriteIo);
+
+        bufUsedSet(serverWrite, 0);
+        ioBufferSizeSet(16);
+
+        TEST_RESULT_BOOL(
+            storageDriverRemoteProtocol(PROTOCOL_COMMAND_STORAGE_OPEN_WRITE_STR, paramList, serverWriteFile), true,
+            "protocol open write");
+        TEST_RESULT_STR(strPtr(strNewBuf(serverWrite)), "{}\n{}\n", "check result");
+        TEST_RESULT_STR(
+            strPtr(strNewBuf(storageGetNP(storageNewReadNP(storageTest, strNew("repo/test2.txt"))))), "0123456789ABCDEFGHIJXY",
+            "    check file");
+
+        bufUsedSet(serverWrite, 0);
+
+        // Check protocol function directly with compression
+        // -------------------------------------------------------------------------------------------------------------------------
+        Buffer *compressBuf = bufNew(256);
+        IoWrite *compressWrite = ioBufferWriteIo(ioBufferWriteNew(compressBuf));
+        ioWriteFilterGroupSet(compressWrite, ioFilterGroupAdd(ioFilterGroupNew(), gzipCompressFilter(gzipCompressNew(3, true))));
+        ioWriteOpen(compressWrite);
+        ioWrite(compressWrite, bufNewZ("COMPRESSED"));
+        ioWriteClose(compressWrite);
+
+        Buffer *protocolBuf = bufNew(512);
+        bufCat(protocolBuf, bufNewStr(strNewFmt("BRBLOCK%zu\n", bufUsed(compressBuf))));
+        bufCat(protocolBuf, compressBuf);
+        bufCat(protocolBuf, bufNewZ("BRBLOCK0\n"));
+
+        varLstFree(paramList);
+        paramList = varLstNew();
+        varLstAdd(paramList, varNewStr(strNew("test3.txt")));
+        varLstAdd(paramList, varNewUInt64(0640));
+        varLstAdd(paramList, varNewUInt64(0750));
+        varLstAdd(paramList, varNewBool(true));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewInt(3));
+        varLstAdd(paramList, varNewBool(true));
+
+        serverReadIo = ioBufferReadIo(ioBufferReadNew(protocolBuf));
+        ioReadOpen(serverReadIo);
+
+        serverWriteFile = protocolServerNew(strNew("test"), strNew("test"), serverReadIo, serverWriteIo);
+
+        bufUsedSet(serverWrite, 0);
+
+        TEST_RESULT_BOOL(
+            storageDriverRemoteProtocol(PROTOCOL_COMMAND_STORAGE_OPEN_WRITE_STR, paramList, serverWriteFile), true,
+            "protocol open write with compression");
+        TEST_RESULT_STR(strPtr(strNewBuf(serverWrite)), "{}\n{}\n", "check result");
+        TEST_RESULT_STR(
+            strPtr(strNewBuf(storageGetNP(storageNewReadNP(storageTest, strNew("repo/test3.txt"))))), "COMPRESSED",
+            "    check file");
+
+        bufUsedSet(serverWrite, 0);
+
+        // Abort mid-stream.  The partial file is removed and the next command is still in sync.
+        // -------------------------------------------------------------------------------------------------------------------------
+        varLstFree(paramList);
+        paramList = varLstNew();
+        varLstAdd(paramList, varNewStr(strNew("test5.txt")));
+        varLstAdd(paramList, varNewUInt64(0640));
+        varLstAdd(paramList, varNewUInt64(0750));
+        varLstAdd(paramList, varNewBool(true));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewBool(true));
+        varLstAdd(paramList, varNewInt(0));
+        varLstAdd(paramList, varNewBool(false));
+
+        serverReadIo = ioBufferReadIo(ioBufferReadNew(bufNewZ("BRBLOCK4\nPARTBRBLOCK-1\n{\"cmd\":\"noop\"}\n")));
+        ioReadOpen(serverReadIo);
+
+        serverWriteFile = protocolServerNew(strNew("test"), strNew("test"), serverReadIo, serverWriteIo);
+        bufUsedSet(serverWrite, 0);
+
+        TEST_RESULT_BOOL(
+            storageDriverRemoteProtocol(PROTOCOL_COMMAND_STORAGE_OPEN_WRITE_STR, paramList, serverWriteFile), true,
+            "protocol open write with abort");
+        TEST_RESULT_STR(strPtr(strNewBuf(serverWrite)), "{}\n{}\n", "    check result");
+        TEST_RESULT_BOOL(storageExistsNP(storageTest, strNew("repo/test5.txt.pgbackrest.tmp")), false, "    check temp file");
+        TEST_RESULT_BOOL(storageExistsNP(storageTest, strNew("repo/test5.txt")), false, "    check file");
+        TEST_RESULT_STR(strPtr(ioReadLine(serverReadIo)), "{\"cmd\":\"noop\"}", "    check next command is in sync");
+
+        // Abort without atomic removes the file itself
+        // -------------------------------------------------------------------------------------------------------------------------
+        varLstFree(paramList);
+        paramList = varLstNew();
+        varLstAdd(paramList, varNewStr(strNew("test5.txt")));
+        varLstAdd(paramList, varNewUInt64(0640));
+        varLstAdd(paramList, varNewUInt64(0750));
+        varLstAdd(paramList, varNewBool(true));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewInt(0));
+        varLstAdd(paramList, varNewBool(false));
+
+        serverReadIo = ioBufferReadIo(ioBufferReadNew(bufNewZ("BRBLOCK4\nPARTBRBLOCK-1\n")));
+        ioReadOpen(serverReadIo);
+
+        serverWriteFile = protocolServerNew(strNew("test"), strNew("test"), serverReadIo, serverWriteIo);
+        bufUsedSet(serverWrite, 0);
+
+        TEST_RESULT_BOOL(
+            storageDriverRemoteProtocol(PROTOCOL_COMMAND_STORAGE_OPEN_WRITE_STR, paramList, serverWriteFile), true,
+            "protocol open write with abort and no atomic");
+        TEST_RESULT_STR(strPtr(strNewBuf(serverWrite)), "{}\n{}\n", "    check result");
+        TEST_RESULT_BOOL(storageExistsNP(storageTest, strNew("repo/test5.txt")), false, "    check file");
+
+        bufUsedSet(serverWrite, 0);
+
+        // Write error mid-stream.  The remaining blocks must be read before the error is returned so the protocol stays in sync.
+        // -------------------------------------------------------------------------------------------------------------------------
+        varLstFree(paramList);
+        paramList = varLstNew();
+        varLstAdd(paramList, varNewStr(strNew("test4.txt")));
+        varLstAdd(paramList, varNewUInt64(0640));
+        varLstAdd(paramList, varNewUInt64(0750));
+        varLstAdd(paramList, varNewBool(true));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewBool(false));
+        varLstAdd(paramList, varNewInt(3));
+        varLstAdd(paramList, varNewBool(false));
+
+        serverReadIo = ioBufferReadIo(
+            ioBufferReadNew(bufNewZ("BRBLOCK12\nNOT-GZIPPED!BRBLOCK4\nMOREBRBLOCK0\n{\"cmd\":\"noop\"}\n")));
+        ioReadOpen(serverReadIo);
+
+        serverWriteFile = protocolServerNew(strNew("test"), strNew("test"), serverReadIo, serverWriteIo);
+        bufUsedSet(serverWrite, 0);
+
+        TEST_ERROR(
+            storageDriverRemoteProtocol(PROTOCOL_COMMAND_STORAGE_OPEN_WRITE_STR, paramList, serverWriteFile), FormatError,
+            "zlib threw error: [-3] data error");
+        TEST_RESULT_STR(strPtr(strNewBuf(serverWrite)), "{}\n", "    check open result");
+        TEST_RESULT_STR(strPtr(ioReadLine(serverReadIo)), "{\"cmd\":\"noop\"}", "    check next command is in sync");
+
+        bufUsedSet(serverWrite, 0);
+        ioBufferSizeSet(8192);
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("storageRemove()"))
+    {
+        Storage *storageRemote = NULL;
+        TEST_ASSIGN(storageRemote, storageRepoGet(strNew(STORAGE_TYPE_POSIX), false), "get remote repo storage");
+        storageRemote->write = true;
+        storagePathCreateNP(storageTest, strNew("repo"));
+
+        storagePutNP(storageNewWriteNP(storageTest, strNew("repo/test.txt")), bufNewZ("TEST"));
+
+        TEST_RESULT_VOID(storageRemoveNP(storageRemote, strNew("test.txt")), "remove file");
+        TEST_RESULT_BOOL(storageExistsNP(storageTest, strNew("repo/test.txt")), false, "    check file");
+        TEST_RESULT_VOID(storageRemoveNP(storageRemote, strNew("test.txt")), "remove missing file");
+        TEST_ERROR(
+            storageRemoveP(storageRemote, strNew("test.txt"), .errorOnMissing = true), FileRemoveError,
+            strPtr(
+                strNewFmt(
+                    "raised from remote-0 protocol on 'localhost': unable to remove '%s/repo/test.txt': [2] No such file or"
+                        " directory",
+                    testPath())));
+
+        // Check protocol function directly
+        // -------------------------------------------------------------------------------------------------------------------------
+        storagePutNP(storageNewWriteNP(storageTest, strNew("repo/test.txt")), bufNewZ("TEST"));
+
+        VariantList *paramList = varLstNew();
+        varLstAdd(paramList, varNewStr(strNew("test.txt")));
+        varLstAdd(paramList, varNewBool(true));
+
+        TEST_RESULT_BOOL(
+            storageDriverRemoteProtocol(PROTOCOL_COMMAND_STORAGE_REMOVE_STR, paramList, server), true, "protocol remove");
+        TEST_RESULT_STR(strPtr(strNewBuf(serverWrite)), "{}\n", "    check result");
+        TEST_RESULT_BOOL(storageExistsNP(storageTest, strNew("repo/test.txt")), false, "    check file");
+
+        bufUsedSet(serverWrite, 0);
     }
 
     // *****************************************************************************************************************************
@@ -183,12 +795,9 @@ testRun(void)
         TEST_ASSIGN(storageRemote, storageRepoGet(strNew(STORAGE_TYPE_POSIX), false), "get remote repo storage");
 
         storageRemote->write = true;
-        TEST_ERROR(storageInfoNP(storageRemote, strNew("file.txt")), AssertError, "NOT YET IMPLEMENTED");
-        TEST_ERROR(storageNewWriteNP(storageRemote, strNew("file.txt")), AssertError, "NOT YET IMPLEMENTED");
         TEST_ERROR(storagePathCreateNP(storageRemote, strNew("path")), AssertError, "NOT YET IMPLEMENTED");
         TEST_ERROR(storagePathRemoveNP(storageRemote, strNew("path")), AssertError, "NOT YET IMPLEMENTED");
         TEST_ERROR(storagePathSyncNP(storageRemote, strNew("path")), AssertError, "NOT YET IMPLEMENTED");
-        TEST_ERROR(storageRemoveNP(storageRemote, strNew("file.txt")), AssertError, "NOT YET IMPLEMENTED");
     }
 
     protocolFree();